@@ -0,0 +1,29 @@
+
+#pragma once
+
+/* Name of package */
+#define PACKAGE "cherrytree"
+
+/* Name of package */
+#define PACKAGE_NAME "cherrytree"
+
+/* Version of package */
+#define PACKAGE_VERSION "1.7.1"
+#define PACKAGE_VERSION_WINDOWS 1,7,1,0
+#define PACKAGE_VERSION_WINDOWS_STR "1.7.1.0"
+
+/* The domain to use with gettext */
+#define GETTEXT_PACKAGE "cherrytree"
+
+/* Localization directory */
+#define CHERRYTREE_LOCALEDIR "/usr/share/locale"
+
+/* data directory */
+#define CHERRYTREE_DATADIR "/usr/share/cherrytree"
+
+/* always defined to indicate that i18n is enabled */
+/* #undef ENABLE_NLS */
+
+/* folder with root CMakeLists.txt */
+#define _CMAKE_SOURCE_DIR "/root/repo"
+#define _CMAKE_BINARY_DIR "/tmp/ctbuild"
@@ -30,6 +30,7 @@
 #include "ct_table.h"
 #include "ct_types.h"
 #include "ct_filesystem.h"
+#include "ct_task_pool.h"
 #include <optional>
 
 class CtMainWin;
@@ -47,6 +48,7 @@ public:
         _find_init();
         _validate_enable_spell_check();
     }
+    ~CtActions();
 
 public:
     CtCodebox*      curr_codebox_anchor{nullptr};
@@ -64,9 +66,13 @@ private:
     struct CtEmbFileOpened {
         fs::path tmp_filepath;
         time_t mod_time;
+        gint64 node_id;
+        Gtk::TreeRowReference nodeRowRef; // the node holding the widget, found without scanning the tree while it is not moved
+        Glib::RefPtr<Gio::FileMonitor> rFileMonitor;
+        sigc::connection debounceConnection; // the burst of events of a save is handled once
     };
     std::unordered_map<size_t, CtEmbFileOpened> _embfiles_opened;
-    sigc::connection _embfiles_timeout_connection;
+    CtTaskPool::CancelToken _embfilesCancelToken;
 
 private:
     CtMainWin* const _pCtMainWin;
@@ -142,10 +148,9 @@ public:
                          bool keep_focus = false);
 
 private:
-    bool _need_node_swap(Gtk::TreeModel::iterator& leftIter,
-                         Gtk::TreeModel::iterator& rightIter,
-                         bool ascendings);
-    bool _tree_sort_level_and_sublevels(const Gtk::TreeNodeChildren& children,
+    bool _node_siblings_sort(Gtk::TreeModel::iterator father_iter,
+                             bool ascending);
+    bool _tree_sort_level_and_sublevels(Gtk::TreeModel::iterator father_iter,
                                         bool ascending);
     void _node_date(const bool from_sel_not_root, const int days_offset = 0);
 
@@ -192,6 +197,7 @@ public:
     void tree_sort_ascending();
     void tree_sort_descending();
     void tree_info();
+    void perf_info();
     void doc_path_to_clipboard();
     void tree_clear_property_exclude_from_search();
     void node_link_to_clipboard();
@@ -228,6 +234,22 @@ private:
                                         const bool all_matches);
     bool _is_node_within_time_filter(const CtTreeIter& node_iter);
     Glib::RefPtr<Glib::Regex> _create_re_pattern(Glib::ustring pattern);
+    Glib::ustring _get_folded_text(const gint64 node_id, Glib::RefPtr<Gtk::TextBuffer> text_buffer);
+    void _folded_texts_clear();
+    // the matches in the first text_len bytes (-1 for all), from start_position, until f_match returns true
+    void _for_each_match(const Glib::ustring& text,
+                         Glib::RefPtr<Glib::Regex> re_pattern,
+                         const int text_len,
+                         const int start_position,
+                         const std::function<bool(const std::pair<int,int>&)>& f_match);
+    void _text_buffer_replace_keep_tags(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer,
+                                        const int startOffset,
+                                        const int endOffset,
+                                        const Glib::ustring& replacer_text);
+    bool _replace_all_in_node_text_can(const CtTreeIter& tree_iter);
+    int _replace_all_in_node_text(const CtTreeIter& tree_iter,
+                                  Glib::RefPtr<Gtk::TextBuffer> text_buffer,
+                                  Glib::RefPtr<Glib::Regex> re_pattern);
     bool _find_pattern(CtTreeIter tree_iter,
                        Glib::RefPtr<Gtk::TextBuffer> text_buffer,
                        Glib::RefPtr<Glib::Regex> re_pattern,
@@ -311,7 +333,7 @@ public:
 
 public:
     // helper for format actions
-    int get_word_count_for_statusbar();
+    CtTextCounts get_text_counts_for_statusbar();
     void apply_tag(const Glib::ustring& tag_property,
                    Glib::ustring property_value = "",
                    std::optional<Gtk::TextIter> iter_sel_start = std::nullopt,
@@ -433,7 +455,11 @@ private:
     void _anchor_edit_dialog(CtImageAnchor* anchor,
                              Gtk::TextIter insert_iter,
                              Gtk::TextIter* iter_bound);
-    bool _on_embfiles_sentinel_timeout();
+    void _embfile_monitor_start(const size_t open_id);
+    void _on_embfile_monitor_changed(const size_t open_id);
+    void _embfile_sync(const size_t open_id);
+    CtTreeIter _embfile_get_node(CtEmbFileOpened& embfileOpened);
+    void _embfile_drop(const size_t open_id);
     void _exec_code(const bool is_all);
     void _link_right_click_pre_action();
 
@@ -542,10 +568,11 @@ private:
     void _export_print(bool save_to_pdf, const fs::path& auto_path, bool auto_overwrite);
     void _export_to_html(const fs::path& auto_path, bool auto_overwrite);
     void _export_to_txt(const fs::path& auto_path, bool auto_overwrite);
+    void _export_to_md(const fs::path& auto_path, bool auto_overwrite);
 
     fs::path _get_pdf_filepath(const fs::path& proposed_name);
-    fs::path _get_txt_filepath(const fs::path& dir_place, const fs::path& proposed_name);
-    fs::path _get_txt_folder(fs::path dir_place, fs::path new_folder, bool export_overwrite);
+    fs::path _get_export_filepath(const fs::path& dir_place, const fs::path& proposed_name, const std::string& extension, const Glib::ustring& filter_name);
+    fs::path _get_export_folder(fs::path dir_place, fs::path new_folder, bool export_overwrite, const std::string& extension);
 
 public:
     // export actions
@@ -554,11 +581,13 @@ public:
     void export_to_pdf();
     void export_to_html();
     void export_to_txt();
+    void export_to_md();
     void export_to_ct();
 
     void export_to_pdf_auto(const std::string& dir, bool overwrite);
     void export_to_html_auto(const std::string& dir, bool overwrite, bool single_file);
     void export_to_txt_auto(const std::string& dir, bool overwrite, bool single_file);
+    void export_to_md_auto(const std::string& dir, bool overwrite, bool single_file);
 
 private:
     // helpers for help actions
@@ -269,7 +269,7 @@ void CtActions::embfile_insert_path(const std::string& filepath)
 
     CtAnchoredWidget* pAnchoredWidget = new CtImageEmbFile{_pCtMainWin,
                                                            name,
-                                                           blob,
+                                                           CtEmbFileBlob::from_memory(std::move(blob)),
                                                            std::time(nullptr),
                                                            _curr_buffer()->get_insert()->get_iter().get_offset(),
                                                            "",
@@ -437,8 +437,7 @@ void CtActions::_insert_toc_at_pos(Glib::RefPtr<Gtk::TextBuffer> text_buffer, co
         text_buffer->insert_at_cursor(entry.text);
 
         auto mark_iter = mark->get_iter();
-        std::string tag_name = _pCtMainWin->get_text_tag_name_exist_or_create(CtConst::TAG_LINK, entry.anchor_link);
-        text_buffer->apply_tag_by_name(tag_name, mark_iter, text_buffer->get_insert()->get_iter());
+        _pCtMainWin->apply_link_tag(text_buffer, entry.anchor_link, mark_iter, text_buffer->get_insert()->get_iter());
         text_buffer->delete_mark(mark);
 
         _insert_toc_at_pos(text_buffer, entry.children);
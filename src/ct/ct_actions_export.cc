@@ -25,6 +25,7 @@
 #include "ct_export2pdf.h"
 #include "ct_export2html.h"
 #include "ct_export2txt.h"
+#include "ct_export2md.h"
 #include "ct_storage_control.h"
 #include <glib/gstdio.h>
 #include "ct_logging.h"
@@ -55,6 +56,11 @@ void CtActions::export_to_txt()
     _export_to_txt("", false);
 }
 
+void CtActions::export_to_md()
+{
+    _export_to_md("", false);
+}
+
 void CtActions::export_to_ct()
 {
     if (not _is_there_selected_node_or_error()) {
@@ -187,6 +193,14 @@ void CtActions::export_to_txt_auto(const std::string& dir, bool overwrite, bool
     _export_to_txt(dir, overwrite);
 }
 
+void CtActions::export_to_md_auto(const std::string& dir, bool overwrite, bool single_file)
+{
+    spdlog::debug("md export to: {}", dir);
+    spdlog::debug("overwrite: {} single_file: {}", overwrite, single_file);
+    _export_options.single_file = single_file;
+    _export_to_md(dir, overwrite);
+}
+
 void CtActions::_export_print(bool save_to_pdf, const fs::path& auto_path, bool auto_overwrite)
 {
     CtExporting export_type;
@@ -199,6 +213,7 @@ void CtActions::_export_print(bool save_to_pdf, const fs::path& auto_path, bool
                                                                       &_export_options.new_node_page, nullptr, nullptr);
     }
     if (export_type == CtExporting::NONESAVE) return;
+    CtPerfScope perfScope{"export_pdf"};
     try {
         fs::path pdf_filepath;
         if (export_type == CtExporting::CURRENT_NODE) {
@@ -263,6 +278,7 @@ void CtActions::_export_to_html(const fs::path& auto_path, bool auto_overwrite)
             nullptr, &_export_options.index_in_page, &_export_options.single_file);
     }
     if (export_type == CtExporting::NONESAVE) return;
+    CtPerfScope perfScope{"export_html"};
 
     CtExport2Html export2html{_pCtMainWin};
     fs::path ret_html_path;
@@ -328,34 +344,35 @@ void CtActions::_export_to_txt(const fs::path& auto_path, bool auto_overwrite)
         export_type = CtDialogs::selnode_selnodeandsub_alltree_dialog(*_pCtMainWin, true, &_export_options.include_node_name, nullptr, nullptr, &_export_options.single_file);
     }
     if (export_type == CtExporting::NONESAVE) return;
+    CtPerfScope perfScope{"export_txt"};
 
     try {
         if (export_type == CtExporting::CURRENT_NODE) {
             fs::path txt_filepath = CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter());
-            txt_filepath = _get_txt_filepath("", txt_filepath);
+            txt_filepath = _get_export_filepath("", txt_filepath, ".txt", _("Plain Text Document"));
             if (txt_filepath.empty()) return;
             CtExport2Txt{_pCtMainWin}.node_export_to_txt(_pCtMainWin->curr_tree_iter(), txt_filepath, _export_options, -1, -1);
         }
         else if (export_type == CtExporting::CURRENT_NODE_AND_SUBNODES) {
             if (_export_options.single_file) {
-               fs::path txt_filepath = _get_txt_filepath("", _pCtMainWin->get_ct_storage()->get_file_name());
+               fs::path txt_filepath = _get_export_filepath("", _pCtMainWin->get_ct_storage()->get_file_name(), ".txt", _("Plain Text Document"));
                if (txt_filepath.empty()) return;
                CtExport2Txt{_pCtMainWin}.nodes_all_export_to_txt(false, "", txt_filepath, _export_options);
             }
             else {
-                fs::path folder_path = _get_txt_folder("", CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter()), false);
+                fs::path folder_path = _get_export_folder("", CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter()), false, ".txt");
                 if (folder_path.empty()) return;
                 CtExport2Txt{_pCtMainWin}.nodes_all_export_to_txt(false, folder_path, "", _export_options);
             }
         }
         else if (export_type == CtExporting::ALL_TREE) {
             if (_export_options.single_file) {
-                fs::path txt_filepath = _get_txt_filepath(auto_path, _pCtMainWin->get_ct_storage()->get_file_name());
+                fs::path txt_filepath = _get_export_filepath(auto_path, _pCtMainWin->get_ct_storage()->get_file_name(), ".txt", _("Plain Text Document"));
                 if (txt_filepath.empty()) return;
                 CtExport2Txt{_pCtMainWin}.nodes_all_export_to_txt(true, "", txt_filepath, _export_options);
             }
             else {
-                auto folder_path = _get_txt_folder(auto_path, _pCtMainWin->get_ct_storage()->get_file_name(), auto_overwrite);
+                auto folder_path = _get_export_folder(auto_path, _pCtMainWin->get_ct_storage()->get_file_name(), auto_overwrite, ".txt");
                 if (folder_path.empty()) return;
                 CtExport2Txt{_pCtMainWin}.nodes_all_export_to_txt(true, folder_path, "", _export_options);
             }
@@ -366,7 +383,7 @@ void CtActions::_export_to_txt(const fs::path& auto_path, bool auto_overwrite)
             _curr_buffer()->get_selection_bounds(iter_start, iter_end);
 
             fs::path txt_filepath = CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter());
-            txt_filepath = _get_txt_filepath("", txt_filepath);
+            txt_filepath = _get_export_filepath("", txt_filepath, ".txt", _("Plain Text Document"));
             if (txt_filepath.empty()) return;
             CtExport2Txt{_pCtMainWin}.node_export_to_txt(_pCtMainWin->curr_tree_iter(), txt_filepath, _export_options, iter_start.get_offset(), iter_end.get_offset());
         }
@@ -377,6 +394,69 @@ void CtActions::_export_to_txt(const fs::path& auto_path, bool auto_overwrite)
     }
 }
 
+// Export To Markdown Multiple (or single) Files
+void CtActions::_export_to_md(const fs::path& auto_path, bool auto_overwrite)
+{
+    CtExporting export_type;
+    if (not auto_path.empty()) {
+        _export_options.include_node_name = true;
+        export_type = CtExporting::ALL_TREE;
+    }
+    else {
+        if (not _is_there_selected_node_or_error()) return;
+        export_type = CtDialogs::selnode_selnodeandsub_alltree_dialog(*_pCtMainWin, true, &_export_options.include_node_name, nullptr, nullptr, &_export_options.single_file);
+    }
+    if (export_type == CtExporting::NONESAVE) return;
+    CtPerfScope perfScope{"export_md"};
+
+    try {
+        if (export_type == CtExporting::CURRENT_NODE) {
+            fs::path md_filepath = CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter());
+            md_filepath = _get_export_filepath("", md_filepath, ".md", _("Markdown Document"));
+            if (md_filepath.empty()) return;
+            CtExport2Md{_pCtMainWin}.node_export_to_md(_pCtMainWin->curr_tree_iter(), md_filepath, _export_options, -1, -1);
+        }
+        else if (export_type == CtExporting::CURRENT_NODE_AND_SUBNODES) {
+            if (_export_options.single_file) {
+               fs::path md_filepath = _get_export_filepath("", _pCtMainWin->get_ct_storage()->get_file_name(), ".md", _("Markdown Document"));
+               if (md_filepath.empty()) return;
+               CtExport2Md{_pCtMainWin}.nodes_all_export_to_md(false, "", md_filepath, _export_options);
+            }
+            else {
+                fs::path folder_path = _get_export_folder("", CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter()), false, ".md");
+                if (folder_path.empty()) return;
+                CtExport2Md{_pCtMainWin}.nodes_all_export_to_md(false, folder_path, "", _export_options);
+            }
+        }
+        else if (export_type == CtExporting::ALL_TREE) {
+            if (_export_options.single_file) {
+                fs::path md_filepath = _get_export_filepath(auto_path, _pCtMainWin->get_ct_storage()->get_file_name(), ".md", _("Markdown Document"));
+                if (md_filepath.empty()) return;
+                CtExport2Md{_pCtMainWin}.nodes_all_export_to_md(true, "", md_filepath, _export_options);
+            }
+            else {
+                auto folder_path = _get_export_folder(auto_path, _pCtMainWin->get_ct_storage()->get_file_name(), auto_overwrite, ".md");
+                if (folder_path.empty()) return;
+                CtExport2Md{_pCtMainWin}.nodes_all_export_to_md(true, folder_path, "", _export_options);
+            }
+        }
+        else if (export_type == CtExporting::SELECTED_TEXT) {
+            if (not _is_there_text_selection_or_error()) return;
+            Gtk::TextIter iter_start, iter_end;
+            _curr_buffer()->get_selection_bounds(iter_start, iter_end);
+
+            fs::path md_filepath = CtMiscUtil::get_node_hierarchical_name(_pCtMainWin->curr_tree_iter());
+            md_filepath = _get_export_filepath("", md_filepath, ".md", _("Markdown Document"));
+            if (md_filepath.empty()) return;
+            CtExport2Md{_pCtMainWin}.node_export_to_md(_pCtMainWin->curr_tree_iter(), md_filepath, _export_options, iter_start.get_offset(), iter_end.get_offset());
+        }
+    }
+    catch (std::exception& e) {
+        spdlog::error(e.what());
+        CtDialogs::error_dialog(e.what(), *_pCtMainWin);
+    }
+}
+
 fs::path CtActions::_get_pdf_filepath(const fs::path& proposed_name)
 {
     CtDialogs::CtFileSelectArgs args{};
@@ -394,17 +474,20 @@ fs::path CtActions::_get_pdf_filepath(const fs::path& proposed_name)
     return filename;
 }
 
-// Prepare for the txt file save
-fs::path CtActions::_get_txt_filepath(const fs::path& dir_place, const fs::path& proposed_name)
+// Prepare for the txt or md file save
+fs::path CtActions::_get_export_filepath(const fs::path& dir_place,
+                                         const fs::path& proposed_name,
+                                         const std::string& extension,
+                                         const Glib::ustring& filter_name)
 {
     fs::path filename;
     if (dir_place.empty())
     {
         CtDialogs::CtFileSelectArgs args{};
         args.curr_folder = _pCtConfig->pickDirExport;
-        args.curr_file_name = proposed_name.string() + ".txt";
-        args.filter_name = _("Plain Text Document");
-        args.filter_pattern = {"*.txt"};
+        args.curr_file_name = proposed_name.string() + extension;
+        args.filter_name = filter_name;
+        args.filter_pattern = {"*" + extension};
 
         filename = CtDialogs::file_save_as_dialog(_pCtMainWin, args);
     }
@@ -415,7 +498,7 @@ fs::path CtActions::_get_txt_filepath(const fs::path& dir_place, const fs::path&
 
     if (not filename.empty())
     {
-        if (filename.extension() != ".txt") filename += ".txt";
+        if (filename.extension() != extension) filename += extension;
         _pCtConfig->pickDirExport = filename.parent_path().string();
 
         if (fs::is_regular_file(filename)) fs::remove(filename);
@@ -423,7 +506,8 @@ fs::path CtActions::_get_txt_filepath(const fs::path& dir_place, const fs::path&
     return filename;
 }
 
-fs::path CtActions::_get_txt_folder(fs::path dir_place, fs::path new_folder, bool export_overwrite)
+// the folder is named after the extension, e.g. _TXT for .txt
+fs::path CtActions::_get_export_folder(fs::path dir_place, fs::path new_folder, bool export_overwrite, const std::string& extension)
 {
     if (dir_place.empty())
     {
@@ -431,7 +515,7 @@ fs::path CtActions::_get_txt_folder(fs::path dir_place, fs::path new_folder, boo
         if (dir_place.empty())
             return "";
     }
-    new_folder = CtMiscUtil::clean_from_chars_not_for_filename(new_folder.string()) + "_TXT";
+    new_folder = CtMiscUtil::clean_from_chars_not_for_filename(new_folder.string()) + "_" + Glib::ustring{extension.substr(1)}.uppercase().raw();
     new_folder = fs::prepare_export_folder(dir_place, new_folder, export_overwrite);
     fs::path export_dir = dir_place / new_folder;
     g_mkdir_with_parents(export_dir.c_str(), 0777);
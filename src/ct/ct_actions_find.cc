@@ -25,9 +25,12 @@
 #include <gtkmm/dialog.h>
 #include <glibmm/regex.h>
 #include <regex>
+#include <algorithm>
 #include "ct_image.h"
 #include "ct_dialogs.h"
 #include "ct_logging.h"
+#include "ct_search_matcher.h"
+#include "ct_links_index.h"
 
 void CtActions::find_matches_store_reset()
 {
@@ -82,6 +85,7 @@ void CtActions::find_in_selected_node_ok_clicked()
 {
     Glib::RefPtr<Glib::Regex> re_pattern = _create_re_pattern(_s_state.curr_find_pattern);
     if (not re_pattern) return;
+    CtPerfScope perfScope{"search_selected_node"};
 
     bool forward = _s_options.direction_fw;
     if (_s_state.from_find_back) {
@@ -238,7 +242,7 @@ void CtActions::find_in_multiple_nodes_ok_clicked()
         while (app_context->pending()) app_context->iteration(false);
 #endif
     }
-    std::time_t search_start_time = std::time(nullptr);
+    CtPerfScope perfScope{"search_multiple_nodes"};
     while (node_iter) {
         _s_state.all_matches_first_in_node = true;
         CtTreeIter ct_node_iter = ctTreeStore.to_ct_tree_iter(node_iter);
@@ -281,8 +285,6 @@ void CtActions::find_in_multiple_nodes_ok_clicked()
             _update_all_matches_progress();
         }
     }
-    std::time_t search_end_time = std::time(nullptr);
-    spdlog::debug("Search took {} sec", search_end_time - search_start_time);
 
     _pCtMainWin->user_active() = user_active_restore;
     if (0 == _s_state.matches_num) {
@@ -554,6 +556,20 @@ bool CtActions::_parse_node_content_iter(const CtTreeIter& tree_iter,
         return false;
     }
 
+    if (all_matches and _s_state.replace_active and _replace_all_in_node_text_can(tree_iter)) {
+        // all the matches of the node replaced in one go, the caller counts one of them
+        if (not _s_state.all_matches_first_in_node) {
+            return false;
+        }
+        _s_state.all_matches_first_in_node = false;
+        const int replaced_num = _replace_all_in_node_text(tree_iter, text_buffer, re_pattern);
+        if (replaced_num <= 0) {
+            return false;
+        }
+        _s_state.matches_num += replaced_num - 1;
+        return true;
+    }
+
     Gtk::TextIter start_iter;
     if ((first_fromsel and first_node) or (all_matches and not _s_state.all_matches_first_in_node)) {
         start_iter = _get_inner_start_iter(text_buffer, forward, all_matches);
@@ -649,7 +665,10 @@ Glib::RefPtr<Glib::Regex> CtActions::_create_re_pattern(Glib::ustring pattern)
             spdlog::debug("auto reg_exp {}", pattern.c_str());
         }
     }
+    _s_state.pLiteralMatcher.reset();
     if (not _s_options.reg_exp and not temp_reg_exp) { // NOT REGULAR EXPRESSION
+        // the node text is searched without the regular expression, still needed for the objects and the replace
+        _s_state.pLiteralMatcher = CtSearchMatcher::create_literal(pattern, _s_options.match_case, _s_options.whole_word, _s_options.start_word);
         pattern = Glib::Regex::escape_string(pattern);     // backslashes all non alphanum chars => to not spoil re
         if (_s_options.whole_word)      // WHOLE WORD
             pattern = "\\b" + pattern + "\\b";
@@ -675,6 +694,236 @@ Glib::RefPtr<Glib::Regex> CtActions::_create_re_pattern(Glib::ustring pattern)
     }
 }
 
+Glib::ustring CtActions::_get_folded_text(const gint64 node_id, Glib::RefPtr<Gtk::TextBuffer> text_buffer)
+{
+    auto mapIter = _s_state.foldedTexts.find(node_id);
+    if (mapIter != _s_state.foldedTexts.end()) {
+        if (mapIter->second.bufferChangedConn.connected() and mapIter->second.pTextBuffer == text_buffer->gobj()) {
+            return mapIter->second.text;
+        }
+        // from a buffer of a document closed in the meantime
+        _s_state.foldedTextsBytes -= mapIter->second.text.bytes();
+        mapIter->second.bufferChangedConn.disconnect();
+        _s_state.foldedTexts.erase(mapIter);
+    }
+    if (_s_state.foldedTextsBytes > 64u*1024u*1024u) {
+        _folded_texts_clear();
+    }
+    CtSearchState::CtFoldedText& foldedText = _s_state.foldedTexts[node_id];
+    foldedText.text = str::diacritical_to_ascii(text_buffer->get_text());
+    foldedText.pTextBuffer = text_buffer->gobj();
+    // any edit of the node text drops it
+    foldedText.bufferChangedConn = text_buffer->signal_changed().connect([this, node_id](){
+        auto mapIter = _s_state.foldedTexts.find(node_id);
+        if (mapIter != _s_state.foldedTexts.end()) {
+            _s_state.foldedTextsBytes -= mapIter->second.text.bytes();
+            mapIter->second.bufferChangedConn.disconnect();
+            _s_state.foldedTexts.erase(mapIter);
+        }
+    });
+    _s_state.foldedTextsBytes += foldedText.text.bytes();
+    return foldedText.text;
+}
+
+void CtActions::_folded_texts_clear()
+{
+    for (auto& pairIdFoldedText : _s_state.foldedTexts) {
+        pairIdFoldedText.second.bufferChangedConn.disconnect();
+    }
+    _s_state.foldedTexts.clear();
+    _s_state.foldedTextsBytes = 0u;
+}
+
+void CtActions::_for_each_match(const Glib::ustring& text,
+                                Glib::RefPtr<Glib::Regex> re_pattern,
+                                const int text_len,
+                                const int start_position,
+                                const std::function<bool(const std::pair<int,int>&)>& f_match)
+{
+    if (_s_state.pLiteralMatcher) {
+        const size_t len = text_len < 0 ? text.bytes() : static_cast<size_t>(text_len);
+        for (std::pair<int,int> curr_pair = _s_state.pLiteralMatcher->find(text.data(), len, start_position);
+             -1 != curr_pair.first and not f_match(curr_pair);
+             curr_pair = _s_state.pLiteralMatcher->find(text.data(), len, curr_pair.second)) {}
+        return;
+    }
+    Glib::MatchInfo match_info;
+    (void)re_pattern->match(text, text_len, start_position, match_info);
+    while (match_info.matches()) {
+        std::pair<int,int> curr_pair;
+        match_info.fetch_pos(0, curr_pair.first, curr_pair.second);
+        if (f_match(curr_pair)) {
+            break;
+        }
+        match_info.next();
+    }
+}
+
+void CtActions::_text_buffer_replace_keep_tags(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer,
+                                               const int startOffset,
+                                               const int endOffset,
+                                               const Glib::ustring& replacer_text)
+{
+    // collect the unique cherrytree formatting tags of the range before erasing
+    auto f_is_ct_tag = [](const Glib::ustring& name)->bool{
+        return str::startswith(name, CtConst::TAG_WEIGHT_PREFIX)
+            or str::startswith(name, CtConst::TAG_FOREGROUND_PREFIX)
+            or str::startswith(name, CtConst::TAG_BACKGROUND_PREFIX)
+            or str::startswith(name, CtConst::TAG_STYLE_PREFIX)
+            or str::startswith(name, CtConst::TAG_UNDERLINE_PREFIX)
+            or str::startswith(name, CtConst::TAG_STRIKETHROUGH_PREFIX)
+            or str::startswith(name, CtConst::TAG_INDENT_PREFIX)
+            or str::startswith(name, CtConst::TAG_SCALE_PREFIX)
+            or str::startswith(name, CtConst::TAG_INVISIBLE_PREFIX)
+            or str::startswith(name, CtConst::TAG_JUSTIFICATION_PREFIX)
+            or str::startswith(name, CtConst::TAG_LINK_PREFIX)
+            or str::startswith(name, CtConst::TAG_FAMILY_PREFIX);
+    };
+    std::vector<Glib::RefPtr<Gtk::TextTag>> range_tags;
+    // the link tag is shared by the links of a type, the target is kept aside
+    Glib::ustring link_target;
+    {
+        Gtk::TextIter it = pTextBuffer->get_iter_at_offset(startOffset);
+        const Gtk::TextIter end_it = pTextBuffer->get_iter_at_offset(endOffset);
+        while (it.compare(end_it) < 0) {
+            if (link_target.empty()) {
+                link_target = CtLinksIndex::get_target_at(it);
+            }
+            for (const auto& tag : it.get_tags()) {
+                if (not f_is_ct_tag(tag->property_name())) continue;
+                bool already_present{false};
+                for (const auto& existing : range_tags) {
+                    if (existing.get() == tag.get()) { already_present = true; break; }
+                }
+                if (not already_present) range_tags.push_back(tag);
+            }
+            if (not it.forward_char()) break;
+        }
+    }
+    pTextBuffer->erase(pTextBuffer->get_iter_at_offset(startOffset), pTextBuffer->get_iter_at_offset(endOffset));
+    pTextBuffer->insert(pTextBuffer->get_iter_at_offset(startOffset), replacer_text);
+    // re-apply the preserved tags to the replacement text
+    if (not range_tags.empty() and replacer_text.size() > 0u) {
+        Gtk::TextIter new_start = pTextBuffer->get_iter_at_offset(startOffset);
+        Gtk::TextIter new_end = pTextBuffer->get_iter_at_offset(startOffset + (int)replacer_text.size());
+        for (const auto& tag : range_tags) {
+            pTextBuffer->apply_tag(tag, new_start, new_end);
+        }
+        if (not link_target.empty()) {
+            CtLinksIndex::get(pTextBuffer).set_target(pTextBuffer->get_iter_at_offset(startOffset),
+                                                      pTextBuffer->get_iter_at_offset(startOffset + (int)replacer_text.size()),
+                                                      link_target);
+        }
+    }
+}
+
+// Replace all the matches in the text of a node without anchored objects, in one go
+bool CtActions::_replace_all_in_node_text_can(const CtTreeIter& tree_iter)
+{
+    if (tree_iter.get_node_read_only() or
+        (tree_iter.get_node_is_rich_text() and _s_options.replace_in_link_targets))
+    {
+        return false; // the link targets are replaced by the per match path
+    }
+    return tree_iter.get_anchored_widgets_fast().empty();
+}
+
+// Returns the number of matches replaced
+int CtActions::_replace_all_in_node_text(const CtTreeIter& tree_iter,
+                                         Glib::RefPtr<Gtk::TextBuffer> text_buffer,
+                                         Glib::RefPtr<Glib::Regex> re_pattern)
+{
+    CtPerfScope perfScope{"replace_all_in_node"};
+    // all the matches on a snapshot of the text, without objects the text offsets are the buffer offsets
+    const Glib::ustring orig_text = text_buffer->get_text();
+    const Glib::ustring text = _s_options.accent_insensitive ? _get_folded_text(tree_iter.get_node_id(), text_buffer) : orig_text;
+    std::vector<std::pair<int,int>> byte_matches;
+    _for_each_match(text, re_pattern, -1, 0/*start_position*/, [&byte_matches](const std::pair<int,int>& curr_pair){
+        byte_matches.push_back(curr_pair);
+        return false;
+    });
+    if (byte_matches.empty()) {
+        return 0;
+    }
+
+    struct Replacement {
+        int           start_offset;
+        int           end_offset;
+        Glib::ustring replacer_text;
+    };
+    std::vector<Replacement> replacements;
+    replacements.reserve(byte_matches.size());
+    const gint64 node_id = tree_iter.get_node_id();
+    const Glib::ustring node_name = tree_iter.get_node_name();
+    const Glib::ustring esc_node_hier_name = str::xml_escape(CtMiscUtil::get_node_hierarchical_name(tree_iter, "  /  ", false/*for_filename*/, true/*root_to_leaf*/));
+    const Glib::ustring text_tags = tree_iter.get_node_tags();
+    const Glib::ustring node_name_w_tags = text_tags.empty() ? node_name : node_name + "\n [" +  _("Tags") + _(": ") + text_tags + "]";
+    const std::string& raw_text = text.raw();
+    const std::string& raw_orig_text = orig_text.raw();
+    // the folded text has the same characters and newlines, fewer bytes where a diacritic was folded
+    const bool same_bytes = raw_text.size() == raw_orig_text.size();
+    int prev_byte{0};
+    int prev_orig_byte{0};
+    int prev_offset{0};
+    int prev_line_num{1};
+    int delta_offsets{0}; // the earlier replacements shift the match store offsets
+    int delta_lines{0};
+    for (const std::pair<int,int>& byte_match : byte_matches) {
+        Replacement replacement;
+        const int match_chars = static_cast<int>(g_utf8_strlen(raw_text.data() + byte_match.first, byte_match.second - byte_match.first));
+        replacement.start_offset = prev_offset + static_cast<int>(g_utf8_strlen(raw_text.data() + prev_byte, byte_match.first - prev_byte));
+        replacement.end_offset = replacement.start_offset + match_chars;
+        const int line_num = prev_line_num + static_cast<int>(std::count(raw_text.begin() + prev_byte, raw_text.begin() + byte_match.first, '\n'));
+        int orig_first{byte_match.first};
+        int orig_second{byte_match.second};
+        if (not same_bytes) {
+            const char* pOrig = raw_orig_text.data();
+            orig_first = static_cast<int>(g_utf8_offset_to_pointer(pOrig + prev_orig_byte, replacement.start_offset - prev_offset) - pOrig);
+            orig_second = static_cast<int>(g_utf8_offset_to_pointer(pOrig + orig_first, match_chars) - pOrig);
+        }
+        prev_byte = byte_match.first;
+        prev_orig_byte = orig_first;
+        prev_offset = replacement.start_offset;
+        prev_line_num = line_num;
+        replacement.replacer_text = _s_options.str_replace;
+        if (_s_options.reg_exp) {
+            const Glib::ustring origin_text = raw_orig_text.substr(orig_first, orig_second - orig_first);
+            replacement.replacer_text = re_pattern->replace(origin_text, 0, replacement.replacer_text, static_cast<Glib::RegexMatchFlags>(0));
+        }
+        // the line of the match before the replace
+        const size_t line_start = orig_first > 0 ? raw_orig_text.rfind('\n', orig_first - 1) : std::string::npos;
+        const size_t line_first_byte = std::string::npos == line_start ? 0u : line_start + 1u;
+        const size_t line_end = raw_orig_text.find('\n', orig_second);
+        const Glib::ustring line_content = raw_orig_text.substr(line_first_byte, std::string::npos == line_end ? std::string::npos : line_end - line_first_byte);
+        (void)_s_state.match_store->add_row(node_id,
+                                            node_name_w_tags,
+                                            esc_node_hier_name,
+                                            replacement.start_offset + delta_offsets,
+                                            replacement.start_offset + delta_offsets + static_cast<int>(replacement.replacer_text.size()),
+                                            line_num + delta_lines,
+                                            line_content.size() <= CtTextIterUtil::LINE_CONTENT_LIMIT ?
+                                                line_content : line_content.substr(0u, CtTextIterUtil::LINE_CONTENT_LIMIT) + "...",
+                                            CtAnchWidgType::None, 0, 0, 0);
+        delta_offsets += static_cast<int>(replacement.replacer_text.size()) - match_chars;
+        delta_lines += static_cast<int>(std::count(replacement.replacer_text.raw().begin(), replacement.replacer_text.raw().end(), '\n')) -
+                       static_cast<int>(std::count(raw_text.begin() + byte_match.first, raw_text.begin() + byte_match.second, '\n'));
+        replacements.push_back(std::move(replacement));
+    }
+
+    // from the last one, so that the offsets of the previous ones are still valid
+    text_buffer->begin_user_action();
+    for (auto it = replacements.rbegin(); it != replacements.rend(); ++it) {
+        _text_buffer_replace_keep_tags(text_buffer, it->start_offset, it->end_offset, it->replacer_text);
+    }
+    text_buffer->end_user_action();
+
+    // one undo step and one save flag for the node
+    _pCtMainWin->get_state_machine().update_state(tree_iter);
+    tree_iter.pending_edit_db_node_buff();
+    _pCtMainWin->update_window_save_needed(CtSaveNeededUpdType::nbuf, false/*new_machine_state*/, &tree_iter);
+    return static_cast<int>(replacements.size());
+}
+
 bool CtActions::_find_pattern(CtTreeIter tree_iter,
                               Glib::RefPtr<Gtk::TextBuffer> text_buffer,
                               Glib::RefPtr<Glib::Regex> re_pattern,
@@ -684,43 +933,33 @@ bool CtActions::_find_pattern(CtTreeIter tree_iter,
 {
     // Gtk::TextBuffer uses symbols positions
     // Glib::Regex uses byte positions
-    Glib::ustring text = text_buffer->get_text();
-    if (_s_options.accent_insensitive) {
-        text = str::diacritical_to_ascii(text);
-    }
-
     const gint64 node_id = tree_iter.get_node_id();
+    // the accent insensitive text has the same symbols positions, one ascii char for each replaced symbol
+    const Glib::ustring text = _s_options.accent_insensitive ? _get_folded_text(node_id, text_buffer) : text_buffer->get_text();
+
     const int start_offset = start_iter.get_offset();
     const int num_objs_before_start = _get_num_objs_before_offset(text_buffer, start_offset);
     const int position_fw_start_or_bw_end = str::symb_pos_to_byte_pos(text, std::max(0, start_offset - num_objs_before_start));
     std::pair<int, int> match_offsets{-1, -1};
     if (forward) {
-        Glib::MatchInfo match_info;
-        (void)re_pattern->match(text, position_fw_start_or_bw_end, match_info);
-        while (match_info.matches()) {
-            std::pair<int,int> curr_pair;
-            match_info.fetch_pos(0, curr_pair.first, curr_pair.second);
+        _for_each_match(text, re_pattern, -1, position_fw_start_or_bw_end, [&](const std::pair<int,int>& curr_pair){
             if (curr_pair.first >= _s_state.latest_node_offset_match_end or
                 node_id != _s_state.latest_node_offset_node_id)
             {
                 match_offsets = curr_pair;
                 _s_state.latest_node_offset_match_start = match_offsets.first;
                 _s_state.latest_node_offset_match_end = match_offsets.second;
-                break;
+                return true;
             }
-            match_info.next();
-        }
+            return false;
+        });
     }
     else {
-        Glib::MatchInfo match_info;
-        (void)re_pattern->match(text, position_fw_start_or_bw_end, 0/*start_position*/, match_info);
         std::deque<std::pair<int,int>> match_deque;
-        while (match_info.matches()) {
-            std::pair<int,int> curr_pair;
-            match_info.fetch_pos(0, curr_pair.first, curr_pair.second);
+        _for_each_match(text, re_pattern, position_fw_start_or_bw_end, 0/*start_position*/, [&match_deque](const std::pair<int,int>& curr_pair){
             match_deque.push_front(curr_pair);
-            match_info.next();
-        }
+            return false;
+        });
         for (const auto& curr_pair : match_deque) {
             if (curr_pair.second <= _s_state.latest_node_offset_match_start or
                 node_id != _s_state.latest_node_offset_node_id)
@@ -892,55 +1131,13 @@ bool CtActions::_find_pattern(CtTreeIter tree_iter,
                                                                        const int startOffset,
                                                                        int& endOffset)->bool{
         if (tree_iter.get_node_read_only()) return false;
-        Gtk::TextIter sel_start = pTextBuffer->get_iter_at_offset(startOffset);
-        Gtk::TextIter sel_end = pTextBuffer->get_iter_at_offset(endOffset);
-        Glib::ustring origin_text = sel_start.get_text(sel_end);
+        Glib::ustring origin_text = pTextBuffer->get_iter_at_offset(startOffset).get_text(pTextBuffer->get_iter_at_offset(endOffset));
         Glib::ustring replacer_text = _s_options.str_replace; /* use Glib::ustring to count symbols */
         // use re_pattern->replace for the cases with \n, maybe it even helps with groups
         if (_s_options.reg_exp) {
             replacer_text = re_pattern->replace(origin_text, 0, replacer_text, static_cast<Glib::RegexMatchFlags>(0));
         }
-        // Collect unique CherryTree formatting tags from the matched range before erasing
-        auto f_is_ct_tag = [](const Glib::ustring& name)->bool{
-            return str::startswith(name, CtConst::TAG_WEIGHT_PREFIX)
-                or str::startswith(name, CtConst::TAG_FOREGROUND_PREFIX)
-                or str::startswith(name, CtConst::TAG_BACKGROUND_PREFIX)
-                or str::startswith(name, CtConst::TAG_STYLE_PREFIX)
-                or str::startswith(name, CtConst::TAG_UNDERLINE_PREFIX)
-                or str::startswith(name, CtConst::TAG_STRIKETHROUGH_PREFIX)
-                or str::startswith(name, CtConst::TAG_INDENT_PREFIX)
-                or str::startswith(name, CtConst::TAG_SCALE_PREFIX)
-                or str::startswith(name, CtConst::TAG_INVISIBLE_PREFIX)
-                or str::startswith(name, CtConst::TAG_JUSTIFICATION_PREFIX)
-                or str::startswith(name, CtConst::TAG_LINK_PREFIX)
-                or str::startswith(name, CtConst::TAG_FAMILY_PREFIX);
-        };
-        std::vector<Glib::RefPtr<Gtk::TextTag>> range_tags;
-        {
-            Gtk::TextIter it = pTextBuffer->get_iter_at_offset(startOffset);
-            const Gtk::TextIter end_it = pTextBuffer->get_iter_at_offset(endOffset);
-            while (it.compare(end_it) < 0) {
-                for (const auto& tag : it.get_tags()) {
-                    if (not f_is_ct_tag(tag->property_name())) continue;
-                    bool already_present{false};
-                    for (const auto& existing : range_tags) {
-                        if (existing.get() == tag.get()) { already_present = true; break; }
-                    }
-                    if (not already_present) range_tags.push_back(tag);
-                }
-                if (not it.forward_char()) break;
-            }
-        }
-        pTextBuffer->erase(sel_start, sel_end);
-        pTextBuffer->insert(pTextBuffer->get_iter_at_offset(startOffset), replacer_text);
-        // Re-apply preserved tags to the replacement text
-        if (not range_tags.empty() and replacer_text.size() > 0u) {
-            Gtk::TextIter new_start = pTextBuffer->get_iter_at_offset(startOffset);
-            Gtk::TextIter new_end = pTextBuffer->get_iter_at_offset(startOffset + (int)replacer_text.size());
-            for (const auto& tag : range_tags) {
-                pTextBuffer->apply_tag(tag, new_start, new_end);
-            }
-        }
+        _text_buffer_replace_keep_tags(pTextBuffer, startOffset, endOffset, replacer_text);
         endOffset = startOffset + replacer_text.size();
         _s_state.replace_subsequent = true;
         _pCtMainWin->get_state_machine().update_state(tree_iter);
@@ -1203,19 +1400,14 @@ bool CtActions::_find_pattern(CtTreeIter tree_iter,
     //spdlog::debug("{} obj={} cell={} {}->{}", __FUNCTION__, obj_offset, anch_cell_idx, anch_offs_start, anch_offs_end);
     Gtk::TextIter anchor_iter = pTextBuffer->get_iter_at_offset(obj_offset);
     if (CtAnchWidgType::Link == anch_type) {
-        std::optional<Glib::ustring> tag_name = CtTextIterUtil::iter_get_tag_startingwith(anchor_iter, CtConst::TAG_LINK_PREFIX);
-        if (tag_name.has_value()) {
-            Glib::RefPtr<Gtk::TextTag> pTextTag = pCtMainWin->get_text_tag_table()->lookup(tag_name.value());
-            Gtk::TextIter textIterEndTmp{anchor_iter};
-            (void)textIterEndTmp.forward_to_tag_toggle(pTextTag);
-            Gtk::TextIter textIterStartTmp{anchor_iter};
-            (void)textIterStartTmp.backward_to_tag_toggle(pTextTag);
+        Gtk::TextIter textIterStartTmp, textIterEndTmp;
+        if (CtLinksIndex::get_link_bounds(anchor_iter, textIterStartTmp, textIterEndTmp)) {
             const int start_offset = textIterStartTmp.get_offset();
             const int end_offset = textIterEndTmp.get_offset();
             pCtMainWin->get_text_view().set_selection_at_offset_n_delta(start_offset, end_offset - start_offset, pTextBuffer);
         }
         else {
-            spdlog::debug("? {} !tag_name", __FUNCTION__);
+            spdlog::debug("? {} !link", __FUNCTION__);
         }
         return;
     }
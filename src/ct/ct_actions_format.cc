@@ -26,6 +26,7 @@
 #include <glibmm/base64.h>
 #include "ct_dialogs.h"
 #include "ct_list.h"
+#include "ct_text_counters.h"
 #include <optional>
 
 void CtActions::_save_tags_at_cursor_as_latest(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer, int cursorOffset)
@@ -508,9 +509,17 @@ void CtActions::apply_tag(const Glib::ustring& tag_property,
     }
 
     if (not property_value.empty()) {
-        text_buffer->apply_tag_by_name(_pCtMainWin->get_text_tag_name_exist_or_create(tag_property, property_value),
-                                       text_buffer->get_iter_at_offset(sel_start_offset),
-                                       text_buffer->get_iter_at_offset(sel_end_offset));
+        if (tag_property == CtConst::TAG_LINK) {
+            _pCtMainWin->apply_link_tag(text_buffer,
+                                        property_value,
+                                        text_buffer->get_iter_at_offset(sel_start_offset),
+                                        text_buffer->get_iter_at_offset(sel_end_offset));
+        }
+        else {
+            text_buffer->apply_tag_by_name(_pCtMainWin->get_text_tag_name_exist_or_create(tag_property, property_value),
+                                           text_buffer->get_iter_at_offset(sel_start_offset),
+                                           text_buffer->get_iter_at_offset(sel_end_offset));
+        }
     }
 
     if (restore_cursor_offset != -1) { // remove auto selection and restore cursor placement
@@ -545,47 +554,35 @@ CtActions::text_view_n_buffer_codebox_proof CtActions::_get_text_view_n_buffer_c
         nullptr};
 }
 
-int CtActions::get_word_count_for_statusbar()
+CtTextCounts CtActions::get_text_counts_for_statusbar()
 {
-    auto get_words_count_for_buffer = [](const Glib::RefPtr<Gtk::TextBuffer>& text_buffer)->int {
-        if (not text_buffer) {
-            return 0;
-        }
-        Gtk::TextIter iter_sel_start;
-        Gtk::TextIter iter_sel_end;
-        if (text_buffer->get_selection_bounds(iter_sel_start, iter_sel_end)) {
-            return CtTextIterUtil::get_words_count(text_buffer->get_text(iter_sel_start, iter_sel_end, true));
-        }
-        return CtTextIterUtil::get_words_count(text_buffer->get_text(true));
-    };
-
-    auto get_words_count_for_table = [get_words_count_for_buffer](CtTableCommon* pTable)->int {
+    auto get_text_counts_for_table = [](CtTableCommon* pTable)->CtTextCounts {
         if (not pTable) {
-            return 0;
+            return CtTextCounts{};
         }
         if (auto pTableHeavy = dynamic_cast<CtTableHeavy*>(pTable)) {
             const auto curr_cell_buffer = pTableHeavy->curr_cell_text_view().get_buffer();
-            return get_words_count_for_buffer(curr_cell_buffer);
+            return CtTextCounters::get_counts(curr_cell_buffer);
         }
         if (auto pTableLight = dynamic_cast<CtTableLight*>(pTable)) {
-            return CtTextIterUtil::get_words_count(pTableLight->get_curr_cell_text());
+            return CtTextCounters::get_counts(pTableLight->get_curr_cell_text());
         }
-        return 0;
+        return CtTextCounts{};
     };
 
     if (auto pCodebox = _codebox_in_use()) {
-        return get_words_count_for_buffer(pCodebox->get_buffer());
+        return CtTextCounters::get_counts(pCodebox->get_buffer());
     }
     if (auto pTable = _table_in_use()) {
-        return get_words_count_for_table(pTable);
+        return get_text_counts_for_table(pTable);
     }
 
     const auto text_buffer = _pCtMainWin->get_text_view().get_buffer();
     if (not text_buffer) {
-        return 0;
+        return CtTextCounts{};
     }
 
-    int words_count = get_words_count_for_buffer(text_buffer);
+    CtTextCounts text_counts = CtTextCounters::get_counts(text_buffer);
     Gtk::TextIter iter_sel_start;
     Gtk::TextIter iter_sel_end;
     if (text_buffer->get_selection_bounds(iter_sel_start, iter_sel_end) and
@@ -597,20 +594,21 @@ int CtActions::get_word_count_for_statusbar()
             if (treeIter) {
                 CtAnchoredWidget* pAnchoredWidget = treeIter.get_anchored_widget(pChildAnchor);
                 if (auto pCodebox = dynamic_cast<CtCodebox*>(pAnchoredWidget)) {
-                    words_count = get_words_count_for_buffer(pCodebox->get_buffer());
+                    text_counts = CtTextCounters::get_counts(pCodebox->get_buffer());
                 }
                 else if (auto pTable = dynamic_cast<CtTableCommon*>(pAnchoredWidget)) {
-                    words_count = get_words_count_for_table(pTable);
+                    text_counts = get_text_counts_for_table(pTable);
                 }
                 else {
                     // Single-char anchor selection of non-text widgets must not report 0.
-                    words_count = CtTextIterUtil::get_words_count(text_buffer->get_text(true));
+                    const CtTextCounters& textCounters = CtTextCounters::get(text_buffer);
+                    text_counts = CtTextCounts{textCounters.get_words(), textCounters.get_chars(), textCounters.get_lines()};
                 }
             }
         }
     }
 
-    return words_count;
+    return text_counts;
 }
 
 CtCodebox* CtActions::_codebox_in_use()
@@ -281,6 +281,7 @@ void CtActions::_import_from_file(CtImporterInterface* importer, const bool dumm
     if (filepath.empty()) return;
     spdlog::debug("{} {}", __FUNCTION__, filepath);
     _pCtConfig->pickDirImport = Glib::path_get_dirname(filepath);
+    CtPerfScope perfScope{"import_file"};
 
     try {
         std::unique_ptr<CtImportedNode> pNode = importer->import_file(filepath);
@@ -298,6 +299,7 @@ void CtActions::_import_from_dir(CtImporterInterface* importer, const std::strin
     std::string start_dir = custom_dir.empty() or not fs::is_directory(custom_dir) ? _pCtConfig->pickDirImport : custom_dir;
     std::string import_dir = CtDialogs::folder_select_dialog(_pCtMainWin, start_dir);
     if (import_dir.empty()) return;
+    CtPerfScope perfScope{"import_dir"};
     if (custom_dir.empty()) {
         _pCtConfig->pickDirImport = import_dir;
     }
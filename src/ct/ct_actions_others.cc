@@ -168,19 +168,19 @@ void CtActions::embfile_save()
 
     _pCtConfig->pickDirFile = Glib::path_get_dirname(filepath);
 
-    if (curr_file_anchor->get_raw_blob().empty()) {
+    if (curr_file_anchor->get_blob()->empty()) {
         const fs::path& embfilePathLast = curr_file_anchor->get_pathLastMultiFile();
         if (fs::exists(embfilePathLast) and fs::copy_file(embfilePathLast, filepath.c_str())) {
             return;
         }
     }
 
-    g_file_set_contents(filepath.c_str(), curr_file_anchor->get_raw_blob().c_str(), (gssize)curr_file_anchor->get_raw_blob().size(), nullptr);
+    (void)curr_file_anchor->get_blob()->write_to_file(filepath);
 }
 
 void CtActions::embfile_open()
 {
-    if (curr_file_anchor->get_raw_blob().empty()) {
+    if (curr_file_anchor->get_blob()->empty()) {
         const fs::path& embfilePathLast = curr_file_anchor->get_pathLastMultiFile();
         if (fs::exists(embfilePathLast)) {
             fs::open_filepath(embfilePathLast, false/*open_folder_if_file_not_exists*/, _pCtConfig);
@@ -198,21 +198,25 @@ void CtActions::embfile_open()
                                                  CtConst::CHAR_MINUS + std::to_string(getpid())+
                                                  CtConst::CHAR_MINUS + curr_file_anchor->get_file_name().string();
         tmp_filepath = _pCtMainWin->get_ct_tmp()->getHiddenFilePath(filename);
+        Glib::RefPtr<Gtk::TreeStore> rTreeStore = _pCtMainWin->get_tree_store().get_store();
         _embfiles_opened[open_id] = CtEmbFileOpened{
             .tmp_filepath = tmp_filepath,
-            .mod_time = 0};
+            .mod_time = 0,
+            .node_id = _pCtMainWin->curr_tree_iter().get_node_id(),
+            .nodeRowRef = Gtk::TreeRowReference{rTreeStore, rTreeStore->get_path(_pCtMainWin->curr_tree_iter())}};
         mapIter = _embfiles_opened.find(open_id);
     }
     else {
         tmp_filepath = mapIter->second.tmp_filepath;
     }
 
-    g_file_set_contents(tmp_filepath.c_str(), curr_file_anchor->get_raw_blob().c_str(), (gssize)curr_file_anchor->get_raw_blob().size(), nullptr);
-    fs::open_filepath(tmp_filepath.c_str(), false, _pCtConfig);
+    (void)curr_file_anchor->get_blob()->write_to_file(tmp_filepath);
+    // our own write is not to be synced back
     mapIter->second.mod_time = fs::getmtime(tmp_filepath);
+    fs::open_filepath(tmp_filepath.c_str(), false, _pCtConfig);
 
-    if (not _embfiles_timeout_connection) {
-        _embfiles_timeout_connection = Glib::signal_timeout().connect(sigc::mem_fun(*this, &CtActions::_on_embfiles_sentinel_timeout), 500);
+    if (not mapIter->second.rFileMonitor) {
+        _embfile_monitor_start(open_id);
     }
 }
 
@@ -1014,47 +1018,145 @@ void CtActions::_anchor_edit_dialog(CtImageAnchor* anchor, Gtk::TextIter insert_
     image_insert_anchor(insert_iter, ret_anchor_name, expCollState, image_justification);
 }
 
-bool CtActions::_on_embfiles_sentinel_timeout()
+CtActions::~CtActions()
 {
+    _folded_texts_clear();
+    _embfilesCancelToken.cancel();
     for (auto& item : _embfiles_opened) {
-        const fs::path& tmp_filepath = item.second.tmp_filepath;
-        if (not fs::is_regular_file(tmp_filepath)) {
-            spdlog::debug("embdrop {}", tmp_filepath.string());
-            _embfiles_opened.erase(item.first);
-            break;
+        item.second.debounceConnection.disconnect();
+        if (item.second.rFileMonitor) {
+            item.second.rFileMonitor->cancel();
         }
-        if (item.second.mod_time != fs::getmtime(tmp_filepath)) {
-            item.second.mod_time = fs::getmtime(tmp_filepath);
-            const auto data_vec = str::split(tmp_filepath.filename().string(), "-");
-            const gint64 node_id = std::stoll(data_vec[0]);
-            const size_t embfile_id = std::stol(data_vec[1]);
-
-            CtTreeIter tree_iter = _pCtMainWin->get_tree_store().get_node_from_node_id(node_id);
-            if (not tree_iter) {
-                continue;
-            }
-            if (tree_iter.get_node_read_only()) {
-                CtDialogs::warning_dialog(_("Cannot Edit Embedded File in Read Only Node."), *_pCtMainWin);
+    }
+}
+
+void CtActions::_embfile_monitor_start(const size_t open_id)
+{
+    CtEmbFileOpened& embfileOpened = _embfiles_opened.at(open_id);
+    try {
+        embfileOpened.rFileMonitor = Gio::File::create_for_path(embfileOpened.tmp_filepath.string())->monitor_file();
+#if GTKMM_MAJOR_VERSION >= 4
+        embfileOpened.rFileMonitor->signal_changed().connect([this, open_id](const Glib::RefPtr<Gio::File>&/*rFile*/,
+                                                                             const Glib::RefPtr<Gio::File>&/*rOtherFile*/,
+                                                                             Gio::FileMonitor::Event/*event*/){
+            _on_embfile_monitor_changed(open_id);
+        });
+#else
+        embfileOpened.rFileMonitor->signal_changed().connect([this, open_id](const Glib::RefPtr<Gio::File>&/*rFile*/,
+                                                                             const Glib::RefPtr<Gio::File>&/*rOtherFile*/,
+                                                                             Gio::FileMonitorEvent/*event*/){
+            _on_embfile_monitor_changed(open_id);
+        });
+#endif
+    }
+    catch (Glib::Error& error) {
+        spdlog::error("!! {} {} {}", __FUNCTION__, embfileOpened.tmp_filepath.string(), error.what());
+    }
+}
+
+void CtActions::_on_embfile_monitor_changed(const size_t open_id)
+{
+    auto mapIter = _embfiles_opened.find(open_id);
+    if (mapIter == _embfiles_opened.end()) {
+        return;
+    }
+    // editors write in more steps or replace the file, we wait for the events to settle
+    mapIter->second.debounceConnection.disconnect();
+    mapIter->second.debounceConnection = Glib::signal_timeout().connect([this, open_id](){
+        _embfile_sync(open_id);
+        return false;
+    }, 300);
+}
+
+void CtActions::_embfile_sync(const size_t open_id)
+{
+    auto mapIter = _embfiles_opened.find(open_id);
+    if (mapIter == _embfiles_opened.end()) {
+        return;
+    }
+    const fs::path tmp_filepath = mapIter->second.tmp_filepath;
+    if (not fs::is_regular_file(tmp_filepath)) {
+        spdlog::debug("embdrop {}", tmp_filepath.string());
+        _embfile_drop(open_id);
+        return;
+    }
+    const time_t mod_time = fs::getmtime(tmp_filepath);
+    if (mod_time == mapIter->second.mod_time) {
+        return;
+    }
+    mapIter->second.mod_time = mod_time;
+    if (not _embfile_get_node(mapIter->second)) {
+        // the node was removed or the document closed
+        _embfile_drop(open_id);
+        return;
+    }
+
+    // the file is copied off the GUI thread to a snapshot of this modification, that the widget then
+    // reads from when needed, as the editor may still write to the opened file or the undo may go back
+    const fs::path snapshot_filepath = _pCtMainWin->get_ct_tmp()->getHiddenFilePath(
+        tmp_filepath.filename().string() + CtConst::CHAR_MINUS + std::to_string(mod_time));
+    auto pCopyOk = std::make_shared<bool>(false);
+    CtTaskPool::get().submit_then([tmp_filepath, snapshot_filepath, pCopyOk](){
+        *pCopyOk = fs::copy_file(tmp_filepath, snapshot_filepath);
+        if (not *pCopyOk) {
+            spdlog::error("!! embfile copy {} to {}", tmp_filepath.string(), snapshot_filepath.string());
+        }
+    }, [this, open_id, snapshot_filepath, pCopyOk](){
+        auto mapIter = _embfiles_opened.find(open_id);
+        if (not *pCopyOk or mapIter == _embfiles_opened.end()) {
+            return;
+        }
+        CtTreeIter tree_iter = _embfile_get_node(mapIter->second);
+        if (not tree_iter) {
+            return;
+        }
+        if (tree_iter.get_node_read_only()) {
+            CtDialogs::warning_dialog(_("Cannot Edit Embedded File in Read Only Node."), *_pCtMainWin);
+            return;
+        }
+        for (CtAnchoredWidget* pAnchoredWidget : tree_iter.get_anchored_widgets_fast()) {
+            auto embFile = dynamic_cast<CtImageEmbFile*>(pAnchoredWidget);
+            if (not embFile or embFile->get_unique_id() != open_id) {
                 continue;
             }
-            _pCtMainWin->get_tree_view().set_cursor_safe(tree_iter);
-            for (auto& widget : tree_iter.get_anchored_widgets_fast()) {
-                if (auto embFile = dynamic_cast<CtImageEmbFile*>(widget)) {
-                    if (embFile->get_unique_id() == embfile_id) {
-                        std::string buffer = Glib::file_get_contents(tmp_filepath.string());
-                        embFile->set_raw_blob(buffer);
-                        embFile->set_time(std::time(nullptr));
-                        embFile->update_tooltip();
-
-                        _pCtMainWin->update_window_save_needed(CtSaveNeededUpdType::nbuf);
-                        _pCtMainWin->get_status_bar().update_status(_("Embedded File Automatically Updated:") + CtConst::CHAR_SPACE + embFile->get_file_name().string());
-                        break;
-                    }
-                }
-            }
+            embFile->set_blob(CtEmbFileBlob::from_file(snapshot_filepath));
+            embFile->set_time(std::time(nullptr));
+            embFile->update_tooltip();
+
+            // the node is not selected, the change goes to its own buffer
+            _pCtMainWin->update_window_save_needed(CtSaveNeededUpdType::nbuf, false/*new_machine_state*/, &tree_iter);
+            _pCtMainWin->get_status_bar().update_status(_("Embedded File Automatically Updated:") + CtConst::CHAR_SPACE + embFile->get_file_name().string());
+            break;
         }
+    }, CtTaskPool::Priority::Normal, _embfilesCancelToken);
+}
+
+CtTreeIter CtActions::_embfile_get_node(CtEmbFileOpened& embfileOpened)
+{
+    CtTreeStore& ctTreeStore = _pCtMainWin->get_tree_store();
+    Glib::RefPtr<Gtk::TreeStore> rTreeStore = ctTreeStore.get_store();
+    if (embfileOpened.nodeRowRef.is_valid()) {
+        return ctTreeStore.to_ct_tree_iter(rTreeStore->get_iter(embfileOpened.nodeRowRef.get_path()));
+    }
+    // the reference does not survive the node being moved, the node id does
+    CtTreeIter tree_iter = ctTreeStore.get_node_from_node_id(embfileOpened.node_id);
+    if (tree_iter) {
+        embfileOpened.nodeRowRef = Gtk::TreeRowReference{rTreeStore, rTreeStore->get_path(tree_iter)};
+    }
+    return tree_iter;
+}
+
+void CtActions::_embfile_drop(const size_t open_id)
+{
+    auto mapIter = _embfiles_opened.find(open_id);
+    if (mapIter == _embfiles_opened.end()) {
+        return;
+    }
+    mapIter->second.debounceConnection.disconnect();
+    if (mapIter->second.rFileMonitor) {
+        mapIter->second.rFileMonitor->cancel();
     }
-    return true; // this way we keep the timer alive
+    _embfiles_opened.erase(mapIter);
 }
 
 void CtActions::terminal_copy()
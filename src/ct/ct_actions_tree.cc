@@ -33,6 +33,7 @@
 
 bool CtActions::_is_there_selected_node_or_error()
 {
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     if (_pCtMainWin->curr_tree_iter()) return true;
     CtDialogs::warning_dialog(_("No Node is Selected"), *_pCtMainWin);
     return false;
@@ -40,6 +41,7 @@ bool CtActions::_is_there_selected_node_or_error()
 
 bool CtActions::_is_tree_not_empty_or_error()
 {
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     if (not _pCtMainWin->get_tree_store().get_iter_first()) {
         CtDialogs::error_dialog(_("The Tree is Empty!"), *_pCtMainWin);
         return false;
@@ -191,29 +193,38 @@ void CtActions::node_subnodes_paste2(CtTreeIter& other_ct_tree_iter,
     Gtk::TreeModel::iterator new_top_iter = _pCtMainWin->curr_tree_iter();
 
     // function to duplicate a node
+    // the text buffer of the duplicated node is built only when first needed (selected, searched, saved...)
     auto duplicate_subnode = [&](CtTreeIter old_iter, Gtk::TreeModel::iterator new_parent) {
+        CtTreeStore& tree_store_from = pWinToCopyFrom->get_tree_store();
+        CtTreeStore& tree_store_to = _pCtMainWin->get_tree_store();
         CtNodeData node_data{};
+        tree_store_from.get_node_data(old_iter, node_data, false/*loadTextBuffer*/);
+        node_data.anchoredWidgets.clear();
+        node_data.tsCreation = std::time(nullptr);
+        node_data.tsLastSave = node_data.tsCreation;
+        node_data.nodeId = tree_store_to.node_id_get();
+
+        const gint64 node_id_data_holder = old_iter.get_node_id_data_holder();
         std::shared_ptr<CtNodeState> node_state;
-        pWinToCopyFrom->get_tree_store().get_node_data(old_iter, node_data, true/*loadTextBuffer*/);
-        if (node_data.syntax != CtConst::RICH_TEXT_ID) {
-            node_data.pTextBuffer = _pCtMainWin->get_new_text_buffer(node_data.pTextBuffer->get_text());
-            node_data.anchoredWidgets.clear();
+        if (tree_store_from.lazy_content_get(node_id_data_holder, node_state) and node_state) {
+            // the source is itself a duplicate not yet used, same snapshot
+            tree_store_to.lazy_content_set(node_data.nodeId, node_state);
         }
-        else {
-            CtStateMachine& state_machine_from = pWinToCopyFrom->get_state_machine();
-            state_machine_from.update_state(old_iter);
-            node_state = state_machine_from.requested_state_current(old_iter.get_node_id_data_holder());
-            node_data.anchoredWidgets.clear();                          // node_state will be used instead
-            node_data.pTextBuffer = _pCtMainWin->get_new_text_buffer(); // node_state will be used instead
+        else if (pWinToCopyFrom == _pCtMainWin and
+                 not old_iter.get_node_buffer_already_loaded() and
+                 _pCtMainWin->get_ct_storage()->delayed_text_buffer_share(node_id_data_holder, node_data.nodeId))
+        {
+            // same stored content as the source
+            tree_store_to.lazy_content_set(node_data.nodeId, nullptr);
         }
-        node_data.tsCreation = std::time(nullptr);
-        node_data.tsLastSave = node_data.tsCreation;
-        node_data.nodeId = _pCtMainWin->get_tree_store().node_id_get();
-        auto new_iter = _pCtMainWin->get_tree_store().append_node(&node_data, &new_parent/*as parent*/);
-        if (node_state) {
-           _pCtMainWin->load_buffer_from_state(node_state, _pCtMainWin->get_tree_store().to_ct_tree_iter(new_iter));
+        else if (node_data.syntax == CtConst::RICH_TEXT_ID) {
+            tree_store_to.lazy_content_set(node_data.nodeId, pWinToCopyFrom->get_state_machine().get_state_snapshot(old_iter));
         }
-        _pCtMainWin->get_tree_store().to_ct_tree_iter(new_iter).pending_new_db_node();
+        else {
+            node_data.pTextBuffer = _pCtMainWin->get_new_text_buffer(old_iter.get_node_text_buffer()->get_text());
+        }
+        auto new_iter = tree_store_to.append_node(&node_data, &new_parent/*as parent*/);
+        tree_store_to.to_ct_tree_iter(new_iter).pending_new_db_node();
         return new_iter;
     };
 
@@ -419,35 +430,36 @@ void CtActions::node_move_after(Gtk::TreeModel::iterator iter_to_move,
     _pCtMainWin->update_window_save_needed();
 }
 
-bool CtActions::_need_node_swap(Gtk::TreeModel::iterator& leftIter, Gtk::TreeModel::iterator& rightIter, bool ascending)
+// Sort the children of father_iter (top level if none) by name, fixing the sequence of the moved ones
+bool CtActions::_node_siblings_sort(Gtk::TreeModel::iterator father_iter, bool ascending)
 {
-    Glib::ustring left_node_name = _pCtMainWin->get_tree_store().to_ct_tree_iter(leftIter).get_node_name().lowercase();
-    Glib::ustring right_node_name = _pCtMainWin->get_tree_store().to_ct_tree_iter(rightIter).get_node_name().lowercase();
-    //int cmp = left_node_name.compare(right_node_name);
-    int cmp = CtStrUtil::natural_compare(left_node_name, right_node_name);
-
-    return ascending ? cmp > 0 : cmp < 0;
+    CtTreeStore& ctTreeStore = _pCtMainWin->get_tree_store();
+    const Gtk::TreeNodeChildren& children = father_iter ? father_iter->children() : ctTreeStore.get_store()->children();
+    auto f_get_key = [&ctTreeStore](const Gtk::TreeModel::iterator& iter) {
+        return ctTreeStore.to_ct_tree_iter(iter).get_node_name().lowercase();
+    };
+    auto f_less = [ascending](const Glib::ustring& left_node_name, const Glib::ustring& right_node_name) {
+        const int cmp = CtStrUtil::natural_compare(left_node_name, right_node_name);
+        return ascending ? cmp < 0 : cmp > 0;
+    };
+    if (not CtMiscUtil::node_siblings_sort_by_key(ctTreeStore.get_store(), children, f_get_key, f_less)) {
+        return false;
+    }
+    ctTreeStore.nodes_sequences_fix(father_iter, false/*process_children*/);
+    return true;
 }
 
-bool CtActions::_tree_sort_level_and_sublevels(const Gtk::TreeNodeChildren& children, bool ascending)
+bool CtActions::_tree_sort_level_and_sublevels(Gtk::TreeModel::iterator father_iter, bool ascending)
 {
-    #if GTKMM_MAJOR_VERSION >= 4
-    // TODO: implement sibling sorting for GTK4; for now, recurse only.
-    bool swap_excecuted = false;
-    for (auto it = children.begin(); it != children.end(); ++it) {
-        // gtkmm4: child->children() returns const-children; recurse by casting to match signature
-        if (_tree_sort_level_and_sublevels(static_cast<const Gtk::TreeNodeChildren&>(it->children()), ascending))
-            swap_excecuted = true;
+    bool sort_executed = _node_siblings_sort(father_iter, ascending);
+    CtTreeStore& ctTreeStore = _pCtMainWin->get_tree_store();
+    const Gtk::TreeNodeChildren& children = father_iter ? father_iter->children() : ctTreeStore.get_store()->children();
+    for (Gtk::TreeModel::iterator& child_iter : CtMiscUtil::get_siblings_iters(ctTreeStore.get_store(), children)) {
+        if (_tree_sort_level_and_sublevels(child_iter, ascending)) {
+            sort_executed = true;
+        }
     }
-    return swap_excecuted;
-    #else
-    auto need_swap = [this,&ascending](Gtk::TreeModel::iterator& l, Gtk::TreeModel::iterator& r) { return _need_node_swap(l, r, ascending); };
-    bool swap_excecuted = CtMiscUtil::node_siblings_sort(_pCtMainWin->get_tree_store().get_store(), children, need_swap);
-    for (auto& child: children)
-        if (_tree_sort_level_and_sublevels(child.children(), ascending))
-            swap_excecuted = true;
-    return swap_excecuted;
-    #endif
+    return sort_executed;
 }
 
 void CtActions::node_edit()
@@ -500,7 +512,8 @@ void CtActions::node_edit()
         }
     }
 
-    _pCtMainWin->get_text_view().mm().set_editable(not newData.isReadOnly);
+    _pCtMainWin->get_text_view().mm().set_editable(not newData.isReadOnly and
+                                                   not _pCtMainWin->text_buffer_is_too_large_to_edit(_pCtMainWin->curr_buffer()));
     _pCtMainWin->update_selected_node_statusbar_info();
     ct_treestore.update_node_aux_icon(ct_tree_iter);
     _pCtMainWin->window_header_update();
@@ -726,7 +739,8 @@ void CtActions::node_toggle_read_only()
     CtTreeIter currTreeIter = _pCtMainWin->curr_tree_iter();
     const bool node_is_ro = not currTreeIter.get_node_read_only();
     currTreeIter.set_node_read_only(node_is_ro);
-    _pCtMainWin->get_text_view().mm().set_editable(not node_is_ro);
+    _pCtMainWin->get_text_view().mm().set_editable(not node_is_ro and
+                                                   not _pCtMainWin->text_buffer_is_too_large_to_edit(_pCtMainWin->curr_buffer()));
     _pCtMainWin->window_header_update_lock_icon(node_is_ro);
     _pCtMainWin->update_selected_node_statusbar_info();
     CtTreeStore& ct_treestore = _pCtMainWin->get_tree_store();
@@ -895,6 +909,7 @@ bool CtActions::node_move(Gtk::TreeModel::Path src_path, Gtk::TreeModel::Path de
     if (only_test_dest)
         return true;
 
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     Gtk::TreeModel::Path father_path{dest_path};
     father_path.up();
     CtTreeIter father_dest_iter = _pCtMainWin->get_tree_store().get_iter(father_path);
@@ -930,8 +945,7 @@ void CtActions::tree_sort_ascending()
     _in_action = true;
     auto on_scope_exit = scope_guard([this](void*) { _in_action = false; });
 
-    if (_tree_sort_level_and_sublevels(_pCtMainWin->get_tree_store().get_store()->children(), true)) {
-        _pCtMainWin->get_tree_store().nodes_sequences_fix(Gtk::TreeModel::iterator(), true);
+    if (_tree_sort_level_and_sublevels(Gtk::TreeModel::iterator{}, true)) {
         _pCtMainWin->update_window_save_needed();
     }
 }
@@ -942,8 +956,7 @@ void CtActions::tree_sort_descending()
     _in_action = true;
     auto on_scope_exit = scope_guard([this](void*) { _in_action = false; });
 
-    if (_tree_sort_level_and_sublevels(_pCtMainWin->get_tree_store().get_store()->children(), false)) {
-        _pCtMainWin->get_tree_store().nodes_sequences_fix(Gtk::TreeModel::iterator(), true);
+    if (_tree_sort_level_and_sublevels(Gtk::TreeModel::iterator{}, false)) {
         _pCtMainWin->update_window_save_needed();
     }
 }
@@ -956,10 +969,7 @@ void CtActions::node_siblings_sort_ascending()
 
     if (not _is_there_selected_node_or_error()) return;
     Gtk::TreeModel::iterator father_iter = _pCtMainWin->curr_tree_iter()->parent();
-    const Gtk::TreeNodeChildren& children = father_iter ? father_iter->children() : _pCtMainWin->get_tree_store().get_store()->children();
-    auto need_swap = [this](Gtk::TreeModel::iterator& l, Gtk::TreeModel::iterator& r) { return _need_node_swap(l, r, true); };
-    if (CtMiscUtil::node_siblings_sort(_pCtMainWin->get_tree_store().get_store(), children, need_swap)) {
-        _pCtMainWin->get_tree_store().nodes_sequences_fix(father_iter, true);
+    if (_node_siblings_sort(father_iter, true)) {
         _pCtMainWin->update_window_save_needed();
     }
 }
@@ -972,10 +982,7 @@ void CtActions::node_siblings_sort_descending()
 
     if (not _is_there_selected_node_or_error()) return;
     Gtk::TreeModel::iterator father_iter = _pCtMainWin->curr_tree_iter()->parent();
-    const Gtk::TreeNodeChildren& children = father_iter ? father_iter->children() : _pCtMainWin->get_tree_store().get_store()->children();
-    auto need_swap = [this](Gtk::TreeModel::iterator& l, Gtk::TreeModel::iterator& r) { return _need_node_swap(l, r, false); };
-    if (CtMiscUtil::node_siblings_sort(_pCtMainWin->get_tree_store().get_store(), children, need_swap)) {
-        _pCtMainWin->get_tree_store().nodes_sequences_fix(father_iter, true);
+    if (_node_siblings_sort(father_iter, false)) {
         _pCtMainWin->update_window_save_needed();
     }
 }
@@ -1074,12 +1081,20 @@ void CtActions::bookmarks_handle()
 void CtActions::tree_info()
 {
     if (not _is_tree_not_empty_or_error()) return;
+    // before the summary that loads all the nodes, as the session has it
+    CtMemoryInfo memoryInfo{};
+    _pCtMainWin->get_tree_store().populate_memory_info(memoryInfo);
     CtSummaryInfo summaryInfo{};
     if (_pCtMainWin->get_tree_store().populate_summary_info(summaryInfo)) {
-        CtDialogs::summary_info_dialog(_pCtMainWin, summaryInfo);
+        CtDialogs::summary_info_dialog(_pCtMainWin, summaryInfo, memoryInfo);
     }
 }
 
+void CtActions::perf_info()
+{
+    CtDialogs::perf_dialog(_pCtMainWin);
+}
+
 void CtActions::tree_clear_property_exclude_from_search()
 {
     if (_in_action) { spdlog::debug("?? 2*{}", __FUNCTION__); return; }
@@ -117,6 +117,7 @@ void CtActions::toggle_focus_vte_text()
 
 void CtActions::nodes_expand_all()
 {
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     _pCtMainWin->get_tree_view().expand_all();
 }
 
@@ -0,0 +1,133 @@
+/*
+ * ct_anchors_index.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_anchors_index.h"
+#include <algorithm>
+
+namespace {
+
+const char ANCHORS_INDEX_KEY[]{"ct-anchors-index"};
+const char ANCHOR_WIDGET_KEY[]{"ct-anchored-widget"};
+
+} // namespace (anonymous)
+
+/*static*/CtAnchorsIndex& CtAnchorsIndex::get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer)
+{
+    GObject* pObject = G_OBJECT(pTextBuffer->gobj());
+    auto pAnchorsIndex = static_cast<CtAnchorsIndex*>(g_object_get_data(pObject, ANCHORS_INDEX_KEY));
+    if (not pAnchorsIndex) {
+        pAnchorsIndex = new CtAnchorsIndex{pTextBuffer->gobj()};
+        g_object_set_data_full(pObject, ANCHORS_INDEX_KEY, pAnchorsIndex, [](gpointer pData){
+            delete static_cast<CtAnchorsIndex*>(pData);
+        });
+    }
+    return *pAnchorsIndex;
+}
+
+CtAnchorsIndex::CtAnchorsIndex(GtkTextBuffer* pBuffer)
+ : _pBuffer{pBuffer}
+{
+    // the anchors already in the buffer, 0xFFFC matches the anchors unless searching text only
+    GtkTextIter iter;
+    gtk_text_buffer_get_start_iter(_pBuffer, &iter);
+    GtkTextIter match_start, match_end;
+    while (gtk_text_iter_forward_search(&iter, "\xEF\xBF\xBC", (GtkTextSearchFlags)0, &match_start, &match_end, nullptr)) {
+        if (GtkTextChildAnchor* pAnchor = gtk_text_iter_get_child_anchor(&match_start)) {
+            _anchors.push_back(static_cast<GtkTextChildAnchor*>(g_object_ref(pAnchor)));
+        }
+        iter = match_end;
+    }
+    // after the default handler, the anchor is then in the buffer
+    g_signal_connect_after(_pBuffer, "insert-child-anchor", G_CALLBACK(_on_insert_child_anchor), this);
+    // before the default handler, the anchors in the range are still in the buffer
+    g_signal_connect(_pBuffer, "delete-range", G_CALLBACK(_on_delete_range), this);
+}
+
+CtAnchorsIndex::~CtAnchorsIndex()
+{
+    // the buffer is being finalised, its handlers are gone with it
+    for (GtkTextChildAnchor* pAnchor : _anchors) {
+        g_object_unref(pAnchor);
+    }
+}
+
+int CtAnchorsIndex::_get_offset(GtkTextChildAnchor* pAnchor) const
+{
+    GtkTextIter iter;
+    gtk_text_buffer_get_iter_at_child_anchor(_pBuffer, &iter, pAnchor);
+    return gtk_text_iter_get_offset(&iter);
+}
+
+size_t CtAnchorsIndex::_lower_bound(const int offset) const
+{
+    size_t low{0};
+    size_t high{_anchors.size()};
+    while (low < high) {
+        const size_t mid = low + (high - low)/2;
+        if (_get_offset(_anchors[mid]) < offset) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+std::vector<Glib::RefPtr<Gtk::TextChildAnchor>> CtAnchorsIndex::get_anchors(const int start_offset, const int end_offset) const
+{
+    std::vector<Glib::RefPtr<Gtk::TextChildAnchor>> anchors;
+    for (size_t i = start_offset >= 0 ? _lower_bound(start_offset) : 0u; i < _anchors.size(); ++i) {
+        if (end_offset >= 0 and _get_offset(_anchors[i]) > end_offset) {
+            break;
+        }
+        anchors.push_back(Glib::wrap(_anchors[i], true/*take_copy*/));
+    }
+    return anchors;
+}
+
+/*static*/void CtAnchorsIndex::set_anchor_widget(const Glib::RefPtr<Gtk::TextChildAnchor>& pChildAnchor, CtAnchoredWidget* pCtAnchoredWidget)
+{
+    g_object_set_data(G_OBJECT(pChildAnchor->gobj()), ANCHOR_WIDGET_KEY, pCtAnchoredWidget);
+}
+
+/*static*/CtAnchoredWidget* CtAnchorsIndex::get_anchor_widget(const Glib::RefPtr<Gtk::TextChildAnchor>& pChildAnchor)
+{
+    return static_cast<CtAnchoredWidget*>(g_object_get_data(G_OBJECT(pChildAnchor->gobj()), ANCHOR_WIDGET_KEY));
+}
+
+/*static*/void CtAnchorsIndex::_on_insert_child_anchor(GtkTextBuffer*/*pBuffer*/, GtkTextIter*/*pIter*/, GtkTextChildAnchor* pAnchor, gpointer pData)
+{
+    auto pAnchorsIndex = static_cast<CtAnchorsIndex*>(pData);
+    const size_t idx = pAnchorsIndex->_lower_bound(pAnchorsIndex->_get_offset(pAnchor));
+    pAnchorsIndex->_anchors.insert(pAnchorsIndex->_anchors.begin() + idx, static_cast<GtkTextChildAnchor*>(g_object_ref(pAnchor)));
+}
+
+/*static*/void CtAnchorsIndex::_on_delete_range(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData)
+{
+    auto pAnchorsIndex = static_cast<CtAnchorsIndex*>(pData);
+    std::vector<GtkTextChildAnchor*>& anchors = pAnchorsIndex->_anchors;
+    if (anchors.empty()) return;
+    const size_t first = pAnchorsIndex->_lower_bound(std::min(gtk_text_iter_get_offset(pStart), gtk_text_iter_get_offset(pEnd)));
+    const size_t last = pAnchorsIndex->_lower_bound(std::max(gtk_text_iter_get_offset(pStart), gtk_text_iter_get_offset(pEnd)));
+    for (size_t i = first; i < last; ++i) {
+        g_object_unref(anchors[i]);
+    }
+    anchors.erase(anchors.begin() + first, anchors.begin() + last);
+}
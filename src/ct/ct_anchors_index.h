@@ -0,0 +1,60 @@
+/*
+ * ct_anchors_index.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <gtkmm/textbuffer.h>
+#include <gtkmm/textchildanchor.h>
+#include <vector>
+
+class CtAnchoredWidget;
+
+// Child anchors of a text buffer in buffer order, kept up to date from the buffer signals and owned by the buffer.
+// The offsets are not stored since every edit shifts them: the anchors never change their relative order,
+// so the offsets are read from the buffer while bisecting.
+class CtAnchorsIndex
+{
+public:
+    static CtAnchorsIndex& get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer);
+
+    // anchors from start_offset to end_offset included (-1 for the buffer start/end), in buffer order
+    std::vector<Glib::RefPtr<Gtk::TextChildAnchor>> get_anchors(const int start_offset, const int end_offset) const;
+    size_t size() const { return _anchors.size(); }
+
+    static void              set_anchor_widget(const Glib::RefPtr<Gtk::TextChildAnchor>& pChildAnchor, CtAnchoredWidget* pCtAnchoredWidget);
+    static CtAnchoredWidget* get_anchor_widget(const Glib::RefPtr<Gtk::TextChildAnchor>& pChildAnchor);
+
+    ~CtAnchorsIndex();
+
+private:
+    explicit CtAnchorsIndex(GtkTextBuffer* pBuffer);
+
+    int    _get_offset(GtkTextChildAnchor* pAnchor) const;
+    size_t _lower_bound(const int offset) const;
+
+    static void _on_insert_child_anchor(GtkTextBuffer* pBuffer, GtkTextIter* pIter, GtkTextChildAnchor* pAnchor, gpointer pData);
+    static void _on_delete_range(GtkTextBuffer* pBuffer, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData);
+
+    GtkTextBuffer*                   _pBuffer; // owns this index
+    std::vector<GtkTextChildAnchor*> _anchors; // a reference is held on each
+};
@@ -31,7 +31,9 @@
 #include "ct_storage_control.h"
 #include "config.h"
 #include "ct_logging.h"
+#include "ct_task_pool.h"
 #include <iostream>
+#include <algorithm>
 
 namespace {
 void queue_focus_node(CtMainWin* pCtMainWin, const Glib::ustring& node_to_focus, const Glib::ustring& anchor_to_focus)
@@ -188,6 +190,12 @@ void CtApp::_on_startup()
     if (_initDone) return;
     _initDone = true;
 
+    CtPerf::startup_mark("startup_before_init");
+
+    // created on the GUI thread, where its main loop continuations are dispatched
+    (void)CtTaskPool::get();
+    CtPerf::startup_mark("startup_task_pool");
+
 #if defined(_WIN32)
     (void)fs::alter_TEXMFROOT_env_var();
     (void)fs::alter_PATH_env_var();
@@ -210,33 +218,20 @@ void CtApp::_on_startup()
 #endif
     _rIcontheme->add_resource_path("/icons/");
     //_print_gresource_icons();
+    CtPerf::startup_mark("startup_icon_theme");
 
     _uCtTmp.reset(new CtTmp{});
     //std::cout << _uCtTmp->get_root_dirpath() << std::endl;
 
     _rTextTagTable = Gtk::TextTagTable::create();
 
-    GtkSourceLanguageManager* pGtkSourceLanguageManager = gtk_source_language_manager_get_default();
-    const gchar * const * pLMSearchPath = gtk_source_language_manager_get_search_path(pGtkSourceLanguageManager);
-    std::vector<gchar const *> langSearchPath;
-    for (auto pPath = pLMSearchPath; *pPath; ++pPath) {
-        langSearchPath.push_back(*pPath);
-    }
-    fs::path ctLanguageSpecsData = fs::get_cherrytree_datadir() / CtConfig::ConfigLanguageSpecsDirname;
-    langSearchPath.push_back(ctLanguageSpecsData.c_str());
-    fs::path ctLanguageSpecsConfig = fs::get_cherrytree_config_language_specs_dirpath();
-    langSearchPath.push_back(ctLanguageSpecsConfig.c_str());
-    langSearchPath.push_back(nullptr);
-    /* At the moment this function can be called only before the language files are loaded for the first time.
-       In practice to set a custom search path for a GtkSourceLanguageManager, you have to call this function right after creating it. */
-    _pGtkSourceLanguageManager = gtk_source_language_manager_new();
-    gtk_source_language_manager_set_search_path(_pGtkSourceLanguageManager, (gchar **)langSearchPath.data());
-
     GtkSourceStyleSchemeManager* pGtkSourceStyleSchemeManager = gtk_source_style_scheme_manager_get_default();
     fs::path ctStylesData = fs::get_cherrytree_datadir() / CtConfig::ConfigStylesDirname;
     gtk_source_style_scheme_manager_append_search_path(pGtkSourceStyleSchemeManager, ctStylesData.c_str());
     fs::path ctStylesConfig = fs::get_cherrytree_config_styles_dirpath();
     gtk_source_style_scheme_manager_append_search_path(pGtkSourceStyleSchemeManager, ctStylesConfig.c_str());
+    // the style files are only scanned at the first lookup, the language manager is created at first use
+    CtPerf::startup_mark("startup_source_managers");
 
     _rCssProvider = Gtk::CssProvider::create();
 
@@ -254,6 +249,7 @@ void CtApp::_on_startup()
 #endif // not _WIN32
         // SIGKILL cannot be handled or ignored, and is therefore always fatal
     }
+    CtPerf::startup_mark("startup_app_init");
 }
 
 void CtApp::on_activate()
@@ -263,36 +259,57 @@ void CtApp::on_activate()
     if (get_windows().size() == 0) {
         // start of main instance
         CtMainWin* pAppWindow = _create_window();
-        if (_pCtConfig->reloadDocLast && not _pCtConfig->recentDocsFilepaths.empty()) {
-            Glib::RefPtr<Gio::File> r_file = Gio::File::create_for_path(_pCtConfig->recentDocsFilepaths.front().string());
-            if (r_file->query_exists()) {
-                const std::string canonicalPath = fs::canonical(r_file->get_path()).string();
+        CtPerf::startup_mark("startup_main_win");
+        present_main_window(pAppWindow);
+        CtPerf::startup_mark("startup_main_win_present");
+        // the last document is loaded once the empty window got drawn
+        const Glib::ustring password = _password;
+        Glib::signal_idle().connect_once([this, pAppWindow, password](){
+            const std::vector<Gtk::Window*> windows = get_windows();
+            if (std::find(windows.begin(), windows.end(), pAppWindow) == windows.end()) {
+                return; // closed in the meantime
+            }
+            if (_pCtConfig->reloadDocLast && not _pCtConfig->recentDocsFilepaths.empty()) {
+                Glib::RefPtr<Gio::File> r_file = Gio::File::create_for_path(_pCtConfig->recentDocsFilepaths.front().string());
+                if (r_file->query_exists()) {
+                    const std::string canonicalPath = fs::canonical(r_file->get_path()).string();
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
-                if (not pAppWindow->start_on_systray_is_active())
+                    if (not pAppWindow->start_on_systray_is_active())
 #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
-                {
-                    if (not pAppWindow->file_open(canonicalPath, ""/*node*/, ""/*anchor*/, _password)) {
-                        spdlog::warn("{} Couldn't open file: {}", __FUNCTION__, canonicalPath);
+                    {
+                        if (not pAppWindow->file_open(canonicalPath, ""/*node*/, ""/*anchor*/, password)) {
+                            spdlog::warn("{} Couldn't open file: {}", __FUNCTION__, canonicalPath);
+                        }
                     }
-                }
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+                    else {
+                        pAppWindow->start_on_systray_delayed_file_open_set(canonicalPath, ""/*node*/, ""/*anchor*/);
+                    }
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
+                }
                 else {
-                    pAppWindow->start_on_systray_delayed_file_open_set(canonicalPath, ""/*node*/, ""/*anchor*/);
+                    const fs::path last_doc_path{_pCtConfig->recentDocsFilepaths.front()};
+                    spdlog::info("{} Last doc not found: {}", __FUNCTION__, last_doc_path.string());
+                    _pCtConfig->recentDocsFilepaths.move_or_push_back(last_doc_path);
+                    pAppWindow->menu_set_items_recent_documents();
                 }
-#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
             }
-            else {
-                const fs::path last_doc_path{_pCtConfig->recentDocsFilepaths.front()};
-                spdlog::info("{} Last doc not found: {}", __FUNCTION__, last_doc_path.string());
-                _pCtConfig->recentDocsFilepaths.move_or_push_back(last_doc_path);
-                pAppWindow->menu_set_items_recent_documents();
+            CtPerf::startup_mark("startup_doc_load");
+            if (_pCtConfig->checkVersion) {
+                pAppWindow->get_ct_actions()->check_for_newer_version();
             }
-        }
-        if (_pCtConfig->checkVersion) {
-            pAppWindow->get_ct_actions()->check_for_newer_version();
-        }
-        pAppWindow->maybe_show_start_dialog();
-        present_main_window(pAppWindow);
+            pAppWindow->maybe_show_start_dialog();
+            Glib::signal_idle().connect_once([this](){
+                CtPerf::startup_mark("startup_first_idle");
+                const std::string report = CtPerf::startup_get_report();
+                if (_startup_profile) {
+                    std::cout << report;
+                }
+                else {
+                    spdlog::debug("\n{}", report);
+                }
+            });
+        });
     }
     else {
         // start of the second instance
@@ -338,8 +355,10 @@ void CtApp::on_open(const Gio::Application::type_vec_files& files, const Glib::u
 
     // do some export stuff from console and close app after
     if ( not _export_to_txt_dir.empty() or
+         not _export_to_md_dir.empty() or
          not _export_to_html_dir.empty() or
-         not _export_to_pdf_dir.empty() )
+         not _export_to_pdf_dir.empty() or
+         _memory_report )
     {
         _no_gui = true;
         spdlog::debug("export arguments are detected");
@@ -352,12 +371,25 @@ void CtApp::on_open(const Gio::Application::type_vec_files& files, const Glib::u
                     if (not _export_to_txt_dir.empty()) {
                         pWin->get_ct_actions()->export_to_txt_auto(_export_to_txt_dir, _export_overwrite, _export_single_file);
                     }
+                    if (not _export_to_md_dir.empty()) {
+                        pWin->get_ct_actions()->export_to_md_auto(_export_to_md_dir, _export_overwrite, _export_single_file);
+                    }
                     if (not _export_to_html_dir.empty()) {
                         pWin->get_ct_actions()->export_to_html_auto(_export_to_html_dir, _export_overwrite, _export_single_file);
                     }
                     if (not _export_to_pdf_dir.empty()) {
                         pWin->get_ct_actions()->export_to_pdf_auto(_export_to_pdf_dir, _export_overwrite);
                     }
+                    if (_memory_report) {
+                        // with all the nodes loaded
+                        CtSummaryInfo summaryInfo{};
+                        if (pWin->get_tree_store().populate_summary_info(summaryInfo)) {
+                            CtMemoryInfo memoryInfo{};
+                            pWin->get_tree_store().populate_memory_info(memoryInfo);
+                            std::cout << r_file->get_path() << std::endl
+                                      << CtMiscUtil::get_memory_info_report(memoryInfo, 20u/*nodes_max*/);
+                        }
+                    }
                 }
                 catch (std::exception& e) {
                     spdlog::error("caught exception: {}", e.what());
@@ -418,6 +450,29 @@ void CtApp::on_window_removed(Gtk::Window* window)
     }
 }
 
+GtkSourceLanguageManager* CtApp::_get_language_manager()
+{
+    if (_pGtkSourceLanguageManager) {
+        return _pGtkSourceLanguageManager;
+    }
+    GtkSourceLanguageManager* pGtkSourceLanguageManager = gtk_source_language_manager_get_default();
+    const gchar * const * pLMSearchPath = gtk_source_language_manager_get_search_path(pGtkSourceLanguageManager);
+    std::vector<gchar const *> langSearchPath;
+    for (auto pPath = pLMSearchPath; *pPath; ++pPath) {
+        langSearchPath.push_back(*pPath);
+    }
+    fs::path ctLanguageSpecsData = fs::get_cherrytree_datadir() / CtConfig::ConfigLanguageSpecsDirname;
+    langSearchPath.push_back(ctLanguageSpecsData.c_str());
+    fs::path ctLanguageSpecsConfig = fs::get_cherrytree_config_language_specs_dirpath();
+    langSearchPath.push_back(ctLanguageSpecsConfig.c_str());
+    langSearchPath.push_back(nullptr);
+    /* At the moment this function can be called only before the language files are loaded for the first time.
+       In practice to set a custom search path for a GtkSourceLanguageManager, you have to call this function right after creating it. */
+    _pGtkSourceLanguageManager = gtk_source_language_manager_new();
+    gtk_source_language_manager_set_search_path(_pGtkSourceLanguageManager, (gchar **)langSearchPath.data());
+    return _pGtkSourceLanguageManager;
+}
+
 CtMainWin* CtApp::_create_window(const bool no_gui)
 {
     CtMainWin* pCtMainWin = new CtMainWin{no_gui,
@@ -429,7 +484,7 @@ CtMainWin* CtApp::_create_window(const bool no_gui)
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
                                           _uCtStatusIcon.get(),
 #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
-                                          _pGtkSourceLanguageManager};
+                                          [this](){ return _get_language_manager(); }};
     add_window(*pCtMainWin);
 
     pCtMainWin->connect_app_new_instance([this]() {
@@ -613,24 +668,30 @@ void CtApp::_add_main_option_entries()
     add_main_option_entry(Gio::Application::OptionType::STRING,   "anchor",             'a', _("Anchor name to scroll to in node"));
     add_main_option_entry(Gio::Application::OptionType::FILENAME, "export_to_html_dir", 'x', _("Export to HTML at specified directory path"));
     add_main_option_entry(Gio::Application::OptionType::FILENAME, "export_to_txt_dir",  't', _("Export to Text at specified directory path"));
+    add_main_option_entry(Gio::Application::OptionType::FILENAME, "export_to_md_dir",   'm', _("Export to Markdown at specified directory path"));
     add_main_option_entry(Gio::Application::OptionType::FILENAME, "export_to_pdf_dir",  'p', _("Export to PDF at specified directory path"));
     add_main_option_entry(Gio::Application::OptionType::BOOL,     "export_overwrite",   'w', _("Overwrite if export path already exists"));
-    add_main_option_entry(Gio::Application::OptionType::BOOL,     "export_single_file", 's', _("Export to a single file (for HTML or TXT)"));
+    add_main_option_entry(Gio::Application::OptionType::BOOL,     "export_single_file", 's', _("Export to a single file (for HTML, TXT or Markdown)"));
     add_main_option_entry(Gio::Application::OptionType::STRING,   "password",           'P', _("Password to open document"));
     add_main_option_entry(Gio::Application::OptionType::BOOL,     "new_window",         'N', _("Create a new window"));
     add_main_option_entry(Gio::Application::OptionType::BOOL,     "secondary_session",  'S', _("Run in secondary session, independent from main session"));
+    add_main_option_entry(Gio::Application::OptionType::BOOL,     "startup_profile",    '\0', _("Print the time taken by the startup phases"));
+    add_main_option_entry(Gio::Application::OptionType::BOOL,     "memory_report",      '\0', _("Print the memory held by the document with all the nodes loaded"));
 #else
     add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "version",            'V', _("Print CherryTree version"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_STRING,   "node",               'n', _("Node name to focus"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_STRING,   "anchor",             'a', _("Anchor name to scroll to in node"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_FILENAME, "export_to_html_dir", 'x', _("Export to HTML at specified directory path"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_FILENAME, "export_to_txt_dir",  't', _("Export to Text at specified directory path"));
+    add_main_option_entry(Gio::Application::OPTION_TYPE_FILENAME, "export_to_md_dir",   'm', _("Export to Markdown at specified directory path"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_FILENAME, "export_to_pdf_dir",  'p', _("Export to PDF at specified directory path"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "export_overwrite",   'w', _("Overwrite if export path already exists"));
-    add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "export_single_file", 's', _("Export to a single file (for HTML or TXT)"));
+    add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "export_single_file", 's', _("Export to a single file (for HTML, TXT or Markdown)"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_STRING,   "password",           'P', _("Password to open document"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "new_window",         'N', _("Create a new window"));
     add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "secondary_session",  'S', _("Run in secondary session, independent from main session"));
+    add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "startup_profile",    '\0', _("Print the time taken by the startup phases"));
+    add_main_option_entry(Gio::Application::OPTION_TYPE_BOOL,     "memory_report",      '\0', _("Print the memory held by the document with all the nodes loaded"));
 #endif
 }
 
@@ -669,11 +730,14 @@ int CtApp::_on_handle_local_options(const Glib::RefPtr<Glib::VariantDict>& rOpti
     rOptions->lookup_value("anchor", _anchor_to_focus);
     rOptions->lookup_value("export_to_html_dir", _export_to_html_dir);
     rOptions->lookup_value("export_to_txt_dir", _export_to_txt_dir);
+    rOptions->lookup_value("export_to_md_dir", _export_to_md_dir);
     rOptions->lookup_value("export_to_pdf_dir", _export_to_pdf_dir);
     rOptions->lookup_value("export_overwrite", _export_overwrite);
     rOptions->lookup_value("export_single_file", _export_single_file);
     rOptions->lookup_value("password", _password);
     rOptions->lookup_value("new_window", new_window);
+    rOptions->lookup_value("startup_profile", _startup_profile);
+    rOptions->lookup_value("memory_report", _memory_report);
 
     if (is_remote() && (not _node_to_focus.empty() || not _anchor_to_focus.empty())) {
         // Forward node focus request from remote to primary instance via action
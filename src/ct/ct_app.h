@@ -66,11 +66,14 @@ protected:
     Glib::ustring _anchor_to_focus;
     std::string   _export_to_html_dir;
     std::string   _export_to_txt_dir;
+    std::string   _export_to_md_dir;
     std::string   _export_to_pdf_dir;
     Glib::ustring _password;
     bool          _export_overwrite{false};
     bool          _export_single_file{false};
     bool          _new_window{false};
+    bool          _startup_profile{false};
+    bool          _memory_report{false};
     bool          _initDone{false};
     bool          _no_gui{false};
     std::mutex    _quitOrHideWinMutex;
@@ -83,6 +86,7 @@ protected:
     void        _on_startup();
     void        _add_main_option_entries();
     void        _print_gresource_icons();
+    GtkSourceLanguageManager* _get_language_manager();
 
 protected:
     CtMainWin*  _create_window(const bool no_gui = false);
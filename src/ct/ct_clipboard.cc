@@ -630,8 +630,7 @@ void CtClipboard::on_received_to_plain_text(const Gtk::SelectionData& selection_
                     link_url = "http://" + link_url;
                 }
                 Glib::ustring property_value = "webs " + link_url;
-                curr_buffer->apply_tag_by_name(_pCtMainWin->get_text_tag_name_exist_or_create(CtConst::TAG_LINK, property_value),
-                                               iter_sel_start, iter_sel_end);
+                _pCtMainWin->apply_link_tag(curr_buffer, property_value, iter_sel_start, iter_sel_end);
             }
         }
         else {
@@ -647,8 +646,7 @@ void CtClipboard::on_received_to_plain_text(const Gtk::SelectionData& selection_
                 if (not property_value.empty()) {
                     Gtk::TextIter iter_sel_end = curr_buffer->get_insert()->get_iter();
                     Gtk::TextIter iter_sel_start = curr_buffer->get_iter_at_offset(start_offset);
-                    curr_buffer->apply_tag_by_name(_pCtMainWin->get_text_tag_name_exist_or_create(CtConst::TAG_LINK, property_value),
-                                                   iter_sel_start, iter_sel_end);
+                    _pCtMainWin->apply_link_tag(curr_buffer, property_value, iter_sel_start, iter_sel_end);
                 }
             }
         }
@@ -1047,8 +1045,7 @@ void CtClipboard::_uri_or_filepath_list_into_rich_text(const std::vector<Glib::u
             pTextBuffer->insert(pTextBuffer->get_insert()->get_iter(), element);
             Gtk::TextIter iter_sel_start = pTextBuffer->get_iter_at_offset(start_offset);
             Gtk::TextIter iter_sel_end = pTextBuffer->get_iter_at_offset(start_offset + (int)element.length());
-            pTextBuffer->apply_tag_by_name(_pCtMainWin->get_text_tag_name_exist_or_create(CtConst::TAG_LINK, property_value),
-                                           iter_sel_start, iter_sel_end);
+            _pCtMainWin->apply_link_tag(pTextBuffer, property_value, iter_sel_start, iter_sel_end);
         }
         subsequent_insert = true;
     }
@@ -327,11 +327,11 @@ void CtCodebox::to_xml(xmlpp::Element* p_node_parent, const int offset_adjustmen
     p_codebox_node->add_child_text(get_text_content());
 }
 
-bool CtCodebox::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
+bool CtCodebox::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
 {
     bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_CODEBOX_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_CODEBOX_INSERT);
+    if (not p_stmt) {
         spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
         retVal = false;
     }
@@ -351,7 +351,6 @@ bool CtCodebox::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_a
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
             retVal = false;
         }
-        sqlite3_finalize(p_stmt);
     }
     return retVal;
 }
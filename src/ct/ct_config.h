@@ -155,6 +155,8 @@ public:
     bool                                        ptHighlCurrLine{true};
     bool                                        rtHighlMatchBra{false};
     bool                                        ptHighlMatchBra{true};
+    int                                         largeNodeKb{1024};          // no highlighting, spell check, undo above this node size, 0 never
+    int                                         largeNodeReadOnlyKb{32768}; // no editing above this node size, 0 never
     int                                         spaceAroundLines{0};
     int                                         relativeWrappedSpace{50};
     Glib::ustring                               hRule{CtConst::HORIZONTAL_RULE_DEFAULT};
@@ -24,6 +24,7 @@
 #include "ct_dialogs.h"
 #include "ct_treestore.h"
 #include "ct_main_win.h"
+#include "ct_logging.h"
 
 namespace {
 #if GTKMM_MAJOR_VERSION >= 4
@@ -49,6 +50,44 @@ int _run_dialog_blocking(Gtk::Dialog& dialog)
 }
 #endif
 
+struct CtPerfDialogColumns : public Gtk::TreeModelColumnRecord
+{
+    Gtk::TreeModelColumn<Glib::ustring> name;
+    Gtk::TreeModelColumn<Glib::ustring> count;
+    Gtk::TreeModelColumn<Glib::ustring> last_ms;
+    Gtk::TreeModelColumn<Glib::ustring> rolling_ms;
+    Gtk::TreeModelColumn<Glib::ustring> max_ms;
+    Gtk::TreeModelColumn<Glib::ustring> total_ms;
+    CtPerfDialogColumns()
+    {
+        add(name);
+        add(count);
+        add(last_ms);
+        add(rolling_ms);
+        add(max_ms);
+        add(total_ms);
+    }
+};
+
+struct CtMemoryDialogColumns : public Gtk::TreeModelColumnRecord
+{
+    Gtk::TreeModelColumn<Glib::ustring> name;
+    Gtk::TreeModelColumn<Glib::ustring> text;
+    Gtk::TreeModelColumn<Glib::ustring> objects;
+    Gtk::TreeModelColumn<Glib::ustring> undo_states;
+    Gtk::TreeModelColumn<Glib::ustring> not_loaded;
+    Gtk::TreeModelColumn<Glib::ustring> total;
+    CtMemoryDialogColumns()
+    {
+        add(name);
+        add(text);
+        add(objects);
+        add(undo_states);
+        add(not_loaded);
+        add(total);
+    }
+};
+
 struct CtStartDialogColumns : public Gtk::TreeModelColumnRecord
 {
     Gtk::TreeModelColumn<Glib::ustring> name;
@@ -1063,10 +1102,10 @@ MA 02110-1301, USA.
     #endif
 }
 
-void CtDialogs::summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo& summaryInfo)
+void CtDialogs::summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo& summaryInfo, const CtMemoryInfo& memoryInfo)
 {
 #if GTK_MAJOR_VERSION >= 4
-    (void)pCtMainWin; (void)summaryInfo;
+    (void)pCtMainWin; (void)summaryInfo; (void)memoryInfo;
     return;
 #else
     Gtk::Dialog dialog = Gtk::Dialog{_("Tree Summary Information"),
@@ -1075,7 +1114,7 @@ void CtDialogs::summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo&
 
     (void)CtMiscUtil::dialog_add_button(&dialog, _("OK"), Gtk::RESPONSE_ACCEPT, "ct_done");
 
-    dialog.set_default_size(400, 300);
+    dialog.set_default_size(600, 700);
     dialog.set_position(Gtk::WindowPosition::WIN_POS_CENTER_ON_PARENT);
     Gtk::Grid grid;
     grid.property_margin() = 6;
@@ -1132,10 +1171,176 @@ void CtDialogs::summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo&
     grid.attach(label_shared_key, 0, 9, 1, 1);
     Gtk::Label label_shared_val{fmt::format("{} / {}", summaryInfo.nodes_shared_tot, summaryInfo.nodes_shared_groups)};
     grid.attach(label_shared_val, 1, 9, 1, 1);
+    Gtk::Label label_wo_key;
+    label_wo_key.set_markup(Glib::ustring{"<b>"} + _("Number of Words") + "</b>");
+    grid.attach(label_wo_key, 0, 10, 1, 1);
+    Gtk::Label label_wo_val{std::to_string(summaryInfo.words_num)};
+    grid.attach(label_wo_val, 1, 10, 1, 1);
+    Gtk::Label label_ch_key;
+    label_ch_key.set_markup(Glib::ustring{"<b>"} + _("Number of Characters") + "</b>");
+    grid.attach(label_ch_key, 0, 11, 1, 1);
+    Gtk::Label label_ch_val{std::to_string(summaryInfo.chars_num)};
+    grid.attach(label_ch_val, 1, 11, 1, 1);
+    Gtk::Label label_li_key;
+    label_li_key.set_markup(Glib::ustring{"<b>"} + _("Number of Lines") + "</b>");
+    grid.attach(label_li_key, 0, 12, 1, 1);
+    Gtk::Label label_li_val{std::to_string(summaryInfo.lines_num)};
+    grid.attach(label_li_val, 1, 12, 1, 1);
+
+    // memory held by the document, estimate
+    Gtk::Grid grid_memory;
+    grid_memory.property_margin() = 6;
+    grid_memory.set_row_spacing(4);
+    grid_memory.set_column_spacing(8);
+    grid_memory.set_row_homogeneous(true);
+    std::list<Gtk::Label> labels_memory;
+    auto f_add_memory_row = [&grid_memory, &labels_memory](const int row, const Glib::ustring& key, const std::string& count, const std::string& size){
+        labels_memory.emplace_back();
+        labels_memory.back().set_markup(Glib::ustring{"<b>"} + key + "</b>");
+        grid_memory.attach(labels_memory.back(), 0, row, 1, 1);
+        labels_memory.emplace_back(count);
+        grid_memory.attach(labels_memory.back(), 1, row, 1, 1);
+        labels_memory.emplace_back(size);
+        grid_memory.attach(labels_memory.back(), 2, row, 1, 1);
+    };
+    f_add_memory_row(0, _("Memory (estimate)"), _("Count"), _("Size"));
+    int memory_row{1};
+    for (const auto& [name, pMemoryCount] : CtMiscUtil::get_memory_info_categories(memoryInfo)) {
+        f_add_memory_row(memory_row++, name, std::to_string(pMemoryCount->num), CtMiscUtil::bytes_to_human_readable(pMemoryCount->bytes));
+    }
+    f_add_memory_row(memory_row, _("Total"), "", CtMiscUtil::bytes_to_human_readable(memoryInfo.get_total_bytes()));
+
+    CtMemoryDialogColumns columns;
+    Glib::RefPtr<Gtk::ListStore> rListStore = Gtk::ListStore::create(columns);
+    for (const auto& [node_id, pNodeInfo] : CtMiscUtil::get_memory_info_nodes_sorted(memoryInfo)) {
+        Gtk::TreeModel::Row row = *rListStore->append();
+        row[columns.name] = pNodeInfo->node_name;
+        row[columns.text] = CtMiscUtil::bytes_to_human_readable(pNodeInfo->textBuffer.bytes);
+        row[columns.objects] = fmt::format("{} / {}", pNodeInfo->widgets.num, CtMiscUtil::bytes_to_human_readable(pNodeInfo->widgets.bytes));
+        row[columns.undo_states] = fmt::format("{} / {}", pNodeInfo->undoStates.num, CtMiscUtil::bytes_to_human_readable(pNodeInfo->undoStates.bytes));
+        row[columns.not_loaded] = CtMiscUtil::bytes_to_human_readable(pNodeInfo->delayedXmlDoc.bytes);
+        row[columns.total] = CtMiscUtil::bytes_to_human_readable(pNodeInfo->get_bytes());
+    }
+    Gtk::TreeView treeview{rListStore};
+    treeview.append_column(_("Node Name"), columns.name);
+    treeview.append_column(_("Text"), columns.text);
+    treeview.append_column(_("Objects"), columns.objects);
+    treeview.append_column(_("Undo States"), columns.undo_states);
+    treeview.append_column(_("Parsed Not Loaded"), columns.not_loaded);
+    treeview.append_column(_("Total"), columns.total);
+    Gtk::ScrolledWindow scrolledwindow;
+    scrolledwindow.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+    scrolledwindow.add(treeview);
+
     Gtk::Box* pContentArea = dialog.get_content_area();
-    pContentArea->pack_start(grid);
+    pContentArea->pack_start(grid, false, true);
+    pContentArea->pack_start(grid_memory, false, true);
+    pContentArea->pack_start(scrolledwindow);
     pContentArea->show_all();
     dialog.run();
     dialog.hide();
 #endif
 }
+
+void CtDialogs::perf_dialog(CtMainWin* pCtMainWin)
+{
+#if GTKMM_MAJOR_VERSION >= 4
+    Gtk::Dialog dialog{_("Performance Information"), *pCtMainWin, true/*modal*/, true/*use_header_bar*/};
+    dialog.add_button(_("OK"), Gtk::ResponseType::ACCEPT);
+#else
+    Gtk::Dialog dialog{_("Performance Information"),
+                       *pCtMainWin,
+                       Gtk::DialogFlags::DIALOG_MODAL | Gtk::DialogFlags::DIALOG_DESTROY_WITH_PARENT};
+    (void)CtMiscUtil::dialog_add_button(&dialog, _("OK"), Gtk::RESPONSE_ACCEPT, "ct_done");
+    dialog.set_position(Gtk::WindowPosition::WIN_POS_CENTER_ON_PARENT);
+#endif
+    dialog.set_default_size(700, 400);
+
+    CtPerfDialogColumns columns;
+    Glib::RefPtr<Gtk::ListStore> rListStore = Gtk::ListStore::create(columns);
+    Gtk::TreeView treeview{rListStore};
+    treeview.append_column(_("Operation"), columns.name);
+    treeview.append_column(_("Count"), columns.count);
+    treeview.append_column(_("Last (ms)"), columns.last_ms);
+    treeview.append_column(_("Average (ms)"), columns.rolling_ms);
+    treeview.append_column(_("Max (ms)"), columns.max_ms);
+    treeview.append_column(_("Total (ms)"), columns.total_ms);
+    Gtk::ScrolledWindow scrolledwindow;
+    scrolledwindow.set_vexpand(true);
+#if GTKMM_MAJOR_VERSION >= 4
+    scrolledwindow.set_policy(Gtk::PolicyType::AUTOMATIC, Gtk::PolicyType::AUTOMATIC);
+    scrolledwindow.set_child(treeview);
+#else
+    scrolledwindow.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+    scrolledwindow.add(treeview);
+#endif
+
+    auto f_refresh = [rListStore, &columns]() {
+        rListStore->clear();
+        for (const CtPerf::Stat& stat : CtPerf::get_stats()) {
+            Gtk::TreeModel::Row row = *rListStore->append();
+            row[columns.name] = stat.name;
+            row[columns.count] = std::to_string(stat.count);
+            if (not stat.is_counter) {
+                row[columns.last_ms] = fmt::format("{:.2f}", stat.last_ms);
+                row[columns.rolling_ms] = fmt::format("{:.2f}", stat.rolling_ms);
+                row[columns.max_ms] = fmt::format("{:.2f}", stat.max_ms);
+                row[columns.total_ms] = fmt::format("{:.2f}", stat.total_ms);
+            }
+        }
+    };
+    f_refresh();
+    // worker threads keep recording while the dialog is open
+    sigc::connection timeoutConnection = Glib::signal_timeout().connect_seconds([f_refresh](){
+        f_refresh();
+        return true;
+    }, 1);
+
+    Gtk::CheckButton checkbutton_trace{_("Record to a Trace File (chrome://tracing)")};
+    checkbutton_trace.set_active(not CtPerf::trace_get_filepath().empty());
+    checkbutton_trace.set_tooltip_text(CtPerf::trace_get_filepath());
+    checkbutton_trace.signal_toggled().connect([&checkbutton_trace, pCtMainWin](){
+        if (not checkbutton_trace.get_active()) {
+            CtPerf::trace_stop();
+            checkbutton_trace.set_tooltip_text("");
+        }
+        else if (CtPerf::trace_get_filepath().empty()) {
+            CtFileSelectArgs args{};
+            args.curr_folder = pCtMainWin->get_ct_config()->pickDirExport;
+            args.curr_file_name = "cherrytree_trace.json";
+            args.filter_name = _("JSON File");
+            args.filter_pattern = {"*.json"};
+            const std::string filepath = CtDialogs::file_save_as_dialog(pCtMainWin, args);
+            if (filepath.empty() or not CtPerf::trace_start(filepath)) {
+                checkbutton_trace.set_active(false);
+            }
+            else {
+                checkbutton_trace.set_tooltip_text(filepath);
+            }
+        }
+    });
+    Gtk::Button button_reset{_("Reset")};
+    button_reset.signal_clicked().connect([f_refresh](){
+        CtPerf::reset();
+        f_refresh();
+    });
+    Gtk::Box* pContentArea = dialog.get_content_area();
+#if GTKMM_MAJOR_VERSION >= 4
+    Gtk::Box hbox{Gtk::Orientation::HORIZONTAL, 6/*spacing*/};
+    hbox.append(checkbutton_trace);
+    hbox.append(button_reset);
+    pContentArea->append(scrolledwindow);
+    pContentArea->append(hbox);
+    (void)_run_dialog_blocking(dialog);
+#else
+    Gtk::Box hbox{Gtk::ORIENTATION_HORIZONTAL, 6/*spacing*/};
+    hbox.pack_start(checkbutton_trace, true, true);
+    hbox.pack_start(button_reset, false, false);
+    pContentArea->pack_start(scrolledwindow);
+    pContentArea->pack_start(hbox, false, false);
+    pContentArea->show_all();
+    dialog.run();
+#endif
+    timeoutConnection.disconnect();
+    dialog.hide();
+}
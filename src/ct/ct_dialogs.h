@@ -240,7 +240,8 @@ void dialog_about(Gtk::Window& parent, Glib::RefPtr<Gdk::Pixbuf> icon);
 std::string dialog_palette(CtMainWin* pCtMainWin);
 gint64 dialog_selnode(CtMainWin* pCtMainWin, const Glib::ustring& entryStr);
 
-void summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo& summaryInfo);
+void summary_info_dialog(CtMainWin* pCtMainWin, const CtSummaryInfo& summaryInfo, const CtMemoryInfo& memoryInfo);
+void perf_dialog(CtMainWin* pCtMainWin);
 
 enum class TableHandleResp { Cancel, Ok, OkFromFile };
 TableHandleResp table_handle_dialog(CtMainWin* pCtMainWin,
@@ -114,8 +114,8 @@ bool CtDialogs::link_handle_dialog(CtMainWin& ctMainWin,
     Gtk::Box hbox_detail{Gtk::Orientation::HORIZONTAL};
     Gtk::TreeView treeview_2(ctMainWin.get_tree_store().get_store());
     treeview_2.set_headers_visible(false);
-    treeview_2.set_search_column(1);
-    treeview_2.append_column("", ctMainWin.get_tree_store().get_columns().rColPixbuf);
+    treeview_2.set_search_column(ctMainWin.get_tree_store().get_columns().colNodeName);
+    ctMainWin.get_tree_store().tree_view_append_node_icon_column(treeview_2);
     treeview_2.append_column("", ctMainWin.get_tree_store().get_columns().colNodeName);
     Gtk::ScrolledWindow scrolledwindow;
     scrolledwindow.set_policy(Gtk::PolicyType::AUTOMATIC, Gtk::PolicyType::AUTOMATIC);
@@ -406,11 +406,11 @@ bool CtDialogs::link_handle_dialog(CtMainWin& ctMainWin,
 
     Gtk::TreeView treeview_2(ctMainWin.get_tree_store().get_store());
     treeview_2.set_headers_visible(false);
-    treeview_2.set_search_column(1);
+    treeview_2.set_search_column(ctMainWin.get_tree_store().get_columns().colNodeName);
     Gtk::CellRendererPixbuf renderer_pixbuf_2;
     Gtk::CellRendererText renderer_text_2;
     Gtk::TreeViewColumn column_2;
-    treeview_2.append_column("", ctMainWin.get_tree_store().get_columns().rColPixbuf);
+    ctMainWin.get_tree_store().tree_view_append_node_icon_column(treeview_2);
     treeview_2.append_column("", ctMainWin.get_tree_store().get_columns().colNodeName);
     Gtk::ScrolledWindow scrolledwindow;
     scrolledwindow.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
@@ -615,8 +615,8 @@ Gtk::TreeModel::iterator CtDialogs::choose_node_dialog(CtMainWin* pCtMainWin,
     dialog.set_default_size(600, 500);
     Gtk::TreeView treeview_2{pCtTreeStore->get_store()};
     treeview_2.set_headers_visible(false);
-    treeview_2.set_search_column(1);
-    treeview_2.append_column("", pCtTreeStore->get_columns().rColPixbuf);
+    treeview_2.set_search_column(pCtTreeStore->get_columns().colNodeName);
+    pCtTreeStore->tree_view_append_node_icon_column(treeview_2);
     treeview_2.append_column("", pCtTreeStore->get_columns().colNodeName);
     Gtk::ScrolledWindow scrolledwindow;
     scrolledwindow.set_policy(Gtk::PolicyType::AUTOMATIC, Gtk::PolicyType::AUTOMATIC);
@@ -645,8 +645,8 @@ Gtk::TreeModel::iterator CtDialogs::choose_node_dialog(CtMainWin* pCtMainWin,
     dialog.set_default_size(600, 500);
     Gtk::TreeView treeview_2{pCtTreeStore->get_store()};
     treeview_2.set_headers_visible(false);
-    treeview_2.set_search_column(1);
-    treeview_2.append_column("", pCtTreeStore->get_columns().rColPixbuf);
+    treeview_2.set_search_column(pCtTreeStore->get_columns().colNodeName);
+    pCtTreeStore->tree_view_append_node_icon_column(treeview_2);
     treeview_2.append_column("", pCtTreeStore->get_columns().colNodeName);
     Gtk::ScrolledWindow scrolledwindow;
     scrolledwindow.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
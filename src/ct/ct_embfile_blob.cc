@@ -0,0 +1,418 @@
+/*
+ * ct_embfile_blob.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_embfile_blob.h"
+#include "ct_storage_multifile.h"
+#include "ct_misc_utils.h"
+#include "ct_logging.h"
+#include <giomm/file.h>
+#include <glibmm/checksum.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr size_t EMBFILE_CHUNK_BYTES{1024*1024};
+
+}
+
+/*static*/std::shared_ptr<CtEmbFileBlob> CtEmbFileBlob::from_memory(std::string rawBlob)
+{
+    std::shared_ptr<CtEmbFileBlob> pBlob{new CtEmbFileBlob{Source::Memory, rawBlob.size()}};
+    pBlob->_rawBlob = std::move(rawBlob);
+    return pBlob;
+}
+
+/*static*/std::shared_ptr<CtEmbFileBlob> CtEmbFileBlob::from_sqlite(sqlite3* pDb, const gint64 rowid, const size_t size)
+{
+    std::shared_ptr<CtEmbFileBlob> pBlob{new CtEmbFileBlob{Source::Sqlite, size}};
+    pBlob->_dbFilepath = _get_db_filepath(pDb);
+    pBlob->_rowid = rowid;
+    pBlob->_registry_add();
+    return pBlob;
+}
+
+/*static*/std::shared_ptr<CtEmbFileBlob> CtEmbFileBlob::from_file(const fs::path& filepath, const std::string& sha256sum/*= ""*/)
+{
+    std::shared_ptr<CtEmbFileBlob> pBlob{new CtEmbFileBlob{Source::File, static_cast<size_t>(fs::file_size(filepath))}};
+    pBlob->_filepath = filepath;
+    pBlob->_sha256sum = sha256sum;
+    pBlob->_registry_add();
+    return pBlob;
+}
+
+CtEmbFileBlob::~CtEmbFileBlob()
+{
+    _registry_remove();
+}
+
+std::string CtEmbFileBlob::read() const
+{
+    if (in_memory()) {
+        return _rawBlob;
+    }
+    std::string rawBlob;
+    rawBlob.reserve(_size);
+    (void)_read_chunks([&rawBlob](const char* pChunk, const size_t chunkLen){
+        rawBlob.append(pChunk, chunkLen);
+        return true;
+    });
+    return rawBlob;
+}
+
+bool CtEmbFileBlob::write_to_file(const fs::path& filepath) const
+{
+    if (Source::File == _source and filepath.string() == _filepath.string()) {
+        return true;
+    }
+    try {
+        Glib::RefPtr<Gio::FileOutputStream> rOutStream = Gio::File::create_for_path(filepath.string())->replace();
+        const bool retVal = _read_chunks([&rOutStream](const char* pChunk, const size_t chunkLen){
+            gsize bytesWritten{0};
+            return rOutStream->write_all(pChunk, chunkLen, bytesWritten);
+        });
+        rOutStream->close();
+        return retVal;
+    }
+    catch (Glib::Error& error) {
+        spdlog::error("!! {} {}: {}", __FUNCTION__, filepath.string(), std::string(error.what()));
+    }
+    return false;
+}
+
+bool CtEmbFileBlob::write_to_sqlite_row(sqlite3* pDb, const gint64 rowid) const
+{
+    sqlite3_blob* pSqliteBlob{nullptr};
+    if (SQLITE_OK != sqlite3_blob_open(pDb, "main", "image", "png", rowid, 1/*read write*/, &pSqliteBlob)) {
+        spdlog::error("!! {} rowid {}: {}", __FUNCTION__, rowid, sqlite3_errmsg(pDb));
+        sqlite3_blob_close(pSqliteBlob);
+        return false;
+    }
+    const size_t blobBytes = static_cast<size_t>(sqlite3_blob_bytes(pSqliteBlob));
+    size_t offset{0};
+    const bool retVal = _read_chunks([&](const char* pChunk, const size_t chunkLen){
+        if (offset + chunkLen > blobBytes or
+            SQLITE_OK != sqlite3_blob_write(pSqliteBlob, pChunk, static_cast<int>(chunkLen), static_cast<int>(offset)))
+        {
+            spdlog::error("!! {} rowid {} offset {}: {}", __FUNCTION__, rowid, offset, sqlite3_errmsg(pDb));
+            return false;
+        }
+        offset += chunkLen;
+        return true;
+    });
+    sqlite3_blob_close(pSqliteBlob);
+    return retVal and offset == blobBytes;
+}
+
+gint64 CtEmbFileBlob::get_sqlite_rowid(sqlite3* pDb) const
+{
+    return Source::Sqlite == _source and _dbFilepath == _get_db_filepath(pDb) ? _rowid : -1;
+}
+
+const std::string& CtEmbFileBlob::get_sha256sum() const
+{
+    if (_sha256sum.empty()) {
+#if GTKMM_MAJOR_VERSION >= 4
+        Glib::Checksum checksum{Glib::Checksum::Type::SHA256};
+#else
+        Glib::Checksum checksum{Glib::Checksum::ChecksumType::CHECKSUM_SHA256};
+#endif
+        if (_read_chunks([&checksum](const char* pChunk, const size_t chunkLen){
+                checksum.update(reinterpret_cast<const guchar*>(pChunk), chunkLen);
+                return true;
+            }))
+        {
+            _sha256sum = checksum.get_string();
+        }
+    }
+    return _sha256sum;
+}
+
+bool CtEmbFileBlob::_read_chunks(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const
+{
+    switch (_source) {
+        case Source::Memory: return _rawBlob.empty() or f_chunk(_rawBlob.data(), _rawBlob.size());
+        case Source::Sqlite: return _read_chunks_sqlite(f_chunk);
+        case Source::File: return _read_chunks_file(f_chunk);
+    }
+    return false;
+}
+
+bool CtEmbFileBlob::_read_chunks_sqlite(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const
+{
+    sqlite3* pDb{nullptr};
+    const auto itConnections = _get_connections().find(_dbFilepath);
+    const bool ownConnection = _get_connections().end() == itConnections or itConnections->second.empty();
+    if (ownConnection) {
+        if (SQLITE_OK != sqlite3_open_v2(_dbFilepath.c_str(), &pDb, SQLITE_OPEN_READONLY, nullptr)) {
+            spdlog::error("!! {} open {}: {}", __FUNCTION__, _dbFilepath, sqlite3_errmsg(pDb));
+            sqlite3_close(pDb);
+            return false;
+        }
+        sqlite3_busy_timeout(pDb, 2000);
+    }
+    else {
+        pDb = itConnections->second.front();
+    }
+    bool retVal{false};
+    sqlite3_blob* pSqliteBlob{nullptr};
+    if (SQLITE_OK != sqlite3_blob_open(pDb, "main", "image", "png", _rowid, 0/*read only*/, &pSqliteBlob)) {
+        spdlog::error("!! {} {} rowid {}: {}", __FUNCTION__, _dbFilepath, _rowid, sqlite3_errmsg(pDb));
+    }
+    else {
+        const size_t blobBytes = static_cast<size_t>(sqlite3_blob_bytes(pSqliteBlob));
+        if (blobBytes != _size) {
+            spdlog::error("!! {} {} rowid {} size {} != {}", __FUNCTION__, _dbFilepath, _rowid, blobBytes, _size);
+        }
+        else {
+            std::vector<char> chunk(std::min(EMBFILE_CHUNK_BYTES, blobBytes));
+            retVal = true;
+            for (size_t offset = 0; offset < blobBytes and retVal; ) {
+                const size_t chunkLen = std::min(EMBFILE_CHUNK_BYTES, blobBytes - offset);
+                if (SQLITE_OK != sqlite3_blob_read(pSqliteBlob, chunk.data(), static_cast<int>(chunkLen), static_cast<int>(offset))) {
+                    spdlog::error("!! {} {} rowid {} offset {}: {}", __FUNCTION__, _dbFilepath, _rowid, offset, sqlite3_errmsg(pDb));
+                    retVal = false;
+                }
+                else {
+                    retVal = f_chunk(chunk.data(), chunkLen);
+                    offset += chunkLen;
+                }
+            }
+        }
+    }
+    sqlite3_blob_close(pSqliteBlob);
+    if (ownConnection) {
+        sqlite3_close(pDb);
+    }
+    return retVal;
+}
+
+bool CtEmbFileBlob::_read_chunks_file(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const
+{
+    fs::path filepath = _filepath;
+    if (not fs::is_regular_file(filepath)) {
+        // while its node is being saved, the file waits in the cleanup folder
+        filepath = _filepath.parent_path() / CtStorageMultiFile::BEFORE_SAVE / _filepath.filename();
+    }
+    try {
+        Glib::RefPtr<Gio::FileInputStream> rInStream = Gio::File::create_for_path(filepath.string())->read();
+        std::vector<char> chunk(EMBFILE_CHUNK_BYTES);
+        size_t totBytes{0};
+        while (true) {
+            const gssize numBytes = rInStream->read(chunk.data(), chunk.size());
+            if (numBytes <= 0) {
+                break;
+            }
+            totBytes += static_cast<size_t>(numBytes);
+            if (not f_chunk(chunk.data(), static_cast<size_t>(numBytes))) {
+                return false;
+            }
+        }
+        if (totBytes != _size) {
+            spdlog::warn("?? {} {} size {} != {}", __FUNCTION__, filepath.string(), totBytes, _size);
+        }
+        return true;
+    }
+    catch (Glib::Error& error) {
+        spdlog::error("!! {} {}: {}", __FUNCTION__, filepath.string(), std::string(error.what()));
+    }
+    return false;
+}
+
+void CtEmbFileBlob::_release()
+{
+    std::string rawBlob = read();
+    _registry_remove();
+    spdlog::debug("{} {}{} {} bytes", __FUNCTION__, _get_registry_key(), _rowid >= 0 ? fmt::format(" rowid {}", _rowid) : "", rawBlob.size());
+    _source = Source::Memory;
+    _size = rawBlob.size();
+    _rawBlob = std::move(rawBlob);
+    _dbFilepath.clear();
+    _rowid = -1;
+    _filepath.clear();
+}
+
+std::string CtEmbFileBlob::_get_registry_key() const
+{
+    switch (_source) {
+        case Source::Sqlite: return _dbFilepath;
+        case Source::File: return _filepath.parent_path().string();
+        default: break;
+    }
+    return "";
+}
+
+void CtEmbFileBlob::_registry_add()
+{
+    _get_registry().emplace(_get_registry_key(), this);
+}
+
+void CtEmbFileBlob::_registry_remove()
+{
+    if (in_memory()) {
+        return;
+    }
+    auto range = _get_registry().equal_range(_get_registry_key());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (this == it->second) {
+            _get_registry().erase(it);
+            return;
+        }
+    }
+}
+
+/*static*/void CtEmbFileBlob::sqlite_connection_register(sqlite3* pDb)
+{
+    const std::string db_filepath = _get_db_filepath(pDb);
+    if (not db_filepath.empty()) {
+        _get_connections()[db_filepath].push_back(pDb);
+    }
+}
+
+/*static*/void CtEmbFileBlob::sqlite_connection_unregister(sqlite3* pDb)
+{
+    const auto it = _get_connections().find(_get_db_filepath(pDb));
+    if (_get_connections().end() != it) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), pDb), it->second.end());
+        if (it->second.empty()) {
+            _get_connections().erase(it);
+        }
+    }
+}
+
+/*static*/void CtEmbFileBlob::sqlite_rows_release(sqlite3* pDb, const std::unordered_set<gint64>& rowids)
+{
+    std::vector<CtEmbFileBlob*> to_release;
+    auto range = _get_registry().equal_range(_get_db_filepath(pDb));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (0u != rowids.count(it->second->_rowid)) {
+            to_release.push_back(it->second);
+        }
+    }
+    for (CtEmbFileBlob* pBlob : to_release) {
+        pBlob->_release();
+    }
+}
+
+/*static*/void CtEmbFileBlob::sqlite_db_release(sqlite3* pDb)
+{
+    std::vector<CtEmbFileBlob*> to_release;
+    auto range = _get_registry().equal_range(_get_db_filepath(pDb));
+    for (auto it = range.first; it != range.second; ++it) {
+        to_release.push_back(it->second);
+    }
+    for (CtEmbFileBlob* pBlob : to_release) {
+        pBlob->_release();
+    }
+}
+
+/*static*/std::unordered_set<gint64> CtEmbFileBlob::sqlite_rows_in_use(sqlite3* pDb)
+{
+    std::unordered_set<gint64> rowids;
+    auto range = _get_registry().equal_range(_get_db_filepath(pDb));
+    for (auto it = range.first; it != range.second; ++it) {
+        rowids.insert(it->second->_rowid);
+    }
+    return rowids;
+}
+
+/*static*/void CtEmbFileBlob::sqlite_rows_remap(sqlite3* pDb, const std::unordered_map<gint64, gint64>& rowids_remap)
+{
+    auto range = _get_registry().equal_range(_get_db_filepath(pDb));
+    for (auto it = range.first; it != range.second; ++it) {
+        const auto itRemap = rowids_remap.find(it->second->_rowid);
+        if (rowids_remap.end() != itRemap) {
+            it->second->_rowid = itRemap->second;
+        }
+        else {
+            spdlog::warn("?? {} missing rowid {}", __FUNCTION__, it->second->_rowid);
+        }
+    }
+}
+
+/*static*/void CtEmbFileBlob::files_release(const fs::path& dir_path, const bool also_existing)
+{
+    std::vector<CtEmbFileBlob*> to_release;
+    auto range = _get_registry().equal_range(dir_path.string());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (also_existing or not fs::is_regular_file(it->second->_filepath)) {
+            to_release.push_back(it->second);
+        }
+    }
+    for (CtEmbFileBlob* pBlob : to_release) {
+        pBlob->_release();
+    }
+}
+
+/*static*/void CtEmbFileBlob::files_release_under(const fs::path& dir_path)
+{
+    const std::string dir_prefix = dir_path.string() + G_DIR_SEPARATOR_S;
+    std::vector<CtEmbFileBlob*> to_release;
+    for (const auto& currPair : _get_registry()) {
+        if (Source::File == currPair.second->_source and
+            (currPair.first == dir_path.string() or str::startswith(currPair.first, dir_prefix)))
+        {
+            to_release.push_back(currPair.second);
+        }
+    }
+    for (CtEmbFileBlob* pBlob : to_release) {
+        pBlob->_release();
+    }
+}
+
+/*static*/void CtEmbFileBlob::files_moved(const fs::path& dir_path_from, const fs::path& dir_path_to)
+{
+    const std::string from_str = dir_path_from.string();
+    const std::string from_prefix = from_str + G_DIR_SEPARATOR_S;
+    std::vector<CtEmbFileBlob*> to_move;
+    for (const auto& currPair : _get_registry()) {
+        if (Source::File == currPair.second->_source and
+            (currPair.first == from_str or str::startswith(currPair.first, from_prefix)))
+        {
+            to_move.push_back(currPair.second);
+        }
+    }
+    for (CtEmbFileBlob* pBlob : to_move) {
+        pBlob->_registry_remove();
+        pBlob->_filepath = dir_path_to.string() + pBlob->_filepath.string().substr(from_str.size());
+        pBlob->_registry_add();
+    }
+}
+
+/*static*/std::unordered_multimap<std::string, CtEmbFileBlob*>& CtEmbFileBlob::_get_registry()
+{
+    static std::unordered_multimap<std::string, CtEmbFileBlob*> registry;
+    return registry;
+}
+
+/*static*/std::unordered_map<std::string, std::vector<sqlite3*>>& CtEmbFileBlob::_get_connections()
+{
+    static std::unordered_map<std::string, std::vector<sqlite3*>> connections;
+    return connections;
+}
+
+/*static*/std::string CtEmbFileBlob::_get_db_filepath(sqlite3* pDb)
+{
+    const char* db_filepath = sqlite3_db_filename(pDb, "main");
+    return db_filepath ? db_filepath : "";
+}
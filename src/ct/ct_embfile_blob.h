@@ -0,0 +1,100 @@
+/*
+ * ct_embfile_blob.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include "ct_filesystem.h"
+#include <sqlite3.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Content of an embedded file, shared by the widget and its undo states.
+// Unless new or replaced, the content stays where the document has it (a row of the SQLite image table
+// or a sha256 named file in a multifile node folder) and is streamed only when opened, saved or exported.
+// The storage notifies before dropping a row or file, then the handles still using it read it in memory.
+// Not thread safe, to be used from the GUI thread.
+class CtEmbFileBlob
+{
+public:
+    static std::shared_ptr<CtEmbFileBlob> from_memory(std::string rawBlob);
+    static std::shared_ptr<CtEmbFileBlob> from_sqlite(sqlite3* pDb, const gint64 rowid, const size_t size);
+    static std::shared_ptr<CtEmbFileBlob> from_file(const fs::path& filepath, const std::string& sha256sum = "");
+
+    CtEmbFileBlob(const CtEmbFileBlob&) = delete;
+    CtEmbFileBlob& operator=(const CtEmbFileBlob&) = delete;
+    ~CtEmbFileBlob();
+
+    size_t size() const { return _size; }
+    bool   empty() const { return 0u == _size; }
+    bool   in_memory() const { return Source::Memory == _source; }
+
+    // the whole content, for the consumers that need it in a string (e.g. base64 encoding)
+    std::string        read() const;
+    bool               write_to_file(const fs::path& filepath) const;
+    // into the png column of an image row inserted with zeroblob(size())
+    bool               write_to_sqlite_row(sqlite3* pDb, const gint64 rowid) const;
+    // the image table rowid if the content is already in this database, else -1
+    gint64             get_sqlite_rowid(sqlite3* pDb) const;
+    const std::string& get_sha256sum() const;
+
+    // a connection to read from instead of opening a read only one, as it may be in a transaction
+    static void sqlite_connection_register(sqlite3* pDb);
+    static void sqlite_connection_unregister(sqlite3* pDb);
+    static void sqlite_rows_release(sqlite3* pDb, const std::unordered_set<gint64>& rowids);
+    static void sqlite_db_release(sqlite3* pDb);
+    static std::unordered_set<gint64> sqlite_rows_in_use(sqlite3* pDb);
+    static void sqlite_rows_remap(sqlite3* pDb, const std::unordered_map<gint64, gint64>& rowids_remap);
+    // the files of the folder no longer there (or all of them) are about to disappear
+    static void files_release(const fs::path& dir_path, const bool also_existing);
+    static void files_release_under(const fs::path& dir_path);
+    static void files_moved(const fs::path& dir_path_from, const fs::path& dir_path_to);
+
+private:
+    enum class Source { Memory, Sqlite, File };
+
+    CtEmbFileBlob(const Source source, const size_t size) : _source{source}, _size{size} {}
+
+    bool        _read_chunks(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const;
+    bool        _read_chunks_sqlite(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const;
+    bool        _read_chunks_file(const std::function<bool(const char* pChunk, const size_t chunkLen)>& f_chunk) const;
+    void        _release();
+    std::string _get_registry_key() const;
+    void        _registry_add();
+    void        _registry_remove();
+
+    static std::unordered_multimap<std::string, CtEmbFileBlob*>&   _get_registry();
+    static std::unordered_map<std::string, std::vector<sqlite3*>>& _get_connections();
+    static std::string                                             _get_db_filepath(sqlite3* pDb);
+
+    Source              _source;
+    size_t              _size;
+    std::string         _rawBlob;
+    std::string         _dbFilepath;
+    gint64              _rowid{-1};
+    fs::path            _filepath;
+    mutable std::string _sha256sum;
+};
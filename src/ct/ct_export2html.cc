@@ -397,7 +397,7 @@ Glib::ustring CtExport2Html::_get_embfile_html(CtImageEmbFile* embfile,
     Glib::ustring embfile_html = "<table style=\"" + embfile_align_text + "\"><tr><td><a href=\"" +
             embfile_rel_path.string_unix() + "\">Linked file: " + embfile->get_file_name().string() + " </a></td></tr></table>";
 
-    g_file_set_contents((embed_dir / embfile_name).c_str(), embfile->get_raw_blob().c_str(), (gssize)embfile->get_raw_blob().size(), nullptr);
+    (void)embfile->get_blob()->write_to_file(embed_dir / embfile_name);
 
     return embfile_html;
 }
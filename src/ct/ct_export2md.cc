@@ -0,0 +1,439 @@
+/*
+ * ct_export2md.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include "ct_export2md.h"
+#include "ct_export2html.h"
+#include "ct_main_win.h"
+#include "ct_storage_control.h"
+#include "ct_list.h"
+#include "ct_logging.h"
+
+namespace {
+
+std::string md_escape(const std::string& text)
+{
+    static constexpr std::string_view md_special_chars{"\\`*_[]<>|"};
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char ch : text) {
+        if (md_special_chars.find(ch) != std::string_view::npos) {
+            escaped += '\\';
+        }
+        escaped += ch;
+    }
+    if (not escaped.empty() and '#' == escaped.front()) {
+        escaped.insert(0, 1, '\\');
+    }
+    return escaped;
+}
+
+// the emphasis markers must be adjacent to the text, not to the surrounding spaces
+std::string md_wrap(const std::string& text, const std::string& mark_open, const std::string& mark_close)
+{
+    const size_t first = text.find_first_not_of(' ');
+    if (std::string::npos == first) {
+        return text;
+    }
+    const size_t last = text.find_last_not_of(' ');
+    return text.substr(0, first) + mark_open + text.substr(first, last + 1 - first) + mark_close + text.substr(last + 1);
+}
+
+std::string md_link_target(const std::string& href)
+{
+    return href.find(' ') != std::string::npos ? "<" + href + ">" : href;
+}
+
+std::string md_node_anchor(const gint64 node_id)
+{
+    return "node-" + std::to_string(node_id);
+}
+
+} // namespace (anonymous)
+
+CtExport2Md::CtExport2Md(CtMainWin* pCtMainWin)
+ : _pCtMainWin{pCtMainWin}
+ , _pCtConfig{pCtMainWin->get_ct_config()}
+{
+}
+
+// Export the Selected Node To Markdown
+void CtExport2Md::node_export_to_md(CtTreeIter tree_iter, const fs::path& filepath, const CtExportOptions& export_options, int sel_start, int sel_end)
+{
+    _export_dir = filepath.parent_path();
+    std::vector<MdNode> md_nodes;
+    md_nodes.push_back(_get_md_node(tree_iter, export_options, sel_start, sel_end, false/*single_file*/));
+    md_nodes.back().filepath = filepath;
+    _render_md_nodes(md_nodes);
+}
+
+// Export All Nodes To Markdown
+void CtExport2Md::nodes_all_export_to_md(bool all_tree, const fs::path& export_dir, const fs::path& single_md_filepath, const CtExportOptions& export_options)
+{
+    const bool single_file = not single_md_filepath.empty();
+    _export_dir = single_file ? single_md_filepath.parent_path() : export_dir;
+    // the text buffers and the widgets are only to be touched from the GUI thread
+    std::vector<MdNode> md_nodes;
+    std::function<void(CtTreeIter)> f_traverseFunc;
+    f_traverseFunc = [&](CtTreeIter tree_iter) {
+        md_nodes.push_back(_get_md_node(tree_iter, export_options, -1, -1, single_file));
+        if (not single_file) {
+            md_nodes.back().filepath = export_dir / get_md_filename(tree_iter).raw();
+        }
+        for (auto child_iter = tree_iter->children().begin(); child_iter != tree_iter->children().end(); ++child_iter) {
+            f_traverseFunc(_pCtMainWin->get_tree_store().to_ct_tree_iter(child_iter));
+        }
+    };
+    CtTreeIter tree_iter = all_tree ? _pCtMainWin->get_tree_store().get_ct_iter_first() : _pCtMainWin->curr_tree_iter();
+    for (; tree_iter; ++tree_iter) {
+        f_traverseFunc(tree_iter);
+        if (not all_tree) break;
+    }
+
+    _render_md_nodes(md_nodes);
+
+    if (single_file) {
+        std::string tree_md_text;
+        for (const MdNode& md_node : md_nodes) {
+            tree_md_text += md_node.rendered;
+        }
+        CtMiscUtil::text_file_set_contents_add_cr_on_win(single_md_filepath.string(), tree_md_text);
+    }
+}
+
+// Get the Markdown filename given the tree iter
+/*static*/Glib::ustring CtExport2Md::get_md_filename(CtTreeIter tree_iter)
+{
+    Glib::ustring name = CtMiscUtil::get_node_hierarchical_name(tree_iter, "--"/*separator*/,
+        true/*for_filename*/, true/*root_to_leaf*/, true/*trail_node_id*/, ".md"/*trailer*/);
+    return str::replace(name, "#", "~");
+}
+
+CtExport2Md::MdNode CtExport2Md::_get_md_node(CtTreeIter tree_iter, const CtExportOptions& export_options, int sel_start, int sel_end, const bool single_file)
+{
+    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = tree_iter.get_node_text_buffer();
+    if (not pTextBuffer) {
+        throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), tree_iter.get_node_name().raw()));
+    }
+    MdNode md_node;
+    std::string node_head;
+    if (single_file) {
+        node_head += "<a id=\"" + md_node_anchor(tree_iter.get_node_id()) + "\"></a>\n\n";
+    }
+    if (export_options.include_node_name) {
+        const int depth = _pCtMainWin->get_tree_store().get_store()->iter_depth(tree_iter);
+        node_head += std::string(std::min(depth + 1, 6), '#') + " " + md_escape(tree_iter.get_node_name().raw()) + "\n\n";
+    }
+    md_node.chunks.push_back(MdChunk{node_head, {}, nullptr, ""});
+
+    if (tree_iter.get_node_is_code()) {
+        Gtk::TextIter start_iter = pTextBuffer->get_iter_at_offset(sel_start == -1 ? 0 : sel_start);
+        Gtk::TextIter end_iter = sel_end == -1 ? pTextBuffer->end() : pTextBuffer->get_iter_at_offset(sel_end);
+        md_node.chunks.push_back(MdChunk{_get_fenced_block(start_iter.get_text(end_iter).raw(), tree_iter.get_node_syntax_highlighting()), {}, nullptr, ""});
+        md_node.chunks.push_back(MdChunk{"\n", {}, nullptr, ""});
+        return md_node;
+    }
+
+    const std::string node_id_str = std::to_string(tree_iter.get_node_id_data_holder());
+    int images_count{0};
+    int start_offset = sel_start == -1 ? 0 : sel_start;
+    for (CtAnchoredWidget* pWidget : tree_iter.get_anchored_widgets(sel_start, sel_end)) {
+        const int end_offset = pWidget->getOffset();
+        md_node.chunks.push_back(MdChunk{md_process_slot(_pCtConfig, _pCtMainWin, start_offset, end_offset, pTextBuffer, single_file), {}, nullptr, ""});
+        start_offset = end_offset;
+        MdChunk md_chunk;
+        if (auto pEmbFile = dynamic_cast<CtImageEmbFile*>(pWidget)) {
+            const fs::path embed_dir = _export_dir / "EmbeddedFiles";
+            (void)g_mkdir_with_parents(embed_dir.c_str(), 0755);
+            const std::string embfile_name = node_id_str + "-" + pEmbFile->get_file_name().string();
+            md_chunk.text = "[" + md_escape(pEmbFile->get_file_name().string()) + "](" + md_link_target("EmbeddedFiles/" + embfile_name) + ")";
+            (void)pEmbFile->get_blob()->write_to_file(embed_dir / embfile_name);
+        }
+        else if (auto pImageAnchor = dynamic_cast<CtImageAnchor*>(pWidget)) {
+            md_chunk.text = "<a id=\"" + str::xml_escape(pImageAnchor->get_anchor_name()) + "\"></a>";
+        }
+        else if (auto pImageLatex = dynamic_cast<CtImageLatex*>(pWidget)) {
+            md_chunk.text = _get_fenced_block(pImageLatex->get_latex_text().raw(), "latex");
+        }
+        else if (auto pImagePng = dynamic_cast<CtImagePng*>(pWidget)) {
+            const fs::path images_dir = _export_dir / "images";
+            (void)g_mkdir_with_parents(images_dir.c_str(), 0755);
+            const std::string image_name = node_id_str + "-" + std::to_string(++images_count) + ".png";
+            md_chunk.text = "![](images/" + image_name + ")";
+            if (not pImagePng->get_link().empty()) {
+                const std::string href = _get_href_from_link_prop_val(_pCtMainWin, pImagePng->get_link(), single_file);
+                if (not href.empty()) {
+                    md_chunk.text = "[" + md_chunk.text + "](" + md_link_target(href) + ")";
+                }
+            }
+            md_chunk.pPngBlob = pImagePng->get_raw_blob_shared();
+            md_chunk.png_filepath = (images_dir / image_name).string();
+        }
+        else if (auto pTable = dynamic_cast<CtTableCommon*>(pWidget)) {
+            pTable->write_strings_matrix(md_chunk.table_rows);
+        }
+        else if (auto pCodebox = dynamic_cast<CtCodebox*>(pWidget)) {
+            md_chunk.text = _get_fenced_block(pCodebox->get_text_content().raw(), pCodebox->get_syntax_highlighting());
+        }
+        md_node.chunks.push_back(std::move(md_chunk));
+    }
+    md_node.chunks.push_back(MdChunk{md_process_slot(_pCtConfig, _pCtMainWin, start_offset, sel_end, pTextBuffer, single_file), {}, nullptr, ""});
+    md_node.chunks.push_back(MdChunk{"\n\n", {}, nullptr, ""});
+    return md_node;
+}
+
+// tables formatting, images and files writing do not need the GUI thread
+void CtExport2Md::_render_md_nodes(std::vector<MdNode>& md_nodes)
+{
+    CtMiscUtil::parallel_for(0, md_nodes.size(), [&md_nodes](size_t index) {
+        MdNode& md_node = md_nodes[index];
+        try {
+            for (const MdChunk& md_chunk : md_node.chunks) {
+                if (not md_chunk.table_rows.empty()) {
+                    md_node.rendered += _get_table_md(md_chunk.table_rows);
+                    continue;
+                }
+                if (md_chunk.pPngBlob and not g_file_set_contents(md_chunk.png_filepath.c_str(),
+                                                                   md_chunk.pPngBlob->data(),
+                                                                   md_chunk.pPngBlob->size(),
+                                                                   NULL))
+                {
+                    spdlog::error("!! {} {}", __FUNCTION__, md_chunk.png_filepath);
+                }
+                md_node.rendered += md_chunk.text;
+            }
+            if (not md_node.filepath.empty()) {
+                CtMiscUtil::text_file_set_contents_add_cr_on_win(md_node.filepath.string(), md_node.rendered);
+            }
+        }
+        catch (std::exception& e) {
+            spdlog::error("!! {} {}", __FUNCTION__, e.what());
+        }
+    });
+}
+
+/*static*/std::string CtExport2Md::_get_table_md(const std::vector<std::vector<Glib::ustring>>& table_rows)
+{
+    std::string table_md{"\n"};
+    bool first{true};
+    for (const auto& row : table_rows) {
+        table_md += "|";
+        for (const Glib::ustring& cell : row) {
+            table_md += " " + str::replace(md_escape(cell.raw()), "\n", "<br>") + " |";
+        }
+        table_md += "\n";
+        if (first) {
+            // the first row is the header
+            table_md += "|";
+            for (size_t i = 0; i < row.size(); ++i) {
+                table_md += " --- |";
+            }
+            table_md += "\n";
+            first = false;
+        }
+    }
+    return table_md;
+}
+
+/*static*/std::string CtExport2Md::_get_fenced_block(const std::string& content, const std::string& syntax_highlighting)
+{
+    std::string fence{"```"};
+    while (content.find(fence) != std::string::npos) {
+        fence += "`";
+    }
+    const std::string language = syntax_highlighting == CtConst::PLAIN_TEXT_ID ? "" : syntax_highlighting;
+    std::string fenced_block = "\n" + fence + language + "\n" + content;
+    if (not content.empty() and '\n' != content.back()) {
+        fenced_block += "\n";
+    }
+    return fenced_block + fence + "\n";
+}
+
+/*static*/std::string CtExport2Md::md_process_slot(const CtConfig* const pCtConfig,
+                                                   CtMainWin* const pCtMainWin,
+                                                   int start_offset,
+                                                   int end_offset,
+                                                   Glib::RefPtr<Gtk::TextBuffer> curr_buffer,
+                                                   const bool single_file)
+{
+    std::string curr_md_text;
+    CtListInfo curr_list_info;
+    CtTextIterUtil::SerializeFunc f_md_serialise = [&](Gtk::TextIter& start_iter,
+                                                       Gtk::TextIter& curr_iter,
+                                                       CtCurrAttributesMap& curr_attributes,
+                                                       CtListInfo* pCurrListInfo)
+    {
+        if (*pCurrListInfo != curr_list_info) {
+            if (CtListType::None == pCurrListInfo->type) {
+                // else the following paragraph would be taken as part of the last list item
+                curr_md_text += "\n";
+            }
+            else {
+                const bool same_item = CtListType::None != curr_list_info.type and
+                                       pCurrListInfo->level == curr_list_info.level and
+                                       pCurrListInfo->startoffs == curr_list_info.startoffs and
+                                       pCurrListInfo->count_nl > curr_list_info.count_nl;
+                while ('\n' == start_iter.get_char()) {
+                    curr_md_text += "\n";
+                    if (not start_iter.forward_char()) break;
+                }
+                if (not curr_md_text.empty() and '\n' != curr_md_text.back()) {
+                    curr_md_text += "\n";
+                }
+                if (same_item) {
+                    curr_md_text += std::string(4*(pCurrListInfo->level + 1), ' ');
+                    start_iter.forward_chars(3*(pCurrListInfo->level + 1) - 1);
+                }
+                else {
+                    curr_md_text += std::string(4*pCurrListInfo->level, ' ');
+                    start_iter.forward_chars(3*pCurrListInfo->level);
+                    if (CtListType::Number == pCurrListInfo->type) {
+                        curr_md_text += std::to_string(pCurrListInfo->num_seq) + ". ";
+                    }
+                    else if (CtListType::Todo == pCurrListInfo->type) {
+                        const bool todo_open = Glib::ustring(1, start_iter.get_char()) == pCtConfig->charsTodo[0];
+                        curr_md_text += todo_open ? "- [ ] " : "- [x] ";
+                    }
+                    else {
+                        curr_md_text += "- ";
+                    }
+                    start_iter.forward_chars(CtList::get_leading_chars_num(pCurrListInfo->type, pCurrListInfo->num_seq));
+                }
+                if (start_iter.compare(curr_iter) > 0) {
+                    start_iter = curr_iter;
+                }
+            }
+            curr_list_info = *pCurrListInfo;
+        }
+        curr_md_text += _md_text_serialize(pCtMainWin, start_iter, curr_iter, curr_attributes, single_file);
+    };
+    CtTextIterUtil::generic_process_slot(pCtConfig, start_offset, end_offset, curr_buffer, f_md_serialise, true/*list_info*/);
+    return curr_md_text;
+}
+
+/*static*/std::string CtExport2Md::_md_text_serialize(CtMainWin* const pCtMainWin,
+                                                      Gtk::TextIter start_iter,
+                                                      Gtk::TextIter end_iter,
+                                                      const CtCurrAttributesMap& curr_attributes,
+                                                      const bool single_file)
+{
+    bool bold_active{false};
+    bool italic_active{false};
+    bool monospace_active{false};
+    bool strikethrough_active{false};
+    bool superscript_active{false};
+    bool subscript_active{false};
+    int hN_active{0};
+    std::string href;
+    for (const std::string_view tag_property : CtConst::TAG_PROPERTIES) {
+        const std::string& property_value = curr_attributes.at(tag_property);
+        if (property_value.empty()) {
+            continue;
+        }
+        if (tag_property == CtConst::TAG_WEIGHT) {
+            bold_active = true;
+        }
+        else if (tag_property == CtConst::TAG_STYLE) {
+            italic_active = true;
+        }
+        else if (tag_property == CtConst::TAG_FAMILY) {
+            monospace_active = true;
+        }
+        else if (tag_property == CtConst::TAG_STRIKETHROUGH) {
+            strikethrough_active = true;
+        }
+        else if (tag_property == CtConst::TAG_SCALE) {
+            if (property_value == CtConst::TAG_PROP_VAL_SUP) {
+                superscript_active = true;
+            }
+            else if (property_value == CtConst::TAG_PROP_VAL_SUB) {
+                subscript_active = true;
+            }
+            else if (2u == property_value.size() and 'h' == property_value[0] and property_value[1] >= '1' and property_value[1] <= '6') {
+                hN_active = property_value[1] - '0';
+            }
+        }
+        else if (tag_property == CtConst::TAG_LINK and pCtMainWin) {
+            href = _get_href_from_link_prop_val(pCtMainWin, property_value, single_file);
+        }
+    }
+
+    std::string md_text;
+    std::vector<std::string> lines = str::split(start_iter.get_text(end_iter).raw(), "\n");
+    const size_t lastIdx = lines.size() - 1;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        std::string tagged_text;
+        if (monospace_active) {
+            const std::string ticks = lines[i].find('`') != std::string::npos ? "``" : "`";
+            tagged_text = md_wrap(lines[i], ticks, ticks);
+        }
+        else {
+            tagged_text = md_escape(lines[i]);
+        }
+        if (strikethrough_active) tagged_text = md_wrap(tagged_text, "~~", "~~");
+        if (italic_active) tagged_text = md_wrap(tagged_text, "*", "*");
+        if (bold_active and 0 == hN_active) tagged_text = md_wrap(tagged_text, "**", "**");
+        if (superscript_active) tagged_text = md_wrap(tagged_text, "<sup>", "</sup>");
+        if (subscript_active) tagged_text = md_wrap(tagged_text, "<sub>", "</sub>");
+        if (not href.empty()) tagged_text = md_wrap(tagged_text, "[", "](" + md_link_target(href) + ")");
+        // a heading only where the line starts, the rest of a line keeps the text attributes
+        if (hN_active > 0 and not tagged_text.empty() and (i > 0 or start_iter.starts_line())) {
+            tagged_text = std::string(hN_active, '#') + " " + tagged_text;
+        }
+        md_text += tagged_text;
+        if (i < lastIdx) {
+            md_text += "\n";
+        }
+    }
+    return md_text;
+}
+
+/*static*/std::string CtExport2Md::_get_href_from_link_prop_val(CtMainWin* const pCtMainWin,
+                                                                const Glib::ustring& link_prop_val,
+                                                                const bool single_file)
+{
+    CtLinkEntry link_entry = CtMiscUtil::get_link_entry_from_property(link_prop_val);
+    std::string href;
+    if (CtLinkType::Webs == link_entry.type) {
+        href = link_entry.webs.raw();
+    }
+    else if (CtLinkType::File == link_entry.type) {
+        href = "file://" + CtExport2Html::link_process_filepath(link_entry.file.raw(), pCtMainWin->get_ct_storage()->get_file_path().parent_path().string(), true/*forHtml*/);
+    }
+    else if (CtLinkType::Fold == link_entry.type) {
+        href = "file://" + CtExport2Html::link_process_folderpath(link_entry.fold.raw(), pCtMainWin->get_ct_storage()->get_file_path().parent_path().string(), true/*forHtml*/);
+    }
+    else if (CtLinkType::Node == link_entry.type) {
+        CtTreeIter node = pCtMainWin->get_tree_store().get_node_from_node_id(link_entry.node_id);
+        if (node) {
+            const std::string anchor = link_entry.anch.empty() ? "" : ("#" + link_entry.anch.raw());
+            if (single_file) {
+                href = anchor.empty() ? ("#" + md_node_anchor(link_entry.node_id)) : anchor;
+            }
+            else {
+                href = get_md_filename(node).raw() + anchor;
+            }
+        }
+    }
+    return href;
+}
@@ -0,0 +1,83 @@
+/*
+ * ct_export2md.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#include "ct_treestore.h"
+#include "ct_dialogs.h" // CtExportOptions
+#include "ct_misc_utils.h"
+#include <memory>
+
+class CtExport2Md
+{
+public:
+    CtExport2Md(CtMainWin* pCtMainWin);
+
+    static std::string   md_process_slot(const CtConfig* const pCtConfig,
+                                         CtMainWin* const pCtMainWin,
+                                         int start_offset,
+                                         int end_offset,
+                                         Glib::RefPtr<Gtk::TextBuffer> curr_buffer,
+                                         const bool single_file);
+    static Glib::ustring get_md_filename(CtTreeIter tree_iter);
+
+    void node_export_to_md(CtTreeIter tree_iter, const fs::path& filepath, const CtExportOptions& export_options, int sel_start, int sel_end);
+    void nodes_all_export_to_md(bool all_tree, const fs::path& export_dir, const fs::path& single_md_filepath, const CtExportOptions& export_options);
+
+private:
+    // a piece of the node markdown, the table is formatted and the image written by the worker threads
+    struct MdChunk
+    {
+        std::string                             text;
+        std::vector<std::vector<Glib::ustring>> table_rows;
+        std::shared_ptr<const std::string>      pPngBlob;
+        std::string                             png_filepath;
+    };
+    // what is needed of a node to render it away from the GUI thread
+    struct MdNode
+    {
+        std::vector<MdChunk> chunks;
+        fs::path             filepath;
+        std::string          rendered;
+    };
+
+    MdNode _get_md_node(CtTreeIter tree_iter, const CtExportOptions& export_options, int sel_start, int sel_end, const bool single_file);
+    void   _render_md_nodes(std::vector<MdNode>& md_nodes);
+
+    static std::string _md_text_serialize(CtMainWin* const pCtMainWin,
+                                          Gtk::TextIter start_iter,
+                                          Gtk::TextIter end_iter,
+                                          const CtCurrAttributesMap& curr_attributes,
+                                          const bool single_file);
+    static std::string _get_href_from_link_prop_val(CtMainWin* const pCtMainWin,
+                                                    const Glib::ustring& link_prop_val,
+                                                    const bool single_file);
+    static std::string _get_table_md(const std::vector<std::vector<Glib::ustring>>& table_rows);
+    static std::string _get_fenced_block(const std::string& content, const std::string& syntax_highlighting);
+
+private:
+    CtMainWin* const      _pCtMainWin;
+    const CtConfig* const _pCtConfig;
+    fs::path              _export_dir;
+};
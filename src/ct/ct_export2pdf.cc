@@ -23,6 +23,8 @@
 
 #include "ct_export2pdf.h"
 #include "ct_dialogs.h"
+#include <cairomm/surface.h>
+#include <pango/pangocairo.h>
 #include <utility>
 
 namespace {
@@ -378,78 +380,104 @@ std::shared_ptr<CtPangoText> CtExport2Pango::_pango_link_url(const Glib::ustring
 
 void CtExport2Pdf::node_export_print(const fs::path& pdf_filepath, CtTreeIter tree_iter, const CtExportOptions& options, int sel_start, int sel_end)
 {
-    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = tree_iter.get_node_text_buffer();
-    if (not pTextBuffer) {
-        throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), tree_iter.get_node_name().raw()));
-    }
-    std::vector<CtPangoObjectPtr> pango_slots;
-    if (tree_iter.get_node_is_text()) {
-        CtExport2Pango{_pCtMainWin}.pango_get_from_treestore_node(tree_iter, sel_start, sel_end, pango_slots);
-    }
-    else {
-        Glib::ustring text = CtExport2Pango{_pCtMainWin}.pango_get_from_code_buffer(
-            pTextBuffer, sel_start, sel_end, tree_iter.get_node_syntax_highlighting());
-        pango_slots.push_back(std::make_shared<CtPangoText>(text, tree_iter.get_node_syntax_highlighting(), 0/*indent*/, PANGO_DIRECTION_LTR));
-    }
-
-    if (options.include_node_name) {
-        pango_slots.emplace(pango_slots.begin(), _generate_pango_node_name(tree_iter));
-    }
-    _pCtMainWin->get_ct_print().print_text(pdf_filepath, pango_slots);
+    _nodes_export_print(pdf_filepath, {tree_iter}, options, sel_start, sel_end);
 }
 
 void CtExport2Pdf::node_and_subnodes_export_print(const fs::path& pdf_filepath, CtTreeIter tree_iter, const CtExportOptions& options)
 {
-    std::vector<CtPangoObjectPtr> tree_pango_slots;
-    _nodes_all_export_print_iter(tree_iter, options, tree_pango_slots);
-
-    _pCtMainWin->get_ct_print().print_text(pdf_filepath, tree_pango_slots);
+    std::list<CtTreeIter> tree_iters;
+    _nodes_all_collect_iter(tree_iter, tree_iters);
+    _nodes_export_print(pdf_filepath, tree_iters, options, -1, -1);
 }
 
 void CtExport2Pdf::tree_export_print(const fs::path& pdf_filepath, CtTreeIter tree_iter, const CtExportOptions& options)
 {
-    std::vector<CtPangoObjectPtr> tree_pango_slots;
+    std::list<CtTreeIter> tree_iters;
     while (tree_iter) {
-        _nodes_all_export_print_iter(tree_iter, options, tree_pango_slots);
+        _nodes_all_collect_iter(tree_iter, tree_iters);
         ++tree_iter;
     }
-    _pCtMainWin->get_ct_print().print_text(pdf_filepath, tree_pango_slots);
+    _nodes_export_print(pdf_filepath, tree_iters, options, -1, -1);
 }
 
-void CtExport2Pdf::_nodes_all_export_print_iter(CtTreeIter tree_iter,
-                                                const CtExportOptions& options,
-                                                std::vector<CtPangoObjectPtr>& tree_pango_slots)
+void CtExport2Pdf::_nodes_all_collect_iter(CtTreeIter tree_iter, std::list<CtTreeIter>& tree_iters)
 {
-    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = tree_iter.get_node_text_buffer();
-    if (not pTextBuffer) {
-        throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), tree_iter.get_node_name().raw()));
+    tree_iters.push_back(tree_iter);
+    for (auto child_iter = tree_iter->children().begin(); child_iter != tree_iter->children().end(); ++child_iter) {
+        _nodes_all_collect_iter(_pCtMainWin->get_tree_store().to_ct_tree_iter(child_iter), tree_iters);
     }
-    std::vector<CtPangoObjectPtr> node_pango_slots;
-    if (tree_iter.get_node_is_text()) {
-        CtExport2Pango{_pCtMainWin}.pango_get_from_treestore_node(tree_iter, -1, -1, node_pango_slots);
+}
+
+void CtExport2Pdf::_nodes_export_print(const fs::path& pdf_filepath,
+                                       const std::list<CtTreeIter>& tree_iters,
+                                       const CtExportOptions& options,
+                                       const int sel_start,
+                                       const int sel_end)
+{
+    auto itTreeIter = tree_iters.begin();
+    auto f_next_node_slots = [&](std::vector<CtPangoObjectPtr>& node_slots)->bool {
+        if (itTreeIter == tree_iters.end()) {
+            return false;
+        }
+        if (itTreeIter != tree_iters.begin()) {
+            if (options.new_node_page)
+                node_slots.push_back(std::make_shared<CtPangoNewPage>());
+            else
+                node_slots.push_back(std::make_shared<CtPangoText>(str::repeat(CtConst::CHAR_NEWLINE, 3), itTreeIter->get_node_syntax_highlighting(), 0/*indent*/, PANGO_DIRECTION_NEUTRAL));
+        }
+        _node_get_pango_slots(*itTreeIter, options, sel_start, sel_end, node_slots);
+        ++itTreeIter;
+        return true;
+    };
+
+    if (pdf_filepath.empty()) {
+        // the print dialog needs all the pages upfront
+        std::vector<CtPangoObjectPtr> tree_pango_slots;
+        std::vector<CtPangoObjectPtr> node_pango_slots;
+        while (f_next_node_slots(node_pango_slots)) {
+            vec::vector_extend(tree_pango_slots, node_pango_slots);
+            node_pango_slots.clear();
+        }
+        _pCtMainWin->get_ct_print().print_text(pdf_filepath, tree_pango_slots);
+        return;
     }
-    else {
-        Glib::ustring text = CtExport2Pango{_pCtMainWin}.pango_get_from_code_buffer(
-            pTextBuffer, -1, -1, tree_iter.get_node_syntax_highlighting());
-        node_pango_slots.push_back(std::make_shared<CtPangoText>(text, tree_iter.get_node_syntax_highlighting(), 0/*indent*/, PANGO_DIRECTION_LTR));
+    // the links can point to nodes/anchors that are drawn later on
+    std::set<Glib::ustring> dest_names;
+    for (const CtTreeIter& tree_iter : tree_iters) {
+        if (options.include_node_name) {
+            dest_names.insert("'" + generate_tag(tree_iter.get_node_id(), "") + "'");
+        }
+        if (tree_iter.get_node_is_text()) {
+            for (CtAnchoredWidget* pWidget : tree_iter.get_anchored_widgets(sel_start, sel_end)) {
+                if (auto pAnchor = dynamic_cast<CtImageAnchor*>(pWidget)) {
+                    dest_names.insert("'" + generate_tag(tree_iter.get_node_id(), pAnchor->get_anchor_name()) + "'");
+                }
+            }
+        }
     }
+    _pCtMainWin->get_ct_print().print_pdf_stream(pdf_filepath, dest_names, f_next_node_slots);
+}
 
+void CtExport2Pdf::_node_get_pango_slots(CtTreeIter tree_iter,
+                                         const CtExportOptions& options,
+                                         const int sel_start,
+                                         const int sel_end,
+                                         std::vector<CtPangoObjectPtr>& out_slots)
+{
+    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = tree_iter.get_node_text_buffer();
+    if (not pTextBuffer) {
+        throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), tree_iter.get_node_name().raw()));
+    }
     if (options.include_node_name) {
-        node_pango_slots.emplace(node_pango_slots.begin(), _generate_pango_node_name(tree_iter));
+        out_slots.push_back(_generate_pango_node_name(tree_iter));
     }
-    if (tree_pango_slots.empty()) {
-        tree_pango_slots = node_pango_slots;
+    if (tree_iter.get_node_is_text()) {
+        CtExport2Pango{_pCtMainWin}.pango_get_from_treestore_node(tree_iter, sel_start, sel_end, out_slots);
     }
     else {
-        if (options.new_node_page)
-            tree_pango_slots.push_back(std::make_shared<CtPangoNewPage>());
-        else
-            tree_pango_slots.push_back(std::make_shared<CtPangoText>(str::repeat(CtConst::CHAR_NEWLINE, 3), tree_iter.get_node_syntax_highlighting(), 0/*indent*/, PANGO_DIRECTION_NEUTRAL));
-        vec::vector_extend(tree_pango_slots, node_pango_slots);
-    }
-
-    for (auto child_iter = tree_iter->children().begin(); child_iter != tree_iter->children().end(); ++child_iter) {
-        _nodes_all_export_print_iter(_pCtMainWin->get_tree_store().to_ct_tree_iter(child_iter), options, tree_pango_slots);
+        Glib::ustring text = CtExport2Pango{_pCtMainWin}.pango_get_from_code_buffer(
+            pTextBuffer, sel_start, sel_end, tree_iter.get_node_syntax_highlighting());
+        out_slots.push_back(std::make_shared<CtPangoText>(text, tree_iter.get_node_syntax_highlighting(), 0/*indent*/, PANGO_DIRECTION_LTR));
     }
 }
 
@@ -576,8 +604,78 @@ void CtPrint::print_text(const fs::path& pdf_filepath, const std::vector<CtPango
         _pCtMainWin->get_status_bar().update_status(print_data.warning);
 }
 
+// Export to PDF Laying Out and Drawing Node by Node, Without Print Operation
+void CtPrint::print_pdf_stream(const fs::path& pdf_filepath,
+                               const std::set<Glib::ustring>& dest_names,
+                               const std::function<bool(std::vector<CtPangoObjectPtr>&)>& f_next_node_slots)
+{
+    CtPrintData print_data;
+    print_data.cairo_names = dest_names;
+
+#if GTKMM_MAJOR_VERSION >= 4
+    const Gtk::Unit unit_points = Gtk::Unit::POINTS;
+#else
+    const Gtk::Unit unit_points = Gtk::UNIT_POINTS;
+#endif
+    Cairo::RefPtr<Cairo::PdfSurface> pdf_surface = Cairo::PdfSurface::create(pdf_filepath.string(),
+        _pPageSetup->get_paper_width(unit_points), _pPageSetup->get_paper_height(unit_points));
+    Cairo::RefPtr<Cairo::Context> cairo_context = Cairo::Context::create(pdf_surface);
+    // as the print context of a pdf export: origin at the margins, 72 dpi, no hinted metrics
+    cairo_context->translate(_pPageSetup->get_left_margin(unit_points), _pPageSetup->get_top_margin(unit_points));
+    PangoContext* pPangoContext = pango_cairo_create_context(cairo_context->cobj());
+    pango_cairo_context_set_resolution(pPangoContext, 72.0);
+    cairo_font_options_t* pFontOptions = cairo_font_options_create();
+    cairo_font_options_set_hint_metrics(pFontOptions, CAIRO_HINT_METRICS_OFF);
+    pango_cairo_context_set_font_options(pPangoContext, pFontOptions);
+    cairo_font_options_destroy(pFontOptions);
+    print_data.pango_context = Glib::wrap(pPangoContext);
+    _init_page_metrics(&print_data, 72.0, _pPageSetup->get_page_width(unit_points), _pPageSetup->get_page_height(unit_points));
+
+    // the total is unknown while drawing, so just the page number
+    int page_num{0};
+    auto f_draw_first_pages = [&](const int num_pages) {
+        for (int i = 0; i < num_pages; ++i) {
+            _draw_page(cairo_context, print_data.pages.get_page(i), std::to_string(++page_num), &print_data);
+            cairo_context->show_page();
+        }
+        print_data.pages.drop_first_pages(num_pages);
+    };
+    bool any_image_resized{false};
+    std::vector<CtPangoObjectPtr> node_slots;
+    while (f_next_node_slots(node_slots)) {
+        _process_slots(&print_data, node_slots, any_image_resized);
+        node_slots.clear();
+        if (print_data.pages.empty()) {
+            continue; // nothing laid out yet, empty node or selection
+        }
+        // only the last page can still receive content
+        f_draw_first_pages(print_data.pages.size() - 1);
+    }
+    f_draw_first_pages(print_data.pages.size());
+    pdf_surface->finish();
+    spdlog::debug("{} {} pages", __FUNCTION__, page_num);
+
+    if (any_image_resized) {
+        _pCtMainWin->get_status_bar().update_status(_get_images_resized_warning());
+    }
+}
+
 // Here we Compute the Lines Positions, the Number of Pages Needed and the Page Breaks
 void CtPrint::_on_begin_print_text(const Glib::RefPtr<Gtk::PrintContext>& context, CtPrintData* print_data)
+{
+    print_data->context = context;
+    _init_page_metrics(print_data, context->get_dpi_x(), context->get_width(), context->get_height());
+
+    bool any_image_resized{false};
+    _process_slots(print_data, print_data->slots, any_image_resized);
+
+    print_data->operation->set_n_pages(print_data->pages.size());
+    if (any_image_resized) {
+        print_data->warning = _get_images_resized_warning();
+    }
+}
+
+void CtPrint::_init_page_metrics(CtPrintData* print_data, const double dpi_x, const double page_width, const double page_height)
 {
     auto get_font_with_fallback_ = [](Pango::FontDescription font, const std::string& fallbackFont) {
 #ifdef _WIN32
@@ -589,7 +687,6 @@ void CtPrint::_on_begin_print_text(const Glib::RefPtr<Gtk::PrintContext>& contex
         return font;
     };
 
-    print_data->context = context;
     _rich_font = get_font_with_fallback_(Pango::FontDescription(_pCtConfig->rtFont), _pCtConfig->fallbackFontFamily);
     _plain_font = get_font_with_fallback_(Pango::FontDescription(_pCtConfig->ptFont), _pCtConfig->fallbackFontFamily);
     _code_font = get_font_with_fallback_(Pango::FontDescription(_pCtConfig->codeFont), "monospace");
@@ -598,19 +695,25 @@ void CtPrint::_on_begin_print_text(const Glib::RefPtr<Gtk::PrintContext>& contex
     _table_line_thickness = 6;
     // standard - 72, but MS print to pdf - 600
     // it helps to fix window pixels, otherwise images, etc will be too small
-    _page_dpi_scale = context->get_dpi_x() / 72.0; 
-    _page_width = context->get_width();
-    _page_height = context->get_height() * 1.02; // tolerance at bottom of the page
+    _page_dpi_scale = dpi_x / 72.0;
+    _page_width = page_width;
+    _page_height = page_height * 1.02; // tolerance at bottom of the page
+    if (_text_window_width <= 1) {
+        // the text view is not allocated when exporting from the command line
+        _text_window_width = _page_width / _page_dpi_scale;
+    }
     _layout_newline_height = [&](){
-        Glib::RefPtr<Pango::Layout> layout_newline = context->create_pango_layout();
+        Glib::RefPtr<Pango::Layout> layout_newline = _create_layout(print_data);
         layout_newline->set_font_description(_rich_font);
         layout_newline->set_width(int(_page_width * Pango::SCALE));
         layout_newline->set_markup(CtConst::CHAR_NEWLINE);
         return _get_width_height_from_layout_line(layout_newline->get_line(0)).height;
     }();
+}
 
-    bool any_image_resized{false};
-    for (auto slot : print_data->slots) {
+void CtPrint::_process_slots(CtPrintData* print_data, const std::vector<CtPangoObjectPtr>& slots, bool& any_image_resized)
+{
+    for (auto slot : slots) {
         if (dynamic_cast<CtPangoNewPage*>(slot.get())) {
             print_data->pages.new_page();
         }
@@ -629,12 +732,20 @@ void CtPrint::_on_begin_print_text(const Glib::RefPtr<Gtk::PrintContext>& contex
             }
         }
     }
+}
 
-    print_data->operation->set_n_pages(print_data->pages.size());
-    if (any_image_resized) {
-        print_data->warning = Glib::ustring(_("Warning: One or More Images Were Reduced to Enter the Page!")) + " ("
-                                       + std::to_string(static_cast<int>(_page_width))+ "x" + std::to_string(static_cast<int>(_page_height)) + ")";
+Glib::ustring CtPrint::_get_images_resized_warning()
+{
+    return Glib::ustring(_("Warning: One or More Images Were Reduced to Enter the Page!")) + " ("
+           + std::to_string(static_cast<int>(_page_width))+ "x" + std::to_string(static_cast<int>(_page_height)) + ")";
+}
+
+Glib::RefPtr<Pango::Layout> CtPrint::_create_layout(const CtPrintData* print_data)
+{
+    if (print_data->context) {
+        return print_data->context->create_pango_layout();
     }
+    return Pango::Layout::create(print_data->pango_context);
 }
 
 bool CtPrint::_cairo_tag_can_apply(const Glib::ustring& tag_name, const Glib::ustring& tag_attr, const CtPrintData* print_data)
@@ -642,11 +753,8 @@ bool CtPrint::_cairo_tag_can_apply(const Glib::ustring& tag_name, const Glib::us
     if (CAIRO_TAG_DEST == tag_name or not str::startswith(tag_attr, "dest=")) {
         return true;
     }
-    Glib::ustring tag_attr_dest = tag_attr.substr(5);
-    for (const Glib::ustring& curr_name : print_data->cairo_names) {
-        if (curr_name == tag_attr_dest) {
-            return true;
-        }
+    if (print_data->cairo_names.count(tag_attr.substr(5))) {
+        return true;
     }
     spdlog::debug("{} dropped", tag_attr.raw());
     return false;
@@ -654,13 +762,18 @@ bool CtPrint::_cairo_tag_can_apply(const Glib::ustring& tag_name, const Glib::us
 
 void CtPrint::_on_draw_page_text(const Glib::RefPtr<Gtk::PrintContext>& context, int page_nr, CtPrintData* print_data)
 {
-    auto operation = print_data->operation;
-    auto cairo_context = context->get_cairo_context();
+    const Glib::ustring page_num_str = std::to_string(page_nr+1) + "/" + std::to_string(print_data->operation->property_n_pages());
+    _draw_page(context->get_cairo_context(), print_data->pages.get_page(page_nr), page_num_str, print_data);
+}
 
+void CtPrint::_draw_page(Cairo::RefPtr<Cairo::Context> cairo_context,
+                         const CtPrintPages::CtPrintPage& page,
+                         const Glib::ustring& page_num_str,
+                         const CtPrintData* print_data)
+{
     // draw page number
     cairo_context->set_source_rgb(0.5, 0.5, 0.5);
-    Glib::ustring page_num_str = std::to_string(page_nr+1) + "/" + std::to_string(operation->property_n_pages());
-    Glib::RefPtr<Pango::Layout> layout = context->create_pango_layout();
+    Glib::RefPtr<Pango::Layout> layout = _create_layout(print_data);
     layout->set_font_description(_rich_font);
     layout->set_markup(page_num_str);
     auto layout_line = layout->get_line(0);
@@ -672,7 +785,6 @@ void CtPrint::_on_draw_page_text(const Glib::RefPtr<Gtk::PrintContext>& context,
     //cairo_context->rectangle(0, 0, _page_width, _page_height);
     //cairo_context->stroke();
 
-    auto& page = print_data->pages.get_page(page_nr);
     for (auto& line : page.lines) {
         for (CtPageElementPtr element : line.elements) {
             if (auto page_text = dynamic_cast<CtPageText*>(element.get())) {
@@ -732,7 +844,6 @@ void CtPrint::_on_draw_page_text(const Glib::RefPtr<Gtk::PrintContext>& context,
 
 void CtPrint::_process_pango_text(CtPrintData* print_data, CtPangoText* text_slot)
 {
-    auto context = print_data->context;
     CtPrintPages& pages = print_data->pages;
     Pango::FontDescription* font = [&]() {
         if (text_slot->synt_highl == CtConst::RICH_TEXT_ID) return &_rich_font;
@@ -748,7 +859,7 @@ void CtPrint::_process_pango_text(CtPrintData* print_data, CtPangoText* text_slo
     else if (auto pango_dest = dynamic_cast<CtPangoDest*>(text_slot)) {
         tag_name = CAIRO_TAG_DEST;
         tag_attr = pango_dest->dest;
-        print_data->cairo_names.push_back(tag_attr.substr(5)); // name='...'
+        print_data->cairo_names.insert(tag_attr.substr(5)); // name='...'
     }
 
     if (not pages.last_line().evaluated_pango_dir) {
@@ -772,7 +883,7 @@ void CtPrint::_process_pango_text(CtPrintData* print_data, CtPangoText* text_slo
         }
     }
 
-    Glib::RefPtr<Pango::Layout> layout = context->create_pango_layout();
+    Glib::RefPtr<Pango::Layout> layout = _create_layout(print_data);
     layout->set_font_description(*font);
     const int max_layout_line_width = _page_width - text_slot->indent;
     layout->set_width(max_layout_line_width * Pango::SCALE);
@@ -859,9 +970,10 @@ void CtPrint::_process_pango_text(CtPrintData* print_data, CtPangoText* text_slo
 
 void CtPrint::_process_pango_image(CtPrintData* print_data, const CtImage* image, const CtPangoWidget* pango_widget, bool& any_image_resized)
 {
-    auto context = print_data->context;
     CtPrintPages& pages = print_data->pages;
-    auto pixbuf = image->get_pixbuf();
+    int pixbuf_w{0};
+    int pixbuf_h{0};
+    image->get_pixbuf_size(pixbuf_w, pixbuf_h);
 
     for (int i = 0; i < 2; ++i) {
         // first loop we try and fit the image in line with existing text
@@ -900,24 +1012,24 @@ void CtPrint::_process_pango_image(CtPrintData* print_data, const CtImage* image
             }
         }
         // calculate image
-        const double scale_w = available_width / (pixbuf->get_width() * _page_dpi_scale);
+        const double scale_w = available_width / (pixbuf_w * _page_dpi_scale);
         if (0 == i and scale_w < 1.0 and available_width < (_page_width - pango_widget->indent)) {
             pages.new_line();
             continue; // restart loop from a new line
         }
-        double scale_h = (_page_height - _layout_newline_height - (CtConst::WHITE_SPACE_BETW_PIXB_AND_TEXT * _page_dpi_scale)) / (pixbuf->get_height() * _page_dpi_scale);
+        double scale_h = (_page_height - _layout_newline_height - (CtConst::WHITE_SPACE_BETW_PIXB_AND_TEXT * _page_dpi_scale)) / (pixbuf_h * _page_dpi_scale);
         double scale = std::min(scale_w, scale_h);
         if (scale > 1.0) scale = 1.0;
         if (scale < 1.0) any_image_resized = true;
 
         scale *= _page_dpi_scale; // need to compensate high dpi
 
-        double pixbuf_width = pixbuf->get_width() * scale;
-        double pixbuf_height = pixbuf->get_height() * scale + (CtConst::WHITE_SPACE_BETW_PIXB_AND_TEXT * _page_dpi_scale);
+        double pixbuf_width = pixbuf_w * scale;
+        double pixbuf_height = pixbuf_h * scale + (CtConst::WHITE_SPACE_BETW_PIXB_AND_TEXT * _page_dpi_scale);
 
         // calculate label if it exists
         Cairo::Rectangle label_size{0,0,0,0};
-        Glib::RefPtr<Pango::Layout> label_layout = context->create_pango_layout();
+        Glib::RefPtr<Pango::Layout> label_layout = _create_layout(print_data);
         label_layout->set_font_description(_plain_font);
         if (auto emb_file = dynamic_cast<const CtImageEmbFile*>(image)) {
             label_layout->set_markup("<b><small>"+str::xml_escape(emb_file->get_file_name().string())+"</small></b>");
@@ -967,7 +1079,6 @@ void CtPrint::_process_pango_image(CtPrintData* print_data, const CtImage* image
 
 void CtPrint::_process_pango_codebox(CtPrintData* print_data, const CtCodebox* codebox, const CtPangoWidget* pango_widget)
 {
-    auto context = print_data->context;
     CtPrintPages& pages = print_data->pages;
 
     Glib::ustring original_content = CtExport2Pango{_pCtMainWin}.pango_get_from_code_buffer(
@@ -1020,7 +1131,7 @@ void CtPrint::_process_pango_codebox(CtPrintData* print_data, const CtCodebox* c
         }
 
         // use content if it's ok
-        auto codebox_layout = _codebox_get_layout(codebox, original_content, context, codebox_width);
+        auto codebox_layout = _codebox_get_layout(codebox, original_content, print_data, codebox_width);
         double codebox_height = _get_height_from_layout(codebox_layout);
         if (pages.last_line().test_element_height(codebox_height + (BOX_OFFSET * _page_dpi_scale), _page_height)) {
 
@@ -1041,12 +1152,12 @@ void CtPrint::_process_pango_codebox(CtPrintData* print_data, const CtCodebox* c
 
         // if content is too long, split it
         Glib::ustring first_split, second_split;
-        _codebox_split_content(codebox, original_content, _page_height - pages.last_line().y, context, first_split, second_split, codebox_width);
+        _codebox_split_content(codebox, original_content, _page_height - pages.last_line().y, print_data, first_split, second_split, codebox_width);
         if (first_split.empty()) {
             pages.new_page(); // need a new page
         }
         else {
-            auto first_split_layout = _codebox_get_layout(codebox, first_split, context, codebox_width);
+            auto first_split_layout = _codebox_get_layout(codebox, first_split, print_data, codebox_width);
             double codebox_height = _get_height_from_layout(first_split_layout);
 
             if (PANGO_DIRECTION_RTL == pango_widget->pango_dir) {
@@ -1068,10 +1179,10 @@ void CtPrint::_process_pango_codebox(CtPrintData* print_data, const CtCodebox* c
 
 Glib::RefPtr<Pango::Layout> CtPrint::_codebox_get_layout(const CtCodebox* codebox,
                                                          Glib::ustring content,
-                                                         Glib::RefPtr<Gtk::PrintContext> context,
+                                                         const CtPrintData* print_data,
                                                          const int codebox_width)
 {
-    Glib::RefPtr<Pango::Layout> layout = context->create_pango_layout();
+    Glib::RefPtr<Pango::Layout> layout = _create_layout(print_data);
     layout->set_font_description(codebox->get_syntax_highlighting() != CtConst::PLAIN_TEXT_ID ? _code_font : _plain_font);
     layout->set_width(int(codebox_width * Pango::SCALE));
 #if GTKMM_MAJOR_VERSION >= 4
@@ -1087,7 +1198,7 @@ Glib::RefPtr<Pango::Layout> CtPrint::_codebox_get_layout(const CtCodebox* codebo
 void CtPrint::_codebox_split_content(const CtCodebox* codebox,
                                      Glib::ustring original_content,
                                      const int check_height,
-                                     const Glib::RefPtr<Gtk::PrintContext>& context,
+                                     const CtPrintData* print_data,
                                      Glib::ustring& first_split,
                                      Glib::ustring& second_split,
                                      const int codebox_width)
@@ -1115,7 +1226,7 @@ void CtPrint::_codebox_split_content(const CtCodebox* codebox,
     while (splitted_pango.size() < original_splitted_pango_size) {
         splitted_pango.push_back(original_splitted_pango[splitted_pango.size()]);
         Glib::ustring new_content = str::join(splitted_pango, CtConst::CHAR_NEWLINE);
-        Glib::RefPtr<Pango::Layout> codebox_layout = _codebox_get_layout(codebox, new_content, context, codebox_width);
+        Glib::RefPtr<Pango::Layout> codebox_layout = _codebox_get_layout(codebox, new_content, print_data, codebox_width);
         const double codebox_height = _get_height_from_layout(codebox_layout);
         if ((codebox_height + BOX_OFFSET) > check_height) {
             if (1u == splitted_pango.size()) {
@@ -1138,7 +1249,6 @@ void CtPrint::_process_pango_table(CtPrintData *print_data,
                                    const CtTableCommon* table,
                                    const CtPangoWidget* pango_widget)
 {
-    auto context = print_data->context;
     CtPrintPages& pages = print_data->pages;
 
     int first_row = 1;
@@ -1193,7 +1303,7 @@ void CtPrint::_process_pango_table(CtPrintData *print_data,
 
         // use table is length is ok
         std::vector<double> rows_h, cols_w;
-        auto table_layouts = _table_get_layouts(table, first_row, -1, context);
+        auto table_layouts = _table_get_layouts(table, first_row, -1, print_data);
         _table_get_grid(table_layouts, table->get_col_widths(), rows_h, cols_w);
         double table_height = _table_get_width_height(rows_h);
         if (pages.last_line().test_element_height(table_height + (BOX_OFFSET * _page_dpi_scale), _page_height)) {
@@ -1214,12 +1324,12 @@ void CtPrint::_process_pango_table(CtPrintData *print_data,
         }
 
         // if table is too long, split it
-        int split_row = _table_split_content(table, first_row, _page_height - pages.last_line().y - (BOX_OFFSET * _page_dpi_scale), context);
+        int split_row = _table_split_content(table, first_row, _page_height - pages.last_line().y - (BOX_OFFSET * _page_dpi_scale), print_data);
         if (split_row == -1) {
             pages.new_page(); // need a new page
         }
         else {
-            auto split_layouts = _table_get_layouts(table, first_row, split_row, context);
+            auto split_layouts = _table_get_layouts(table, first_row, split_row, print_data);
             _table_get_grid(split_layouts, table->get_col_widths(), rows_h, cols_w);
             double table_height = _table_get_width_height(rows_h);
 
@@ -1243,7 +1353,7 @@ void CtPrint::_process_pango_table(CtPrintData *print_data,
 CtPageTable::TableLayouts CtPrint::_table_get_layouts(const CtTableCommon* table,
                                                       const int first_row,
                                                       const int last_row,
-                                                      const Glib::RefPtr<Gtk::PrintContext>& context)
+                                                      const CtPrintData* print_data)
 {
     std::vector<std::vector<Glib::ustring>> rows;
     table->write_strings_matrix(rows);
@@ -1256,7 +1366,7 @@ CtPageTable::TableLayouts CtPrint::_table_get_layouts(const CtTableCommon* table
         for (size_t c = 0u; c < rows.at(r).size(); ++c) {
             Glib::ustring text = str::xml_escape(rows.at(r).at(c));
             if (r == 0) text = "<b>" + text + "</b>";
-            Glib::RefPtr<Pango::Layout> cell_layout = context->create_pango_layout();
+            Glib::RefPtr<Pango::Layout> cell_layout = _create_layout(print_data);
             cell_layout->set_font_description(_rich_font);
             cell_layout->set_width(int((table->get_col_width(c) * _page_dpi_scale) * Pango::SCALE));
 #if GTKMM_MAJOR_VERSION >= 4
@@ -1306,12 +1416,12 @@ double CtPrint::_table_get_width_height(std::vector<double>& data)
 int CtPrint::_table_split_content(const CtTableCommon* table,
                                   const int start_row,
                                   const int check_height,
-                                  const Glib::RefPtr<Gtk::PrintContext>& context)
+                                  const CtPrintData* print_data)
 {
     int last_row = start_row;
     for (; last_row < (int)table->get_num_rows(); ++last_row) {
         std::vector<double> rows_h, cols_w;
-        auto table_layouts = _table_get_layouts(table, start_row, last_row, context);
+        auto table_layouts = _table_get_layouts(table, start_row, last_row, print_data);
         _table_get_grid(table_layouts, table->get_col_widths(), rows_h, cols_w);
         double table_height = _table_get_width_height(rows_h);
         if (table_height > check_height) {
@@ -26,6 +26,8 @@
 #include "ct_main_win.h"
 #include "ct_dialogs.h"
 #include <iterator>
+#include <functional>
+#include <set>
 
 struct CtPangoObject
 {
@@ -139,9 +141,17 @@ public:
                            const CtExportOptions& options);
 
 private:
-    void             _nodes_all_export_print_iter(CtTreeIter tree_iter,
-                                                  const CtExportOptions& options,
-                                                  std::vector<CtPangoObjectPtr>& tree_pango_slots);
+    void             _nodes_all_collect_iter(CtTreeIter tree_iter, std::list<CtTreeIter>& tree_iters);
+    void             _nodes_export_print(const fs::path& pdf_filepath,
+                                         const std::list<CtTreeIter>& tree_iters,
+                                         const CtExportOptions& options,
+                                         const int sel_start,
+                                         const int sel_end);
+    void             _node_get_pango_slots(CtTreeIter tree_iter,
+                                           const CtExportOptions& options,
+                                           const int sel_start,
+                                           const int sel_end,
+                                           std::vector<CtPangoObjectPtr>& out_slots);
     CtPangoObjectPtr _generate_pango_node_name(CtTreeIter tree_iter);
 
 private:
@@ -254,11 +264,13 @@ struct CtPrintPages
 
 public:
     int          size()          { return static_cast<int>(_pages.size()); }
+    bool         empty()         { return _pages.empty(); }
     CtPrintPage& get_page(int i) { return _pages[i]; }
     CtPrintPage& last_page()     { return _pages.back(); }
     CtPageLine&  last_line()     { return _pages.back().lines.back(); }
     void         new_page()      { _pages.emplace_back(CtPrintPage{});  }
     void         new_line()      { last_page().lines.emplace_back(CtPageLine{last_line().y + 2}); }
+    void         drop_first_pages(const int num) { _pages.erase(_pages.begin(), _pages.begin() + num); }
     void         line_on_new_page() {
         CtPageLine line = last_line();
         new_page();
@@ -277,11 +289,12 @@ struct CtPrintData
 
     Glib::RefPtr<Gtk::PrintOperation>  operation;
     Glib::RefPtr<Gtk::PrintContext>    context;
+    Glib::RefPtr<Pango::Context>       pango_context; // pdf stream, without print context
 
     CtPrintPages                       pages;
     Glib::ustring                      warning;
 
-    std::list<Glib::ustring>           cairo_names;
+    std::set<Glib::ustring>            cairo_names;
 };
 
 class CtPrint
@@ -296,12 +309,24 @@ public:
 public:
     void run_page_setup_dialog(Gtk::Window* pMainWin);
     void print_text(const fs::path& pdf_filepath, const std::vector<CtPangoObjectPtr>& slots);
+    void print_pdf_stream(const fs::path& pdf_filepath,
+                          const std::set<Glib::ustring>& dest_names,
+                          const std::function<bool(std::vector<CtPangoObjectPtr>&)>& f_next_node_slots);
 
 private:
     void _on_begin_print_text(const Glib::RefPtr<Gtk::PrintContext>& context, CtPrintData* print_data);
     void _on_draw_page_text(const Glib::RefPtr<Gtk::PrintContext>& context, int page_nr, CtPrintData* print_data);
     bool _cairo_tag_can_apply(const Glib::ustring& tag_name, const Glib::ustring& tag_attr, const CtPrintData* print_data);
 
+    void _init_page_metrics(CtPrintData* print_data, const double dpi_x, const double page_width, const double page_height);
+    void _process_slots(CtPrintData* print_data, const std::vector<CtPangoObjectPtr>& slots, bool& any_image_resized);
+    void _draw_page(Cairo::RefPtr<Cairo::Context> cairo_context,
+                    const CtPrintPages::CtPrintPage& page,
+                    const Glib::ustring& page_num_str,
+                    const CtPrintData* print_data);
+    Glib::RefPtr<Pango::Layout> _create_layout(const CtPrintData* print_data);
+    Glib::ustring               _get_images_resized_warning();
+
 private:
     void _process_pango_text(CtPrintData* print_data, CtPangoText* text_slot);
     void _process_pango_image(CtPrintData* print_data, const CtImage* image, const CtPangoWidget* pango_widget, bool& any_image_resized);
@@ -310,12 +335,12 @@ private:
 
     Glib::RefPtr<Pango::Layout> _codebox_get_layout(const CtCodebox* codebox,
                                                     Glib::ustring content,
-                                                    Glib::RefPtr<Gtk::PrintContext> context,
+                                                    const CtPrintData* print_data,
                                                     const int codebox_width);
     void                        _codebox_split_content(const CtCodebox* codebox,
                                                        Glib::ustring original_content,
                                                        const int check_height,
-                                                       const Glib::RefPtr<Gtk::PrintContext>& context,
+                                                       const CtPrintData* print_data,
                                                        Glib::ustring& first_split,
                                                        Glib::ustring& second_split,
                                                        const int codebox_width);
@@ -323,7 +348,7 @@ private:
     CtPageTable::TableLayouts   _table_get_layouts(const CtTableCommon* table,
                                                    const int first_row,
                                                    const int last_row,
-                                                   const Glib::RefPtr<Gtk::PrintContext>& context);
+                                                   const CtPrintData* print_data);
     void                        _table_get_grid(const CtPageTable::TableLayouts& table_layouts,
                                                 const CtTableColWidths& col_widths,
                                                 std::vector<double>& rows_h,
@@ -332,7 +357,7 @@ private:
     int                         _table_split_content(const CtTableCommon* table,
                                                      const int start_row,
                                                      const int check_height,
-                                                     const Glib::RefPtr<Gtk::PrintContext>& context);
+                                                     const CtPrintData* print_data);
 
     void _draw_codebox_box(Cairo::RefPtr<Cairo::Context> cairo_context, double x0, double y0, double codebox_width, double codebox_height);
     void _draw_codebox_code(Cairo::RefPtr<Cairo::Context> cairo_context, Glib::RefPtr<Pango::Layout> codebox_layout, double x0, double y0);
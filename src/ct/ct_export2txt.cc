@@ -23,6 +23,9 @@
 
 #include "ct_export2txt.h"
 #include "ct_main_win.h"
+#include "ct_logging.h"
+#include "ct_links_index.h"
+#include <fstream>
 
 CtExport2Txt::CtExport2Txt(CtMainWin* pCtMainWin)
  : _pCtMainWin(pCtMainWin)
@@ -43,6 +46,10 @@ Glib::ustring CtExport2Txt::node_export_to_txt(CtTreeIter tree_iter, fs::path fi
         }
         plain_text += CtConst::CHAR_SPACE + tree_iter.get_node_name() + CtConst::CHAR_NEWLINE;
     }
+    if (not filepath.empty() and not tree_iter.get_node_is_rich_text() and _pCtMainWin->text_buffer_is_large(pTextBuffer)) {
+        _large_node_stream_to_txt(pTextBuffer, filepath, plain_text, sel_start, sel_end);
+        return Glib::ustring{};
+    }
     plain_text += selection_export_to_txt(tree_iter, pTextBuffer, sel_start, sel_end, false);
     plain_text += str::repeat(CtConst::CHAR_NEWLINE, 2);
     if (not filepath.empty()) {
@@ -51,6 +58,31 @@ Glib::ustring CtExport2Txt::node_export_to_txt(CtTreeIter tree_iter, fs::path fi
     return plain_text;
 }
 
+// Write a large plain text or code node to the file a slice at a time
+void CtExport2Txt::_large_node_stream_to_txt(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer,
+                                             const fs::path& filepath,
+                                             const Glib::ustring& header,
+                                             const int sel_start,
+                                             const int sel_end)
+{
+    std::ofstream ofs{filepath.string(), std::ios::binary};
+    auto f_write = [&ofs](const Glib::ustring& text){
+#if defined(_WIN32)
+        ofs << str::replace(text.raw(), "\n", "\r\n");
+#else
+        ofs << text.raw();
+#endif
+    };
+    f_write(header);
+    CtTextIterUtil::text_for_each_chunk(sel_start >= 0 ? pTextBuffer->get_iter_at_offset(sel_start) : pTextBuffer->begin(),
+                                        sel_end >= 0 ? pTextBuffer->get_iter_at_offset(sel_end) : pTextBuffer->end(),
+                                        f_write);
+    f_write(str::repeat(CtConst::CHAR_NEWLINE, 2));
+    if (not ofs) {
+        spdlog::error("!! {} {}", __FUNCTION__, filepath.string());
+    }
+}
+
 // Export All Nodes To Txt
 void CtExport2Txt::nodes_all_export_to_txt(bool all_tree, fs::path export_dir, fs::path single_txt_filepath, CtExportOptions export_options)
 {
@@ -170,10 +202,7 @@ Glib::ustring CtExport2Txt::_plain_process_slot(int start_offset, int end_offset
 // Check for tag link in given_iter
 Glib::ustring CtExport2Txt::_tag_link_in_given_iter(Gtk::TextIter iter)
 {
-    for (auto tag: iter.get_tags())
-        if (str::startswith(tag->property_name().get_value(), CtConst::TAG_LINK_PREFIX))
-            return tag->property_name().get_value().substr(5);
-    return "";
+    return CtLinksIndex::get_target_at(iter);
 }
 
 
@@ -36,6 +36,7 @@ public:
     CtExport2Txt(CtMainWin* pCtMainWin);
 
 public:
+    // the text of a large plain text or code node written to filepath is not also returned
     Glib::ustring node_export_to_txt(CtTreeIter tree_iter, fs::path filepath, CtExportOptions export_options, int sel_start, int sel_end);
     void          nodes_all_export_to_txt(bool all_tree, fs::path export_dir, fs::path single_txt_filepath, CtExportOptions export_options);
     Glib::ustring selection_export_to_txt(CtTreeIter tree_iter, Glib::RefPtr<Gtk::TextBuffer> text_buffer, int sel_start, int sel_end, bool check_link_target);
@@ -45,6 +46,11 @@ public:
     Glib::ustring get_latex_plain(CtImageLatex* latex);
 
 private:
+    void          _large_node_stream_to_txt(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer,
+                                            const fs::path& filepath,
+                                            const Glib::ustring& header,
+                                            const int sel_start,
+                                            const int sel_end);
     Glib::ustring _plain_process_slot(int start_offset, int end_offset, Glib::RefPtr<Gtk::TextBuffer> curr_buffer, bool check_link_target);
     Glib::ustring _tag_link_in_given_iter(Gtk::TextIter iter);
 
@@ -0,0 +1,191 @@
+/*
+ * ct_fuzzy_index.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_fuzzy_index.h"
+#include "ct_misc_utils.h"
+#include <algorithm>
+
+void CtFuzzyIndex::clear()
+{
+    _entries.clear();
+    _trigrams.clear();
+    _wordCandidates.clear();
+}
+
+size_t CtFuzzyIndex::add(const gint64 id, const Glib::ustring& label, const Glib::ustring& path)
+{
+    const uint32_t idx = _entries.size();
+    Entry entry{id, label, path, label.casefold().raw(), path.casefold().raw(), ""};
+    entry.search_cf = entry.label_cf + '\n' + entry.path_cf;
+    _entries.push_back(std::move(entry));
+    const std::string& search_cf = _entries.back().search_cf;
+    for (size_t i = 0; i + 3 <= search_cf.size(); ++i) {
+        std::vector<uint32_t>& postings = _trigrams[_trigram_key(search_cf.c_str() + i)];
+        if (postings.empty() or postings.back() != idx) {
+            postings.push_back(idx);
+        }
+    }
+    _wordCandidates.clear();
+    return idx;
+}
+
+/*static*/Glib::ustring CtFuzzyIndex::normalise_filter(const Glib::ustring& raw_filter)
+{
+    Glib::ustring filter;
+    bool prev_space{false};
+    for (const gunichar ch : str::trim(raw_filter)) {
+        const bool is_space = g_unichar_isspace(ch);
+        if (not is_space or not prev_space) {
+            filter += is_space ? ' ' : ch;
+        }
+        prev_space = is_space;
+    }
+    return filter.casefold();
+}
+
+/*static*/std::vector<Glib::ustring> CtFuzzyIndex::get_filter_words(const Glib::ustring& filter)
+{
+    std::vector<Glib::ustring> filter_words;
+    for (const Glib::ustring& word : str::split(filter, " ")) {
+        if (not word.empty()) {
+            filter_words.push_back(word);
+        }
+    }
+    return filter_words;
+}
+
+std::vector<uint32_t> CtFuzzyIndex::_get_word_candidates(const std::string& word)
+{
+    const auto itCached = _wordCandidates.find(word);
+    if (itCached != _wordCandidates.end()) {
+        return itCached->second;
+    }
+    std::vector<uint32_t> candidates;
+    const std::vector<uint32_t>* pNarrowFrom{nullptr};
+    // the query being typed, the previous candidates of a shorter word are a superset
+    for (size_t len = word.size() - 1; len > 0 and not pNarrowFrom; --len) {
+        const auto itPrefix = _wordCandidates.find(word.substr(0, len));
+        if (itPrefix != _wordCandidates.end()) {
+            pNarrowFrom = &itPrefix->second;
+        }
+    }
+    std::vector<uint32_t> trigram_candidates;
+    if (not pNarrowFrom and word.size() >= 3) {
+        // start from the rarest trigram of the word
+        const std::vector<uint32_t>* pRarest{nullptr};
+        for (size_t i = 0; i + 3 <= word.size(); ++i) {
+            const auto itTrigram = _trigrams.find(_trigram_key(word.c_str() + i));
+            if (itTrigram == _trigrams.end()) {
+                _wordCandidates[word] = candidates;
+                return candidates;
+            }
+            if (not pRarest or itTrigram->second.size() < pRarest->size()) {
+                pRarest = &itTrigram->second;
+            }
+        }
+        trigram_candidates = *pRarest;
+        pNarrowFrom = &trigram_candidates;
+    }
+    if (pNarrowFrom) {
+        for (const uint32_t idx : *pNarrowFrom) {
+            if (_entries[idx].search_cf.find(word) != std::string::npos) {
+                candidates.push_back(idx);
+            }
+        }
+    }
+    else {
+        for (uint32_t idx = 0; idx < _entries.size(); ++idx) {
+            if (_entries[idx].search_cf.find(word) != std::string::npos) {
+                candidates.push_back(idx);
+            }
+        }
+    }
+    _wordCandidates[word] = candidates;
+    return candidates;
+}
+
+int CtFuzzyIndex::_get_score(const Entry& entry, const std::string& filter, const std::vector<std::string>& words) const
+{
+    if (str::startswith(entry.label_cf, filter)) return 0;
+    if (entry.label_cf.find(filter) != std::string::npos) return 1;
+    if (CtStrUtil::contains_words(entry.label_cf, words)) return 2;
+    if (CtStrUtil::contains_words(entry.label_cf, words, false/*require_all*/)) return 3;
+    if (CtStrUtil::contains_words(entry.path_cf, words)) return 4;
+    if (CtStrUtil::contains_words(entry.path_cf, words, false/*require_all*/)) return 5;
+    return -1;
+}
+
+std::vector<CtFuzzyIndex::Match> CtFuzzyIndex::query(const Glib::ustring& filter, const size_t max_results)
+{
+    std::vector<Match> matches;
+    const std::string filter_cf = normalise_filter(filter).raw();
+    std::vector<std::string> words;
+    for (const Glib::ustring& word : get_filter_words(filter_cf)) {
+        words.push_back(word.raw());
+    }
+    if (words.empty()) {
+        for (size_t idx = 0; idx < _entries.size() and matches.size() < max_results; ++idx) {
+            matches.push_back(Match{idx, 0});
+        }
+        return matches;
+    }
+
+    // an entry is a match if at least one word is in its label or path
+    std::vector<uint32_t> union_candidates;
+    for (const std::string& word : words) {
+        const std::vector<uint32_t> word_candidates = _get_word_candidates(word);
+        std::vector<uint32_t> merged;
+        merged.reserve(union_candidates.size() + word_candidates.size());
+        std::set_union(union_candidates.begin(), union_candidates.end(),
+                       word_candidates.begin(), word_candidates.end(),
+                       std::back_inserter(merged));
+        union_candidates.swap(merged);
+    }
+    // keep the candidates of the current words and of their prefixes (backspace)
+    for (auto it = _wordCandidates.begin(); it != _wordCandidates.end();) {
+        const bool in_use = std::any_of(words.begin(), words.end(), [&](const std::string& word){
+            return str::startswith(word, it->first);
+        });
+        if (in_use) ++it;
+        else it = _wordCandidates.erase(it);
+    }
+
+    matches.reserve(union_candidates.size());
+    for (const uint32_t idx : union_candidates) {
+        const int score = _get_score(_entries[idx], filter_cf, words);
+        if (score >= 0) {
+            matches.push_back(Match{idx, score});
+        }
+    }
+    auto f_better = [](const Match& lhs, const Match& rhs) {
+        return lhs.score != rhs.score ? lhs.score < rhs.score : lhs.idx < rhs.idx;
+    };
+    if (matches.size() > max_results) {
+        std::partial_sort(matches.begin(), matches.begin() + max_results, matches.end(), f_better);
+        matches.resize(max_results);
+    }
+    else {
+        std::sort(matches.begin(), matches.end(), f_better);
+    }
+    return matches;
+}
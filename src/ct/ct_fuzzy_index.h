@@ -0,0 +1,76 @@
+/*
+ * ct_fuzzy_index.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <glibmm/ustring.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Index of labels and hierarchical paths for the quick selection dialogs (go to node, command palette).
+// Casefolded text is computed once and the entries are pre-filtered by trigrams, then the candidates
+// of every query word are kept so that extending the query only narrows the previous candidates.
+class CtFuzzyIndex
+{
+public:
+    struct Match {
+        size_t idx;
+        int    score; // 0 label starts with filter .. 5 path contains any word
+    };
+
+    void   clear();
+    void   reserve(const size_t num_entries) { _entries.reserve(num_entries); }
+    size_t add(const gint64 id, const Glib::ustring& label, const Glib::ustring& path);
+    size_t size() const { return _entries.size(); }
+
+    gint64               get_id(const size_t idx) const { return _entries.at(idx).id; }
+    const Glib::ustring& get_label(const size_t idx) const { return _entries.at(idx).label; }
+    const Glib::ustring& get_path(const size_t idx) const { return _entries.at(idx).path; }
+
+    // best matches first (lower score, then insertion order), at most max_results
+    std::vector<Match> query(const Glib::ustring& filter, const size_t max_results);
+
+    static Glib::ustring              normalise_filter(const Glib::ustring& raw_filter);
+    static std::vector<Glib::ustring> get_filter_words(const Glib::ustring& filter);
+
+private:
+    struct Entry {
+        gint64        id;
+        Glib::ustring label;
+        Glib::ustring path;
+        std::string   label_cf;
+        std::string   path_cf;
+        std::string   search_cf; // label_cf + '\n' + path_cf
+    };
+
+    static uint32_t _trigram_key(const char* p) {
+        return (uint32_t)(uint8_t)p[0] << 16 | (uint32_t)(uint8_t)p[1] << 8 | (uint32_t)(uint8_t)p[2];
+    }
+    std::vector<uint32_t> _get_word_candidates(const std::string& word);
+    int                   _get_score(const Entry& entry, const std::string& filter, const std::vector<std::string>& words) const;
+
+    std::vector<Entry>                                     _entries;
+    std::unordered_map<uint32_t, std::vector<uint32_t>>    _trigrams;        // search_cf trigram -> sorted entries
+    std::unordered_map<std::string, std::vector<uint32_t>> _wordCandidates;  // from the previous queries
+};
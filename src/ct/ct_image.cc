@@ -28,29 +28,103 @@
 #include "ct_logging.h"
 #include "ct_storage_control.h"
 #include "ct_storage_multifile.h"
+#include "ct_task_pool.h"
 #include <regex>
+#include <unordered_map>
 
-CtImage::CtImage(CtMainWin* pCtMainWin,
-                 const std::string& rawBlob,
-                 const char* mimeType,
-                 const int charOffset,
-                 const std::string& justification)
- : CtAnchoredWidget{pCtMainWin, charOffset, justification}
+namespace {
+
+Glib::RefPtr<Gdk::Pixbuf> decode_png(const std::string& rawBlob)
 {
-    Glib::RefPtr<Gdk::PixbufLoader> rPixbufLoader = Gdk::PixbufLoader::create(mimeType, true);
-    rPixbufLoader->write(reinterpret_cast<const guint8*>(rawBlob.c_str()), rawBlob.size());
-    rPixbufLoader->close();
-    _rPixbuf = rPixbufLoader->get_pixbuf();
+    try {
+        Glib::RefPtr<Gdk::PixbufLoader> rPixbufLoader = Gdk::PixbufLoader::create("image/png", true);
+        rPixbufLoader->write(reinterpret_cast<const guint8*>(rawBlob.c_str()), rawBlob.size());
+        rPixbufLoader->close();
+        return rPixbufLoader->get_pixbuf();
+    }
+    catch (Glib::Error& error) {
+        spdlog::error("!! {} {}", __FUNCTION__, std::string(error.what()));
+    }
+    return Glib::RefPtr<Gdk::Pixbuf>{};
+}
 
-    _image.set(_rPixbuf);
-#if GTKMM_MAJOR_VERSION >= 4
-    _frame.set_child(_image);
-#else
-    _frame.add(_image);
-    show_all();
-#endif
+// width and height from the IHDR chunk, that follows the signature
+bool get_png_size(const std::string& rawBlob, int& width, int& height)
+{
+    if (rawBlob.size() < 24u or
+        0 != rawBlob.compare(0, 8, "\x89PNG\r\n\x1a\n") or
+        0 != rawBlob.compare(12, 4, "IHDR"))
+    {
+        return false;
+    }
+    auto f_be32 = [&rawBlob](const size_t pos)->int{
+        return static_cast<int>(static_cast<guint32>(static_cast<guint8>(rawBlob[pos])) << 24 |
+                                static_cast<guint32>(static_cast<guint8>(rawBlob[pos+1])) << 16 |
+                                static_cast<guint32>(static_cast<guint8>(rawBlob[pos+2])) << 8 |
+                                static_cast<guint32>(static_cast<guint8>(rawBlob[pos+3])));
+    };
+    width = f_be32(16);
+    height = f_be32(20);
+    return width > 0 and height > 0;
 }
 
+} // namespace (anonymous)
+
+// Decodes the png images on the task pool, the results are handed back on the GUI thread
+// to the images still waiting for them. Push and forget are to be called from the GUI thread.
+class CtImageDecoder
+{
+public:
+    static CtImageDecoder& get()
+    {
+        static CtImageDecoder decoder;
+        return decoder;
+    }
+
+    size_t push(CtImagePng* pImagePng, std::shared_ptr<const std::string> pRawBlob)
+    {
+        const size_t ticket = _nextTicket++;
+        CtTaskPool::CancelToken cancelToken;
+        _waiting.emplace(ticket, Waiting{pImagePng, cancelToken});
+        auto pDecoded = std::make_shared<Glib::RefPtr<Gdk::Pixbuf>>();
+        CtTaskPool::get().submit_then(
+            [pRawBlob, pDecoded](){ *pDecoded = decode_png(*pRawBlob); },
+            [this, ticket, pDecoded](){ _on_decoded(ticket, *pDecoded); },
+            CtTaskPool::Priority::Normal,
+            cancelToken);
+        return ticket;
+    }
+
+    void forget(const size_t ticket)
+    {
+        const auto it = _waiting.find(ticket);
+        if (it != _waiting.end()) {
+            it->second.cancelToken.cancel();
+            _waiting.erase(it);
+        }
+    }
+
+private:
+    struct Waiting
+    {
+        CtImagePng*             pImagePng;
+        CtTaskPool::CancelToken cancelToken;
+    };
+
+    void _on_decoded(const size_t ticket, const Glib::RefPtr<Gdk::Pixbuf>& rPixbuf)
+    {
+        const auto it = _waiting.find(ticket);
+        if (it != _waiting.end()) {
+            CtImagePng* pImagePng = it->second.pImagePng;
+            _waiting.erase(it);
+            pImagePng->_set_decoded_pixbuf(rPixbuf);
+        }
+    }
+
+    std::unordered_map<size_t, Waiting> _waiting;
+    size_t _nextTicket{1};
+};
+
 CtImage::CtImage(CtMainWin* pCtMainWin,
                  const char* stockImage,
                  const int size,
@@ -96,7 +170,7 @@ CtImage::CtImage(CtMainWin* pCtMainWin,
 
 void CtImage::save(const fs::path& file_name, const Glib::ustring& type)
 {
-    _rPixbuf->save(file_name.string(), type);
+    get_pixbuf()->save(file_name.string(), type);
 }
 
 CtImagePng::CtImagePng(CtMainWin* pCtMainWin,
@@ -104,9 +178,31 @@ CtImagePng::CtImagePng(CtMainWin* pCtMainWin,
                        const Glib::ustring& link,
                        const int charOffset,
                        const std::string& justification)
- : CtImage{pCtMainWin, rawBlob, "image/png", charOffset, justification}
+ : CtImagePng{pCtMainWin, std::make_shared<const std::string>(rawBlob), link, charOffset, justification}
+{
+}
+
+CtImagePng::CtImagePng(CtMainWin* pCtMainWin,
+                       std::shared_ptr<const std::string> pRawBlob,
+                       const Glib::ustring& link,
+                       const int charOffset,
+                       const std::string& justification)
+ : CtImage{pCtMainWin, Glib::RefPtr<Gdk::Pixbuf>{}, charOffset, justification}
  , _link{link}
+ , _pRawBlob{std::move(pRawBlob)}
 {
+    int width{0};
+    int height{0};
+    if (get_png_size(*_pRawBlob, width, height)) {
+        // placeholder of the right size until decoded
+        _image.set_size_request(width, height);
+        _mapConnection = _image.signal_map().connect(sigc::mem_fun(*this, &CtImagePng::_on_image_map));
+        _unmapConnection = _image.signal_unmap().connect(sigc::mem_fun(*this, &CtImagePng::_on_image_unmap));
+    }
+    else {
+        _rPixbuf = decode_png(*_pRawBlob);
+        _image.set(_rPixbuf);
+    }
 #if GTKMM_MAJOR_VERSION < 4
     signal_button_press_event().connect(sigc::mem_fun(*this, &CtImagePng::_on_button_press_event), false);
 #endif
@@ -127,13 +223,76 @@ CtImagePng::CtImagePng(CtMainWin* pCtMainWin,
     update_label_widget();
 }
 
+CtImagePng::~CtImagePng()
+{
+    _mapConnection.disconnect();
+    _unmapConnection.disconnect();
+    if (_decodeTicket) {
+        CtImageDecoder::get().forget(_decodeTicket);
+    }
+}
+
+Glib::RefPtr<Gdk::Pixbuf> CtImagePng::get_pixbuf() const
+{
+    if (_rPixbuf or not _pRawBlob) {
+        return _rPixbuf;
+    }
+    // not shown, decoded for the caller without keeping it
+    return decode_png(*_pRawBlob);
+}
+
+void CtImagePng::get_pixbuf_size(int& width, int& height) const
+{
+    if (_rPixbuf or not _pRawBlob or not get_png_size(*_pRawBlob, width, height)) {
+        CtImage::get_pixbuf_size(width, height);
+    }
+}
+
+std::shared_ptr<const std::string> CtImagePng::get_raw_blob_shared()
+{
+    if (not _pRawBlob) {
+        g_autofree gchar* pBuffer{NULL};
+        gsize buffer_size;
+        _rPixbuf->save_to_buffer(pBuffer, buffer_size, "png");
+        _pRawBlob = std::make_shared<const std::string>(pBuffer, buffer_size);
+    }
+    return _pRawBlob;
+}
+
 const std::string CtImagePng::get_raw_blob()
 {
-    g_autofree gchar* pBuffer{NULL};
-    gsize buffer_size;
-    _rPixbuf->save_to_buffer(pBuffer, buffer_size, "png");
-    const std::string rawBlob = std::string(pBuffer, buffer_size);
-    return rawBlob;
+    return *get_raw_blob_shared();
+}
+
+void CtImagePng::_on_image_map()
+{
+    if (not _rPixbuf and 0 == _decodeTicket) {
+        _decodeTicket = CtImageDecoder::get().push(this, _pRawBlob);
+    }
+}
+
+void CtImagePng::_on_image_unmap()
+{
+    if (_decodeTicket) {
+        CtImageDecoder::get().forget(_decodeTicket);
+        _decodeTicket = 0;
+    }
+    if (_rPixbuf) {
+        _image.set_size_request(_rPixbuf->get_width(), _rPixbuf->get_height());
+        _image.clear();
+        _rPixbuf.reset();
+    }
+}
+
+void CtImagePng::_set_decoded_pixbuf(const Glib::RefPtr<Gdk::Pixbuf>& rPixbuf)
+{
+    _decodeTicket = 0;
+    if (not rPixbuf) {
+        return;
+    }
+    _rPixbuf = rPixbuf;
+    _image.set(_rPixbuf);
+    _image.set_size_request(-1, -1);
 }
 
 void CtImagePng::to_xml(xmlpp::Element* p_node_parent,
@@ -162,11 +321,11 @@ void CtImagePng::to_xml(xmlpp::Element* p_node_parent,
     }
 }
 
-bool CtImagePng::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* storage_cache)
+bool CtImagePng::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* storage_cache)
 {
     bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT);
+    if (not p_stmt) {
         spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
         retVal = false;
     }
@@ -189,7 +348,6 @@ bool CtImagePng::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
             retVal = false;
         }
-        sqlite3_finalize(p_stmt);
     }
     return retVal;
 }
@@ -292,11 +450,11 @@ void CtImageAnchor::to_xml(xmlpp::Element* p_node_parent, const int offset_adjus
     }
 }
 
-bool CtImageAnchor::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
+bool CtImageAnchor::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
 {
     bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT);
+    if (not p_stmt) {
         spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
         retVal = false;
     }
@@ -319,7 +477,6 @@ bool CtImageAnchor::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offs
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
             retVal = false;
         }
-        sqlite3_finalize(p_stmt);
     }
     return retVal;
 }
@@ -448,11 +605,11 @@ void CtImageLatex::to_xml(xmlpp::Element* p_node_parent, const int offset_adjust
     p_image_node->add_child_text(_latexText);
 }
 
-bool CtImageLatex::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
+bool CtImageLatex::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
 {
     bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT);
+    if (not p_stmt) {
         spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
         retVal = false;
     }
@@ -469,7 +626,6 @@ bool CtImageLatex::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offse
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
             retVal = false;
         }
-        sqlite3_finalize(p_stmt);
     }
     return retVal;
 }
@@ -770,7 +926,7 @@ bool CtImageLatex::_on_button_press_event(GdkEventButton* event)
 
 CtImageEmbFile::CtImageEmbFile(CtMainWin* pCtMainWin,
                                const fs::path& fileName,
-                               const std::string& rawBlob,
+                               const std::shared_ptr<CtEmbFileBlob>& pBlob,
                                const time_t timeSeconds,
                                const int charOffset,
                                const std::string& justification,
@@ -778,7 +934,7 @@ CtImageEmbFile::CtImageEmbFile(CtMainWin* pCtMainWin,
                                const fs::path& pathLastMultiFile)
  : CtImage{pCtMainWin, _get_file_icon(pCtMainWin, fileName), charOffset, justification}
  , _fileName{fileName}
- , _rawBlob{rawBlob}
+ , _pBlob{pBlob}
  , _timeSeconds{timeSeconds}
  , _uniqueId{uniqueId}
  , _pathLastMultiFile{pathLastMultiFile}
@@ -792,7 +948,7 @@ CtImageEmbFile::CtImageEmbFile(CtMainWin* pCtMainWin,
 
 void CtImageEmbFile::_checkNonEmptyRawBlob(const char* multifile_dir)
 {
-    if (not _rawBlob.empty()) {
+    if (not _pBlob->empty()) {
         return;
     }
     // an embedded file can potentially be empty, but if that is the case, we will check if a constant file name exists
@@ -800,7 +956,7 @@ void CtImageEmbFile::_checkNonEmptyRawBlob(const char* multifile_dir)
         // the current data format is multifile, let's check in the current multifile directory
         const fs::path embfilePath = fs::path{multifile_dir} / _fileName;
         if (fs::exists(embfilePath)) {
-            _rawBlob = Glib::file_get_contents(embfilePath.string());
+            _pBlob = CtEmbFileBlob::from_file(embfilePath);
             spdlog::debug("{} FROM multifile constant {}", __FUNCTION__, embfilePath.c_str());
         }
         else {
@@ -808,7 +964,7 @@ void CtImageEmbFile::_checkNonEmptyRawBlob(const char* multifile_dir)
             // let's check in the cleanup folder .before
             const fs::path embfileBeforePath = fs::path{multifile_dir} / ".before" / _fileName;
             if (fs::exists(embfileBeforePath)) {
-                _rawBlob = Glib::file_get_contents(embfileBeforePath.string());
+                _pBlob = CtEmbFileBlob::from_memory(Glib::file_get_contents(embfileBeforePath.string()));
                 spdlog::debug("{} FROM multifile before constant {}", __FUNCTION__, embfileBeforePath.c_str());
             }
             else {
@@ -816,12 +972,12 @@ void CtImageEmbFile::_checkNonEmptyRawBlob(const char* multifile_dir)
             }
         }
     }
-    if (not _rawBlob.empty()) {
+    if (not _pBlob->empty()) {
         return;
     }
     // let's check also if the embedded file was copied/moved and the original file is still in the old directory
     if (fs::exists(_pathLastMultiFile)) {
-        _rawBlob = Glib::file_get_contents(_pathLastMultiFile.string());
+        _pBlob = CtEmbFileBlob::from_file(_pathLastMultiFile);
         spdlog::debug("{} FROM multifile constant last {}", __FUNCTION__, _pathLastMultiFile.string());
     }
     else {
@@ -842,22 +998,22 @@ void CtImageEmbFile::to_xml(xmlpp::Element* p_node_parent,
     if (multifile_dir.empty()) {
         // target is not multifile
         _checkNonEmptyRawBlob(nullptr/*multifile_dir*/);
-        const std::string encodedBlob = Glib::Base64::encode(_rawBlob);
+        const std::string encodedBlob = Glib::Base64::encode(_pBlob->read());
         p_image_node->add_child_text(encodedBlob);
     }
     else {
         // target is multifile
         if (_pCtMainWin->get_ct_config()->embfileMFNameOnDisk) {
             // save as multifile constant name on disk.
-            // If _rawBlob is non-empty, the in-memory content is newer and must overwrite the on-disk file.
+            // If the content is in memory and non-empty, it is newer and must overwrite the on-disk file.
             const fs::path embfilePath = fs::path{multifile_dir} / _fileName;
-            if (not fs::exists(embfilePath) or not _rawBlob.empty()) {
+            if (not fs::exists(embfilePath) or (_pBlob->in_memory() and not _pBlob->empty())) {
                 _checkNonEmptyRawBlob(multifile_dir.c_str());
-                Glib::file_set_contents(embfilePath.string(), _rawBlob);
+                (void)_pBlob->write_to_file(embfilePath);
                 if (fs::exists(embfilePath)) {
-                    spdlog::debug("{} written multifile constant name {}, cleared _rawBlob", __FUNCTION__, embfilePath.c_str());
+                    spdlog::debug("{} written multifile constant name {}, cleared blob", __FUNCTION__, embfilePath.c_str());
                     _pathLastMultiFile = embfilePath;
-                    _rawBlob.clear();
+                    _pBlob = CtEmbFileBlob::from_memory("");
                 }
                 else {
                     spdlog::warn("!! {} multifile constant name {} could not write", __FUNCTION__, embfilePath.c_str());
@@ -867,38 +1023,74 @@ void CtImageEmbFile::to_xml(xmlpp::Element* p_node_parent,
         else {
             // save as multifile with sha256 as name
             _checkNonEmptyRawBlob(multifile_dir.c_str());
-            const std::string sha256sum = CtStorageMultiFile::save_blob(_rawBlob, multifile_dir, _fileName.extension());
+            const std::string sha256sum = CtStorageMultiFile::save_blob(*_pBlob, multifile_dir, _fileName.extension());
             p_image_node->set_attribute("sha256sum", sha256sum);
         }
     }
 }
 
-bool CtImageEmbFile::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
+bool CtImageEmbFile::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
 {
-    bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
-        spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
-        retVal = false;
-    }
-    else {
-        const std::string file_name = _fileName.string();
+    _checkNonEmptyRawBlob(nullptr/*multifile_dir*/);
+    const std::string file_name = _fileName.string();
+    const gint64 src_rowid = _pBlob->get_sqlite_rowid(pDb);
+    if (src_rowid >= 0) {
+        // the content is already in this database: take back the row detached from this node or else copy it
+        sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_REATTACH);
+        if (not p_stmt) {
+            spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
+            return false;
+        }
         sqlite3_bind_int64(p_stmt, 1, node_id);
         sqlite3_bind_int64(p_stmt, 2, _charOffset+offset_adjustment);
         sqlite3_bind_text(p_stmt, 3, _justification.c_str(), _justification.size(), SQLITE_STATIC);
-        sqlite3_bind_text(p_stmt, 4, "", -1, SQLITE_STATIC); // anchor
-        _checkNonEmptyRawBlob(nullptr/*multifile_dir*/);
-        sqlite3_bind_blob(p_stmt, 5, _rawBlob.c_str(), _rawBlob.size(), SQLITE_STATIC);
-        sqlite3_bind_text(p_stmt, 6, file_name.c_str(), file_name.size(), SQLITE_STATIC);
-        sqlite3_bind_text(p_stmt, 7, "", -1, SQLITE_STATIC); // link
-        sqlite3_bind_int64(p_stmt, 8, _timeSeconds);
+        sqlite3_bind_text(p_stmt, 4, file_name.c_str(), file_name.size(), SQLITE_STATIC);
+        sqlite3_bind_int64(p_stmt, 5, _timeSeconds);
+        sqlite3_bind_int64(p_stmt, 6, src_rowid);
+        sqlite3_bind_int64(p_stmt, 7, -node_id);
         if (sqlite3_step(p_stmt) != SQLITE_DONE) {
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
-            retVal = false;
+            return false;
+        }
+        if (sqlite3_changes(pDb) > 0) {
+            return true;
         }
-        sqlite3_finalize(p_stmt);
+        p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_COPY);
+        if (not p_stmt) {
+            spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
+            return false;
+        }
+        sqlite3_bind_int64(p_stmt, 1, node_id);
+        sqlite3_bind_int64(p_stmt, 2, _charOffset+offset_adjustment);
+        sqlite3_bind_text(p_stmt, 3, _justification.c_str(), _justification.size(), SQLITE_STATIC);
+        sqlite3_bind_text(p_stmt, 4, file_name.c_str(), file_name.size(), SQLITE_STATIC);
+        sqlite3_bind_int64(p_stmt, 5, _timeSeconds);
+        sqlite3_bind_int64(p_stmt, 6, src_rowid);
+        if (sqlite3_step(p_stmt) != SQLITE_DONE or sqlite3_changes(pDb) != 1) {
+            spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
+            return false;
+        }
+        return true;
     }
-    return retVal;
+    // the content is streamed into the new row, never entirely in memory unless it already was
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_IMAGE_INSERT_ZEROBLOB);
+    if (not p_stmt) {
+        spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
+        return false;
+    }
+    sqlite3_bind_int64(p_stmt, 1, node_id);
+    sqlite3_bind_int64(p_stmt, 2, _charOffset+offset_adjustment);
+    sqlite3_bind_text(p_stmt, 3, _justification.c_str(), _justification.size(), SQLITE_STATIC);
+    sqlite3_bind_text(p_stmt, 4, "", -1, SQLITE_STATIC); // anchor
+    sqlite3_bind_int64(p_stmt, 5, static_cast<sqlite3_int64>(_pBlob->size()));
+    sqlite3_bind_text(p_stmt, 6, file_name.c_str(), file_name.size(), SQLITE_STATIC);
+    sqlite3_bind_text(p_stmt, 7, "", -1, SQLITE_STATIC); // link
+    sqlite3_bind_int64(p_stmt, 8, _timeSeconds);
+    if (sqlite3_step(p_stmt) != SQLITE_DONE) {
+        spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
+        return false;
+    }
+    return _pBlob->write_to_sqlite_row(pDb, sqlite3_last_insert_rowid(pDb));
 }
 
 std::shared_ptr<CtAnchoredWidgetState> CtImageEmbFile::get_state()
@@ -920,7 +1112,7 @@ void CtImageEmbFile::update_label_widget()
 
 void CtImageEmbFile::update_tooltip()
 {
-    const size_t embfileBytes{_rawBlob.size()};
+    const size_t embfileBytes{_pBlob->size()};
     if (embfileBytes > 0u) {
         const double embfileKbytes{static_cast<double>(embfileBytes)/1024};
         const double embfileMbytes{embfileKbytes/1024};
@@ -27,15 +27,11 @@
 #include "ct_const.h"
 #include "ct_codebox.h"
 #include "ct_widgets.h"
+#include "ct_embfile_blob.h"
 
 class CtImage : public CtAnchoredWidget
 {
 public:
-    CtImage(CtMainWin* pCtMainWin,
-            const std::string& rawBlob,
-            const char* mimeType,
-            const int charOffset,
-            const std::string& justification);
     CtImage(CtMainWin* pCtMainWin,
             const char* stockImage,
             const int size,
@@ -52,13 +48,16 @@ public:
     void set_modified_false() override {}
 
     void save(const fs::path& file_name, const Glib::ustring& type);
-    Glib::RefPtr<Gdk::Pixbuf> get_pixbuf() const { return _rPixbuf; }
+    virtual Glib::RefPtr<Gdk::Pixbuf> get_pixbuf() const { return _rPixbuf; }
+    virtual void get_pixbuf_size(int& width, int& height) const { width = _rPixbuf->get_width(); height = _rPixbuf->get_height(); }
 
 protected:
     Gtk::Image _image;
     Glib::RefPtr<Gdk::Pixbuf> _rPixbuf;
 };
 
+// The encoded png is what is kept (and shared with the undo states), the pixbuf is decoded
+// in background when the image is shown and dropped when it is no longer shown.
 class CtImagePng : public CtImage
 {
 public:
@@ -67,30 +66,47 @@ public:
                const Glib::ustring& link,
                const int charOffset,
                const std::string& justification);
+    CtImagePng(CtMainWin* pCtMainWin,
+               std::shared_ptr<const std::string> pRawBlob,
+               const Glib::ustring& link,
+               const int charOffset,
+               const std::string& justification);
     CtImagePng(CtMainWin* pCtMainWin,
                Glib::RefPtr<Gdk::Pixbuf> pixBuf,
                const Glib::ustring& link,
                const int charOffset,
                const std::string& justification);
-    ~CtImagePng() override {}
+    ~CtImagePng() override;
 
     void to_xml(xmlpp::Element* p_node_parent, const int offset_adjustment, CtStorageCache* cache, const std::string& multifile_dir) override;
-    bool to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
+    bool to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
     CtAnchWidgType get_type() const override { return CtAnchWidgType::ImagePng; }
     std::shared_ptr<CtAnchoredWidgetState> get_state() override;
 
+    // full resolution, decoded on demand if not currently shown
+    Glib::RefPtr<Gdk::Pixbuf> get_pixbuf() const override;
+    void get_pixbuf_size(int& width, int& height) const override;
     const std::string get_raw_blob();
+    std::shared_ptr<const std::string> get_raw_blob_shared();
     void update_label_widget();
     const Glib::ustring& get_link() const { return _link; }
     void set_link(const Glib::ustring& link) { _link = link; }
 
 private:
+    friend class CtImageDecoder;
 #if GTKMM_MAJOR_VERSION < 4
     bool _on_button_press_event(GdkEventButton* event);
 #endif
+    void _on_image_map();
+    void _on_image_unmap();
+    void _set_decoded_pixbuf(const Glib::RefPtr<Gdk::Pixbuf>& rPixbuf);
 
 protected:
     Glib::ustring _link;
+    std::shared_ptr<const std::string> _pRawBlob;
+    size_t _decodeTicket{0};
+    sigc::connection _mapConnection;
+    sigc::connection _unmapConnection;
 };
 
 class CtImageAnchor : public CtImage
@@ -104,7 +120,7 @@ public:
     ~CtImageAnchor() override {}
 
     void to_xml(xmlpp::Element* p_node_parent, const int offset_adjustment, CtStorageCache* cache, const std::string& multifile_dir) override;
-    bool to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
+    bool to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
     CtAnchWidgType get_type() const override { return CtAnchWidgType::ImageAnchor; }
     std::shared_ptr<CtAnchoredWidgetState> get_state() override;
 
@@ -142,7 +158,7 @@ public:
     static Glib::ustring getRenderingErrorMessage(const Glib::ustring* pLatexText = nullptr);
 
     void to_xml(xmlpp::Element* p_node_parent, const int offset_adjustment, CtStorageCache* cache, const std::string& multifile_dir) override;
-    bool to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
+    bool to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
     CtAnchWidgType get_type() const override { return CtAnchWidgType::ImageLatex; }
     std::shared_ptr<CtAnchoredWidgetState> get_state() override;
 
@@ -176,7 +192,7 @@ class CtImageEmbFile : public CtImage
 public:
     CtImageEmbFile(CtMainWin* pCtMainWin,
                    const fs::path& fileName,
-                   const std::string& rawBlob,
+                   const std::shared_ptr<CtEmbFileBlob>& pBlob,
                    const time_t timeSeconds,
                    const int charOffset,
                    const std::string& justification,
@@ -185,14 +201,15 @@ public:
     ~CtImageEmbFile() override {}
 
     void to_xml(xmlpp::Element* p_node_parent, const int offset_adjustment, CtStorageCache* cache, const std::string& multifile_dir) override;
-    bool to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
+    bool to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) override;
     CtAnchWidgType get_type() const override { return CtAnchWidgType::ImageEmbFile; }
     std::shared_ptr<CtAnchoredWidgetState> get_state() override;
 
     const fs::path&      get_file_name() const { return _fileName; }
     void                 set_file_name(const fs::path& path) { _fileName = path; }
-    const std::string&   get_raw_blob() { return _rawBlob; }
-    void                 set_raw_blob(const std::string& buffer) { _rawBlob = buffer; }
+    const std::shared_ptr<CtEmbFileBlob>& get_blob() { return _pBlob; }
+    std::string          get_raw_blob() { return _pBlob->read(); }
+    void                 set_blob(std::shared_ptr<CtEmbFileBlob> pBlob) { _pBlob = std::move(pBlob); }
     time_t               get_time() { return _timeSeconds; }
     void                 set_time(const time_t time) { _timeSeconds = time; }
     size_t               get_unique_id() { return _uniqueId; }
@@ -214,7 +231,7 @@ private:
 
 protected:
     fs::path      _fileName;
-    std::string   _rawBlob;      // raw data, not a string
+    std::shared_ptr<CtEmbFileBlob> _pBlob; // not in memory unless new or edited
     time_t        _timeSeconds;
     const size_t  _uniqueId;
     fs::path      _pathLastMultiFile;
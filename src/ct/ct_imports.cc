@@ -475,9 +475,20 @@ std::unique_ptr<CtImportedNode> CtMDImport::import_file(const fs::path& file)
     if (file.extension() != ".md")
         return nullptr;
 
-    const std::string file_contents = Glib::file_get_contents(file.string());
+    // the tokens are views on the mapped file rather than copies of it
+    GError* pError{nullptr};
+    GMappedFile* pMappedFile = g_mapped_file_new(file.c_str(), FALSE/*writable*/, &pError);
+    if (not pMappedFile) {
+        spdlog::error("{} {} {}", __FUNCTION__, file.string(), pError ? pError->message : "");
+        g_clear_error(&pError);
+        return nullptr;
+    }
+    const gsize file_size = g_mapped_file_get_length(pMappedFile);
+    const std::string_view file_contents = file_size > 0 ?
+        std::string_view{g_mapped_file_get_contents(pMappedFile), file_size} : std::string_view{};
     _parser->wipe_doc();
-    _parser->feed(file_contents);
+    _parser->feed_raw(file_contents);
+    g_mapped_file_unref(pMappedFile);
 
     std::unique_ptr<CtImportedNode> node = std::make_unique<CtImportedNode>(file, file.stem());
     node->xml_content = _parser->doc().document();
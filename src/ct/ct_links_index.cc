@@ -0,0 +1,187 @@
+/*
+ * ct_links_index.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_links_index.h"
+#include "ct_const.h"
+#include "ct_misc_utils.h"
+#include <algorithm>
+
+namespace {
+
+const char LINKS_INDEX_KEY[]{"ct-links-index"};
+const char LINK_TARGET_KEY[]{"ct-link-target"};
+
+const gchar* mark_get_target(GtkTextMark* pMark)
+{
+    return static_cast<const gchar*>(g_object_get_data(G_OBJECT(pMark), LINK_TARGET_KEY));
+}
+
+} // namespace (anonymous)
+
+/*static*/CtLinksIndex& CtLinksIndex::get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer)
+{
+    CtLinksIndex* pLinksIndex = _find(pTextBuffer->gobj());
+    if (not pLinksIndex) {
+        pLinksIndex = new CtLinksIndex{pTextBuffer->gobj()};
+        g_object_set_data_full(G_OBJECT(pTextBuffer->gobj()), LINKS_INDEX_KEY, pLinksIndex, [](gpointer pData){
+            delete static_cast<CtLinksIndex*>(pData);
+        });
+    }
+    return *pLinksIndex;
+}
+
+/*static*/CtLinksIndex* CtLinksIndex::_find(GtkTextBuffer* pBuffer)
+{
+    return static_cast<CtLinksIndex*>(g_object_get_data(G_OBJECT(pBuffer), LINKS_INDEX_KEY));
+}
+
+CtLinksIndex::CtLinksIndex(GtkTextBuffer* pBuffer)
+ : _pBuffer{pBuffer}
+{
+    // before the default handler, the marks in the range are still at their offsets
+    g_signal_connect(_pBuffer, "delete-range", G_CALLBACK(_on_delete_range), this);
+}
+
+CtLinksIndex::~CtLinksIndex()
+{
+    // the buffer is being finalised, its handlers are gone with it
+    for (GtkTextMark* pMark : _marks) {
+        g_object_unref(pMark);
+    }
+}
+
+int CtLinksIndex::_get_offset(GtkTextMark* pMark) const
+{
+    GtkTextIter iter;
+    gtk_text_buffer_get_iter_at_mark(_pBuffer, &iter, pMark);
+    return gtk_text_iter_get_offset(&iter);
+}
+
+size_t CtLinksIndex::_upper_bound(const int offset) const
+{
+    size_t low{0};
+    size_t high{_marks.size()};
+    while (low < high) {
+        const size_t mid = low + (high - low)/2;
+        if (_get_offset(_marks[mid]) <= offset) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+void CtLinksIndex::_insert_mark(const size_t idx, const GtkTextIter* pIter, const gchar* link_target)
+{
+    // right gravity, the text inserted at the start of a link is not part of it
+    GtkTextMark* pMark = gtk_text_buffer_create_mark(_pBuffer, nullptr/*name*/, pIter, FALSE/*left_gravity*/);
+    g_object_set_data_full(G_OBJECT(pMark), LINK_TARGET_KEY, g_strdup(link_target), g_free);
+    _marks.insert(_marks.begin() + idx, static_cast<GtkTextMark*>(g_object_ref(pMark)));
+}
+
+void CtLinksIndex::_erase_marks(const size_t first, const size_t last)
+{
+    for (size_t i = first; i < last; ++i) {
+        gtk_text_buffer_delete_mark(_pBuffer, _marks[i]);
+        g_object_unref(_marks[i]);
+    }
+    _marks.erase(_marks.begin() + first, _marks.begin() + last);
+}
+
+void CtLinksIndex::set_target(const Gtk::TextIter& iter_start, const Gtk::TextIter& iter_end, const Glib::ustring& link_target)
+{
+    const int start_offset = iter_start.get_offset();
+    const int end_offset = iter_end.get_offset();
+    if (start_offset >= end_offset) return;
+    const size_t first = _upper_bound(start_offset - 1);
+    const size_t last = _upper_bound(end_offset - 1);
+    // the text after the range, up to the next mark, keeps the link that ruled it so far
+    if (last > 0 and (last == _marks.size() or _get_offset(_marks[last]) != end_offset)) {
+        const Glib::ustring prev_target{mark_get_target(_marks[last - 1])};
+        _insert_mark(last, iter_end.gobj(), prev_target.c_str());
+    }
+    _erase_marks(first, last);
+    _insert_mark(first, iter_start.gobj(), link_target.c_str());
+}
+
+/*static*/bool CtLinksIndex::iter_has_link_tag(const Gtk::TextIter& iter)
+{
+    for (const auto& pTextTag : iter.get_tags()) {
+        if (str::startswith(pTextTag->property_name().get_value(), CtConst::TAG_LINK_PREFIX)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*static*/Glib::ustring CtLinksIndex::get_target_at(const Gtk::TextIter& iter)
+{
+    if (not iter_has_link_tag(iter)) return "";
+    const CtLinksIndex* pLinksIndex = _find(gtk_text_iter_get_buffer(iter.gobj()));
+    if (not pLinksIndex) return "";
+    const size_t idx = pLinksIndex->_upper_bound(iter.get_offset());
+    if (0 == idx) return "";
+    return mark_get_target(pLinksIndex->_marks[idx - 1]);
+}
+
+/*static*/const gchar* CtLinksIndex::get_target_starting_at(const Gtk::TextIter& iter)
+{
+    const gchar* pTarget{nullptr};
+    GSList* pMarks = gtk_text_iter_get_marks(iter.gobj());
+    for (GSList* pItem = pMarks; pItem; pItem = pItem->next) {
+        if (const gchar* pMarkTarget = mark_get_target(GTK_TEXT_MARK(pItem->data))) {
+            pTarget = pMarkTarget;
+        }
+    }
+    g_slist_free(pMarks);
+    return pTarget;
+}
+
+/*static*/bool CtLinksIndex::get_link_bounds(const Gtk::TextIter& iter, Gtk::TextIter& iter_start, Gtk::TextIter& iter_end)
+{
+    const Glib::ustring link_target = get_target_at(iter);
+    if (link_target.empty()) return false;
+    iter_end = iter;
+    while (iter_end.forward_char() and get_target_at(iter_end) == link_target) {}
+    iter_start = iter;
+    while (iter_start.backward_char()) {
+        if (get_target_at(iter_start) != link_target) {
+            iter_start.forward_char();
+            break;
+        }
+    }
+    return true;
+}
+
+/*static*/void CtLinksIndex::_on_delete_range(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData)
+{
+    auto pLinksIndex = static_cast<CtLinksIndex*>(pData);
+    if (pLinksIndex->_marks.empty()) return;
+    const int start_offset = std::min(gtk_text_iter_get_offset(pStart), gtk_text_iter_get_offset(pEnd));
+    const int end_offset = std::max(gtk_text_iter_get_offset(pStart), gtk_text_iter_get_offset(pEnd));
+    const size_t first = pLinksIndex->_upper_bound(start_offset - 1);
+    size_t last = pLinksIndex->_upper_bound(end_offset - 1);
+    // the last mark of the range rules the text after it, unless a mark is already at the range end
+    if (first < last and (last == pLinksIndex->_marks.size() or pLinksIndex->_get_offset(pLinksIndex->_marks[last]) != end_offset)) {
+        --last;
+    }
+    pLinksIndex->_erase_marks(first, last);
+}
@@ -0,0 +1,65 @@
+/*
+ * ct_links_index.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <gtkmm/textbuffer.h>
+#include <vector>
+
+// Link targets of a text buffer, owned by the buffer. The link text only carries the tag of its link type,
+// the target is held by a mark at the start of the link: the link text is ruled by the closest mark before it.
+// The marks are kept in buffer order, at most one per offset, and their offsets are read from the buffer while bisecting.
+class CtLinksIndex
+{
+public:
+    static CtLinksIndex& get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer);
+
+    // records the target of the link text from iter_start to iter_end, the link tag is applied by the caller
+    void set_target(const Gtk::TextIter& iter_start, const Gtk::TextIter& iter_end, const Glib::ustring& link_target);
+    size_t size() const { return _marks.size(); }
+
+    // target of the link at iter, empty if iter is not on a link
+    static Glib::ustring get_target_at(const Gtk::TextIter& iter);
+    // target of a link starting at iter, also where two links of the same type touch without a tag toggle
+    static const gchar*  get_target_starting_at(const Gtk::TextIter& iter);
+    // bounds of the link at iter, false if iter is not on a link
+    static bool          get_link_bounds(const Gtk::TextIter& iter, Gtk::TextIter& iter_start, Gtk::TextIter& iter_end);
+    static bool          iter_has_link_tag(const Gtk::TextIter& iter);
+
+    ~CtLinksIndex();
+
+private:
+    explicit CtLinksIndex(GtkTextBuffer* pBuffer);
+
+    static CtLinksIndex* _find(GtkTextBuffer* pBuffer);
+
+    int    _get_offset(GtkTextMark* pMark) const;
+    size_t _upper_bound(const int offset) const;
+    void   _insert_mark(const size_t idx, const GtkTextIter* pIter, const gchar* link_target);
+    void   _erase_marks(const size_t first, const size_t last);
+
+    static void _on_delete_range(GtkTextBuffer* pBuffer, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData);
+
+    GtkTextBuffer*            _pBuffer; // owns this index
+    std::vector<GtkTextMark*> _marks;   // a reference is held on each
+};
@@ -0,0 +1,227 @@
+/*
+ * ct_logging.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include "ct_logging.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t ROLLING_SAMPLES{32};
+
+struct CtPerfEntry
+{
+    bool                               is_counter{false};
+    int64_t                            count{0};
+    double                             last_ms{0};
+    double                             max_ms{0};
+    double                             total_ms{0};
+    std::array<double, ROLLING_SAMPLES> latest_ms{};
+};
+
+struct CtStartupMark
+{
+    std::string phase;
+    double      since_launch_ms;
+    double      phase_ms;
+};
+
+// as close as we get to the process launch
+const std::chrono::steady_clock::time_point startup_origin{std::chrono::steady_clock::now()};
+
+struct CtPerfData
+{
+    std::mutex                         mutex;
+    std::map<std::string, CtPerfEntry> entries;
+    std::ofstream                      trace_stream;
+    std::string                        trace_filepath;
+    bool                               trace_first_event{true};
+    std::vector<CtStartupMark>         startup_marks;
+    std::chrono::steady_clock::time_point startup_last{startup_origin};
+    bool                               startup_over{false};
+    const std::chrono::steady_clock::time_point epoch{std::chrono::steady_clock::now()};
+};
+
+CtPerfData& get_perf_data()
+{
+    static CtPerfData perfData;
+    return perfData;
+}
+
+int64_t to_trace_us(const CtPerfData& perfData, const std::chrono::steady_clock::time_point time_point)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_point - perfData.epoch).count();
+}
+
+size_t get_thread_num()
+{
+    return std::hash<std::thread::id>{}(std::this_thread::get_id()) % 100000u;
+}
+
+// with the mutex locked
+void trace_write_event(CtPerfData& perfData, const std::string& event_json)
+{
+    if (not perfData.trace_stream.is_open()) {
+        return;
+    }
+    perfData.trace_stream << (perfData.trace_first_event ? "" : ",\n") << event_json;
+    perfData.trace_first_event = false;
+}
+
+} // namespace (anonymous)
+
+/*static*/void CtPerf::record(const char* name,
+                              const std::chrono::steady_clock::time_point start,
+                              const std::chrono::steady_clock::time_point end)
+{
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    CtPerfEntry& entry = perfData.entries[name];
+    entry.latest_ms[entry.count % ROLLING_SAMPLES] = elapsed_ms;
+    ++entry.count;
+    entry.last_ms = elapsed_ms;
+    entry.total_ms += elapsed_ms;
+    if (elapsed_ms > entry.max_ms) entry.max_ms = elapsed_ms;
+    trace_write_event(perfData, fmt::format(R"({{"name":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":{}}})",
+                                            name,
+                                            to_trace_us(perfData, start),
+                                            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+                                            get_thread_num()));
+    spdlog::debug("{} took {:.3f} ms", name, elapsed_ms);
+}
+
+/*static*/void CtPerf::counter_add(const char* name, const int64_t delta/*= 1*/)
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    CtPerfEntry& entry = perfData.entries[name];
+    entry.is_counter = true;
+    entry.count += delta;
+    trace_write_event(perfData, fmt::format(R"({{"name":"{}","ph":"C","ts":{},"pid":1,"args":{{"value":{}}}}})",
+                                            name,
+                                            to_trace_us(perfData, std::chrono::steady_clock::now()),
+                                            entry.count));
+}
+
+/*static*/std::vector<CtPerf::Stat> CtPerf::get_stats()
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    std::vector<Stat> stats;
+    stats.reserve(perfData.entries.size());
+    for (const auto& [name, entry] : perfData.entries) {
+        Stat stat{name, entry.is_counter, entry.count, entry.last_ms, entry.max_ms, entry.total_ms, 0};
+        if (not entry.is_counter and entry.count > 0) {
+            const size_t samples = std::min(static_cast<size_t>(entry.count), ROLLING_SAMPLES);
+            for (size_t i = 0; i < samples; ++i) {
+                stat.rolling_ms += entry.latest_ms[i];
+            }
+            stat.rolling_ms /= samples;
+        }
+        stats.push_back(std::move(stat));
+    }
+    return stats;
+}
+
+/*static*/void CtPerf::reset()
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    perfData.entries.clear();
+}
+
+/*static*/bool CtPerf::trace_start(const std::string& filepath)
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    if (perfData.trace_stream.is_open()) {
+        perfData.trace_stream << "\n]\n";
+        perfData.trace_stream.close();
+    }
+    perfData.trace_stream.open(filepath, std::ios::out | std::ios::trunc);
+    if (not perfData.trace_stream.is_open()) {
+        spdlog::error("!! {} {}", __FUNCTION__, filepath);
+        perfData.trace_filepath.clear();
+        return false;
+    }
+    // the JSON array format, the closing bracket is optional for chrome://tracing
+    perfData.trace_stream << "[\n";
+    perfData.trace_first_event = true;
+    perfData.trace_filepath = filepath;
+    return true;
+}
+
+/*static*/void CtPerf::trace_stop()
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    if (perfData.trace_stream.is_open()) {
+        perfData.trace_stream << "\n]\n";
+        perfData.trace_stream.close();
+    }
+    perfData.trace_filepath.clear();
+}
+
+/*static*/std::string CtPerf::trace_get_filepath()
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    return perfData.trace_filepath;
+}
+
+/*static*/void CtPerf::startup_mark(const char* phase)
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last;
+    {
+        CtPerfData& perfData = get_perf_data();
+        std::lock_guard<std::mutex> lock{perfData.mutex};
+        if (perfData.startup_over) {
+            return;
+        }
+        last = perfData.startup_last;
+        perfData.startup_last = now;
+        perfData.startup_marks.push_back(CtStartupMark{phase,
+                                                       std::chrono::duration<double, std::milli>(now - startup_origin).count(),
+                                                       std::chrono::duration<double, std::milli>(now - last).count()});
+    }
+    record(phase, last, now);
+}
+
+/*static*/std::string CtPerf::startup_get_report()
+{
+    CtPerfData& perfData = get_perf_data();
+    std::lock_guard<std::mutex> lock{perfData.mutex};
+    perfData.startup_over = true;
+    std::string report = fmt::format("{:<32}{:>12}{:>12}\n", "startup phase", "phase ms", "total ms");
+    for (const CtStartupMark& startupMark : perfData.startup_marks) {
+        report += fmt::format("{:<32}{:>12.1f}{:>12.1f}\n", startupMark.phase, startupMark.phase_ms, startupMark.since_launch_ms);
+    }
+    return report;
+}
@@ -1,7 +1,7 @@
 /*
  * ct_logging.h
  *
- * Copyright 2009-2024
+ * Copyright 2009-2026
  * Giuseppe Penone <giuspen@gmail.com>
  * Evgenii Gurianov <https://github.com/txe>
  *
@@ -50,3 +50,56 @@
 #undef DOUBLE_CLICK
 #endif
 #endif
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Timings and counters of the core operations, for the performance dialog
+// and, while a trace file is set, as events in the chrome://tracing JSON format.
+// Thread safe.
+class CtPerf
+{
+public:
+    struct Stat
+    {
+        std::string name;
+        bool        is_counter{false};
+        int64_t     count{0};     // samples, or the counter value
+        double      last_ms{0};
+        double      max_ms{0};
+        double      total_ms{0};
+        double      rolling_ms{0}; // average of the latest samples
+    };
+
+    static void record(const char* name,
+                       const std::chrono::steady_clock::time_point start,
+                       const std::chrono::steady_clock::time_point end);
+    static void counter_add(const char* name, const int64_t delta = 1);
+
+    static std::vector<Stat> get_stats();
+    static void              reset();
+
+    static bool        trace_start(const std::string& filepath);
+    static void        trace_stop();
+    static std::string trace_get_filepath();
+
+    // the end of a startup phase, timed from the previous mark (or from the process launch);
+    // getting the report ends the startup, the later marks are ignored
+    static void        startup_mark(const char* phase);
+    static std::string startup_get_report();
+};
+
+// Times its own scope, e.g. CtPerfScope perfScope{"file_save"};
+class CtPerfScope
+{
+public:
+    explicit CtPerfScope(const char* name) : _name{name}, _start{std::chrono::steady_clock::now()} {}
+    ~CtPerfScope() { CtPerf::record(_name, _start, std::chrono::steady_clock::now()); }
+    CtPerfScope(const CtPerfScope&) = delete;
+    CtPerfScope& operator=(const CtPerfScope&) = delete;
+
+private:
+    const char*                                 _name; // a string literal
+    const std::chrono::steady_clock::time_point _start;
+};
@@ -115,7 +115,7 @@ CtMainWin::CtMainWin(bool                            no_gui,
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
                      CtStatusIcon*                   pCtStatusIcon,
 #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
-                     GtkSourceLanguageManager*       pGtkSourceLanguageManager)
+                     std::function<GtkSourceLanguageManager*()> getGtkSourceLanguageManager)
  : Gtk::ApplicationWindow{}
  , _no_gui{no_gui}
  , _pCtConfig{pCtConfig}
@@ -123,7 +123,7 @@ CtMainWin::CtMainWin(bool                            no_gui,
  , _pGtkIconTheme{pGtkIconTheme}
  , _rGtkTextTagTable{rGtkTextTagTable}
  , _rGtkCssProvider{rGtkCssProvider}
- , _pGtkSourceLanguageManager{pGtkSourceLanguageManager}
+ , _getGtkSourceLanguageManager{getGtkSourceLanguageManager}
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
  , _pCtStatusIcon{pCtStatusIcon}
 #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
@@ -149,7 +149,7 @@ CtMainWin::CtMainWin(bool                            no_gui,
     _uCtActions.reset(new CtActions{this});
     _uCtMenu.reset(new CtMenu{this});
     _pSaveMenuAction = _uCtMenu->find_action("ct_save");
-    _uCtPrint.reset(new CtPrint{this});
+    CtPerf::startup_mark("main_win_actions");
     _uCtStorage.reset(CtStorageControl::create_dummy_storage(this));
 
     _scrolledwindowTree.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
@@ -206,6 +206,17 @@ CtMainWin::CtMainWin(bool                            no_gui,
     _pMenuBar->set_name("MenuBar");
     _resolve_bookmarks_submenus();
     _pRecentDocsSubmenu = CtMenu::find_menu_item(_pMenuBar, "RecentDocsSubMenu");
+    if (_pRecentDocsSubmenu) {
+        // the recent documents are listed when the submenu is about to pop up
+        _pRecentDocsSubmenu->signal_select().connect([this](){
+            if (_recentDocsMenusDirty[0]) {
+                _recentDocsMenusDirty[0] = false;
+                Gtk::Menu* pMenu = _pRecentDocsSubmenu->get_submenu();
+                delete pMenu;
+                _pRecentDocsSubmenu->set_submenu(*_recent_docs_menu_build());
+            }
+        }, false/*after*/);
+    }
     _pMenuBar->show_all();
     add_accel_group(_uCtMenu->get_accel_group());
     _pToolbars = _uCtMenu->build_toolbars(_pRecentDocsMenuToolButton, _pSaveToolButton);
@@ -260,6 +271,7 @@ CtMainWin::CtMainWin(bool                            no_gui,
     _uCtMenu->populate_recent_docs_menu4(_pRecentDocsMenuButton4, _pCtConfig->recentDocsFilepaths);
     _uCtMenu->update_recent_docs_gio_menu4(_pCtConfig->recentDocsFilepaths);
 #endif
+    CtPerf::startup_mark("main_win_menus_toolbars");
     // Main layout assembly
 #if GTKMM_MAJOR_VERSION >= 4
     _vboxMain.append(_vPaned);
@@ -331,6 +343,7 @@ CtMainWin::CtMainWin(bool                            no_gui,
     #endif
     menu_update_doc_path_menu_item();
     menu_top_optional_bookmarks_enforce();
+    CtPerf::startup_mark("main_win_layout_config");
 
     if (_no_gui) {
         set_visible(false);
@@ -1090,20 +1103,58 @@ void CtMainWin::window_header_update_bookmark_icon(const bool show)
 
 void CtMainWin::_resolve_bookmarks_submenus()
 {
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+    auto f_resolve = [this](const unsigned idx, Gtk::MenuItem* pMenuItem) {
+        if (not pMenuItem or _pBookmarksSubmenus[idx] == pMenuItem) {
+            return;
+        }
+        _pBookmarksSubmenus[idx] = pMenuItem;
+        _bookmarksSubmenusDirty[idx] = true;
+        // the bookmarks are listed when the submenu is about to pop up
+        pMenuItem->signal_select().connect([this, idx](){ _bookmarks_submenu_fill(idx); }, false/*after*/);
+    };
     if (_pMenuBar) {
         if (Gtk::MenuItem* pTreeMenuItem = CtMenu::find_menu_item(_pMenuBar, "TreeMenu")) {
             if (Gtk::Menu* pTreeMenu = pTreeMenuItem->get_submenu()) {
-                _pBookmarksSubmenus[0] = CtMenu::find_menu_item(pTreeMenu, "BookmarksSubMenu");
+                f_resolve(0, CtMenu::find_menu_item(pTreeMenu, "BookmarksSubMenu"));
             }
         }
-        _pBookmarksSubmenus[2] = CtMenu::find_menu_item(_pMenuBar, "BookmarksMenu");
+        f_resolve(2, CtMenu::find_menu_item(_pMenuBar, "BookmarksMenu"));
     }
+    // the node popup menu is only built at its first use
     if (_uCtMenu) {
-        if (Gtk::Menu* pPopupMenuTree = _uCtMenu->get_popup_menu(CtMenu::POPUP_MENU_TYPE::Node)) {
-            _pBookmarksSubmenus[1] = CtMenu::find_menu_item(pPopupMenuTree, "BookmarksSubMenu");
+        if (Gtk::Menu* pPopupMenuTree = _uCtMenu->get_popup_menu_if_built(CtMenu::POPUP_MENU_TYPE::Node)) {
+            f_resolve(1, CtMenu::find_menu_item(pPopupMenuTree, "BookmarksSubMenu"));
         }
     }
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
+}
+
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+void CtMainWin::_bookmarks_submenu_fill(const unsigned idx)
+{
+    if (not _bookmarksSubmenusDirty[idx]) {
+        return;
+    }
+    _bookmarksSubmenusDirty[idx] = false;
+    std::list<std::tuple<gint64, Glib::ustring, const char*>> bookmarks;
+    for (const gint64& node_id : _uCtTreestore->bookmarks_get()) {
+        CtTreeIter ct_tree_iter = _uCtTreestore->get_node_from_node_id(node_id);
+        bookmarks.push_back(std::make_tuple(node_id,
+            ct_tree_iter.get_node_name(),
+            _uCtTreestore->get_node_icon(_uCtTreestore->get_store()->iter_depth(ct_tree_iter),
+                ct_tree_iter.get_node_syntax_highlighting(),
+                ct_tree_iter.get_node_custom_icon_id())));
+    }
+    sigc::slot<void, gint64> bookmark_action = [&](gint64 node_id) {
+        CtTreeIter tree_iter = _uCtTreestore->get_node_from_node_id(node_id);
+        if (tree_iter) {
+            _uCtTreeview->set_cursor_safe(tree_iter);
+        }
+    };
+    _pBookmarksSubmenus[idx]->set_submenu(*_uCtMenu->build_bookmarks_menu(bookmarks, bookmark_action, 2 == idx/*isTopMenu*/));
 }
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
 
 void CtMainWin::menu_top_optional_bookmarks_enforce()
 {
@@ -1215,28 +1266,8 @@ void CtMainWin::menu_set_bookmark_menu_items()
     #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
 
     _resolve_bookmarks_submenus();
-
-    std::list<std::tuple<gint64, Glib::ustring, const char*>> bookmarks;
-    for (const gint64& node_id : _uCtTreestore->bookmarks_get()) {
-        CtTreeIter ct_tree_iter = _uCtTreestore->get_node_from_node_id(node_id);
-        bookmarks.push_back(std::make_tuple(node_id,
-            ct_tree_iter.get_node_name(),
-            _uCtTreestore->get_node_icon(_uCtTreestore->get_store()->iter_depth(ct_tree_iter),
-                ct_tree_iter.get_node_syntax_highlighting(),
-                ct_tree_iter.get_node_custom_icon_id())));
-    }
-
-    sigc::slot<void, gint64> bookmark_action = [&](gint64 node_id) {
-        CtTreeIter tree_iter = _uCtTreestore->get_node_from_node_id(node_id);
-        if (tree_iter) {
-            _uCtTreeview->set_cursor_safe(tree_iter);
-        }
-    };
-    for (unsigned i = 0; i < _pBookmarksSubmenus.size(); ++i) {
-        if (_pBookmarksSubmenus[i]) {
-            _pBookmarksSubmenus[i]->set_submenu(*_uCtMenu->build_bookmarks_menu(bookmarks, bookmark_action, 2 == i/*isTopMenu*/));
-        }
-    }
+    // the submenus are rebuilt when they are next about to pop up
+    _bookmarksSubmenusDirty.fill(true);
     #else
     // GTK4: update both the top-level Bookmarks menu and the Tree > Bookmarks submenu
     // via the Gio::Menu references captured during build_popover_menubar4().
@@ -1257,6 +1288,31 @@ void CtMainWin::menu_set_items_recent_documents()
 {
     if (not _pCtConfig->rememberRecentDocs) return;
     #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+    if (_pRecentDocsMenuToolButton and not _pRecentDocsMenuToolButton->get_menu()) {
+        // new toolbar button: the arrow stays insensitive without a menu, the real one is built before showing
+        _pRecentDocsMenuToolButton->set_arrow_tooltip_text(_("Open a Recent CherryTree Document"));
+        _pRecentDocsMenuToolButton->set_menu(*Gtk::manage(new Gtk::Menu{}));
+        _pRecentDocsMenuToolButton->signal_show_menu().connect([this](){
+            if (_recentDocsMenusDirty[1]) {
+                _recentDocsMenusDirty[1] = false;
+                Gtk::Menu* pMenu = _pRecentDocsMenuToolButton->get_menu();
+                delete pMenu;
+                _pRecentDocsMenuToolButton->set_menu(*_recent_docs_menu_build());
+            }
+        });
+    }
+    // the menus are rebuilt when they are next about to pop up
+    _recentDocsMenusDirty.fill(true);
+    #else
+    // GTK4: update both the toolbar recent-docs dropdown and the Gio::Menu recent-docs submenu.
+    _uCtMenu->populate_recent_docs_menu4(_pRecentDocsMenuButton4, _pCtConfig->recentDocsFilepaths);
+    _uCtMenu->update_recent_docs_gio_menu4(_pCtConfig->recentDocsFilepaths);
+    #endif
+}
+
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+Gtk::Menu* CtMainWin::_recent_docs_menu_build()
+{
     sigc::slot<void, const std::string&> recent_doc_open_action = [&](const std::string& filepath){
         if (Glib::file_test(filepath, Glib::FILE_TEST_EXISTS)) {
             if (file_open(filepath, ""/*node*/, ""/*anchor*/)) {
@@ -1275,27 +1331,11 @@ void CtMainWin::menu_set_items_recent_documents()
         _pCtConfig->recentDocsFilepaths.remove(filepath);
         menu_set_items_recent_documents();
     };
-    if (_pRecentDocsSubmenu) {
-        Gtk::Menu* pMenu = _pRecentDocsSubmenu->get_submenu();
-        delete pMenu;
-        _pRecentDocsSubmenu->set_submenu(*_uCtMenu->build_recent_docs_menu(_pCtConfig->recentDocsFilepaths,
-                                                                           recent_doc_open_action,
-                                                                           recent_doc_rm_action));
-    }
-    if (_pRecentDocsMenuToolButton) {
-        _pRecentDocsMenuToolButton->set_arrow_tooltip_text(_("Open a Recent CherryTree Document"));
-        Gtk::Menu* pMenu = _pRecentDocsMenuToolButton->get_menu();
-        delete pMenu;
-        _pRecentDocsMenuToolButton->set_menu(*_uCtMenu->build_recent_docs_menu(_pCtConfig->recentDocsFilepaths,
-                                                                               recent_doc_open_action,
-                                                                               recent_doc_rm_action));
-    }
-    #else
-    // GTK4: update both the toolbar recent-docs dropdown and the Gio::Menu recent-docs submenu.
-    _uCtMenu->populate_recent_docs_menu4(_pRecentDocsMenuButton4, _pCtConfig->recentDocsFilepaths);
-    _uCtMenu->update_recent_docs_gio_menu4(_pCtConfig->recentDocsFilepaths);
-    #endif
+    return _uCtMenu->build_recent_docs_menu(_pCtConfig->recentDocsFilepaths,
+                                            recent_doc_open_action,
+                                            recent_doc_rm_action);
 }
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
 
 void CtMainWin::menu_set_visible_exit_app(bool visible)
 {
@@ -1514,8 +1554,10 @@ void CtMainWin::update_selected_node_statusbar_info()
             statusbar_text += separator_text + _("Spell Check") + _(": ") + _pCtConfig->spellCheckLang;
         }
         if (_pCtConfig->wordCountOn) {
-            const int words_count = _uCtActions->get_word_count_for_statusbar();
-            statusbar_text += separator_text + _("Word Count") + _(": ") + std::to_string(words_count);
+            const CtTextCounts text_counts = _uCtActions->get_text_counts_for_statusbar();
+            statusbar_text += separator_text + _("Word Count") + _(": ") + std::to_string(text_counts.words);
+            statusbar_text += separator_text + _("Characters") + _(": ") + std::to_string(text_counts.chars);
+            statusbar_text += separator_text + _("Lines") + _(": ") + std::to_string(text_counts.lines);
         }
         if (treeIter.get_node_creating_time() > 0) {
             const Glib::ustring timestamp_creation = str::time_format(_pCtConfig->timestampFormat, treeIter.get_node_creating_time());
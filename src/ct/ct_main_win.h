@@ -101,7 +101,7 @@ public:
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
         CtStatusIcon*            pCtStatusIcon,
 #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
-        GtkSourceLanguageManager* pGtkSourceLanguageManager
+        std::function<GtkSourceLanguageManager*()> getGtkSourceLanguageManager
     );
     virtual ~CtMainWin();
 
@@ -146,7 +146,12 @@ public:
     CtTextView&                       get_text_view()   { return _ctTextview; }
     CtStatusBar&                      get_status_bar()  { return _ctStatusBar; }
     CtMenu&                           get_ct_menu()     { return *_uCtMenu; }
-    CtPrint&                          get_ct_print()    { return *_uCtPrint; }
+    CtPrint&                          get_ct_print()
+    {
+        // the page setup file is only read at the first print or export to PDF
+        if (not _uCtPrint) _uCtPrint.reset(new CtPrint{this});
+        return *_uCtPrint;
+    }
     CtConfig*                         get_ct_config()   { return _pCtConfig; }
     CtStorageControl*                 get_ct_storage()  { return _uCtStorage.get(); }
     CtActions*                        get_ct_actions()  { return _uCtActions.get(); }
@@ -155,7 +160,7 @@ public:
     CtStateMachine&                   get_state_machine() { return _ctStateMachine; }
     Glib::RefPtr<Gtk::TextTagTable>&  get_text_tag_table() { return _rGtkTextTagTable; }
     Glib::RefPtr<Gtk::CssProvider>&   get_css_provider()   { return _rGtkCssProvider; }
-    GtkSourceLanguageManager*         get_language_manager() { return _pGtkSourceLanguageManager; }
+    GtkSourceLanguageManager*         get_language_manager() { return _getGtkSourceLanguageManager(); }
 
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
     Gtk::StatusIcon*                  get_status_icon() { return _pCtStatusIcon->get(); }
@@ -178,7 +183,12 @@ public:
     void                      resetup_for_syntax(const char target/*'r':RichText, 'p':PlainTextNCode*/);
     void                      codeboxes_reload_toolbar();
     Glib::RefPtr<Gtk::TextBuffer> get_new_text_buffer(const Glib::ustring& textContent="");
+    // large node mode: above the configured sizes the features costing time over the whole text are off
+    bool                      text_buffer_is_large(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer) const;
+    bool                      text_buffer_is_too_large_to_edit(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer) const;
+    void                      large_node_mode_apply(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer);
     std::string               get_text_tag_name_exist_or_create(const std::string& propertyName, const std::string& propertyValue);
+    void                      apply_link_tag(Glib::RefPtr<Gtk::TextBuffer> text_buffer, const Glib::ustring& link_target, const Gtk::TextIter& iter_start, const Gtk::TextIter& iter_end);
     void                      apply_scalable_properties(Glib::RefPtr<Gtk::TextTag> rTextTag, CtScalableTag* pCtScalableTag);
     Glib::ustring             sourceview_hovering_link_get_tooltip(const Glib::ustring& link);
     bool                      apply_tag_try_automatic_bounds(Glib::RefPtr<Gtk::TextBuffer> text_buffer, Gtk::TextIter iter_start);
@@ -188,6 +198,10 @@ private:
     Gtk::Box&      _init_status_bar();
     Gtk::EventBox& _init_window_header();
     void           _resolve_bookmarks_submenus();
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+    void           _bookmarks_submenu_fill(const unsigned idx);
+    Gtk::Menu*     _recent_docs_menu_build();
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
 
 public:
     void window_title_update(std::optional<bool> saveNeeded = std::nullopt);
@@ -340,7 +354,7 @@ private:
     Gtk::IconTheme*              _pGtkIconTheme;
     Glib::RefPtr<Gtk::TextTagTable> _rGtkTextTagTable;
     Glib::RefPtr<Gtk::CssProvider>  _rGtkCssProvider;
-    GtkSourceLanguageManager*    const _pGtkSourceLanguageManager;
+    const std::function<GtkSourceLanguageManager*()> _getGtkSourceLanguageManager;
 
 #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
     CtStatusIcon*                _pCtStatusIcon;
@@ -366,8 +380,10 @@ private:
     CtWinHeader                  _ctWinHeader;
     #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
     std::array<Gtk::MenuItem*,3> _pBookmarksSubmenus{nullptr,nullptr,nullptr};
+    std::array<bool,3>           _bookmarksSubmenusDirty{true,true,true};
     Gtk::MenuItem*               _pRecentDocsSubmenu{nullptr};
     Gtk::MenuToolButton*         _pRecentDocsMenuToolButton{nullptr};
+    std::array<bool,2>           _recentDocsMenusDirty{true,true}; // menubar submenu, toolbar button
     Gtk::ToolButton*             _pSaveToolButton{nullptr};
     #endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
     #if GTKMM_MAJOR_VERSION >= 4
@@ -24,6 +24,7 @@
 #include "ct_main_win.h"
 #include "ct_storage_xml.h"
 #include "ct_export2txt.h"
+#include "ct_links_index.h"
 
 // GtkSourceView 5 removed begin/end_not_undoable_action
 #if GTK_SOURCE_CHECK_VERSION(5, 0, 0)
@@ -34,6 +35,31 @@
 #define CT_SOURCE_BUFFER_END_NOT_UNDOABLE(buf)   gtk_source_buffer_end_not_undoable_action(buf)
 #endif
 
+namespace {
+
+// The size in bytes of the UTF-8 text is only summed line by line when the chars count is not enough to tell
+bool text_buffer_bytes_over(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer, const int64_t bytesLimit)
+{
+    const int64_t numChars = pTextBuffer->get_char_count();
+    if (numChars > bytesLimit) {
+        return true;
+    }
+    if (4*numChars <= bytesLimit) {
+        return false;
+    }
+    int64_t numBytes{0};
+    Gtk::TextIter lineIter = pTextBuffer->begin();
+    do {
+        numBytes += lineIter.get_bytes_in_line();
+        if (numBytes > bytesLimit) {
+            return true;
+        }
+    } while (lineIter.forward_line());
+    return false;
+}
+
+} // namespace (anonymous)
+
 void CtMainWin::apply_syntax_highlighting(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer,
                                           const std::string& syntax,
                                           const bool forceReApply)
@@ -80,6 +106,10 @@ void CtMainWin::apply_syntax_highlighting(Glib::RefPtr<Gtk::TextBuffer> pTextBuf
         }
         gtk_source_buffer_set_highlight_matching_brackets(pGtkSourceBuffer, _pCtConfig->ptHighlMatchBra);
     }
+    if (pTextBuffer->get_data(CtConst::LARGE_NODE_MODE_ID)) {
+        gtk_source_buffer_set_highlight_syntax(pGtkSourceBuffer, false);
+        gtk_source_buffer_set_highlight_matching_brackets(pGtkSourceBuffer, false);
+    }
     pTextBuffer->set_data(CtConst::STYLE_APPLIED_ID, (void*)1);
 }
 
@@ -215,6 +245,34 @@ Glib::RefPtr<Gtk::TextBuffer> CtMainWin::get_new_text_buffer(const Glib::ustring
     return rRetTextBuffer;
 }
 
+bool CtMainWin::text_buffer_is_large(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer) const
+{
+    return pTextBuffer and _pCtConfig->largeNodeKb > 0 and text_buffer_bytes_over(pTextBuffer, int64_t{_pCtConfig->largeNodeKb}*1024);
+}
+
+bool CtMainWin::text_buffer_is_too_large_to_edit(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer) const
+{
+    return pTextBuffer and _pCtConfig->largeNodeReadOnlyKb > 0 and text_buffer_bytes_over(pTextBuffer, int64_t{_pCtConfig->largeNodeReadOnlyKb}*1024);
+}
+
+void CtMainWin::large_node_mode_apply(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer)
+{
+    if (pTextBuffer->get_data(CtConst::LARGE_NODE_MODE_ID)) {
+        return;
+    }
+    spdlog::debug("{} {} chars", __FUNCTION__, pTextBuffer->get_char_count());
+    auto pGtkSourceBuffer = GTK_SOURCE_BUFFER(pTextBuffer->gobj());
+    gtk_source_buffer_set_highlight_syntax(pGtkSourceBuffer, false);
+    gtk_source_buffer_set_highlight_matching_brackets(pGtkSourceBuffer, false);
+#if GTKMM_MAJOR_VERSION < 4
+    gtk_source_buffer_set_max_undo_levels(pGtkSourceBuffer, 0);
+#else
+    gtk_text_buffer_set_enable_undo(GTK_TEXT_BUFFER(pGtkSourceBuffer), false);
+#endif
+    // kept until the node is loaded again
+    pTextBuffer->set_data(CtConst::LARGE_NODE_MODE_ID, (void*)1);
+}
+
 void CtMainWin::apply_scalable_properties(Glib::RefPtr<Gtk::TextTag> rTextTag, CtScalableTag* pCtScalableTag)
 {
     rTextTag->property_scale() = pCtScalableTag->scale;
@@ -240,7 +298,8 @@ void CtMainWin::apply_scalable_properties(Glib::RefPtr<Gtk::TextTag> rTextTag, C
 std::string CtMainWin::get_text_tag_name_exist_or_create(const std::string& propertyName,
                                                          const std::string& propertyValue)
 {
-    const std::string tagName{propertyName + "_" + propertyValue};
+    // one tag per link type, the link targets are in the links index of each buffer
+    const std::string tagName{CtConst::TAG_LINK == propertyName ? propertyName + "_" + propertyValue.substr(0, 4) : propertyName + "_" + propertyValue};
     Glib::RefPtr<Gtk::TextTag> rTextTag = _rGtkTextTagTable->lookup(tagName);
     if (not rTextTag) {
         bool identified{true};
@@ -384,6 +443,19 @@ std::string CtMainWin::get_text_tag_name_exist_or_create(const std::string& prop
     return tagName;
 }
 
+void CtMainWin::apply_link_tag(Glib::RefPtr<Gtk::TextBuffer> text_buffer,
+                               const Glib::ustring& link_target,
+                               const Gtk::TextIter& iter_start,
+                               const Gtk::TextIter& iter_end)
+{
+    const int start_offset = iter_start.get_offset();
+    const int end_offset = iter_end.get_offset();
+    text_buffer->apply_tag_by_name(get_text_tag_name_exist_or_create(CtConst::TAG_LINK, link_target), iter_start, iter_end);
+    CtLinksIndex::get(text_buffer).set_target(text_buffer->get_iter_at_offset(start_offset),
+                                              text_buffer->get_iter_at_offset(end_offset),
+                                              link_target);
+}
+
 // Get the tooltip for the underlying link
 Glib::ustring CtMainWin::sourceview_hovering_link_get_tooltip(const Glib::ustring& link)
 {
@@ -391,6 +391,7 @@ void CtMainWin::_on_textview_populate_popup(Gtk::Menu* menu)
         //for (auto iter : menu->get_children()) menu->remove(*iter);
         _uCtActions->getCtMainWin()->get_ct_menu().build_popup_menu(menu, CtMenu::POPUP_MENU_TYPE::Code);
     }
+    _ctTextview.spell_check_populate_popup(menu);
 }
 #endif
 
@@ -248,6 +248,7 @@ bool CtMainWin::file_open(const fs::path& filepath,
     }
 
     _uCtStorage.reset(new_storage);
+    mod_time_sentinel_restart();
 
     window_title_update(false/*saveNeeded*/);
     menu_set_bookmark_menu_items();
@@ -465,11 +466,17 @@ void CtMainWin::mod_time_sentinel_restart()
 {
     const bool was_connected = not _mod_time_sentinel_timout_connection.empty();
     _mod_time_sentinel_timout_connection.disconnect();
+    _uCtStorage->external_changes_watch_stop();
     if (not _pCtConfig->modTimeSentinel) {
         if (was_connected) spdlog::debug("mod time sentinel was stopped");
         return;
     }
 
+    if (_uCtStorage->external_changes_watch_start()) {
+        // the storage reloads in place only what was changed on disk
+        spdlog::debug("mod time sentinel is started (file monitors)");
+        return;
+    }
     spdlog::debug("mod time sentinel is started");
     _mod_time_sentinel_timout_connection = Glib::signal_timeout().connect_seconds([this]() {
         if (user_active() and _uCtStorage->get_mod_time() > 0) {
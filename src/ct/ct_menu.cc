@@ -794,6 +794,12 @@ Gtk::Menu* CtMenu::get_popup_menu(POPUP_MENU_TYPE popupMenuType)
             });
         }
         _popupMenus[popupMenuType] = pMenu;
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+        if (popupMenuType == POPUP_MENU_TYPE::Node) {
+            // the node popup holds one of the bookmarks submenus
+            _pCtMainWin->menu_set_bookmark_menu_items();
+        }
+#endif /* GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED) */
     }
     return _popupMenus[popupMenuType];
 }
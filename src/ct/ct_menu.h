@@ -151,6 +151,7 @@ private:
                                                       sigc::slot<void, const std::string&>& recent_doc_rm_action);
 
     Gtk::Menu*                 get_popup_menu(POPUP_MENU_TYPE popupMenuType);
+    Gtk::Menu*                 get_popup_menu_if_built(POPUP_MENU_TYPE popupMenuType) { return _popupMenus[popupMenuType]; }
     void                       build_popup_menu(Gtk::Menu* pMenu, POPUP_MENU_TYPE popupMenuType);
     void                       build_popup_menu_table_cell(Gtk::Menu* pMenu, const bool first_row, const bool first_col, const bool last_row, const bool last_col);
 
@@ -99,6 +99,8 @@ void CtMenu::init_actions(CtActions* pActions)
             _("Export Preferences"), sigc::mem_fun(*pActions, &CtActions::preferences_export) });
         _actions.push_back(CtMenuAction{file_cat, "tree_parse_info", "ct_info", _("Tree In_fo"), None,
             _("Tree Summary Information"), sigc::mem_fun(*pActions, &CtActions::tree_info)});
+        _actions.push_back(CtMenuAction{file_cat, "perf_info", "ct_info", _("_Performance Info"), None,
+            _("Timings of the Core Operations"), sigc::mem_fun(*pActions, &CtActions::perf_info)});
         _actions.push_back(CtMenuAction{file_cat, "doc_path_clip", "ct_edit_copy", _("_Document Path to Clipboard"), None,
             _("Copy Document Path to Clipboard"), sigc::mem_fun(*pActions, &CtActions::doc_path_to_clipboard)});
         _actions.push_back(CtMenuAction{file_cat, "quit_app", "ct_quit-app", _("_Quit"), KB_CONTROL+"q",
@@ -513,6 +515,8 @@ void CtMenu::init_actions(CtActions* pActions)
             _("Export To HTML"), sigc::mem_fun(*pActions, &CtActions::export_to_html)});
         _actions.push_back(CtMenuAction{export_cat, "export_txt", "ct_to_txt", _("Export to Plain _Text"), None,
             _("Export to Plain Text"), sigc::mem_fun(*pActions, &CtActions::export_to_txt)});
+        _actions.push_back(CtMenuAction{export_cat, "export_md", "ct_markdown", _("Export to _Markdown"), None,
+            _("Export to Markdown"), sigc::mem_fun(*pActions, &CtActions::export_to_md)});
         _actions.push_back(CtMenuAction{export_cat, "export_ct", "ct_to_cherrytree", _("_Export To CherryTree"), None,
             _("Export To CherryTree File or Folder"), sigc::mem_fun(*pActions, &CtActions::export_to_ct)});
     }
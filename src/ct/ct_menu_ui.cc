@@ -143,6 +143,7 @@ const char* CtMenu::_get_ui_str_menu()
       <menuitem action='export_pdf'/>
       <menuitem action='export_html'/>
       <menuitem action='export_txt'/>
+      <menuitem action='export_md'/>
       <menuitem action='export_ct'/>
     </menu>
     <separator/>
@@ -160,6 +161,7 @@ const char* CtMenu::_get_ui_str_menu()
       <menuitem action='open_cfg_folder'/>
     </menu>
     <menuitem action='tree_parse_info'/>
+    <menuitem action='perf_info'/>
     <menuitem action='doc_path_clip'/>
     <separator/>
     <menuitem action='quit_app'/>
@@ -29,6 +29,8 @@
 #include "ct_const.h"
 #include "ct_logging.h"
 #include "ct_list.h"
+#include "ct_task_pool.h"
+#include "ct_links_index.h"
 #include <ctime>
 #include <regex>
 #include <glib/gstdio.h> // to get stats
@@ -40,8 +42,6 @@
 #else
 #include <uchardet.h>
 #endif // __APPLE__
-#include <thread> // for parallel_for
-#include <future> // parallel_for
 
 #ifdef _WIN32
 #include <windows.h>
@@ -324,45 +324,20 @@ Glib::ustring CtMiscUtil::get_link_property_from_entry(const CtLinkEntry& link_e
 // Check if the cursor is on a link, in this case select the link and return the tag_property_value
 Glib::ustring CtMiscUtil::link_check_around_cursor(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer, std::optional<Gtk::TextIter> optTextIter/*= std::nullopt*/)
 {
-    auto link_check_around_cursor_iter = [](Gtk::TextIter text_iter)->Glib::ustring{
-        auto tags = text_iter.get_tags();
-        for (auto& tag : tags) {
-            Glib::ustring tag_name = tag->property_name();
-            if (str::startswith(tag_name, CtConst::TAG_LINK)) {
-                return tag_name;
-            }
-        }
-        return "";
-    };
     Gtk::TextIter text_iter = optTextIter.has_value() ? optTextIter.value() : pTextBuffer->get_insert()->get_iter();
-    Glib::ustring tag_name = link_check_around_cursor_iter(text_iter);
-    if (tag_name.empty()) {
-        if (text_iter.get_char() == ' ' and text_iter.backward_char()) {
-            tag_name = link_check_around_cursor_iter(text_iter);
-            if (tag_name.empty()) return "";
-        }
-        else {
+    Gtk::TextIter iter_start, iter_end;
+    if (not CtLinksIndex::get_link_bounds(text_iter, iter_start, iter_end)) {
+        if (text_iter.get_char() != ' ' or not text_iter.backward_char() or
+            not CtLinksIndex::get_link_bounds(text_iter, iter_start, iter_end))
+        {
             return "";
         }
     }
-    auto iter_end = text_iter;
-    while (iter_end.forward_char()) {
-        Glib::ustring ret_tag_name = link_check_around_cursor_iter(iter_end);
-        if (ret_tag_name != tag_name) {
-            break;
-        }
-    }
-    while (text_iter.backward_char()) {
-        Glib::ustring ret_tag_name = link_check_around_cursor_iter(text_iter);
-        if (ret_tag_name != tag_name) {
-            text_iter.forward_char();
-            break;
-        }
-    }
-    if (text_iter == iter_end) return "";
+    if (iter_start == iter_end) return "";
+    const Glib::ustring link_target = CtLinksIndex::get_target_at(iter_start);
     pTextBuffer->move_mark(pTextBuffer->get_insert(), iter_end);
-    pTextBuffer->move_mark(pTextBuffer->get_selection_bound(), text_iter);
-    return tag_name.substr(5);
+    pTextBuffer->move_mark(pTextBuffer->get_selection_bound(), iter_start);
+    return link_target;
 }
 
 bool CtMiscUtil::mime_type_contains(const std::string &filepath, const char* type)
@@ -392,6 +367,70 @@ bool CtMiscUtil::text_file_set_contents_add_cr_on_win(const std::string& filepat
     return g_file_set_contents(filepath.c_str(), pTextContent, -1, NULL);
 }
 
+std::string CtMiscUtil::bytes_to_human_readable(const size_t bytes)
+{
+    if (bytes < 1024u) {
+        return fmt::format("{} B", bytes);
+    }
+    const double kbytes{static_cast<double>(bytes)/1024};
+    if (kbytes < 1024) {
+        return fmt::format("{:.1f} KB", kbytes);
+    }
+    const double mbytes{kbytes/1024};
+    if (mbytes < 1024) {
+        return fmt::format("{:.1f} MB", mbytes);
+    }
+    return fmt::format("{:.1f} GB", mbytes/1024);
+}
+
+std::vector<std::pair<Glib::ustring, const CtMemoryCount*>> CtMiscUtil::get_memory_info_categories(const CtMemoryInfo& memoryInfo)
+{
+    return {
+        {_("Text Buffers"), &memoryInfo.textBuffers},
+        {_("Objects Text and Cells"), &memoryInfo.widgets},
+        {_("Images Pixels"), &memoryInfo.pixbufs},
+        {_("Images Encoded"), &memoryInfo.pngBlobs},
+        {_("Embedded Files"), &memoryInfo.embFileBlobs},
+        {_("Undo States"), &memoryInfo.undoStates},
+        {_("Nodes Parsed Not Loaded"), &memoryInfo.delayedXmlDocs},
+        {_("Text Tags"), &memoryInfo.textTags},
+    };
+}
+
+std::vector<std::pair<gint64, const CtMemoryNodeInfo*>> CtMiscUtil::get_memory_info_nodes_sorted(const CtMemoryInfo& memoryInfo)
+{
+    std::vector<std::pair<gint64, const CtMemoryNodeInfo*>> nodes;
+    nodes.reserve(memoryInfo.nodes.size());
+    for (const auto& [node_id, nodeInfo] : memoryInfo.nodes) {
+        nodes.push_back(std::make_pair(node_id, &nodeInfo));
+    }
+    std::stable_sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b){
+        return a.second->get_bytes() > b.second->get_bytes();
+    });
+    return nodes;
+}
+
+std::string CtMiscUtil::get_memory_info_report(const CtMemoryInfo& memoryInfo, const size_t nodes_max)
+{
+    std::string report = fmt::format("{:<28} {:>10} {:>12}\n", _("Memory (estimate)"), _("Count"), _("Size"));
+    for (const auto& [name, pMemoryCount] : get_memory_info_categories(memoryInfo)) {
+        report += fmt::format("{:<28} {:>10} {:>12}\n", name.raw(), pMemoryCount->num, bytes_to_human_readable(pMemoryCount->bytes));
+    }
+    report += fmt::format("{:<28} {:>10} {:>12}\n", _("Total"), "", bytes_to_human_readable(memoryInfo.get_total_bytes()));
+    const std::vector<std::pair<gint64, const CtMemoryNodeInfo*>> nodes = get_memory_info_nodes_sorted(memoryInfo);
+    for (size_t i = 0u; i < nodes.size() and i < nodes_max; ++i) {
+        const CtMemoryNodeInfo* pNodeInfo = nodes[i].second;
+        report += fmt::format("{} [{}] {}: {} {}, {} {} {}, {} {} {}, {} {}\n",
+                              pNodeInfo->node_name.raw(), nodes[i].first,
+                              bytes_to_human_readable(pNodeInfo->get_bytes()),
+                              _("Text"), bytes_to_human_readable(pNodeInfo->textBuffer.bytes),
+                              pNodeInfo->widgets.num, _("Objects"), bytes_to_human_readable(pNodeInfo->widgets.bytes),
+                              pNodeInfo->undoStates.num, _("Undo States"), bytes_to_human_readable(pNodeInfo->undoStates.bytes),
+                              _("Parsed Not Loaded"), bytes_to_human_readable(pNodeInfo->delayedXmlDoc.bytes));
+    }
+    return report;
+}
+
 CtMiscUtil::URI_TYPE CtMiscUtil::get_uri_type(const std::string &uri)
 {
     constexpr std::array<std::string_view, 2> http_ids = {"https://", "http://"};
@@ -449,42 +488,10 @@ bool CtMiscUtil::system_cmd(const char* shell_cmd, const char* cwd)
     return success;
 }
 
-// analog to tbb::parallel_for
+// analog to tbb::parallel_for, on the application wide task pool
 void CtMiscUtil::parallel_for(size_t first, size_t last, std::function<void(size_t)> f)
 {
-    size_t concur_num = std::thread::hardware_concurrency();
-    if (concur_num == 0) concur_num = 4;
-    if (first == last) return;
-    if (last < first) return;
-    if (last - first < concur_num) // to make slice calc simpler
-        concur_num = last - first;
-    size_t slice_item_num = (last - first) / concur_num;
-    size_t slice_leftover = (last - first) % concur_num;
-
-    std::list<std::thread> td_tasks;
-    size_t td_first = first;
-    for  (size_t thread_index = 0; thread_index < concur_num; ++thread_index)
-    {
-        std::packaged_task<void(size_t, size_t)> task([f](size_t slice_start, size_t slice_end)
-        {
-            for (size_t index = slice_start; index < slice_end; ++index)
-                f(index);
-        });
-
-        size_t td_slice = slice_item_num;
-        if (slice_leftover != 0) {
-            td_slice += 1;
-            slice_leftover -= 1;
-        }
-        if (td_first + td_slice > last)
-            td_slice = last - td_first;
-
-        td_tasks.emplace_back(std::thread(std::move(task), td_first, td_first + td_slice));
-        td_first += td_slice;
-    }
-
-    for (auto& task: td_tasks)
-        task.join();
+    CtTaskPool::get().parallel_for(first, last, f);
 }
 
 std::optional<Glib::ustring> CtTextIterUtil::iter_get_tag_startingwith(const Gtk::TextIter& iter, const Glib::ustring& tag_startwith)
@@ -509,6 +516,22 @@ Glib::ustring CtTextIterUtil::get_selected_text(Glib::RefPtr<Gtk::TextBuffer> pT
     return Glib::ustring{};
 }
 
+void CtTextIterUtil::text_for_each_chunk(Gtk::TextIter start_iter,
+                                         const Gtk::TextIter& end_iter,
+                                         const std::function<void(const Glib::ustring& chunk)>& f_chunk)
+{
+    constexpr int CHUNK_CHARS{1024*1024};
+    while (start_iter.compare(end_iter) < 0) {
+        Gtk::TextIter chunk_end = start_iter;
+        chunk_end.forward_chars(CHUNK_CHARS);
+        if (chunk_end.compare(end_iter) > 0) {
+            chunk_end = end_iter;
+        }
+        f_chunk(start_iter.get_text(chunk_end));
+        start_iter = chunk_end;
+    }
+}
+
 bool CtTextIterUtil::get_is_camel_case(Gtk::TextIter text_iter, int num_chars)
 {
     int curr_state{0};
@@ -668,9 +691,18 @@ bool CtTextIterUtil::rich_text_attributes_update(const Gtk::TextIter& text_iter,
         else if (str::startswith(tag_name, CtConst::TAG_UNDERLINE_PREFIX)) delta_attributes[CtConst::TAG_UNDERLINE] = tag_name.substr(10);
         else if (str::startswith(tag_name, CtConst::TAG_STRIKETHROUGH_PREFIX)) delta_attributes[CtConst::TAG_STRIKETHROUGH] = tag_name.substr(14);
         else if (str::startswith(tag_name, CtConst::TAG_INDENT_PREFIX)) delta_attributes[CtConst::TAG_INDENT] = tag_name.substr(7);
-        else if (str::startswith(tag_name, CtConst::TAG_LINK_PREFIX)) delta_attributes[CtConst::TAG_LINK] = tag_name.substr(5);
+        else if (str::startswith(tag_name, CtConst::TAG_LINK_PREFIX)) delta_attributes[CtConst::TAG_LINK] = CtLinksIndex::get_target_at(text_iter);
         else if (str::startswith(tag_name, CtConst::TAG_FAMILY_PREFIX)) delta_attributes[CtConst::TAG_FAMILY] = tag_name.substr(7);
     }
+    // two links of the same type side by side share the tag, the boundary is a new target in the links index
+    if (0 == delta_attributes.count(CtConst::TAG_LINK)) {
+        auto keyFound = curr_attributes.find(CtConst::TAG_LINK);
+        if (keyFound != curr_attributes.end() and not keyFound->second.empty()) {
+            if (const gchar* pLinkTarget = CtLinksIndex::get_target_starting_at(text_iter)) {
+                delta_attributes[CtConst::TAG_LINK] = pLinkTarget;
+            }
+        }
+    }
     bool anyDelta{false};
     for (const auto& currDelta : delta_attributes) {
         auto keyFound = curr_attributes.find(currDelta.first);
@@ -1563,15 +1595,10 @@ Glib::ustring str::sanitize_bad_symbols(const Glib::ustring& xml_content)
 }
 
 struct DiacrToAscii {
-    DiacrToAscii(const char* replacement_, const char* pattern_)
-     : replacement{replacement_}
-     , pattern{pattern_}
-    {}
-    Glib::ustring replacement;
-    Glib::ustring pattern;
-    Glib::RefPtr<Glib::Regex> pRegExp;
+    const char* replacement;
+    const char* pattern;
 };
-static std::list<DiacrToAscii> list_DiacrToAscii{
+static const DiacrToAscii list_DiacrToAscii[]{
     {"a", "[àáâãäåāăąạ]"},
     {"A", "[ÀÁÂÃÄÅĀĂĄẠ]"},
     {"b", "[ḅ]"},
@@ -1615,25 +1642,41 @@ static std::list<DiacrToAscii> list_DiacrToAscii{
     {"z", "[źżžẓ]"},
     {"Z", "[ŹŻŽẒ]"},
 };
-static bool list_DiacrToAscii_initialised{false};
 
 // https://docs.oracle.com/cd/E29584_01/webhelp/mdex_basicDev/src/rbdv_chars_mapping.html
 Glib::ustring str::diacritical_to_ascii(const Glib::ustring& in_text)
 {
-    const Glib::RegexMatchFlags re_flags{static_cast<Glib::RegexMatchFlags>(0u)};
-    Glib::ustring tmp_str{in_text};
-    if (not list_DiacrToAscii_initialised) {
-        list_DiacrToAscii_initialised = true;
-        for (DiacrToAscii& curr_DiacrToAscii : list_DiacrToAscii) {
-            curr_DiacrToAscii.pRegExp = Glib::Regex::create(curr_DiacrToAscii.pattern);
+    // every symbol in the brackets becomes the ascii char, so the symbols positions do not change
+    static const std::unordered_map<gunichar, char> mapDiacrToAscii = [](){
+        std::unordered_map<gunichar, char> retMap;
+        for (const DiacrToAscii& curr_DiacrToAscii : list_DiacrToAscii) {
+            const Glib::ustring pattern{curr_DiacrToAscii.pattern};
+            for (gunichar ch : pattern.substr(1, pattern.size() - 2)) {
+                retMap[ch] = curr_DiacrToAscii.replacement[0];
+            }
         }
-    }
-    for (DiacrToAscii& curr_DiacrToAscii : list_DiacrToAscii) {
-        if (curr_DiacrToAscii.pRegExp->match(tmp_str, re_flags)) {
-            tmp_str = curr_DiacrToAscii.pRegExp->replace(tmp_str, 0/*start_position*/, curr_DiacrToAscii.replacement, re_flags);
+        return retMap;
+    }();
+    const std::string& in_raw = in_text.raw();
+    std::string out_raw;
+    out_raw.reserve(in_raw.size());
+    for (size_t pos = 0u; pos < in_raw.size(); ) {
+        if (static_cast<unsigned char>(in_raw[pos]) < 0x80u) {
+            out_raw += in_raw[pos++];
+            continue;
+        }
+        const char* pChar = in_raw.data() + pos;
+        const size_t charLen = static_cast<size_t>(g_utf8_next_char(pChar) - pChar);
+        const auto mapIter = mapDiacrToAscii.find(g_utf8_get_char(pChar));
+        if (mapIter != mapDiacrToAscii.end()) {
+            out_raw += mapIter->second;
+        }
+        else {
+            out_raw.append(pChar, charLen);
         }
+        pos += charLen;
     }
-    return tmp_str;
+    return out_raw;
 }
 
 Glib::ustring str::re_escape(const Glib::ustring& text)
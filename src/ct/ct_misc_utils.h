@@ -33,6 +33,7 @@
 #include <gtkmm/treestore.h>
 #include <gtksourceview/gtksource.h>
 #include <numeric>
+#include <type_traits>
 
 /*
  * Compatibility shim: gtkmm4 removed the BuiltinIconSize enum that existed in
@@ -182,6 +183,45 @@ std::string get_doc_extension(const CtDocType ctDocType, const CtDocEncrypt ctDo
 
 void filepath_extension_fix(const CtDocType ctDocType, const CtDocEncrypt ctDocEncrypt, std::string& filepath);
 
+template<class TreeOrListStore>
+std::vector<Gtk::TreeModel::iterator> get_siblings_iters(Glib::RefPtr<TreeOrListStore> model,
+                                                         const Gtk::TreeNodeChildren& children)
+{
+    std::vector<Gtk::TreeModel::iterator> siblings_iters;
+    siblings_iters.reserve(children.size());
+    for (auto iter = children.begin(); iter != children.end(); ++iter) {
+        #if GTKMM_MAJOR_VERSION >= 4
+        siblings_iters.push_back(model->get_iter(model->get_path(iter)));
+        #else
+        (void)model;
+        siblings_iters.push_back(iter);
+        #endif
+    }
+    return siblings_iters;
+}
+
+// new_order[new_pos] = old_pos, applied with a single reorder (one rows-reordered signal)
+template<class TreeOrListStore>
+bool siblings_reorder(Glib::RefPtr<TreeOrListStore> model,
+                      const Gtk::TreeNodeChildren& children,
+                      const std::vector<int>& new_order)
+{
+    bool order_changed{false};
+    for (size_t pos = 0; pos < new_order.size() and not order_changed; ++pos) {
+        order_changed = static_cast<int>(pos) != new_order[pos];
+    }
+    if (order_changed) {
+        if constexpr (std::is_base_of<Gtk::TreeStore, TreeOrListStore>::value) {
+            model->reorder(children, new_order);
+        }
+        else {
+            (void)children;
+            model->reorder(new_order);
+        }
+    }
+    return order_changed;
+}
+
 template<class TreeOrListStore>
 bool node_siblings_sort(Glib::RefPtr<TreeOrListStore> model,
                         const Gtk::TreeNodeChildren& children,
@@ -193,21 +233,12 @@ bool node_siblings_sort(Glib::RefPtr<TreeOrListStore> model,
         return false;
     }
 
-    std::vector<Gtk::TreeModel::iterator> initial_iters;
-    initial_iters.reserve(children_count);
-    for (auto iter = children.begin(); iter != children.end(); ++iter) {
-        #if GTKMM_MAJOR_VERSION >= 4
-        initial_iters.push_back(model->get_iter(model->get_path(iter)));
-        #else
-        initial_iters.push_back(iter);
-        #endif
-    }
+    std::vector<Gtk::TreeModel::iterator> initial_iters = get_siblings_iters(model, children);
 
-    std::vector<size_t> current_order(children_count);
-    std::iota(current_order.begin(), current_order.end(), 0u);
-    std::vector<size_t> target_order = current_order;
+    std::vector<int> new_order(children_count);
+    std::iota(new_order.begin(), new_order.end(), 0);
 
-    auto less_than = [&f_need_swap, &initial_iters](const size_t left_idx, const size_t right_idx)->bool {
+    auto less_than = [&f_need_swap, &initial_iters](const int left_idx, const int right_idx)->bool {
         Gtk::TreeModel::iterator left_iter = initial_iters.at(left_idx);
         Gtk::TreeModel::iterator right_iter = initial_iters.at(right_idx);
         // f_need_swap(left, right) means left should go after right.
@@ -215,50 +246,39 @@ bool node_siblings_sort(Glib::RefPtr<TreeOrListStore> model,
         return f_need_swap(right_iter, left_iter);
     };
 
-    std::stable_sort(target_order.begin() + start_offset,
-                     target_order.end(),
+    std::stable_sort(new_order.begin() + start_offset,
+                     new_order.end(),
                      less_than);
 
-    auto get_iter_by_pos = [&children, &model](size_t pos)->Gtk::TreeModel::iterator {
-        auto iter = children.begin();
-        while (pos-- > 0u && iter) {
-            ++iter;
-        }
-        #if GTKMM_MAJOR_VERSION >= 4
-        if (!iter) {
-            return Gtk::TreeModel::iterator{};
-        }
-        return model->get_iter(model->get_path(iter));
-        #else
-        return iter;
-        #endif
-    };
-
-    bool swap_executed{false};
-    for (size_t pos = start_offset; pos < children_count; ++pos) {
-        if (current_order[pos] == target_order[pos]) {
-            continue;
-        }
+    return siblings_reorder(model, children, new_order);
+}
 
-        size_t swap_pos = pos + 1u;
-        while (swap_pos < children_count && current_order[swap_pos] != target_order[pos]) {
-            ++swap_pos;
-        }
-        if (swap_pos >= children_count) {
-            spdlog::error("node_siblings_sort: cannot resolve reorder permutation");
-            return swap_executed;
-        }
+// as node_siblings_sort but the sort key of every sibling is read only once
+template<class TreeOrListStore, class FGetKey, class FLess>
+bool node_siblings_sort_by_key(Glib::RefPtr<TreeOrListStore> model,
+                               const Gtk::TreeNodeChildren& children,
+                               FGetKey f_get_key,
+                               FLess f_less)
+{
+    const size_t children_count = children.size();
+    if (children_count <= 1u) {
+        return false;
+    }
 
-        Gtk::TreeModel::iterator left_iter = get_iter_by_pos(pos);
-        Gtk::TreeModel::iterator right_iter = get_iter_by_pos(swap_pos);
-        if (left_iter && right_iter) {
-            model->iter_swap(left_iter, right_iter);
-            std::swap(current_order[pos], current_order[swap_pos]);
-            swap_executed = true;
-        }
+    using Key = std::decay_t<decltype(f_get_key(std::declval<Gtk::TreeModel::iterator&>()))>;
+    std::vector<Key> keys;
+    keys.reserve(children_count);
+    for (Gtk::TreeModel::iterator& iter : get_siblings_iters(model, children)) {
+        keys.push_back(f_get_key(iter));
     }
 
-    return swap_executed;
+    std::vector<int> new_order(children_count);
+    std::iota(new_order.begin(), new_order.end(), 0);
+    std::stable_sort(new_order.begin(), new_order.end(), [&keys, &f_less](const int left_idx, const int right_idx) {
+        return f_less(keys[left_idx], keys[right_idx]);
+    });
+
+    return siblings_reorder(model, children, new_order);
 }
 
 std::string get_node_hierarchical_name(const CtTreeIter tree_iter, const char* separator="--",
@@ -289,6 +309,14 @@ void parallel_for(size_t first, size_t last, std::function<void(size_t)> f);
 
 bool text_file_set_contents_add_cr_on_win(const std::string& filepath, const std::string& text_content);
 
+std::string bytes_to_human_readable(const size_t bytes);
+
+// the categories with their names, for the dialog and the command line
+std::vector<std::pair<Glib::ustring, const CtMemoryCount*>> get_memory_info_categories(const CtMemoryInfo& memoryInfo);
+// the nodes with anything in memory, the heaviest first
+std::vector<std::pair<gint64, const CtMemoryNodeInfo*>> get_memory_info_nodes_sorted(const CtMemoryInfo& memoryInfo);
+std::string get_memory_info_report(const CtMemoryInfo& memoryInfo, const size_t nodes_max);
+
 } // namespace CtMiscUtil
 
 namespace CtTextIterUtil {
@@ -305,6 +333,11 @@ bool startswith_url(Gtk::TextIter text_iter);
 
 Glib::ustring get_selected_text(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer);
 
+// the text in the range a slice at a time, not to copy the text of a large node whole
+void text_for_each_chunk(Gtk::TextIter start_iter,
+                         const Gtk::TextIter& end_iter,
+                         const std::function<void(const Glib::ustring& chunk)>& f_chunk);
+
 template<class type>
 const gchar* get_str_pointer(const type& str)
 {
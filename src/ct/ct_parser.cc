@@ -715,13 +715,13 @@ std::vector<CtTextParser::token_schema> CtZimParser::_token_schemas()
 void CtZimParser::_parse_body_line(const std::string& line)
 {
     auto tokens_raw = _text_parser->tokenize(line);
-    auto tokens = _text_parser->parse_tokens(tokens_raw);
+    auto token_stream = _text_parser->parse_tokens(tokens_raw);
 
-    for (const auto& token : tokens) {
+    for (const auto& token : token_stream.tokens) {
         if (token.first) {
-            token.first->action(token.second);
+            token.first->action(std::string{token.second});
         } else {
-            doc_builder().add_text(token.second);
+            doc_builder().add_text(std::string{token.second});
         }
 
     }
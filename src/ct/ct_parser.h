@@ -175,16 +175,29 @@ public:
     const tags_map_t& close_tokens_map() const { return _close_tokens_map; }
     const std::vector<token_schema>& token_schemas() const { return _token_schemas; }
     const pos_tokens_t& pos_tokens() const { return _possible_tokens; }
+    /// The contents are views on the text given to tokenize(), unless joined from tokens not
+    /// contiguous in the text (e.g. around an escape) and then kept in joined_contents
+    struct token_stream_t {
+        std::vector<std::pair<const token_schema*, std::string_view>> tokens;
+        std::list<std::string> joined_contents;
+    };
+
      /**
      * @brief Transform an input string into a token stream
      * @param tokens
      * @return
      */
-    std::vector<std::pair<const token_schema*, std::string>> parse_tokens(const std::vector<std::string>& tokens) const;
+    token_stream_t parse_tokens(const std::vector<std::string_view>& tokens) const;
 
-    std::vector<std::string> tokenize(const std::string& text) const;
+    /// The tokens are views on the text, that must outlive them
+    std::vector<std::string_view> tokenize(const std::string_view text) const;
 
 private:
+    using tokens_const_iter_t = std::vector<std::string_view>::const_iterator;
+    void _parse_tokens(tokens_const_iter_t token,
+                       const tokens_const_iter_t tokens_end,
+                       token_stream_t& token_stream) const;
+
     /// Tokens to be cached by the parser
     const std::vector<token_schema> _token_schemas;
 
@@ -222,6 +235,8 @@ public:
     CtMDParser(CtConfig* config, std::shared_ptr<CtTextParser> parser) : CtDocBuildingParser{config} , _text_parser{std::move(parser)}{}
 
     void feed(const Glib::ustring& stream) override;
+    /// Feed utf-8 text without copying it (e.g. a memory mapped file)
+    void feed_raw(const std::string_view stream);
 
     virtual ~CtMDParser() = default;
 
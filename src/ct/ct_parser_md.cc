@@ -206,10 +206,16 @@ void CtMDParser::_place_free_text()
 }
 
 void CtMDParser::feed(const Glib::ustring& buffer)
+{
+    feed_raw(buffer.raw());
+}
+
+void CtMDParser::feed_raw(const std::string_view buffer)
 {
     try {
-        auto tokens_raw = _text_parser->tokenize(buffer);
-        auto tokens     = _text_parser->parse_tokens(tokens_raw);
+        auto tokens_raw   = _text_parser->tokenize(buffer);
+        auto token_stream = _text_parser->parse_tokens(tokens_raw);
+        auto& tokens      = token_stream.tokens;
 
         for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
             if (iter->first) {
@@ -218,14 +224,14 @@ void CtMDParser::feed(const Glib::ustring& buffer)
                 if ((iter + 1) != tokens.end()) {
                     if (!(iter + 1)->first && ((iter + 1)->second == ")")) {
                         // Excess bracket from link
-                        iter->first->action(iter->second + ")");
+                        iter->first->action(std::string{iter->second} + ")");
                         ++iter;
                         if ((iter + 1) != tokens.end()) ++iter;
 
                         continue;
                     }
                 }
-                iter->first->action(iter->second);
+                iter->first->action(std::string{iter->second});
             }
             else {
                 if (!iter->second.empty()) {
@@ -234,7 +240,7 @@ void CtMDParser::feed(const Glib::ustring& buffer)
                         doc_builder().add_newline();
                     }
                     if (_current_table.empty()) {
-                        _free_text += iter->second;
+                        _free_text.append(iter->second.begin(), iter->second.end());
                     }
                 }
             }
@@ -244,7 +250,7 @@ void CtMDParser::feed(const Glib::ustring& buffer)
         _place_free_text();
     }
     catch (std::exception& e) {
-        spdlog::error("Exception while parsing '{}': {}", buffer.c_str(), e.what());
+        spdlog::error("Exception while parsing '{}': {}", buffer, e.what());
     }
 }
 
@@ -26,25 +26,16 @@
 
 namespace {
 
-template<class ITER_T>
-bool do_token_branch(ITER_T begin, ITER_T end, std::string_view match) {
-    std::string buff;
-    while ((begin != end) && (buff.size() < match.size())) {
-        buff += *begin;
-        if (buff == match) {
-            return true;
-        }
-        ++begin;
-    }
-    return false;
+bool do_token_branch(const std::string_view text, std::string_view match) {
+    return not match.empty() and 0 == text.compare(0, match.size(), match);
 }
 
-template<class ITER_T, class STR_T>
-std::optional<STR_T> branch_token(ITER_T begin, ITER_T end, const std::vector<STR_T>& options) {
+template<class STR_T>
+std::optional<STR_T> branch_token(const std::string_view text, const std::vector<STR_T>& options) {
     std::size_t largest_len = 0;
     std::optional<STR_T> largest = std::nullopt;
     for (const auto& opt : options) {
-        if (do_token_branch(begin, end, opt)) {
+        if (do_token_branch(text, opt)) {
             // Do a greedy match
             if (opt.length() > largest_len) {
                 largest_len = opt.length();
@@ -99,58 +90,107 @@ CtTextParser::CtTextParser(std::vector<token_schema>&& token_schemas) : _token_s
 
 
 
-std::vector<std::string> CtTextParser::tokenize(const std::string& text) const
+std::vector<std::string_view> CtTextParser::tokenize(const std::string_view text) const
 {
 
-    std::vector<std::string> tokens;
-    std::string::const_iterator last_pos = text.begin();
-    for (auto ch = text.begin(); ch != text.end(); ++ch) {
-
-        if (*ch == ' ') {
-            if (last_pos != ch) tokens.emplace_back(last_pos, ch);
-            last_pos = ch;
+    std::vector<std::string_view> tokens;
+    size_t last_pos = 0;
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+        const char ch = text[pos];
+        if (ch == ' ') {
+            if (last_pos != pos) tokens.push_back(text.substr(last_pos, pos - last_pos));
+            last_pos = pos;
             continue;
         }
-        if (*ch == '\\') {
+        if (ch == '\\') {
             // Escape next char
-            if (last_pos != ch) tokens.emplace_back(last_pos, ch);
-            ++ch;
-            last_pos = ch;
-            if (ch == text.end()) break;
+            if (last_pos != pos) tokens.push_back(text.substr(last_pos, pos - last_pos));
+            ++pos;
+            last_pos = pos;
+            if (pos == text.size()) break;
             continue;
         }
 
-        auto pos_token = _possible_tokens.find(*ch);
+        auto pos_token = _possible_tokens.find(ch);
         if (pos_token != _possible_tokens.end()){
-            auto found_token = branch_token(ch, text.end(), pos_token->second);
+            auto found_token = branch_token(text.substr(pos), pos_token->second);
             if (found_token) {
                 spdlog::debug("TOKEN: {}", *found_token);
-                tokens.emplace_back(last_pos, ch);
-                tokens.emplace_back(*found_token);
-                ch += found_token->length() - 1;
-                last_pos = ch + 1;
+                tokens.push_back(text.substr(last_pos, pos - last_pos));
+                tokens.push_back(text.substr(pos, found_token->length()));
+                pos += found_token->length() - 1;
+                last_pos = pos + 1;
             }
-
-            if (ch == text.end()) break;
         }
     }
-    if (last_pos != text.end()) {
-        tokens.emplace_back(last_pos, text.end());
+    if (last_pos < text.size()) {
+        tokens.push_back(text.substr(last_pos));
     }
     return tokens;
 }
 
-std::vector<std::pair<const CtTextParser::token_schema *, std::string>> CtTextParser::parse_tokens(const std::vector<std::string>& tokens) const
+namespace {
+
+// the contents of a tag, a view on the text while the tokens added are contiguous
+struct CtTokensSpan
+{
+    std::string_view view;
+    std::string      joined;
+    bool             is_joined{false};
+
+    void append(const std::string_view token) {
+        if (is_joined) {
+            joined += token;
+        }
+        else if (view.empty()) {
+            view = token;
+        }
+        else if (view.data() + view.size() == token.data()) {
+            view = std::string_view{view.data(), view.size() + token.size()};
+        }
+        else {
+            joined = std::string{view};
+            joined += token;
+            is_joined = true;
+        }
+    }
+    std::string_view take(std::list<std::string>& joined_contents) {
+        std::string_view retVal = view;
+        if (is_joined) {
+            joined_contents.push_back(std::move(joined));
+            retVal = joined_contents.back();
+        }
+        clear();
+        return retVal;
+    }
+    void clear() {
+        view = std::string_view{};
+        joined.clear();
+        is_joined = false;
+    }
+};
+
+} // namespace (anonymous)
+
+CtTextParser::token_stream_t CtTextParser::parse_tokens(const std::vector<std::string_view>& tokens) const
+{
+    token_stream_t token_stream;
+    _parse_tokens(tokens.begin(), tokens.end(), token_stream);
+    return token_stream;
+}
+
+void CtTextParser::_parse_tokens(tokens_const_iter_t token,
+                                 const tokens_const_iter_t tokens_end,
+                                 token_stream_t& token_stream) const
 {
-    std::vector<std::pair<const token_schema *, std::string>> token_stream;
-    std::unordered_map<std::string_view, bool>                open_tags;
-    std::pair<std::vector<const token_schema *>, std::string> curr_open_tags;
-    bool                                                      keep_parsing     = true;
-    auto                                                      &token_map_open  = open_tokens_map();
-    auto                                                      &token_map_close = close_tokens_map();
+    std::unordered_map<std::string_view, bool>                 open_tags;
+    std::pair<std::vector<const token_schema *>, CtTokensSpan> curr_open_tags;
+    bool                                                       keep_parsing     = true;
+    auto                                                       &token_map_open  = open_tokens_map();
+    auto                                                       &token_map_close = close_tokens_map();
     int  nb_open_tags = 0;
 
-    for (auto token = tokens.begin(); token != tokens.end(); ++token) {
+    for (; token != tokens_end; ++token) {
 
         if (token->empty()) continue;
 
@@ -172,19 +212,17 @@ std::vector<std::pair<const CtTextParser::token_schema *, std::string>> CtTextPa
                     ++token;
                     if (keep_parsing) {
                         // Parse the other data in the stream
-                        token_stream.emplace_back(tokens_iter->second, "");
-                        std::vector<std::string> rem_tokens(token, tokens.end());
-                        auto tokonised_stream = parse_tokens(rem_tokens);
-                        token_stream.insert(token_stream.end(), tokonised_stream.begin(), tokonised_stream.end());
+                        token_stream.tokens.emplace_back(tokens_iter->second, "");
+                        _parse_tokens(token, tokens_end, token_stream);
                     } else {
-                        std::string buff;
-                        while (token != tokens.end()) {
-                            buff += *token;
+                        CtTokensSpan buff;
+                        while (token != tokens_end) {
+                            buff.append(*token);
                             ++token;
                         }
-                        token_stream.emplace_back(tokens_iter->second, buff);
+                        token_stream.tokens.emplace_back(tokens_iter->second, buff.take(token_stream.joined_contents));
                     }
-                    return token_stream;
+                    return;
                 }
                 open_tags[tokens_iter->first] = true;
                 continue;
@@ -196,30 +234,30 @@ std::vector<std::pair<const CtTextParser::token_schema *, std::string>> CtTextPa
         if (token_iter != token_map_close.end()) {
             if (curr_open_tags.first.empty()) {
                 spdlog::debug("Found close tag without open: {}, assuming escaped", *token);
-                token_stream.emplace_back(nullptr, *token);
+                token_stream.tokens.emplace_back(nullptr, *token);
                 continue;
             }
 
             if (!keep_parsing) {
                 if (curr_open_tags.first.front()->close_tag != *token) {
-                    curr_open_tags.second += *token;
+                    curr_open_tags.second.append(*token);
                     continue;
                 } else if (curr_open_tags.first.front()->close_tag == *token) {
                     if (nb_open_tags > 1) {
                         --nb_open_tags;
-                        curr_open_tags.second += *token;
+                        curr_open_tags.second.append(*token);
                         continue;
                     }
                 }
             }
 
 
-            token_stream.emplace_back(curr_open_tags.first.front(), curr_open_tags.second);
+            token_stream.tokens.emplace_back(curr_open_tags.first.front(), curr_open_tags.second.take(token_stream.joined_contents));
 
             if (curr_open_tags.first.size() >= 2) {
                 // Found more than one tag
                 for (auto iter = curr_open_tags.first.begin() + 1; iter != curr_open_tags.first.end(); ++iter) {
-                    if ((*iter)->open_tag != curr_open_tags.first.front()->open_tag) token_stream.emplace_back(*iter, "");
+                    if ((*iter)->open_tag != curr_open_tags.first.front()->open_tag) token_stream.tokens.emplace_back(*iter, "");
                 }
             }
             open_tags[token_iter->first] = false;
@@ -229,13 +267,11 @@ std::vector<std::pair<const CtTextParser::token_schema *, std::string>> CtTextPa
             curr_open_tags.second.clear();
             curr_open_tags.first.clear();
         } else if (curr_open_tags.first.empty()) {
-            token_stream.emplace_back(nullptr, *token);
+            token_stream.tokens.emplace_back(nullptr, *token);
         } else if (!curr_open_tags.first.empty()) {
-            curr_open_tags.second += *token;
+            curr_open_tags.second.append(*token);
         }
     }
-
-    return token_stream;
 }
 
 std::unordered_set<char> shred(const std::vector<std::string>& strings) {
@@ -472,7 +508,7 @@ std::pair<Gtk::TextIter, Gtk::TextIter> CtTextParser::find_formatting_boundaries
 
     Glib::ustring token_str(start_bounds, word_end);
 
-    auto tokens = tokenize(token_str);
+    auto tokens = tokenize(token_str.raw());
     auto& close_tags = close_tokens_map();
 
     // Forward match
@@ -35,14 +35,44 @@ Gtk::Widget* CtPrefDlg::build_tab_plain_text_n_code()
     auto checkbutton_pt_highl_match_bra = Gtk::manage(new Gtk::CheckButton{_("Highlight Matching Brackets")});
     checkbutton_pt_highl_match_bra->set_active(_pConfig->ptHighlMatchBra);
 
+    auto hbox_large_node = Gtk::manage(new Gtk::Box{Gtk::ORIENTATION_HORIZONTAL, 4/*spacing*/});
+    auto label_large_node = Gtk::manage(new Gtk::Label{_("Large Node Mode Above")});
+    Glib::RefPtr<Gtk::Adjustment> adj_large_node = Gtk::Adjustment::create(_pConfig->largeNodeKb, 0, 1048576, 256);
+    auto spinbutton_large_node = Gtk::manage(new Gtk::SpinButton{adj_large_node});
+    spinbutton_large_node->set_value(_pConfig->largeNodeKb);
+    auto hbox_large_node_ro = Gtk::manage(new Gtk::Box{Gtk::ORIENTATION_HORIZONTAL, 4/*spacing*/});
+    auto label_large_node_ro = Gtk::manage(new Gtk::Label{_("Large Node Read Only Above")});
+    Glib::RefPtr<Gtk::Adjustment> adj_large_node_ro = Gtk::Adjustment::create(_pConfig->largeNodeReadOnlyKb, 0, 1048576, 1024);
+    auto spinbutton_large_node_ro = Gtk::manage(new Gtk::SpinButton{adj_large_node_ro});
+    spinbutton_large_node_ro->set_value(_pConfig->largeNodeReadOnlyKb);
+    auto size_group_large_node = Gtk::SizeGroup::create(Gtk::SizeGroupMode::SIZE_GROUP_HORIZONTAL);
+    size_group_large_node->add_widget(*label_large_node);
+    size_group_large_node->add_widget(*label_large_node_ro);
+
 #if GTKMM_MAJOR_VERSION >= 4
+    hbox_large_node->append(*label_large_node);
+    hbox_large_node->append(*spinbutton_large_node);
+    hbox_large_node->append(*Gtk::manage(new Gtk::Label{"KB"}));
+    hbox_large_node_ro->append(*label_large_node_ro);
+    hbox_large_node_ro->append(*spinbutton_large_node_ro);
+    hbox_large_node_ro->append(*Gtk::manage(new Gtk::Label{"KB"}));
     vbox_syntax->append(*checkbutton_pt_show_white_spaces);
     vbox_syntax->append(*checkbutton_pt_highl_curr_line);
     vbox_syntax->append(*checkbutton_pt_highl_match_bra);
+    vbox_syntax->append(*hbox_large_node);
+    vbox_syntax->append(*hbox_large_node_ro);
 #else
+    hbox_large_node->pack_start(*label_large_node, false, false);
+    hbox_large_node->pack_start(*spinbutton_large_node, false, false);
+    hbox_large_node->pack_start(*Gtk::manage(new Gtk::Label{"KB"}), false, false);
+    hbox_large_node_ro->pack_start(*label_large_node_ro, false, false);
+    hbox_large_node_ro->pack_start(*spinbutton_large_node_ro, false, false);
+    hbox_large_node_ro->pack_start(*Gtk::manage(new Gtk::Label{"KB"}), false, false);
     vbox_syntax->pack_start(*checkbutton_pt_show_white_spaces, false, false);
     vbox_syntax->pack_start(*checkbutton_pt_highl_curr_line, false, false);
     vbox_syntax->pack_start(*checkbutton_pt_highl_match_bra, false, false);
+    vbox_syntax->pack_start(*hbox_large_node, false, false);
+    vbox_syntax->pack_start(*hbox_large_node_ro, false, false);
 #endif
 
     Gtk::Frame* frame_syntax = new_managed_frame_with_align(_("Text Editor"), vbox_syntax);
@@ -231,6 +261,12 @@ Gtk::Widget* CtPrefDlg::build_tab_plain_text_n_code()
         _pConfig->ptHighlMatchBra = checkbutton_pt_highl_match_bra->get_active();
         apply_for_each_window([](CtMainWin* win) { win->reapply_syntax_highlighting('p'/*PlainTextNCode*/); });
     });
+    spinbutton_large_node->signal_value_changed().connect([this, spinbutton_large_node](){
+        _pConfig->largeNodeKb = spinbutton_large_node->get_value_as_int();
+    });
+    spinbutton_large_node_ro->signal_value_changed().connect([this, spinbutton_large_node_ro](){
+        _pConfig->largeNodeReadOnlyKb = spinbutton_large_node_ro->get_value_as_int();
+    });
     checkbutton_code_exec_confirm->signal_toggled().connect([this, checkbutton_code_exec_confirm](){
         _pConfig->codeExecConfirm = checkbutton_code_exec_confirm->get_active();
     });
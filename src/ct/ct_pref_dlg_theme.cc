@@ -489,7 +489,7 @@ Gtk::Widget* CtPrefDlg::build_tab_theme()
     pVBoxIconTheme->pack_start(*pButtonDefaultIcons, false, false);
 #endif
 
-    auto f_removeConfigIconsAndCopyFrom = [](const char* folderName){
+    auto f_removeConfigIconsAndCopyFrom = [this](const char* folderName){
         fs::path ConfigIcons_dst = fs::get_cherrytree_config_icons_dirpath();
         if (fs::exists(ConfigIcons_dst)) {
             fs::remove_all(ConfigIcons_dst);
@@ -507,6 +507,10 @@ Gtk::Widget* CtPrefDlg::build_tab_theme()
     #else
         Gtk::IconTheme::get_default()->rescan_if_needed();
     #endif
+        apply_for_each_window([](CtMainWin* win) {
+            win->window_header_update();
+            win->get_tree_store().update_nodes_icon(Gtk::TreeModel::iterator{}, false);
+        });
     };
 
     pButtonBreezeDarkIcons->signal_clicked().connect([f_removeConfigIconsAndCopyFrom](){
@@ -0,0 +1,117 @@
+/*
+ * ct_search_matcher.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_search_matcher.h"
+#include <glib.h>
+#include <algorithm>
+#include <string_view>
+
+namespace {
+
+inline char ascii_tolower(const char ch)
+{
+    return ('A' <= ch and ch <= 'Z') ? ch + ('a' - 'A') : ch;
+}
+
+// as \w of Glib::Regex, which matches with the unicode properties
+bool is_word_char(const gunichar ch)
+{
+    return g_unichar_isalnum(ch) or '_' == ch;
+}
+
+} // namespace (anonymous)
+
+/*static*/std::unique_ptr<CtSearchMatcher> CtSearchMatcher::create_literal(const Glib::ustring& pattern,
+                                                                           const bool match_case,
+                                                                           const bool whole_word,
+                                                                           const bool start_word)
+{
+    if (pattern.empty()) {
+        return nullptr;
+    }
+    if (not match_case and not pattern.is_ascii()) {
+        // the unicode case folding is left to the regular expression
+        return nullptr;
+    }
+    return std::unique_ptr<CtSearchMatcher>{new CtSearchMatcher{pattern.raw(), match_case, whole_word, start_word}};
+}
+
+CtSearchMatcher::CtSearchMatcher(const std::string& pattern, const bool match_case, const bool whole_word, const bool start_word)
+ : _pattern{match_case ? pattern : [&pattern](){
+       std::string lower_pattern{pattern};
+       std::transform(lower_pattern.begin(), lower_pattern.end(), lower_pattern.begin(), ascii_tolower);
+       return lower_pattern;
+   }()}
+ , _wholeWord{whole_word}
+ , _startWord{start_word}
+{
+    if (match_case) {
+        // memchr for the first byte then memcmp, both vectorised by the C library
+        _f_search = [this](const char* pFirst, const char* pLast)->const char*{
+            const std::string_view haystack{pFirst, static_cast<size_t>(pLast - pFirst)};
+            const size_t pos = haystack.find(_pattern);
+            return std::string_view::npos == pos ? pLast : pFirst + pos;
+        };
+    }
+    else {
+        // the pattern is ASCII, so a byte of a multi-byte character never matches any of it
+        auto f_hash = [](const char ch){ return std::hash<char>{}(ascii_tolower(ch)); };
+        auto f_equal = [](const char ch1, const char ch2){ return ascii_tolower(ch1) == ascii_tolower(ch2); };
+        const std::boyer_moore_horspool_searcher searcher{_pattern.begin(), _pattern.end(), f_hash, f_equal};
+        _f_search = [searcher](const char* pFirst, const char* pLast)->const char*{
+            return searcher(pFirst, pLast).first;
+        };
+    }
+}
+
+std::pair<int, int> CtSearchMatcher::find(const char* pText, const size_t len, const size_t start_pos) const
+{
+    const char* const pLast = pText + len;
+    for (size_t pos = start_pos; pos + _pattern.size() <= len; ) {
+        const char* pMatch = _f_search(pText + pos, pLast);
+        if (pMatch == pLast) {
+            break;
+        }
+        const size_t matchStart = static_cast<size_t>(pMatch - pText);
+        const size_t matchEnd = matchStart + _pattern.size();
+        if ( (not (_wholeWord or _startWord) or _is_word_boundary(pText, len, matchStart)) and
+             (not _wholeWord or _is_word_boundary(pText, len, matchEnd)) )
+        {
+            return std::make_pair(static_cast<int>(matchStart), static_cast<int>(matchEnd));
+        }
+        // the pattern starts with a lead byte, so the next candidate is at a character start anyway
+        pos = matchStart + 1u;
+    }
+    return std::make_pair(-1, -1);
+}
+
+/*static*/bool CtSearchMatcher::_is_word_boundary(const char* pText, const size_t len, const size_t pos)
+{
+    bool word_before{false};
+    if (pos > 0u) {
+        const char* pPrev = g_utf8_find_prev_char(pText, pText + pos);
+        word_before = pPrev and is_word_char(g_utf8_get_char(pPrev));
+    }
+    const bool word_after = pos < len and is_word_char(g_utf8_get_char(pText + pos));
+    return word_before != word_after;
+}
@@ -0,0 +1,62 @@
+/*
+ * ct_search_matcher.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <glibmm/ustring.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+// A search pattern that is not a regular expression, found by scanning the UTF-8 bytes
+// instead of going through the regular expression engine.
+// The positions are in bytes and the matches do not overlap, as with Glib::Regex.
+class CtSearchMatcher
+{
+public:
+    // nullptr if the regular expression is needed, i.e. empty pattern or caseless with non ASCII characters
+    static std::unique_ptr<CtSearchMatcher> create_literal(const Glib::ustring& pattern,
+                                                           const bool match_case,
+                                                           const bool whole_word,
+                                                           const bool start_word);
+
+    CtSearchMatcher(const CtSearchMatcher&) = delete;
+    CtSearchMatcher& operator=(const CtSearchMatcher&) = delete;
+
+    // the first match starting at or after start_pos within the first len bytes, else {-1, -1};
+    // as for a regular expression given a string length, the word boundaries do not look past len
+    std::pair<int, int> find(const char* pText, const size_t len, const size_t start_pos) const;
+    std::pair<int, int> find(const Glib::ustring& text, const size_t start_pos = 0u) const { return find(text.data(), text.bytes(), start_pos); }
+
+private:
+    CtSearchMatcher(const std::string& pattern, const bool match_case, const bool whole_word, const bool start_word);
+
+    static bool _is_word_boundary(const char* pText, const size_t len, const size_t pos);
+
+    const std::string _pattern;
+    const bool        _wholeWord;
+    const bool        _startWord;
+    // the first occurrence in [pFirst, pLast), pLast if none
+    std::function<const char*(const char* pFirst, const char* pLast)> _f_search;
+};
@@ -0,0 +1,432 @@
+/*
+ * ct_spell_check.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_GSPELL
+
+#include "ct_spell_check.h"
+#include "ct_const.h"
+#include "ct_logging.h"
+#include <glibmm/i18n.h>
+#include <gtkmm/separatormenuitem.h>
+#include <algorithm>
+#include <array>
+#include <functional>
+
+const gint64 CtSpellCheck::SLICE_MICROSECONDS{4000}; // work per idle callback, well within a frame
+const size_t CtSpellCheck::CACHE_MAX_ENTRIES{65536};
+
+CtSpellCheck::CtSpellCheck(Gtk::TextView& textView)
+ : _textView{textView}
+{
+    _buttonPressConnection = _textView.signal_button_press_event().connect(
+        sigc::mem_fun(*this, &CtSpellCheck::_on_button_press), false);
+}
+
+CtSpellCheck::~CtSpellCheck()
+{
+    _detach();
+    _buttonPressConnection.disconnect();
+}
+
+void CtSpellCheck::set_checker(GspellChecker* pGspellChecker)
+{
+    const Glib::RefPtr<Gtk::TextBuffer> rTextBuffer = _textView.get_buffer();
+    if (pGspellChecker == _pGspellChecker and rTextBuffer == _rTextBuffer) {
+        return;
+    }
+    _detach();
+    if (not pGspellChecker or not rTextBuffer) {
+        return;
+    }
+    _pGspellChecker = pGspellChecker;
+    _rTextBuffer = rTextBuffer;
+
+    _rTagMisspelled = _rTextBuffer->get_tag_table()->lookup(CtConst::GTKSPELLCHECK_TAG_NAME);
+    if (not _rTagMisspelled) {
+        _rTagMisspelled = _rTextBuffer->create_tag(CtConst::GTKSPELLCHECK_TAG_NAME);
+        _rTagMisspelled->property_underline() = Pango::UNDERLINE_ERROR;
+    }
+
+    // before the default handlers, while the iters still refer to the text being changed
+    _bufferConnections.push_back(_rTextBuffer->signal_insert().connect(
+        sigc::mem_fun(*this, &CtSpellCheck::_on_insert), false));
+    _bufferConnections.push_back(_rTextBuffer->signal_erase().connect(
+        sigc::mem_fun(*this, &CtSpellCheck::_on_erase), false));
+    _bufferConnections.push_back(_rTextBuffer->signal_insert_child_anchor().connect(
+        [this](const Gtk::TextIter& pos, const Glib::RefPtr<Gtk::TextChildAnchor>&){
+            _lines_sync();
+            _linesChecked[pos.get_line()] = false;
+            _schedule();
+        }, false));
+    _bufferConnections.push_back(_rTextBuffer->signal_insert_pixbuf().connect(
+        [this](const Gtk::TextIter& pos, const Glib::RefPtr<Gdk::Pixbuf>&){
+            _lines_sync();
+            _linesChecked[pos.get_line()] = false;
+            _schedule();
+        }, false));
+    _bufferConnections.push_back(_rTextBuffer->signal_mark_set().connect(
+        sigc::mem_fun(*this, &CtSpellCheck::_on_mark_set)));
+
+    _checkerHandlers.push_back(g_signal_connect(_pGspellChecker, "notify::language", G_CALLBACK(_on_checker_notify_language), this));
+    _checkerHandlers.push_back(g_signal_connect(_pGspellChecker, "word-added-to-personal", G_CALLBACK(_on_checker_word_added), this));
+    _checkerHandlers.push_back(g_signal_connect(_pGspellChecker, "word-added-to-session", G_CALLBACK(_on_checker_word_added), this));
+    _checkerHandlers.push_back(g_signal_connect(_pGspellChecker, "session-cleared", G_CALLBACK(_on_checker_session_cleared), this));
+
+    // the cached lines of the other buffers and languages are kept, the language is part of the hash
+    _lang_hash_update();
+    _lines_reset();
+    _schedule();
+}
+
+void CtSpellCheck::_detach()
+{
+    _idleConnection.disconnect();
+    for (sigc::connection& connection : _bufferConnections) {
+        connection.disconnect();
+    }
+    _bufferConnections.clear();
+    for (const gulong handlerId : _checkerHandlers) {
+        g_signal_handler_disconnect(_pGspellChecker, handlerId);
+    }
+    _checkerHandlers.clear();
+    if (_rTextBuffer and _rTagMisspelled) {
+        _rTextBuffer->remove_tag(_rTagMisspelled, _rTextBuffer->begin(), _rTextBuffer->end());
+    }
+    _rTagMisspelled.reset();
+    _rTextBuffer.reset();
+    _pGspellChecker = nullptr;
+    _linesChecked.clear();
+    _typingLine = -1;
+    _popupOffset = -1;
+}
+
+void CtSpellCheck::_lines_reset()
+{
+    _linesChecked.assign(static_cast<size_t>(_rTextBuffer->get_line_count()), false);
+}
+
+void CtSpellCheck::_lines_sync()
+{
+    if (static_cast<size_t>(_rTextBuffer->get_line_count()) != _linesChecked.size()) {
+        // lines split or joined in a way that was not tracked (e.g. by a lone '\r')
+        _lines_reset();
+    }
+}
+
+void CtSpellCheck::_schedule()
+{
+    if (not _idleConnection.connected()) {
+        _idleConnection = Glib::signal_idle().connect(sigc::mem_fun(*this, &CtSpellCheck::_on_idle));
+    }
+}
+
+bool CtSpellCheck::_on_idle()
+{
+    const gint64 deadline = g_get_monotonic_time() + SLICE_MICROSECONDS;
+    _lines_sync();
+    const int linesNum = static_cast<int>(_linesChecked.size());
+    int visibleFirst{0};
+    int visibleLast{-1};
+    if (_textView.get_buffer() == _rTextBuffer) {
+        Gdk::Rectangle visibleRect;
+        _textView.get_visible_rect(visibleRect);
+        Gtk::TextIter iterTop, iterBottom;
+        int lineTop;
+        _textView.get_line_at_y(iterTop, visibleRect.get_y(), lineTop);
+        _textView.get_line_at_y(iterBottom, visibleRect.get_y() + visibleRect.get_height(), lineTop);
+        visibleFirst = iterTop.get_line();
+        visibleLast = iterBottom.get_line();
+    }
+    // the visible lines, then the ones below them, then the ones above
+    const std::array<std::pair<int, int>, 3> ranges{{{visibleFirst, visibleLast + 1},
+                                                     {visibleLast + 1, linesNum},
+                                                     {0, visibleFirst}}};
+    for (const auto& [first, last] : ranges) {
+        for (int line = first; line < last; ++line) {
+            if (_linesChecked[line]) {
+                continue;
+            }
+            _check_line(line);
+            if (g_get_monotonic_time() >= deadline) {
+                return true; // continue in the next idle
+            }
+        }
+    }
+    return false;
+}
+
+void CtSpellCheck::_check_line(const int line)
+{
+    _linesChecked[line] = true;
+    Gtk::TextIter lineStart = _rTextBuffer->get_iter_at_line(line);
+    Gtk::TextIter lineEnd = lineStart;
+    if (not lineEnd.ends_line()) {
+        lineEnd.forward_to_line_end();
+    }
+    _rTextBuffer->remove_tag(_rTagMisspelled, lineStart, lineEnd);
+    if (lineStart == lineEnd) {
+        return;
+    }
+    // with the hidden text and the anchors placeholders, so that the chars offsets match the buffer ones
+    const Glib::ustring text = _rTextBuffer->get_slice(lineStart, lineEnd, true/*include_hidden_chars*/);
+    const size_t hash = _get_text_hash(text);
+    auto it = _cache.find(hash);
+    if (_cache.end() == it) {
+        if (_cache.size() >= CACHE_MAX_ENTRIES) {
+            _cache.clear();
+        }
+        it = _cache.emplace(hash, _find_misspelled(text)).first;
+    }
+    if (it->second.empty()) {
+        return;
+    }
+    // the word that is being typed is not marked until the cursor leaves it
+    int cursorOffset{-1};
+    if (line == _typingLine) {
+        const Gtk::TextIter iterCursor = _rTextBuffer->get_insert()->get_iter();
+        if (iterCursor.get_line() == line) {
+            cursorOffset = iterCursor.get_line_offset();
+        }
+    }
+    for (const auto& [wordStart, wordEnd] : it->second) {
+        if (cursorOffset >= wordStart and cursorOffset <= wordEnd) {
+            continue;
+        }
+        _rTextBuffer->apply_tag(_rTagMisspelled,
+                                _rTextBuffer->get_iter_at_line_offset(line, wordStart),
+                                _rTextBuffer->get_iter_at_line_offset(line, wordEnd));
+    }
+}
+
+CtSpellCheck::CtWordsBounds CtSpellCheck::_find_misspelled(const Glib::ustring& text)
+{
+    CtWordsBounds misspelled;
+    const std::string& raw = text.raw();
+    const int charsNum = static_cast<int>(g_utf8_strlen(raw.c_str(), static_cast<gssize>(raw.size())));
+    std::vector<PangoLogAttr> logAttrs(static_cast<size_t>(charsNum) + 1u);
+    pango_get_log_attrs(raw.c_str(), static_cast<int>(raw.size()), -1, nullptr, logAttrs.data(), charsNum + 1);
+    int wordStart{-1};
+    size_t wordStartByte{0};
+    size_t currByte{0};
+    for (int i = 0; i <= charsNum; ++i) {
+        const gunichar currChar = i < charsNum ? g_utf8_get_char(raw.c_str() + currByte) : 0;
+        if (wordStart >= 0 and logAttrs[i].is_word_end) {
+            // pango splits the words at the apostrophe, e.g. "don't"
+            const bool isApostropheInWord = ('\'' == currChar or 0x2019 == currChar) and logAttrs[i + 1].is_word_start;
+            if (not isApostropheInWord) {
+                GError* pError{nullptr};
+                const gboolean isCorrect = gspell_checker_check_word(_pGspellChecker,
+                                                                     raw.c_str() + wordStartByte,
+                                                                     static_cast<gssize>(currByte - wordStartByte),
+                                                                     &pError);
+                if (pError) {
+                    spdlog::error("!! {} {}", __FUNCTION__, pError->message);
+                    g_clear_error(&pError);
+                }
+                else if (not isCorrect) {
+                    misspelled.emplace_back(wordStart, i);
+                }
+                wordStart = -1;
+            }
+        }
+        if (i == charsNum) {
+            break;
+        }
+        if (wordStart < 0 and logAttrs[i].is_word_start) {
+            wordStart = i;
+            wordStartByte = currByte;
+        }
+        currByte = static_cast<size_t>(g_utf8_next_char(raw.c_str() + currByte) - raw.c_str());
+    }
+    return misspelled;
+}
+
+size_t CtSpellCheck::_get_text_hash(const Glib::ustring& text) const
+{
+    return std::hash<std::string>{}(text.raw()) * 31u + _langHash;
+}
+
+void CtSpellCheck::_on_insert(const Gtk::TextIter& pos, const Glib::ustring& text, int/*bytes*/)
+{
+    _lines_sync();
+    const int line = pos.get_line();
+    const auto newlinesNum = std::count(text.raw().begin(), text.raw().end(), '\n');
+    _linesChecked[line] = false;
+    _linesChecked.insert(_linesChecked.begin() + line + 1, static_cast<size_t>(newlinesNum), false);
+    _typingLine = line + static_cast<int>(newlinesNum);
+    _schedule();
+}
+
+void CtSpellCheck::_on_erase(const Gtk::TextIter& start, const Gtk::TextIter& end)
+{
+    _lines_sync();
+    const int startLine = start.get_line();
+    const int endLine = end.get_line();
+    _linesChecked.erase(_linesChecked.begin() + startLine + 1, _linesChecked.begin() + endLine + 1);
+    _linesChecked[startLine] = false;
+    _typingLine = startLine;
+    _schedule();
+}
+
+void CtSpellCheck::_on_mark_set(const Gtk::TextIter&/*iter*/, const Glib::RefPtr<Gtk::TextMark>& rMark)
+{
+    if (rMark != _rTextBuffer->get_insert()) {
+        return;
+    }
+    // the cursor moved away from the word being typed, or on a misspelled word, no more to be skipped
+    if (_typingLine >= 0 and static_cast<size_t>(_typingLine) < _linesChecked.size()) {
+        _linesChecked[_typingLine] = false;
+        _schedule();
+    }
+    _typingLine = -1;
+}
+
+bool CtSpellCheck::_on_button_press(GdkEventButton* pEvent)
+{
+    if (GDK_BUTTON_PRESS == pEvent->type and 3 == pEvent->button and _rTextBuffer) {
+        int x, y;
+        _textView.window_to_buffer_coords(Gtk::TEXT_WINDOW_TEXT, (int)pEvent->x, (int)pEvent->y, x, y);
+        Gtk::TextIter iter;
+        _textView.get_iter_at_location(iter, x, y);
+        _popupOffset = iter.get_offset();
+    }
+    return false;
+}
+
+void CtSpellCheck::_lang_hash_update()
+{
+    const GspellLanguage* pGspellLang = gspell_checker_get_language(_pGspellChecker);
+    _langHash = std::hash<std::string>{}(pGspellLang ? gspell_language_get_code(pGspellLang) : "");
+}
+
+void CtSpellCheck::_on_checker_changed()
+{
+    // a word added to the dictionaries may be in any of the cached lines
+    _lang_hash_update();
+    _cache.clear();
+    _lines_reset();
+    _schedule();
+}
+
+/*static*/void CtSpellCheck::_on_checker_notify_language(GObject*, GParamSpec*, gpointer pData)
+{
+    static_cast<CtSpellCheck*>(pData)->_on_checker_changed();
+}
+
+/*static*/void CtSpellCheck::_on_checker_word_added(GspellChecker*, gchar*, gpointer pData)
+{
+    static_cast<CtSpellCheck*>(pData)->_on_checker_changed();
+}
+
+/*static*/void CtSpellCheck::_on_checker_session_cleared(GspellChecker*, gpointer pData)
+{
+    static_cast<CtSpellCheck*>(pData)->_on_checker_changed();
+}
+
+bool CtSpellCheck::_get_misspelled_word_at(const Gtk::TextIter& iter, Gtk::TextIter& wordStart, Gtk::TextIter& wordEnd)
+{
+    wordStart = iter;
+    if (not wordStart.has_tag(_rTagMisspelled)) {
+        // right after the end of the word
+        if (not wordStart.ends_tag(_rTagMisspelled) or not wordStart.backward_char()) {
+            return false;
+        }
+    }
+    wordEnd = wordStart;
+    if (not wordStart.starts_tag(_rTagMisspelled)) {
+        wordStart.backward_to_tag_toggle(_rTagMisspelled);
+    }
+    wordEnd.forward_to_tag_toggle(_rTagMisspelled);
+    return wordStart != wordEnd;
+}
+
+void CtSpellCheck::populate_popup(Gtk::Menu* pMenu)
+{
+    const int popupOffset = _popupOffset;
+    _popupOffset = -1;
+    if (not _pGspellChecker or not _rTextBuffer or _textView.get_buffer() != _rTextBuffer) {
+        return;
+    }
+    if (not _textView.get_editable()) {
+        return; // as the gspell menu, nothing to correct in a read only node
+    }
+    // from the keyboard, the word at the cursor
+    const Gtk::TextIter iter = popupOffset >= 0 ? _rTextBuffer->get_iter_at_offset(popupOffset)
+                                                : _rTextBuffer->get_insert()->get_iter();
+    Gtk::TextIter wordStart, wordEnd;
+    if (not _get_misspelled_word_at(iter, wordStart, wordEnd)) {
+        return;
+    }
+    const Glib::ustring word = _rTextBuffer->get_text(wordStart, wordEnd, false/*include_hidden_chars*/);
+    const int startOffset = wordStart.get_offset();
+    const int endOffset = wordEnd.get_offset();
+
+    auto f_replace = [this, word, startOffset, endOffset](const Glib::ustring& suggestion){
+        if (not _rTextBuffer or not _textView.get_editable()) return;
+        Gtk::TextIter iterStart = _rTextBuffer->get_iter_at_offset(startOffset);
+        Gtk::TextIter iterEnd = _rTextBuffer->get_iter_at_offset(endOffset);
+        if (_rTextBuffer->get_text(iterStart, iterEnd, false/*include_hidden_chars*/) != word) {
+            return; // the text changed in the meantime
+        }
+        _rTextBuffer->begin_user_action();
+        iterStart = _rTextBuffer->erase(iterStart, iterEnd);
+        _rTextBuffer->insert(iterStart, suggestion);
+        _rTextBuffer->end_user_action();
+        gspell_checker_set_correction(_pGspellChecker, word.c_str(), -1, suggestion.c_str(), -1);
+    };
+
+    // collected top down, then prepended bottom up
+    std::vector<Gtk::MenuItem*> menuItems;
+    GSList* pSuggestions = gspell_checker_get_suggestions(_pGspellChecker, word.c_str(), -1);
+    if (not pSuggestions) {
+        auto pMenuItem = Gtk::manage(new Gtk::MenuItem{_("(no suggestions)")});
+        pMenuItem->set_sensitive(false);
+        menuItems.push_back(pMenuItem);
+    }
+    for (GSList* l = pSuggestions; l; l = l->next) {
+        const Glib::ustring suggestion{static_cast<const gchar*>(l->data)};
+        auto pMenuItem = Gtk::manage(new Gtk::MenuItem{suggestion});
+        pMenuItem->signal_activate().connect([f_replace, suggestion](){ f_replace(suggestion); });
+        menuItems.push_back(pMenuItem);
+    }
+    g_slist_free_full(pSuggestions, g_free);
+    menuItems.push_back(Gtk::manage(new Gtk::SeparatorMenuItem{}));
+    auto pMenuItemAdd = Gtk::manage(new Gtk::MenuItem{_("_Add to Dictionary"), true/*mnemonic*/});
+    pMenuItemAdd->signal_activate().connect([this, word](){
+        if (_pGspellChecker) gspell_checker_add_word_to_personal(_pGspellChecker, word.c_str(), -1);
+    });
+    menuItems.push_back(pMenuItemAdd);
+    auto pMenuItemIgnore = Gtk::manage(new Gtk::MenuItem{_("_Ignore All"), true/*mnemonic*/});
+    pMenuItemIgnore->signal_activate().connect([this, word](){
+        if (_pGspellChecker) gspell_checker_add_word_to_session(_pGspellChecker, word.c_str(), -1);
+    });
+    menuItems.push_back(pMenuItemIgnore);
+    menuItems.push_back(Gtk::manage(new Gtk::SeparatorMenuItem{}));
+
+    for (auto it = menuItems.rbegin(); it != menuItems.rend(); ++it) {
+        pMenu->prepend(**it);
+        (*it)->show();
+    }
+}
+
+#endif // HAVE_GSPELL
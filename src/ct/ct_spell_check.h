@@ -0,0 +1,96 @@
+/*
+ * ct_spell_check.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#ifdef HAVE_GSPELL
+
+#include <gtkmm/textview.h>
+#include <gtkmm/menu.h>
+#include <gspell/gspell.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Inline spell checking of the buffer of a text view, in place of the gspell one that checks
+// the whole buffer on the main thread as soon as it is attached.
+// The lines are checked in idle slices of a few milliseconds, the visible ones first, and the
+// misspelled words of a line are cached by the hash of its text (and language) so that going back
+// to a node or editing a line of it does not check again the text that did not change.
+class CtSpellCheck
+{
+public:
+    CtSpellCheck(Gtk::TextView& textView);
+    ~CtSpellCheck();
+
+    CtSpellCheck(const CtSpellCheck&) = delete;
+    CtSpellCheck& operator=(const CtSpellCheck&) = delete;
+
+    // the current buffer of the view is checked with the checker, nullptr to clear the marks
+    void set_checker(GspellChecker* pGspellChecker);
+    // the suggestions for the misspelled word under the latest right click, on top of the menu
+    void populate_popup(Gtk::Menu* pMenu);
+
+private:
+    using CtWordsBounds = std::vector<std::pair<int, int>>; // chars offsets in the line
+
+    void          _detach();
+    void          _lines_reset();
+    void          _lines_sync();
+    void          _schedule();
+    void          _lang_hash_update();
+    bool          _on_idle();
+    void          _check_line(const int line);
+    CtWordsBounds _find_misspelled(const Glib::ustring& text);
+    size_t        _get_text_hash(const Glib::ustring& text) const;
+    bool          _get_misspelled_word_at(const Gtk::TextIter& iter, Gtk::TextIter& wordStart, Gtk::TextIter& wordEnd);
+
+    void _on_insert(const Gtk::TextIter& pos, const Glib::ustring& text, int bytes);
+    void _on_erase(const Gtk::TextIter& start, const Gtk::TextIter& end);
+    void _on_mark_set(const Gtk::TextIter& iter, const Glib::RefPtr<Gtk::TextMark>& rMark);
+    bool _on_button_press(GdkEventButton* pEvent);
+    void _on_checker_changed();
+
+    static void _on_checker_notify_language(GObject*, GParamSpec*, gpointer pData);
+    static void _on_checker_word_added(GspellChecker*, gchar*, gpointer pData);
+    static void _on_checker_session_cleared(GspellChecker*, gpointer pData);
+
+    static const gint64 SLICE_MICROSECONDS;
+    static const size_t CACHE_MAX_ENTRIES;
+
+    Gtk::TextView&                _textView;
+    GspellChecker*                _pGspellChecker{nullptr};
+    Glib::RefPtr<Gtk::TextBuffer> _rTextBuffer;
+    Glib::RefPtr<Gtk::TextTag>    _rTagMisspelled;
+    std::vector<bool>             _linesChecked;
+    size_t                        _langHash{0};
+    int                           _typingLine{-1};
+    int                           _popupOffset{-1};
+    std::vector<sigc::connection> _bufferConnections;
+    sigc::connection              _buttonPressConnection;
+    sigc::connection              _idleConnection;
+    std::vector<gulong>           _checkerHandlers;
+    std::unordered_map<size_t, CtWordsBounds> _cache;
+};
+
+#endif // HAVE_GSPELL
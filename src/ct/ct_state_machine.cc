@@ -24,12 +24,13 @@
 #include "ct_state_machine.h"
 #include "ct_main_win.h"
 #include "ct_storage_xml.h"
+#include "ct_logging.h"
 
 // ImagePng
 CtAnchoredWidgetState_ImagePng::CtAnchoredWidgetState_ImagePng(CtImagePng* image)
  : CtAnchoredWidgetState{image->getOffset(), image->getJustification()}
  , link{image->get_link()}
- , pixbuf{image->get_pixbuf()->copy()}
+ , pRawBlob{image->get_raw_blob_shared()}
 {
 }
 
@@ -40,13 +41,12 @@ bool CtAnchoredWidgetState_ImagePng::equal(std::shared_ptr<CtAnchoredWidgetState
            charOffset == other_state->charOffset and
            justification == other_state->justification and
            link == other_state->link and
-           pixbuf->get_byte_length() == other_state->pixbuf->get_byte_length() and
-           0 == memcmp(pixbuf->get_pixels(), other_state->pixbuf->get_pixels(), pixbuf->get_byte_length() * sizeof(guint8));
+           (pRawBlob == other_state->pRawBlob or *pRawBlob == *other_state->pRawBlob);
 }
 
 CtAnchoredWidget* CtAnchoredWidgetState_ImagePng::to_widget(CtMainWin* pCtMainWin)
 {
-    return new CtImagePng{pCtMainWin, pixbuf->copy(), link, charOffset, justification};
+    return new CtImagePng{pCtMainWin, pRawBlob, link, charOffset, justification};
 }
 
 // ImageAnchor
@@ -99,7 +99,7 @@ CtAnchoredWidget* CtAnchoredWidgetState_Latex::to_widget(CtMainWin* pCtMainWin)
 CtAnchoredWidgetState_EmbFile::CtAnchoredWidgetState_EmbFile(CtImageEmbFile* embFile)
  : CtAnchoredWidgetState{embFile->getOffset(), embFile->getJustification()}
  , fileName{embFile->get_file_name()}
- , rawBlob{embFile->get_raw_blob()}
+ , pBlob{embFile->get_blob()}
  , timeSeconds{embFile->get_time()}
  , uniqueId{embFile->get_unique_id()}
  , pathLastMultiFile{embFile->get_pathLastMultiFile()}
@@ -113,7 +113,7 @@ bool CtAnchoredWidgetState_EmbFile::equal(std::shared_ptr<CtAnchoredWidgetState>
            charOffset == other_state->charOffset and
            justification == other_state->justification and
            fileName == other_state->fileName and
-           rawBlob == other_state->rawBlob and
+           pBlob == other_state->pBlob and
            timeSeconds == other_state->timeSeconds and
            uniqueId == other_state->uniqueId and
            pathLastMultiFile == other_state->pathLastMultiFile;
@@ -121,7 +121,7 @@ bool CtAnchoredWidgetState_EmbFile::equal(std::shared_ptr<CtAnchoredWidgetState>
 
 CtAnchoredWidget* CtAnchoredWidgetState_EmbFile::to_widget(CtMainWin* pCtMainWin)
 {
-    return new CtImageEmbFile{pCtMainWin, fileName, rawBlob, timeSeconds, charOffset, justification, uniqueId, pathLastMultiFile};
+    return new CtImageEmbFile{pCtMainWin, fileName, pBlob, timeSeconds, charOffset, justification, uniqueId, pathLastMultiFile};
 }
 
 // Codebox
@@ -370,6 +370,49 @@ void CtStateMachine::delete_states(const gint64 node_id_data_holder)
     }
 }
 
+void CtStateMachine::populate_memory_info(CtMemoryInfo& memoryInfo) const
+{
+    for (const auto& [node_id, nodeStates] : _node_states) {
+        CtMemoryNodeInfo& nodeInfo = memoryInfo.nodes[node_id];
+        for (const std::shared_ptr<CtNodeState>& pNodeState : nodeStates.states) {
+            size_t stateBytes = sizeof(CtNodeState) +
+                                CtXmlHelper::get_document_bytes(&pNodeState->buffer_xml) +
+                                pNodeState->buffer_xml_string.bytes();
+            size_t blobsBytes{0u}; // in the totals of the blobs
+            for (const std::shared_ptr<CtAnchoredWidgetState>& pWidgetState : pNodeState->widgetStates) {
+                if (auto pImagePng = dynamic_cast<CtAnchoredWidgetState_ImagePng*>(pWidgetState.get())) {
+                    // the blobs still used by a widget are already accounted
+                    if (pImagePng->pRawBlob and memoryInfo.sharedSeen.insert(pImagePng->pRawBlob.get()).second) {
+                        memoryInfo.pngBlobs.add(pImagePng->pRawBlob->size());
+                        blobsBytes += pImagePng->pRawBlob->size();
+                    }
+                }
+                else if (auto pEmbFile = dynamic_cast<CtAnchoredWidgetState_EmbFile*>(pWidgetState.get())) {
+                    if (pEmbFile->pBlob and pEmbFile->pBlob->in_memory() and memoryInfo.sharedSeen.insert(pEmbFile->pBlob.get()).second) {
+                        memoryInfo.embFileBlobs.add(pEmbFile->pBlob->size());
+                        blobsBytes += pEmbFile->pBlob->size();
+                    }
+                }
+                else if (auto pLatex = dynamic_cast<CtAnchoredWidgetState_Latex*>(pWidgetState.get())) {
+                    stateBytes += pLatex->text.bytes();
+                }
+                else if (auto pCodebox = dynamic_cast<CtAnchoredWidgetState_Codebox*>(pWidgetState.get())) {
+                    stateBytes += pCodebox->content.bytes();
+                }
+                else if (auto pTable = dynamic_cast<CtAnchoredWidgetState_TableCommon*>(pWidgetState.get())) {
+                    for (const std::vector<Glib::ustring>& row : pTable->rows) {
+                        for (const Glib::ustring& cell : row) {
+                            stateBytes += sizeof(Glib::ustring) + cell.bytes();
+                        }
+                    }
+                }
+            }
+            nodeInfo.undoStates.add(stateBytes + blobsBytes);
+            memoryInfo.undoStates.add(stateBytes);
+        }
+    }
+}
+
 // Are we in the last state?
 bool CtStateMachine::curr_index_is_last_index(const gint64 node_id_data_holder)
 {
@@ -400,6 +443,8 @@ void CtStateMachine::update_state(CtTreeIter tree_iter)
     if (not_undoable_timeslot_get()) return;
     if (not tree_iter) return;
     if (not tree_iter.get_node_is_rich_text()) return;
+    if (_pCtMainWin->text_buffer_is_large(tree_iter.get_node_text_buffer())) return; // large node mode
+    CtPerfScope perfScope{"undo_snapshot"};
 
     const gint64 node_id_data_holder = tree_iter.get_node_id_data_holder();
     auto& node_states = _node_states[node_id_data_holder];
@@ -407,13 +452,7 @@ void CtStateMachine::update_state(CtTreeIter tree_iter)
         node_states.states.erase(node_states.states.begin() + node_states.index + 1, node_states.states.end());
     }
 
-    auto new_state = std::shared_ptr<CtNodeState>(new CtNodeState{});
-    CtStorageXmlHelper{_pCtMainWin}.save_buffer_no_widgets_to_xml(new_state->buffer_xml.get_root_node(),
-                                                                  tree_iter.get_node_text_buffer(), 0, -1, 'n');
-    new_state->buffer_xml_string = new_state->buffer_xml.write_to_string();
-    for (auto widget : tree_iter.get_anchored_widgets()) {
-        new_state->widgetStates.push_back(widget->get_state());
-    }
+    std::shared_ptr<CtNodeState> new_state = get_state_snapshot(tree_iter);
 
     if (node_states.states.size() > 0) {
         auto compare_widgets = [](const std::list<std::shared_ptr<CtAnchoredWidgetState>> lhs,
@@ -441,6 +480,18 @@ void CtStateMachine::update_state(CtTreeIter tree_iter)
     node_states.indicator = 0; // the current buffer state is saved
 }
 
+std::shared_ptr<CtNodeState> CtStateMachine::get_state_snapshot(CtTreeIter tree_iter)
+{
+    auto new_state = std::shared_ptr<CtNodeState>(new CtNodeState{});
+    CtStorageXmlHelper{_pCtMainWin}.save_buffer_no_widgets_to_xml(new_state->buffer_xml.get_root_node(),
+                                                                  tree_iter.get_node_text_buffer(), 0, -1, 'n');
+    new_state->buffer_xml_string = new_state->buffer_xml.write_to_string();
+    for (auto widget : tree_iter.get_anchored_widgets()) {
+        new_state->widgetStates.push_back(widget->get_state());
+    }
+    return new_state;
+}
+
 void CtStateMachine::update_curr_state_cursor_pos(const gint64 node_id_data_holder)
 {
     if (not_undoable_timeslot_get()) return;
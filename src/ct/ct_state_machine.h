@@ -61,7 +61,7 @@ public:
 
 public:
     Glib::ustring link;
-    Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+    std::shared_ptr<const std::string> pRawBlob; // encoded png, shared with the widget
 };
 
 class CtAnchoredWidgetState_Anchor : public CtAnchoredWidgetState
@@ -100,7 +100,7 @@ public:
 
 public:
     fs::path      fileName;
-    std::string   rawBlob;      // raw data, not a string
+    std::shared_ptr<CtEmbFileBlob> pBlob; // shared with the widget, not a copy
     time_t        timeSeconds;
     const size_t  uniqueId;
     fs::path      pathLastMultiFile;
@@ -197,8 +197,11 @@ public:
     bool not_undoable_timeslot_get();
     void update_state();
     void update_state(CtTreeIter tree_iter);
+    // the current content of the rich text node, not added to its states
+    std::shared_ptr<CtNodeState> get_state_snapshot(CtTreeIter tree_iter);
     void update_curr_state_cursor_pos(const gint64 node_id_data_holder);
     void update_curr_state_v_adj_val(const gint64 node_id_data_holder);
+    void populate_memory_info(CtMemoryInfo& memoryInfo) const;
 
     void set_go_bk_fw_active(bool val) { _go_bk_fw_active = val; }
 
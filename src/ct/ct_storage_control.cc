@@ -29,6 +29,7 @@
 #include "ct_p7za_iface.h"
 #include "ct_main_win.h"
 #include "ct_logging.h"
+#include "ct_task_pool.h"
 #include <glib/gstdio.h>
 
 //#define DEBUG_BACKUP_ENCRYPT
@@ -111,6 +112,7 @@ static bool _move_dir_with_fallback(const fs::path& dir_from, const fs::path& di
                                                         Glib::ustring& error,
                                                         Glib::ustring password)
 {
+    CtPerfScope perfScope{"file_load"};
     fs::path extracted_file_path{file_path};
 
     try {
@@ -168,6 +170,37 @@ static bool _move_dir_with_fallback(const fs::path& dir_from, const fs::path& di
     return storage->populate_treestore(file_path, error);
 }
 
+/*static*/bool CtStorageControl::document_quick_integrity_check_pass(const fs::path& file_path,
+                                                                     const std::unordered_map<gint64, size_t>& nodes_checksums,
+                                                                     Glib::ustring& error)
+{
+    switch (fs::get_doc_type_from_file_ext(file_path)) {
+        case CtDocType::SQLite:
+            return CtStorageSqlite::quick_check_pass(file_path, nodes_checksums, error);
+        case CtDocType::XML:
+            return CtStorageXml::well_formed_check_pass(file_path, error);
+        default:
+            error = fmt::format("{} no quick check", file_path.string());
+            return false;
+    }
+}
+
+bool CtStorageControl::_integrity_check_pass(const fs::path& file_path,
+                                             const std::unordered_map<gint64, size_t>& nodes_checksums,
+                                             Glib::ustring& error)
+{
+    CtPerfScope perfScope{"integrity_check"};
+    if (0u != ++_integrityChecksNum % INTEGRITY_FULL_CHECK_EVERY) {
+        if (document_quick_integrity_check_pass(file_path, nodes_checksums, error)) {
+            return true;
+        }
+        // the full dry run has the last word
+        spdlog::warn("{} {}", __FUNCTION__, error.raw());
+        error.clear();
+    }
+    return document_integrity_check_pass(_pCtMainWin, file_path, error);
+}
+
 /*static*/void CtStorageControl::get_first_backup_file_or_dir(std::string& out_first_backup_file_or_dir,
                                                               const std::string& file_or_dir_path,
                                                               const CtConfig* pCtConfig)
@@ -223,6 +256,7 @@ static bool _move_dir_with_fallback(const fs::path& dir_from, const fs::path& di
                                                       const int start_offset/*= 0*/,
                                                       const int end_offset/*= -1*/)
 {
+    pCtMainWin->get_ct_storage()->populate_treestore_complete();
     auto on_scope_exit = scope_guard([&](void*) { pCtMainWin->get_status_bar().pop(); });
     pCtMainWin->get_status_bar().push(_("Writing to Disk..."));
     #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
@@ -364,6 +398,12 @@ bool CtStorageControl::try_reopen(Glib::ustring& error)
 
 bool CtStorageControl::save(bool need_vacuum, Glib::ustring& error)
 {
+    CtPerfScope perfScope{"file_save"};
+    populate_treestore_complete();
+    if (_storage and not _storage->delayed_text_buffer_share_saved()) {
+        // the stored content shared with the duplicated nodes is about to be rewritten
+        _pCtMainWin->get_tree_store().lazy_contents_materialize();
+    }
     _mod_time = 0;
     _pCtMainWin->get_status_bar().push(_("Writing to Disk..."));
     #if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
@@ -452,8 +492,9 @@ bool CtStorageControl::save(bool need_vacuum, Glib::ustring& error)
                 _storage->reopen_connect();
                 pBackupEncryptData->password = _password;
             }
+            pBackupEncryptData->nodes_checksums = _storage->get_written_nodes_checksums();
             pBackupEncryptData->p_mod_time = &_mod_time;
-            backupEncryptDEQueue.push_back(pBackupEncryptData);
+            backup_encrypt_push(pBackupEncryptData);
         }
         _syncPending.fix_db_tables = false;
         _syncPending.bookmarks_to_write = false;
@@ -485,9 +526,26 @@ Glib::RefPtr<Gtk::TextBuffer> CtStorageControl::get_delayed_text_buffer(const gi
         spdlog::error("!! {} storage is not initialized", __FUNCTION__);
         return Glib::RefPtr<Gtk::TextBuffer>{};
     }
+    CtPerf::counter_add("node_buffers_loaded");
     return _storage->get_delayed_text_buffer(node_id, syntax, widgets);
 }
 
+bool CtStorageControl::delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id)
+{
+    if (not _storage) {
+        spdlog::error("!! {} storage is not initialized", __FUNCTION__);
+        return false;
+    }
+    return _storage->delayed_text_buffer_share(node_id, copy_node_id);
+}
+
+void CtStorageControl::populate_memory_info(CtMemoryInfo& memoryInfo) const
+{
+    if (_storage) {
+        _storage->populate_memory_info(memoryInfo);
+    }
+}
+
 fs::path CtStorageControl::get_embedded_filepath(const CtTreeIter& ct_tree_iter, const std::string& filename) const
 {
     if (not _storage) {
@@ -497,6 +555,25 @@ fs::path CtStorageControl::get_embedded_filepath(const CtTreeIter& ct_tree_iter,
     return _storage->get_embedded_filepath(ct_tree_iter, filename);
 }
 
+bool CtStorageControl::external_changes_watch_start()
+{
+    return _storage and _storage->external_changes_watch_start();
+}
+
+void CtStorageControl::external_changes_watch_stop()
+{
+    if (_storage) {
+        _storage->external_changes_watch_stop();
+    }
+}
+
+void CtStorageControl::populate_treestore_complete()
+{
+    if (_storage) {
+        _storage->populate_treestore_complete();
+    }
+}
+
 /*static*/fs::path CtStorageControl::_extract_file(CtMainWin* pCtMainWin, const fs::path& file_path, Glib::ustring& password)
 {
     fs::path temp_dir = pCtMainWin->get_ct_tmp()->getHiddenDirPath(file_path);
@@ -588,31 +665,47 @@ CtStorageControl::CtStorageControl(CtMainWin* pCtMainWin)
  : _pCtMainWin{pCtMainWin}
  , _pCtConfig{pCtMainWin->get_ct_config()}
 {
-    _pThreadBackupEncrypt = std::make_unique<std::thread>(std::bind(&CtStorageControl::_backupEncryptThread, this));
 }
 
 CtStorageControl::~CtStorageControl()
 {
-    if (_pThreadBackupEncrypt) {
-        _backupEncryptKeepGoing = false;
-        backupEncryptDEQueue.push_back(nullptr);
-        _pThreadBackupEncrypt->join();
+    // the queued backups and encryptions are completed before leaving
+    std::unique_lock<std::mutex> lock{_backupEncryptMutex};
+    _backupEncryptCv.wait(lock, [this](){ return not _backupEncryptDraining; });
+}
+
+void CtStorageControl::backup_encrypt_push(std::shared_ptr<CtBackupEncryptData> pBackupEncryptData)
+{
+    _backupEncryptDEQueue.push_back(pBackupEncryptData);
+    std::lock_guard<std::mutex> lock{_backupEncryptMutex};
+    if (not _backupEncryptDraining) {
+        // a single drain at a time, so the files are processed in order
+        _backupEncryptDraining = true;
+        CtTaskPool::get().submit([this](){ _backupEncryptDrain(); }, CtTaskPool::Priority::Low);
     }
 }
 
-void CtStorageControl::_backupEncryptThread()
+void CtStorageControl::_backupEncryptDrain()
 {
-    while (_backupEncryptKeepGoing) {
-        std::shared_ptr<CtBackupEncryptData> pBackupEncryptData = backupEncryptDEQueue.pop_front();
-        if (not pBackupEncryptData) {
-            // a nullptr is passed on purpose in order to exit the loop at app quit
+    while (true) {
+        std::optional<std::shared_ptr<CtBackupEncryptData>> optBackupEncryptData = _backupEncryptDEQueue.try_pop_front();
+        if (not optBackupEncryptData) {
+            std::lock_guard<std::mutex> lock{_backupEncryptMutex};
+            if (not _backupEncryptDEQueue.empty()) {
+                // pushed just now, before the pusher could see us still draining
+                continue;
+            }
+            _backupEncryptDraining = false;
+            _backupEncryptCv.notify_all();
             break;
         }
+        std::shared_ptr<CtBackupEncryptData> pBackupEncryptData = *optBackupEncryptData;
+        CtPerfScope perfScope{"backup_encrypt"};
 
         // encrypt the file
         if (pBackupEncryptData->needEncrypt) {
             Glib::ustring error;
-            if (not CtStorageControl::document_integrity_check_pass(_pCtMainWin, pBackupEncryptData->extracted_copy, error)) {
+            if (not _integrity_check_pass(pBackupEncryptData->extracted_copy, pBackupEncryptData->nodes_checksums, error)) {
                 spdlog::error("{} {}", __FUNCTION__, error.raw());
                 _pCtMainWin->errorsDEQueue.push_back(_("Failed integrity check of the saved document. Try File-->Save As"));
                 _pCtMainWin->dispatcherErrorMsg.emit();
@@ -653,7 +746,8 @@ void CtStorageControl::_backupEncryptThread()
 
         if (CtBackupType::SingleFile == pBackupEncryptData->backupType and not pBackupEncryptData->needEncrypt) {
             Glib::ustring error;
-            if (not CtStorageControl::document_integrity_check_pass(_pCtMainWin, pBackupEncryptData->main_backup, error)) {
+            // the previous version of the document, not what was just written
+            if (not _integrity_check_pass(pBackupEncryptData->main_backup, {}/*nodes_checksums*/, error)) {
                 spdlog::error("{} {}", __FUNCTION__, error.raw());
                 _pCtMainWin->errorsDEQueue.push_back(_("Failed integrity check of the saved document. Try File-->Save As"));
                 _pCtMainWin->dispatcherErrorMsg.emit();
@@ -765,9 +859,9 @@ void CtStorageControl::_backupEncryptThread()
 #endif // DEBUG_BACKUP_ENCRYPT
             }
         }
-    } // while (_backupEncryptKeepGoing)
+    } // while (true)
 #if defined(DEBUG_BACKUP_ENCRYPT)
-    spdlog::debug("out _backupEncryptThread");
+    spdlog::debug("out _backupEncryptDrain");
 #endif // DEBUG_BACKUP_ENCRYPT
 }
 
@@ -884,11 +978,19 @@ void CtStorageCache::generate_cache(CtMainWin* pCtMainWin, const CtStorageSyncPe
 {
     std::vector<CtImagePng*> image_list;
     auto& store = pCtMainWin->get_tree_store();
+    // the duplicated nodes not used yet are left without text buffer
+    auto f_is_lazy = [&store](const CtTreeIter& ct_tree_iter){
+        std::shared_ptr<CtNodeState> pNodeState;
+        return store.lazy_content_get(ct_tree_iter.get_node_id(), pNodeState);
+    };
     if (not pending) {
         // all nodes
         std::string error;
         store.get_store()->foreach([&](const Gtk::TreePath&, const Gtk::TreeModel::iterator& iter)->bool{
             CtTreeIter ct_tree_iter = store.to_ct_tree_iter(iter);
+            if (f_is_lazy(ct_tree_iter)) {
+                return false; /* false for continue */
+            }
             Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = ct_tree_iter.get_node_text_buffer();
             if (not pTextBuffer) {
                 error = str::format(_("Failed to retrieve the content of the node '%s'"), ct_tree_iter.get_node_name().raw());
@@ -905,7 +1007,7 @@ void CtStorageCache::generate_cache(CtMainWin* pCtMainWin, const CtStorageSyncPe
     else {
         for (const auto& node_pair : pending->nodes_to_write_dict) {
             CtTreeIter ct_tree_iter = store.get_node_from_node_id(node_pair.first);
-            if (node_pair.second.buff && ct_tree_iter.get_node_is_rich_text()) {
+            if (node_pair.second.buff && ct_tree_iter.get_node_is_rich_text() && not f_is_lazy(ct_tree_iter)) {
                 Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = ct_tree_iter.get_node_text_buffer();
                 if (not pTextBuffer) {
                     throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), ct_tree_iter.get_node_name().raw()));
@@ -924,7 +1026,7 @@ void CtStorageCache::_parallel_fetch_pixbufers(const std::vector<CtImagePng*>& i
 {
     _cached_images.clear();
 
-    // auto start = std::chrono::steady_clock::now();
+    CtPerfScope perfScope{"fetch_images"};
 
     std::vector<std::pair<CtImagePng*, std::string>> image_pair(image_widgets.size());
     for (size_t i = 0; i < image_widgets.size(); ++i)
@@ -940,10 +1042,6 @@ void CtStorageCache::_parallel_fetch_pixbufers(const std::vector<CtImagePng*>& i
     for (auto& pair : image_pair) {
         _cached_images.emplace(pair);
     }
-
-    //auto end = std::chrono::steady_clock::now();
-    //std::chrono::duration<double> elapsed_seconds = end-start;
-    //spdlog::debug("{} amount: , {} sec.", __FUNCTION__, elapsed_seconds.count());
 }
 
 bool CtStorageCache::get_cached_image(CtImagePng* image, std::string& cached_image)
@@ -26,7 +26,8 @@
 #include "ct_types.h"
 #include "ct_widgets.h"
 #include <glibmm/miscutils.h>
-#include <thread>
+#include <condition_variable>
+#include <mutex>
 
 class CtMainWin;
 class CtTreeStore;
@@ -50,6 +51,11 @@ public:
     static bool document_integrity_check_pass(CtMainWin* pCtMainWin,
                                               const fs::path& file_path,
                                               Glib::ustring& error);
+    // without loading the document: the storage own check (PRAGMA quick_check or xml well formed)
+    // plus, if given, the checksums of the nodes written by the save
+    static bool document_quick_integrity_check_pass(const fs::path& file_path,
+                                                    const std::unordered_map<gint64, size_t>& nodes_checksums,
+                                                    Glib::ustring& error);
     static void get_first_backup_file_or_dir(std::string& out_first_backup_file_or_dir,
                                              const std::string& file_or_dir_path,
                                              const CtConfig* pCtConfig);
@@ -60,14 +66,20 @@ public:
 
     virtual ~CtStorageControl();
 
-    ThreadSafeDEQueue<std::shared_ptr<CtBackupEncryptData>,1000> backupEncryptDEQueue;
+    // the backups and encryptions run in order on the task pool
+    void backup_encrypt_push(std::shared_ptr<CtBackupEncryptData> pBackupEncryptData);
 
     bool save(bool need_vacuum, Glib::ustring& error);
     bool try_reopen(Glib::ustring& error);
     Glib::RefPtr<Gtk::TextBuffer> get_delayed_text_buffer(const gint64 node_id,
                                                           const std::string& syntax,
                                                           std::list<CtAnchoredWidget*>& widgets) const;
+    bool delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id);
+    void populate_memory_info(CtMemoryInfo& memoryInfo) const;
     fs::path get_embedded_filepath(const CtTreeIter& ct_tree_iter, const std::string& filename) const;
+    bool external_changes_watch_start();
+    void external_changes_watch_stop();
+    void populate_treestore_complete();
     const fs::path& get_file_path() { return _file_path; }
     time_t get_mod_time() { return _mod_time; }
     fs::path get_file_name() { return _file_path.empty() ? "" : _file_path.filename(); }
@@ -106,9 +118,17 @@ private:
     std::unique_ptr<CtStorageEntity> _storage;
     CtStorageSyncPending             _syncPending;
 
-    std::unique_ptr<std::thread> _pThreadBackupEncrypt;
-    void _backupEncryptThread();
-    bool _backupEncryptKeepGoing{true};
+    ThreadSafeDEQueue<std::shared_ptr<CtBackupEncryptData>,1000> _backupEncryptDEQueue;
+    void _backupEncryptDrain();
+    bool _integrity_check_pass(const fs::path& file_path,
+                               const std::unordered_map<gint64, size_t>& nodes_checksums,
+                               Glib::ustring& error);
+    // every so many checks the full dry run load is done anyway
+    static constexpr size_t INTEGRITY_FULL_CHECK_EVERY{10u};
+    size_t _integrityChecksNum{0u};
+    std::mutex _backupEncryptMutex;
+    std::condition_variable _backupEncryptCv;
+    bool _backupEncryptDraining{false};
 };
 
 class CtImagePng;
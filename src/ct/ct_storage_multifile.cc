@@ -26,6 +26,7 @@
 #include "ct_storage_control.h"
 #include "ct_main_win.h"
 #include "ct_logging.h"
+#include "ct_embfile_blob.h"
 #include <glib/gstdio.h>
 
 /*static*/const std::string CtStorageMultiFile::SUBNODES_LST{"subnodes.lst"};
@@ -38,6 +39,11 @@ CtStorageMultiFile::CtStorageMultiFile(CtMainWin* pCtMainWin)
  , _pCtConfig{pCtMainWin->get_ct_config()}
 {}
 
+CtStorageMultiFile::~CtStorageMultiFile()
+{
+    external_changes_watch_stop();
+}
+
 bool CtStorageMultiFile::save_treestore(const fs::path& dir_path,
                                         const CtStorageSyncPending& syncPending,
                                         Glib::ustring& error,
@@ -194,6 +200,9 @@ bool CtStorageMultiFile::save_treestore(const fs::path& dir_path,
             if (any_hier) {
                 // full tree hierarchy verification needed
                 _verify_update_hierarchy(nullptr/*ct_tree_iter_parent*/, _dir_path);
+                if (_extChangesWatching) {
+                    _dir_monitors_refresh();
+                }
             }
         }
         return true;
@@ -288,7 +297,9 @@ void CtStorageMultiFile::_remove_disk_node_with_children(const gint64 node_id)
         pBackupEncryptData->file_path = _dir_path.string();
         pBackupEncryptData->main_backup = curr_node_dirpath.string();
         pBackupEncryptData->p_mod_time = nullptr;
-        _pCtMainWin->get_ct_storage()->backupEncryptDEQueue.push_back(pBackupEncryptData);
+        // the node folder is going to the backups, its embedded files still in use are read in memory
+        CtEmbFileBlob::files_release(curr_node_dirpath, true/*also_existing*/);
+        _pCtMainWin->get_ct_storage()->backup_encrypt_push(pBackupEncryptData);
         _already_queued_for_removal.insert(curr_node_id);
     };
     fs::path node_dirpath;
@@ -329,7 +340,9 @@ void CtStorageMultiFile::_hier_try_move_existing_node_to_path(const fs::path& di
     f_find_dir_from(_dir_path);
     if (not dir_path_from.empty()) {
         spdlog::debug("{} -> {}", dir_path_from.string(), dir_path_to.string());
-        fs::move_file(dir_path_from, dir_path_to);
+        if (fs::move_file(dir_path_from, dir_path_to)) {
+            CtEmbFileBlob::files_moved(dir_path_from, dir_path_to);
+        }
     }
 }
 
@@ -403,6 +416,10 @@ bool CtStorageMultiFile::_nodes_to_multifile(const CtTreeIter* ct_tree_iter,
             // parse back
             try {
                 std::unique_ptr<xmlpp::DomParser> parser = CtStorageXml::get_parser(xml_filepath);
+                if (_extChangesWatching and CtExporting::NONESAVE == export_type) {
+                    // so that the file monitor does not take our own write for an external change
+                    _nodeXmlSignatures[ct_tree_iter->get_node_id()] = _get_file_signature(xml_filepath);
+                }
             }
             catch (std::exception& ex) {
                 error = fmt::format("parse {} after write: {}", xml_filepath, ex.what());
@@ -420,13 +437,15 @@ bool CtStorageMultiFile::_nodes_to_multifile(const CtTreeIter* ct_tree_iter,
             }
         }
         if (CtExporting::NONESAVE == export_type) {
+            // the files left in BEFORE_SAVE are going to the backups, the embedded ones still in use are read in memory
+            CtEmbFileBlob::files_release(dir_path, false/*also_existing*/);
             auto pBackupEncryptData = std::make_shared<CtBackupEncryptData>();
             pBackupEncryptData->backupType = CtBackupType::MultiFile;
             pBackupEncryptData->needEncrypt = false;
             pBackupEncryptData->file_path = _dir_path.string();
             pBackupEncryptData->main_backup = dir_before_save.string();
             pBackupEncryptData->p_mod_time = nullptr;
-            _pCtMainWin->get_ct_storage()->backupEncryptDEQueue.push_back(pBackupEncryptData);
+            _pCtMainWin->get_ct_storage()->backup_encrypt_push(pBackupEncryptData);
         }
     }
     // subnodes?
@@ -491,24 +510,59 @@ bool CtStorageMultiFile::_nodes_to_multifile(const CtTreeIter* ct_tree_iter,
     return sha256sum;
 }
 
+/*static*/std::string CtStorageMultiFile::save_blob(const CtEmbFileBlob& blob,
+                                                    const std::string& dir_path,
+                                                    const std::string& file_ext)
+{
+    const std::string sha256sum = blob.get_sha256sum();
+    const std::string sha256sum_ext = sha256sum + file_ext;
+    const std::string filepath = Glib::build_filename(dir_path, sha256sum_ext);
+    if (not Glib::file_test(filepath, Glib::FILE_TEST_IS_REGULAR)) {
+        const std::string filepath_before = Glib::build_filename(dir_path, BEFORE_SAVE, sha256sum_ext);
+        if (Glib::file_test(filepath_before, Glib::FILE_TEST_IS_REGULAR)) {
+            fs::move_file(filepath_before, filepath);
+        }
+        else {
+            (void)blob.write_to_file(filepath);
+        }
+    }
+    return sha256sum;
+}
+
 /*static*/bool CtStorageMultiFile::read_blob(const std::string& dir_path,
                                              const std::string& sha256sum,
                                              std::string& rawBlob)
+{
+    const fs::path filepath = find_blob(dir_path, sha256sum);
+    if (filepath.empty()) {
+        return false;
+    }
+    try {
+        rawBlob = Glib::file_get_contents(filepath.string());
+        return true;
+    }
+    catch (Glib::Error& error) {
+        spdlog::error("{} {}", __FUNCTION__, std::string(error.what()));
+    }
+    return false;
+}
+
+/*static*/fs::path CtStorageMultiFile::find_blob(const std::string& dir_path,
+                                                 const std::string& sha256sum)
 {
     try {
         Glib::Dir gdir{dir_path};
         std::list<std::string> dir_entries{gdir.begin(), gdir.end()};
         for (const std::string& filename : dir_entries) {
             if (str::startswith(filename, sha256sum)) {
-                rawBlob = Glib::file_get_contents(Glib::build_filename(dir_path, filename));
-                return true;
+                return fs::path{dir_path} / filename;
             }
         }
     }
     catch (Glib::Error& error) {
         spdlog::error("{} {}", __FUNCTION__, std::string(error.what()));
     }
-    return false;
+    return fs::path{};
 }
 
 /*static*/std::list<fs::path> CtStorageMultiFile::get_child_nodes_dirs(const fs::path& dir_path)
@@ -690,6 +744,8 @@ void CtStorageMultiFile::import_nodes(const fs::path& dir_path, const Gtk::TreeM
     for (const fs::path& node_dirpath : CtStorageMultiFile::get_child_nodes_dirs(dir_path)) {
         f_nodes_from_multifile(node_dirpath, ++sequence, ct_tree_store.to_ct_tree_iter(parent_iter));
     }
+    // the imported embedded files cannot stay in a folder that is not the document
+    CtEmbFileBlob::files_release_under(dir_path);
     // populate shared non master nodes now that the master nodes
     // are in the tree
     for (CtTreeIter& ctTreeIter : nodes_shared_non_master) {
@@ -718,10 +774,511 @@ Glib::RefPtr<Gtk::TextBuffer> CtStorageMultiFile::get_delayed_text_buffer(const
     }
     std::shared_ptr<xmlpp::Document> node_buffer = _delayed_text_buffers[node_id];
     auto xml_element = dynamic_cast<xmlpp::Element*>(node_buffer->get_root_node()->get_first_child());
-    const fs::path multifile_dir = _get_node_dirpath(_pCtMainWin->get_tree_store().get_node_from_node_id(node_id));
+    // the embedded files of a duplicated node are still in the folder of the source node
+    const auto iterShared = _sharedDelayedDirs.find(node_id);
+    const fs::path multifile_dir = iterShared != _sharedDelayedDirs.end() ?
+        iterShared->second : _get_node_dirpath(_pCtMainWin->get_tree_store().get_node_from_node_id(node_id));
     auto ret_buffer = CtStorageXmlHelper{_pCtMainWin}.create_buffer_and_widgets_from_xml(xml_element, syntax, widgets, nullptr, -1, multifile_dir.string());
     if (ret_buffer) {
         _delayed_text_buffers.erase(node_id);
+        _sharedDelayedDirs.erase(node_id);
     }
     return ret_buffer;
 }
+
+bool CtStorageMultiFile::delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id)
+{
+    const auto iterDelayed = _delayed_text_buffers.find(node_id);
+    if (iterDelayed == _delayed_text_buffers.end()) {
+        return false;
+    }
+    // the parsed document is not modified, each node builds its own text buffer from it
+    _delayed_text_buffers[copy_node_id] = iterDelayed->second;
+    const auto iterShared = _sharedDelayedDirs.find(node_id);
+    _sharedDelayedDirs[copy_node_id] = iterShared != _sharedDelayedDirs.end() ?
+        iterShared->second : _get_node_dirpath(_pCtMainWin->get_tree_store().get_node_from_node_id(node_id));
+    return true;
+}
+
+void CtStorageMultiFile::populate_memory_info(CtMemoryInfo& memoryInfo) const
+{
+    CtXmlHelper::populate_memory_info(_delayed_text_buffers, memoryInfo);
+}
+
+bool CtStorageMultiFile::external_changes_watch_start()
+{
+    if (_dir_path.empty() or _isDryRun) {
+        return false;
+    }
+    _extChangesWatching = true;
+    _dir_monitors_refresh();
+    if (0 == _dirMonitors.count(_dir_path.string())) {
+        // not even the root folder can be monitored, fallback to mod time polling
+        external_changes_watch_stop();
+        return false;
+    }
+    return true;
+}
+
+void CtStorageMultiFile::external_changes_watch_stop()
+{
+    _extChangesTimeoutConn.disconnect();
+    for (auto& dirMonitor : _dirMonitors) {
+        dirMonitor.second->cancel();
+    }
+    _dirMonitors.clear();
+    _nodeXmlSignatures.clear();
+    _extChangedNodeXml.clear();
+    _extChangedSubnodesLst.clear();
+    _extChangedBookmarks = false;
+    _extChangesWatching = false;
+}
+
+/*static*/std::string CtStorageMultiFile::_get_file_signature(const fs::path& filepath)
+{
+    try {
+        Glib::RefPtr<Gio::FileInfo> rFileInfo = Gio::File::create_for_path(filepath.string())->query_info(
+            "standard::size,time::modified,time::modified-usec");
+        return fmt::format("{}.{}.{}", rFileInfo->get_size(),
+                                       rFileInfo->get_attribute_uint64("time::modified"),
+                                       rFileInfo->get_attribute_uint32("time::modified-usec"));
+    }
+    catch (Glib::Error&) {}
+    return std::string{};
+}
+
+void CtStorageMultiFile::_dir_monitors_refresh()
+{
+    // one monitor per node folder (inotify is not recursive), plus the root folder
+    std::unordered_set<std::string> dirs_in_tree{_dir_path.string()};
+    std::function<void(CtTreeIter, const fs::path&)> f_collect_dirs;
+    f_collect_dirs = [&](CtTreeIter ct_tree_iter, const fs::path& parent_dirpath) {
+        while (ct_tree_iter) {
+            const gint64 node_id = ct_tree_iter.get_node_id();
+            const fs::path node_dirpath = parent_dirpath / std::to_string(node_id);
+            dirs_in_tree.insert(node_dirpath.string());
+            if (0 == _nodeXmlSignatures.count(node_id)) {
+                _nodeXmlSignatures[node_id] = _get_file_signature(node_dirpath / NODE_XML);
+            }
+            f_collect_dirs(ct_tree_iter.first_child(), node_dirpath);
+            ++ct_tree_iter;
+        }
+    };
+    f_collect_dirs(_pCtMainWin->get_tree_store().get_ct_iter_first(), _dir_path);
+
+    for (auto it = _dirMonitors.begin(); it != _dirMonitors.end();) {
+        if (0 == dirs_in_tree.count(it->first)) {
+            it->second->cancel();
+            it = _dirMonitors.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (const std::string& dirpath : dirs_in_tree) {
+        if (_dirMonitors.count(dirpath) or not Glib::file_test(dirpath, Glib::FILE_TEST_IS_DIR)) {
+            // already monitored or node not yet written to disk
+            continue;
+        }
+        try {
+            Glib::RefPtr<Gio::FileMonitor> rDirMonitor = Gio::File::create_for_path(dirpath)->monitor_directory();
+#if GTKMM_MAJOR_VERSION >= 4
+            rDirMonitor->signal_changed().connect([this](const Glib::RefPtr<Gio::File>& rFile,
+                                                         const Glib::RefPtr<Gio::File>&/*rOtherFile*/,
+                                                         Gio::FileMonitor::Event/*event*/){
+                _on_dir_monitor_changed(rFile);
+            });
+#else
+            rDirMonitor->signal_changed().connect([this](const Glib::RefPtr<Gio::File>& rFile,
+                                                         const Glib::RefPtr<Gio::File>&/*rOtherFile*/,
+                                                         Gio::FileMonitorEvent/*event*/){
+                _on_dir_monitor_changed(rFile);
+            });
+#endif
+            _dirMonitors[dirpath] = rDirMonitor;
+        }
+        catch (Glib::Error& error) {
+            spdlog::error("!! {} {} {}", __FUNCTION__, dirpath, error.what());
+        }
+    }
+    spdlog::debug("{} {} monitored folders", __FUNCTION__, _dirMonitors.size());
+}
+
+void CtStorageMultiFile::_on_dir_monitor_changed(const Glib::RefPtr<Gio::File>& rFile)
+{
+    if (not rFile) {
+        return;
+    }
+    const fs::path file_path{rFile->get_path()};
+    const fs::path file_name = file_path.filename();
+    const fs::path dir_path = file_path.parent_path();
+    if (file_name == NODE_XML) {
+        const gint64 node_id = CtStrUtil::gint64_from_gstring(dir_path.filename().c_str());
+        if (node_id <= 0) {
+            return;
+        }
+        _extChangedNodeXml.insert(node_id);
+    }
+    else if (file_name == SUBNODES_LST) {
+        _extChangedSubnodesLst.insert(dir_path.string());
+    }
+    else if (file_name == BOOKMARKS_LST and dir_path == _dir_path) {
+        _extChangedBookmarks = true;
+    }
+    else {
+        // embedded files, BEFORE_SAVE folders and node folders themselves are not of interest
+        return;
+    }
+    // wait for the writer to be done before applying
+    _extChangesTimeoutConn.disconnect();
+    _extChangesTimeoutConn = Glib::signal_timeout().connect(sigc::mem_fun(*this, &CtStorageMultiFile::_on_ext_changes_timeout), 1000);
+}
+
+bool CtStorageMultiFile::_on_ext_changes_timeout()
+{
+    if (not _pCtMainWin->user_active()) {
+        return true; // try again later
+    }
+    std::set<gint64> changedNodeXml;
+    std::set<std::string> changedSubnodesLst;
+    std::swap(changedNodeXml, _extChangedNodeXml);
+    std::swap(changedSubnodesLst, _extChangedSubnodesLst);
+    const bool changedBookmarks = _extChangedBookmarks;
+    _extChangedBookmarks = false;
+
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    const CtStorageSyncPending* pSyncPending = _pCtMainWin->get_ct_storage()->get_storage_sync_pending();
+    bool need_full_reload{false};
+    bool any_change{false};
+    _pCtMainWin->user_active() = false;
+    try {
+        if (not changedSubnodesLst.empty()) {
+            bool local_hier_pending = not pSyncPending->nodes_to_rm_set.empty();
+            for (const auto& node_pair : pSyncPending->nodes_to_write_dict) {
+                if (node_pair.second.hier) {
+                    local_hier_pending = true;
+                    break;
+                }
+            }
+            if (local_hier_pending) {
+                // the next save will overwrite the hierarchy on disk anyway
+                spdlog::debug("?? {} external hierarchy change ignored, local hierarchy change pending", __FUNCTION__);
+            }
+            else {
+                // first all the removals, then the additions so that a node moved on disk
+                // from one parent to another is not found in two places at once
+                std::set<gint64> loaded_node_ids;
+                for (const std::string& dirpath : changedSubnodesLst) {
+                    if (not _ext_changes_hier_removals(dirpath, any_change)) {
+                        need_full_reload = true;
+                        break;
+                    }
+                }
+                for (const std::string& dirpath : changedSubnodesLst) {
+                    if (need_full_reload) break;
+                    if (not _ext_changes_hier_additions(dirpath, loaded_node_ids, any_change)) {
+                        need_full_reload = true;
+                    }
+                }
+                for (const gint64 node_id : loaded_node_ids) {
+                    // freshly loaded from disk, nothing else to do
+                    changedNodeXml.erase(node_id);
+                }
+            }
+        }
+        if (not need_full_reload) {
+            for (const gint64 node_id : changedNodeXml) {
+                if (_ext_changes_node_reload(node_id)) {
+                    any_change = true;
+                }
+            }
+        }
+        if (not need_full_reload and changedBookmarks and not pSyncPending->bookmarks_to_write) {
+            const fs::path bookmarks_filepath = _dir_path / BOOKMARKS_LST;
+            std::list<gint64> bookmarks;
+            if (fs::is_regular_file(bookmarks_filepath)) {
+                const std::string bookmarks_csv = Glib::file_get_contents(bookmarks_filepath.string());
+                for (const gint64 nodeId : CtStrUtil::gstring_split_to_int64(bookmarks_csv.c_str(), ",")) {
+                    bookmarks.push_back(nodeId);
+                }
+            }
+            if (bookmarks != ct_tree_store.bookmarks_get()) {
+                ct_tree_store.bookmarks_set(bookmarks);
+                _pCtMainWin->menu_set_bookmark_menu_items();
+                any_change = true;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        spdlog::error("!! {} {}", __FUNCTION__, e.what());
+        need_full_reload = true;
+    }
+    _pCtMainWin->user_active() = true;
+
+    if (need_full_reload) {
+        // this storage is about to be replaced, the reload must happen outside of its callback
+        CtMainWin* pCtMainWin = _pCtMainWin;
+        Glib::signal_idle().connect_once([pCtMainWin](){
+            const fs::path file_path = pCtMainWin->get_ct_storage()->get_file_path();
+            if (pCtMainWin->file_open(file_path, ""/*node*/, ""/*anchor*/, ""/*password*/, true/*is_reload*/)) {
+                pCtMainWin->get_status_bar().update_status(_("The Document was Reloaded After External Update to CT* File."));
+            }
+        });
+    }
+    else if (any_change) {
+        _dir_monitors_refresh();
+        _pCtMainWin->get_status_bar().update_status(_("The Document was Reloaded After External Update to CT* File."));
+    }
+    return false;
+}
+
+bool CtStorageMultiFile::_ext_changes_hier_removals(const fs::path& dir_path, bool& treeChanged)
+{
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    CtTreeIter ct_tree_iter_parent;
+    if (dir_path != _dir_path) {
+        ct_tree_iter_parent = ct_tree_store.get_node_from_node_id(CtStrUtil::gint64_from_gstring(dir_path.filename().c_str()));
+        if (not ct_tree_iter_parent or _get_node_dirpath(ct_tree_iter_parent) != dir_path) {
+            // the parent itself was moved or removed, its own parent subnodes.lst takes care
+            return true;
+        }
+    }
+    std::unordered_set<gint64> disk_ids;
+    for (const fs::path& subnode_dirpath : get_child_nodes_dirs(dir_path)) {
+        disk_ids.insert(CtStrUtil::gint64_from_gstring(subnode_dirpath.filename().c_str()));
+    }
+    std::list<CtTreeIter> to_remove;
+    CtTreeIter ct_tree_iter = ct_tree_iter_parent ? ct_tree_iter_parent.first_child() : ct_tree_store.get_ct_iter_first();
+    while (ct_tree_iter) {
+        if (0 == disk_ids.count(ct_tree_iter.get_node_id())) {
+            to_remove.push_back(ct_tree_iter);
+        }
+        ++ct_tree_iter;
+    }
+    if (to_remove.empty()) {
+        return true;
+    }
+    const gint64 curr_node_id = _pCtMainWin->curr_tree_iter() ? _pCtMainWin->curr_tree_iter().get_node_id() : -1;
+    CtSharedNodesMap shared_nodes_map;
+    ct_tree_store.populate_shared_nodes_map(shared_nodes_map);
+    for (CtTreeIter& ct_tree_iter_rm : to_remove) {
+        std::vector<gint64> rm_node_ids = ct_tree_iter_rm.get_children_node_ids();
+        rm_node_ids.push_back(ct_tree_iter_rm.get_node_id());
+        for (const gint64 node_id : rm_node_ids) {
+            if (node_id == curr_node_id or shared_nodes_map.count(node_id)) {
+                // removing the selected node or a shared node master needs the full reload
+                return false;
+            }
+        }
+        bool anyRemovedBookmarked{false};
+        for (const gint64 node_id : rm_node_ids) {
+            _pCtMainWin->get_state_machine().delete_states(node_id);
+            _delayed_text_buffers.erase(node_id);
+            _nodeXmlSignatures.erase(node_id);
+            if (ct_tree_store.bookmarks_remove(node_id)) {
+                anyRemovedBookmarked = true;
+            }
+        }
+        ct_tree_store.get_store()->erase(ct_tree_iter_rm);
+        treeChanged = true;
+        if (anyRemovedBookmarked) {
+            _pCtMainWin->menu_set_bookmark_menu_items();
+        }
+    }
+    return true;
+}
+
+bool CtStorageMultiFile::_ext_changes_hier_additions(const fs::path& dir_path, std::set<gint64>& loaded_node_ids, bool& treeChanged)
+{
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    CtTreeIter ct_tree_iter_parent;
+    if (dir_path != _dir_path) {
+        ct_tree_iter_parent = ct_tree_store.get_node_from_node_id(CtStrUtil::gint64_from_gstring(dir_path.filename().c_str()));
+        if (not ct_tree_iter_parent or _get_node_dirpath(ct_tree_iter_parent) != dir_path) {
+            return true;
+        }
+    }
+    std::vector<gint64> disk_ids;
+    for (const fs::path& subnode_dirpath : get_child_nodes_dirs(dir_path)) {
+        disk_ids.push_back(CtStrUtil::gint64_from_gstring(subnode_dirpath.filename().c_str()));
+    }
+    std::vector<gint64> tree_ids;
+    CtTreeIter ct_tree_iter = ct_tree_iter_parent ? ct_tree_iter_parent.first_child() : ct_tree_store.get_ct_iter_first();
+    while (ct_tree_iter) {
+        tree_ids.push_back(ct_tree_iter.get_node_id());
+        ++ct_tree_iter;
+    }
+    if (disk_ids == tree_ids) {
+        return true;
+    }
+    // from here on nodes are added or reordered
+    treeChanged = true;
+    // new subtrees are appended, the order is fixed below
+    std::list<CtTreeIter> nodes_shared_non_master;
+    for (const gint64 node_id : disk_ids) {
+        if (vec::exists(tree_ids, node_id)) {
+            continue;
+        }
+        if (ct_tree_store.get_node_from_node_id(node_id)) {
+            // node still somewhere else in the tree
+            return false;
+        }
+        tree_ids.push_back(node_id);
+        _ext_node_load(dir_path / std::to_string(node_id), tree_ids.size(), ct_tree_iter_parent, loaded_node_ids, nodes_shared_non_master);
+    }
+    for (CtTreeIter& ctTreeIter : nodes_shared_non_master) {
+        CtNodeData nodeData{};
+        ct_tree_store.get_node_data(ctTreeIter, nodeData, false/*loadTextBuffer*/);
+        ct_tree_store.update_node_data(ctTreeIter, nodeData);
+    }
+    if (disk_ids.size() != tree_ids.size()) {
+        return false;
+    }
+    if (disk_ids != tree_ids) {
+        // new_order[new_position] = old_position
+        std::vector<int> new_order;
+        for (const gint64 node_id : disk_ids) {
+            new_order.push_back(std::distance(tree_ids.begin(), std::find(tree_ids.begin(), tree_ids.end(), node_id)));
+        }
+        if (ct_tree_iter_parent) {
+            ct_tree_store.get_store()->reorder(ct_tree_iter_parent->children(), new_order);
+        }
+        else {
+            ct_tree_store.get_store()->reorder(ct_tree_store.get_store()->children(), new_order);
+        }
+    }
+    gint64 sequence{0};
+    ct_tree_iter = ct_tree_iter_parent ? ct_tree_iter_parent.first_child() : ct_tree_store.get_ct_iter_first();
+    while (ct_tree_iter) {
+        // not via nodes_sequences_fix as the disk is already up to date
+        ct_tree_iter.set_node_sequence(++sequence);
+        ++ct_tree_iter;
+    }
+    return true;
+}
+
+void CtStorageMultiFile::_ext_node_load(const fs::path& nodedir,
+                                        const gint64 sequence,
+                                        Gtk::TreeModel::iterator parent_iter,
+                                        std::set<gint64>& loaded_node_ids,
+                                        std::list<CtTreeIter>& nodes_shared_non_master)
+{
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    const fs::path node_xml_path = nodedir / NODE_XML;
+    std::unique_ptr<xmlpp::DomParser> pParser = CtStorageXml::get_parser(node_xml_path);
+    auto xml_element = static_cast<xmlpp::Element*>(pParser->get_document()->get_root_node()->get_first_child("node"));
+    bool is_shared_non_master{false};
+    Gtk::TreeModel::iterator new_iter = CtStorageXmlHelper{_pCtMainWin}.node_from_xml(
+        xml_element,
+        sequence,
+        parent_iter,
+        -1/*new_id*/,
+        nullptr/*pHasDuplicatedId*/,
+        &is_shared_non_master,
+        nullptr/*pImportedIdsRemap*/,
+        _delayed_text_buffers,
+        false/*isDryRun*/,
+        nodedir.string());
+    CtTreeIter new_ct_iter = ct_tree_store.to_ct_tree_iter(new_iter);
+    if (is_shared_non_master) {
+        nodes_shared_non_master.push_back(new_ct_iter);
+    }
+    const gint64 node_id = new_ct_iter.get_node_id();
+    loaded_node_ids.insert(node_id);
+    _nodeXmlSignatures[node_id] = _get_file_signature(node_xml_path);
+    gint64 child_sequence{0};
+    for (const fs::path& subnode_dirpath : CtStorageMultiFile::get_child_nodes_dirs(nodedir)) {
+        _ext_node_load(subnode_dirpath, ++child_sequence, new_iter, loaded_node_ids, nodes_shared_non_master);
+    }
+}
+
+bool CtStorageMultiFile::_ext_changes_node_reload(const gint64 node_id)
+{
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    CtTreeIter ct_tree_iter = ct_tree_store.get_node_from_node_id(node_id);
+    if (not ct_tree_iter or ct_tree_iter.get_node_shared_master_id() > 0) {
+        // removed or a shared non master whose content lives in the master
+        return false;
+    }
+    const fs::path node_dirpath = _get_node_dirpath(ct_tree_iter);
+    const fs::path node_xml_path = node_dirpath / NODE_XML;
+    const std::string signature = _get_file_signature(node_xml_path);
+    if (signature.empty() or signature == _nodeXmlSignatures[node_id]) {
+        // removed along with the node folder or written by ourselves
+        return false;
+    }
+    _nodeXmlSignatures[node_id] = signature;
+
+    CtTreeIter curr_tree_iter = _pCtMainWin->curr_tree_iter();
+    const bool is_curr_node = curr_tree_iter and curr_tree_iter.get_node_id_data_holder() == node_id;
+    const CtStorageSyncPending* pSyncPending = _pCtMainWin->get_ct_storage()->get_storage_sync_pending();
+    const auto itPending = pSyncPending->nodes_to_write_dict.find(node_id);
+    if ( (itPending != pSyncPending->nodes_to_write_dict.end() and (itPending->second.buff or itPending->second.prop)) or
+         (is_curr_node and _pCtMainWin->curr_buffer()->get_modified()) )
+    {
+        // the local changes win, they will overwrite the file at the next save
+        spdlog::debug("?? {} node {} changed on disk with local changes pending, ignored", __FUNCTION__, node_id);
+        return false;
+    }
+
+    std::unique_ptr<xmlpp::DomParser> pParser = CtStorageXml::get_parser(node_xml_path);
+    auto xml_element = static_cast<xmlpp::Element*>(pParser->get_document()->get_root_node()->get_first_child("node"));
+    CtNodeData node_data{};
+    ct_tree_store.get_node_data(ct_tree_iter, node_data, false/*loadTextBuffer*/);
+    CtStorageXmlHelper{_pCtMainWin}.node_props_from_xml(xml_element, node_data);
+    if (node_data.sharedNodesMasterId > 0) {
+        // turned into a shared non master, too deep a change
+        throw std::runtime_error(fmt::format("node {} became shared", node_id));
+    }
+
+    const bool buffer_was_loaded = ct_tree_iter.get_node_buffer_already_loaded();
+    int cursor_pos{0};
+    int v_adj_val{0};
+    if (is_curr_node) {
+        cursor_pos = _pCtMainWin->curr_buffer()->property_cursor_position();
+        v_adj_val = round(_pCtMainWin->getScrolledwindowText().get_vadjustment()->get_value());
+    }
+    if (buffer_was_loaded) {
+        ct_tree_iter.remove_all_embedded_widgets();
+        node_data.pTextBuffer = CtStorageXmlHelper{_pCtMainWin}.create_buffer_and_widgets_from_xml(
+            xml_element, node_data.syntax, node_data.anchoredWidgets, nullptr, -1, node_dirpath.string());
+        if (not node_data.pTextBuffer) {
+            throw std::runtime_error(fmt::format("node {} buffer from {}", node_id, node_xml_path.string()));
+        }
+    }
+    else {
+        // still not visited, keep delaying the buffer creation
+        auto node_buffer = std::make_shared<xmlpp::Document>();
+        node_buffer->create_root_node("root")->import_node(xml_element);
+        _delayed_text_buffers[node_id] = node_buffer;
+    }
+    ct_tree_store.update_node_data(ct_tree_iter, node_data);
+
+    // shared non master nodes show the master properties
+    CtSharedNodesMap shared_nodes_map;
+    ct_tree_store.populate_shared_nodes_map(shared_nodes_map);
+    const auto itShared = shared_nodes_map.find(node_id);
+    if (itShared != shared_nodes_map.end()) {
+        for (const gint64 nonMasterId : itShared->second) {
+            CtTreeIter nonMasterTreeIter = ct_tree_store.get_node_from_node_id(nonMasterId);
+            if (nonMasterTreeIter) {
+                CtNodeData nonMasterNodeData{};
+                ct_tree_store.get_node_data(nonMasterTreeIter, nonMasterNodeData, false/*loadTextBuffer*/);
+                ct_tree_store.update_node_data(nonMasterTreeIter, nonMasterNodeData);
+            }
+        }
+    }
+
+    if (is_curr_node) {
+        ct_tree_store.text_view_apply_textbuffer(curr_tree_iter, &_pCtMainWin->get_text_view());
+        _pCtMainWin->text_view_apply_cursor_position(curr_tree_iter, cursor_pos, v_adj_val);
+        _pCtMainWin->window_header_update();
+        _pCtMainWin->update_selected_node_statusbar_info();
+    }
+    if (buffer_was_loaded) {
+        // the external change becomes one more undoable step
+        _pCtMainWin->get_state_machine().update_state(ct_tree_iter);
+    }
+    spdlog::debug("{} node {} reloaded", __FUNCTION__, node_id);
+    return true;
+}
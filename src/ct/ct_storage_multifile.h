@@ -27,6 +27,8 @@
 #include "ct_widgets.h"
 #include "ct_filesystem.h"
 #include <glibmm/refptr.h>
+#include <giomm/file.h>
+#include <giomm/filemonitor.h>
 #include <gtkmm/textbuffer.h>
 #include <gtkmm/treeiter.h>
 #include <libxml++/libxml++.h>
@@ -35,6 +37,7 @@ class CtMainWin;
 class CtAnchoredWidget;
 class CtTreeIter;
 class CtStorageCache;
+class CtEmbFileBlob;
 
 class CtStorageMultiFile : public CtStorageEntity
 {
@@ -47,13 +50,19 @@ public:
     static std::string save_blob(const std::string& rawBlob,
                                  const std::string& dir_path,
                                  const std::string& file_ext);
+    static std::string save_blob(const CtEmbFileBlob& blob,
+                                 const std::string& dir_path,
+                                 const std::string& file_ext);
     static bool read_blob(const std::string& dir_path,
                           const std::string& sha256sum,
                           std::string& rawBlob);
+    static fs::path find_blob(const std::string& dir_path,
+                              const std::string& sha256sum);
 
     static std::list<fs::path> get_child_nodes_dirs(const fs::path& dir_path);
 
     CtStorageMultiFile(CtMainWin* pCtMainWin);
+    ~CtStorageMultiFile() override;
 
     void close_connect() override {}
     void reopen_connect() override {}
@@ -74,16 +83,44 @@ public:
     Glib::RefPtr<Gtk::TextBuffer> get_delayed_text_buffer(const gint64 node_id,
                                                           const std::string& syntax,
                                                           std::list<CtAnchoredWidget*>& widgets) const override;
+    bool delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id) override;
+    void populate_memory_info(CtMemoryInfo& memoryInfo) const override;
 
     fs::path get_embedded_filepath(const CtTreeIter& ct_tree_iter, const std::string& filename) const override;
 
+    bool external_changes_watch_start() override;
+    void external_changes_watch_stop() override;
+
 private:
     CtMainWin* const _pCtMainWin;
     CtConfig*  const _pCtConfig;
     fs::path         _dir_path;
     mutable CtDelayedTextBufferMap _delayed_text_buffers;
+    mutable std::unordered_map<gint64, fs::path> _sharedDelayedDirs; // copy node id -> folder of the source node
     std::unordered_set<gint64> _already_queued_for_removal;
 
+    bool                                                             _extChangesWatching{false};
+    std::unordered_map<std::string, Glib::RefPtr<Gio::FileMonitor>> _dirMonitors;
+    std::unordered_map<gint64, std::string>                         _nodeXmlSignatures;
+    std::set<gint64>                                                 _extChangedNodeXml;
+    std::set<std::string>                                            _extChangedSubnodesLst;
+    bool                                                             _extChangedBookmarks{false};
+    sigc::connection                                                 _extChangesTimeoutConn;
+
+    static std::string _get_file_signature(const fs::path& filepath);
+    void _dir_monitors_refresh();
+    void _on_dir_monitor_changed(const Glib::RefPtr<Gio::File>& rFile);
+    bool _on_ext_changes_timeout();
+    // false if the full reload is needed, treeChanged set if the tree was updated
+    bool _ext_changes_hier_removals(const fs::path& dir_path, bool& treeChanged);
+    bool _ext_changes_hier_additions(const fs::path& dir_path, std::set<gint64>& loaded_node_ids, bool& treeChanged);
+    bool _ext_changes_node_reload(const gint64 node_id);
+    void _ext_node_load(const fs::path& nodedir,
+                        const gint64 sequence,
+                        Gtk::TreeModel::iterator parent_iter,
+                        std::set<gint64>& loaded_node_ids,
+                        std::list<CtTreeIter>& nodes_shared_non_master);
+
     fs::path _get_node_dirpath(const CtTreeIter& ct_tree_iter) const;
     bool _found_node_dirpath(const fs::path& node_id, const fs::path parent_path, fs::path& hierarchical_path) const;
     void _remove_disk_node_with_children(const gint64 node_id);
@@ -26,8 +26,10 @@
 #include "ct_storage_control.h"
 #include "ct_main_win.h"
 #include "ct_logging.h"
+#include "ct_embfile_blob.h"
 #include <unistd.h>
 #include <optional>
+#include <unordered_map>
 
 // GtkSourceView 5 removed begin/end_not_undoable_action
 #if GTK_SOURCE_CHECK_VERSION(5, 0, 0)
@@ -56,6 +58,7 @@ const char CtStorageSqlite::TABLE_NODE_CREATE[]{"CREATE TABLE node ("
 };
 const char CtStorageSqlite::TABLE_NODE_INSERT[]{"INSERT INTO node VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?)"};
 const char CtStorageSqlite::TABLE_NODE_DELETE[]{"DELETE FROM node WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_NODE_COPY[]{"INSERT INTO node SELECT ?,name,txt,syntax,tags,is_ro,is_richtxt,has_codebox,has_table,has_image,level,?,? FROM node WHERE node_id=?"};
 
 const char CtStorageSqlite::TABLE_CODEBOX_CREATE[]{"CREATE TABLE codebox ("
 "node_id INTEGER,"
@@ -72,6 +75,7 @@ const char CtStorageSqlite::TABLE_CODEBOX_CREATE[]{"CREATE TABLE codebox ("
 };
 const char CtStorageSqlite::TABLE_CODEBOX_INSERT[]{"INSERT INTO codebox VALUES(?,?,?,?,?,?,?,?,?,?)"};
 const char CtStorageSqlite::TABLE_CODEBOX_DELETE[]{"DELETE FROM codebox WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_CODEBOX_COPY[]{"INSERT INTO codebox SELECT ?,offset,justification,txt,syntax,width,height,is_width_pix,do_highl_bra,do_show_linenum FROM codebox WHERE node_id=?"};
 
 const char CtStorageSqlite::TABLE_TABLE_CREATE[]{"CREATE TABLE grid ("
 "node_id INTEGER,"
@@ -84,6 +88,7 @@ const char CtStorageSqlite::TABLE_TABLE_CREATE[]{"CREATE TABLE grid ("
 };
 const char CtStorageSqlite::TABLE_TABLE_INSERT[]{"INSERT INTO grid VALUES(?,?,?,?,?,?)"};
 const char CtStorageSqlite::TABLE_TABLE_DELETE[]{"DELETE FROM grid WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_TABLE_COPY[]{"INSERT INTO grid SELECT ?,offset,justification,txt,col_min,col_max FROM grid WHERE node_id=?"};
 
 const char CtStorageSqlite::TABLE_IMAGE_CREATE[]{"CREATE TABLE image ("
 "node_id INTEGER,"
@@ -98,6 +103,12 @@ const char CtStorageSqlite::TABLE_IMAGE_CREATE[]{"CREATE TABLE image ("
 };
 const char CtStorageSqlite::TABLE_IMAGE_INSERT[]{"INSERT INTO image VALUES(?,?,?,?,?,?,?,?)"};
 const char CtStorageSqlite::TABLE_IMAGE_DELETE[]{"DELETE FROM image WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_IMAGE_INSERT_ZEROBLOB[]{"INSERT INTO image VALUES(?,?,?,?,zeroblob(?),?,?,?)"};
+const char CtStorageSqlite::TABLE_IMAGE_DETACH[]{"UPDATE image SET node_id=-node_id WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_IMAGE_REATTACH[]{"UPDATE image SET node_id=?, offset=?, justification=?, filename=?, time=? WHERE rowid=? AND node_id=?"};
+const char CtStorageSqlite::TABLE_IMAGE_COPY[]{"INSERT INTO image SELECT ?,?,?,'',png,?,'',? FROM image WHERE rowid=?"};
+const char CtStorageSqlite::TABLE_IMAGE_SELECT_ROWIDS[]{"SELECT rowid FROM image WHERE node_id=?"};
+const char CtStorageSqlite::TABLE_IMAGE_COPY_NODE[]{"INSERT INTO image SELECT ?,offset,justification,anchor,png,filename,link,time FROM image WHERE node_id=?"};
 
 const char CtStorageSqlite::TABLE_CHILDREN_CREATE[]{"CREATE TABLE children ("
 "node_id INTEGER UNIQUE,"
@@ -117,6 +128,10 @@ const char CtStorageSqlite::TABLE_BOOKMARK_CREATE[]{"CREATE TABLE bookmark ("
 const char CtStorageSqlite::TABLE_BOOKMARK_INSERT[]{"INSERT INTO bookmark VALUES(?,?)"};
 const char CtStorageSqlite::TABLE_BOOKMARK_DELETE[]{"DELETE FROM bookmark"};
 
+const char CtStorageSqlite::NODE_PROP_UPDATE[]{"UPDATE node SET name=?, syntax=?, tags=?, is_ro=?, is_richtxt=?, level=? WHERE node_id=?"};
+const char CtStorageSqlite::NODE_BUFF_UPDATE[]{"UPDATE node SET txt=?, syntax=?, is_richtxt=?, has_codebox=?, has_table=?, has_image=?, ts_lastsave=? WHERE node_id=?"};
+const char CtStorageSqlite::NODE_ROWID_SELECT[]{"SELECT rowid FROM node WHERE node_id=?"};
+
 /*static*/const std::string CtStorageSqlite::ERR_SQLITE_PREPV2{"!! sqlite3_prepare_v2: "};
 /*static*/const std::string CtStorageSqlite::ERR_SQLITE_STEP{"!! sqlite3_step: "};
 
@@ -135,6 +150,56 @@ private:
     sqlite3_stmt* _pStmt{nullptr};
 };
 
+sqlite3_stmt* CtSqliteStmtsCache::get(sqlite3* pDb, const char* sql)
+{
+    const auto it = _stmts.find(sql);
+    sqlite3_stmt* pStmt{nullptr};
+    if (it != _stmts.end()) {
+        pStmt = it->second;
+        sqlite3_reset(pStmt);
+        sqlite3_clear_bindings(pStmt);
+    }
+    else {
+        if (sqlite3_prepare_v2(pDb, sql, -1, &pStmt, nullptr) != SQLITE_OK) {
+            sqlite3_finalize(pStmt);
+            return nullptr;
+        }
+        _stmts[sql] = pStmt;
+        ++_numPrepared;
+    }
+    ++_numExecuted;
+    return pStmt;
+}
+
+void CtSqliteStmtsCache::reset_all()
+{
+    for (auto& stmtPair : _stmts) {
+        sqlite3_reset(stmtPair.second);
+    }
+}
+
+void CtSqliteStmtsCache::finalize_all()
+{
+    for (auto& stmtPair : _stmts) {
+        sqlite3_finalize(stmtPair.second);
+    }
+    _stmts.clear();
+}
+
+namespace {
+
+// FNV-1a, independent of the slicing since the node text is written in slices and read back at once
+uint64_t node_txt_checksum_update(uint64_t checksum, const char* pData, const size_t dataLen)
+{
+    for (size_t i = 0; i < dataLen; ++i) {
+        checksum = (checksum ^ static_cast<unsigned char>(pData[i])) * 1099511628211ull;
+    }
+    return checksum;
+}
+constexpr uint64_t NODE_TXT_CHECKSUM_INIT{14695981039346656037ull};
+
+} // namespace (anonymous)
+
 std::optional<std::vector<std::string>> get_quick_check_issues(sqlite3* db)
 {
     if (not db) throw std::logic_error("get_quick_check_issues passed invalid database object");
@@ -155,6 +220,48 @@ std::optional<std::vector<std::string>> get_quick_check_issues(sqlite3* db)
     return rows;
 }
 
+/*static*/bool CtStorageSqlite::quick_check_pass(const fs::path& file_path,
+                                                const std::unordered_map<gint64, size_t>& nodes_checksums,
+                                                Glib::ustring& error)
+{
+    sqlite3* pDb{nullptr};
+    if (sqlite3_open_v2(file_path.c_str(), &pDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        error = std::string("sqlite3_open: ") + sqlite3_errmsg(pDb);
+        sqlite3_close(pDb); // even after error, pDb is initialized
+        return false;
+    }
+    auto on_scope_exit = scope_guard([pDb](void*) { sqlite3_close(pDb); });
+
+    if (get_quick_check_issues(pDb)) {
+        error = fmt::format("{} quick_check failed", file_path.string());
+        return false;
+    }
+    if (nodes_checksums.empty()) {
+        return true;
+    }
+    Sqlite3StmtAuto stmt{pDb, "SELECT txt FROM node WHERE node_id=?"};
+    if (stmt.is_bad()) {
+        error = ERR_SQLITE_PREPV2 + sqlite3_errmsg(pDb);
+        return false;
+    }
+    for (const auto& [node_id, checksum] : nodes_checksums) {
+        sqlite3_reset(stmt);
+        sqlite3_bind_int64(stmt, 1, node_id);
+        if (sqlite3_step(stmt) != SQLITE_ROW) {
+            error = fmt::format("{} node {} differs from what was written", file_path.string(), node_id);
+            return false;
+        }
+        // the text first, then its length
+        const char* pTxt = safe_sqlite3_column_text(stmt, 0);
+        const size_t txtBytes = static_cast<size_t>(sqlite3_column_bytes(stmt, 0));
+        if (checksum != static_cast<size_t>(node_txt_checksum_update(NODE_TXT_CHECKSUM_INIT, pTxt, txtBytes))) {
+            error = fmt::format("{} node {} differs from what was written", file_path.string(), node_id);
+            return false;
+        }
+    }
+    return true;
+}
+
 bool CtStorageSqlite::_check_database_integrity()
 {
     auto corrupted_rows = get_quick_check_issues(_pDb);
@@ -175,6 +282,7 @@ bool CtStorageSqlite::_check_database_integrity()
 
 CtStorageSqlite::~CtStorageSqlite()
 {
+    _skeleton_clear();
     _close_db();
 }
 
@@ -260,27 +368,13 @@ bool CtStorageSqlite::populate_treestore(const fs::path& file_path, Glib::ustrin
         }
 
         // load node tree
-        std::function<void(const std::pair<gint64,gint64>& id_pair, const gint64 sequence, Gtk::TreeModel::iterator parent_iter)> f_nodes_from_db;
-        f_nodes_from_db = [this, &f_nodes_from_db](const std::pair<gint64,gint64>& id_pair, const gint64 sequence, Gtk::TreeModel::iterator parent_iter) {
-            Gtk::TreeModel::iterator new_iter = _node_from_db(id_pair.first,
-                                                   id_pair.second,
-                                                   sequence,
-                                                   parent_iter,
-                                                   -1/*new_id*/);
-            gint64 child_sequence{0};
-            for (const std::pair<gint64,gint64>& child_id_pair : _get_children_node_ids_from_db(id_pair.first)) {
-                f_nodes_from_db(child_id_pair, ++child_sequence, new_iter);
-            }
-        };
-        gint64 sequence{0};
-        for (const std::pair<gint64,gint64>& top_id_pair : _get_children_node_ids_from_db(0)) {
-            f_nodes_from_db(top_id_pair, ++sequence, Gtk::TreeModel::iterator{});
-        }
+        _skeleton_from_db();
 
         // keep db open for lazy node buffer loading
         return true;
     }
     catch (std::exception& e) {
+        _skeleton_clear();
         _close_db();
         error = e.what();
         return false;
@@ -295,12 +389,23 @@ bool CtStorageSqlite::save_treestore(const fs::path& file_path,
                                      const int start_offset/*= 0*/,
                                      const int end_offset/*= -1*/)
 {
+    const gint64 time_start = g_get_monotonic_time();
+    bool in_transaction{false};
     try {
         // it's the first time (or an export), a new file will be created
-        if (_pDb == nullptr) {
+        const bool is_new_db = _pDb == nullptr;
+        if (is_new_db) {
             _open_db(file_path);
             _file_path = file_path;
-
+        }
+        _writtenNodesChecksums.clear();
+        const size_t num_executed_before = _stmtsCache.get_num_executed();
+        const size_t num_prepared_before = _stmtsCache.get_num_prepared();
+        // all the writes of a save are committed together or not at all
+        _exec_no_callback("BEGIN IMMEDIATE");
+        in_transaction = true;
+
+        if (is_new_db) {
             _create_all_tables_in_db();
             if ( CtExporting::NONESAVEAS == export_type or
                  CtExporting::ALL_TREE == export_type )
@@ -374,12 +479,24 @@ bool CtStorageSqlite::save_treestore(const fs::path& file_path,
             // update changed nodes
             const std::list<std::pair<CtTreeIter, CtStorageNodeState>> nodes_to_write = CtStorageControl::get_sorted_by_level_nodes_to_write(
                 &_pCtMainWin->get_tree_store(), syncPending.nodes_to_write_dict);
+            // the rows shared with the duplicated nodes are copied before any of them is rewritten
+            std::unordered_set<gint64> shared_rows_copied;
+            for (const auto& node_pair : nodes_to_write) {
+                if (_shared_delayed_row_copy(node_pair.first, node_pair.second)) {
+                    shared_rows_copied.insert(node_pair.first.get_node_id());
+                }
+            }
             for (const auto& node_pair : nodes_to_write) {
                 CtTreeIter ct_tree_iter_parent = node_pair.first.parent();
+                CtStorageNodeState node_state = node_pair.second;
+                if (0 != shared_rows_copied.count(node_pair.first.get_node_id())) {
+                    // text and widgets are already in the copied rows
+                    node_state.buff = false;
+                }
                 _write_node_to_db(&node_pair.first,
                                   node_pair.first.get_node_sequence(),
                                   ct_tree_iter_parent ? ct_tree_iter_parent.get_node_id() : 0,
-                                  node_pair.second,
+                                  node_state,
                                   0,
                                   -1,
                                   &storage_cache,
@@ -391,19 +508,59 @@ bool CtStorageSqlite::save_treestore(const fs::path& file_path,
                 _remove_db_node_with_children(node_id);
             }
         }
+
+        const gint64 time_commit = g_get_monotonic_time();
+        _stmtsCache.reset_all();
+        _exec_no_callback("COMMIT");
+        in_transaction = false;
+        spdlog::debug("{} {} statements ({} prepared) in {} ms, commit {} ms", __FUNCTION__,
+            _stmtsCache.get_num_executed() - num_executed_before,
+            _stmtsCache.get_num_prepared() - num_prepared_before,
+            (time_commit - time_start)/1000, (g_get_monotonic_time() - time_commit)/1000);
         return true;
     }
     catch (std::exception& e) {
         error = e.what();
+        if (in_transaction) {
+            _stmtsCache.reset_all();
+            char* p_err_msg{nullptr};
+            if (SQLITE_OK != sqlite3_exec(_pDb, "ROLLBACK", nullptr, nullptr, &p_err_msg)) {
+                spdlog::error("!! {} rollback: {}", __FUNCTION__, p_err_msg ? p_err_msg : "");
+                sqlite3_free(p_err_msg);
+            }
+        }
         return false;
     }
 }
 
 void CtStorageSqlite::vacuum()
 {
+    // VACUUM may renumber the image rows, the embedded files left in the db are found again by node and offset
+    std::unordered_map<gint64, std::pair<gint64, gint64>> embfiles_locations;
+    for (const gint64 rowid : CtEmbFileBlob::sqlite_rows_in_use(_pDb)) {
+        sqlite3_stmt* pStmt = _get_cached_stmt_or_throw("SELECT node_id, offset FROM image WHERE rowid=?");
+        sqlite3_bind_int64(pStmt, 1, rowid);
+        if (SQLITE_ROW == sqlite3_step(pStmt)) {
+            embfiles_locations[rowid] = std::make_pair(sqlite3_column_int64(pStmt, 0), sqlite3_column_int64(pStmt, 1));
+        }
+    }
+    _stmtsCache.reset_all();
     spdlog::debug("VACUUM");
     _exec_no_callback("VACUUM");
     _exec_no_callback("REINDEX");
+    if (not embfiles_locations.empty()) {
+        std::unordered_map<gint64, gint64> rowids_remap;
+        for (const auto& location : embfiles_locations) {
+            sqlite3_stmt* pStmt = _get_cached_stmt_or_throw("SELECT rowid FROM image WHERE node_id=? AND offset=?");
+            sqlite3_bind_int64(pStmt, 1, location.second.first);
+            sqlite3_bind_int64(pStmt, 2, location.second.second);
+            if (SQLITE_ROW == sqlite3_step(pStmt)) {
+                rowids_remap[location.first] = sqlite3_column_int64(pStmt, 0);
+            }
+        }
+        _stmtsCache.reset_all();
+        CtEmbFileBlob::sqlite_rows_remap(_pDb, rowids_remap);
+    }
 }
 
 void CtStorageSqlite::_open_db(const fs::path& path)
@@ -415,11 +572,19 @@ void CtStorageSqlite::_open_db(const fs::path& path)
         _pDb = nullptr;
         throw std::runtime_error(std::string("sqlite3_open: ") + error);
     }
+    if (not _isDryRun) {
+        // the dry run is on a worker thread and never hands embedded files to the widgets
+        CtEmbFileBlob::sqlite_connection_register(_pDb);
+    }
 }
 
 void CtStorageSqlite::_close_db()
 {
     if (not _pDb) return;
+    if (not _isDryRun) {
+        CtEmbFileBlob::sqlite_connection_unregister(_pDb);
+    }
+    _stmtsCache.finalize_all();
     sqlite3_close(_pDb);
     _pDb = nullptr;
     //_file_path = ""; we need file_path for reconnection
@@ -454,51 +619,203 @@ Gtk::TreeModel::iterator CtStorageSqlite::_node_from_db(const gint64 node_id,
     nodeData.nodeId = new_id == -1 ? node_id : new_id;
     nodeData.sharedNodesMasterId = master_id;
     nodeData.sequence = sequence;
+    _node_data_from_stmt(*uStmt, 0/*firstCol*/, nodeData);
 
-    nodeData.name = safe_sqlite3_column_text(*uStmt, 0);
-    nodeData.syntax = safe_sqlite3_column_text(*uStmt, 1);
-    nodeData.tags = safe_sqlite3_column_text(*uStmt, 2);
-    const gint64 readonly_n_custom_icon_id = sqlite3_column_int64(*uStmt, 3);
+    if (_isDryRun) {
+        return Gtk::TreeModel::iterator{};
+    }
+
+    // buffer for imported node should be loaded now because file will be closed
+    if (new_id != -1 and master_id <= 0/*no need for shared non master*/) {
+        nodeData.pTextBuffer = get_delayed_text_buffer(node_id, nodeData.syntax, nodeData.anchoredWidgets);
+    }
+
+    return _pCtMainWin->get_tree_store().append_node(&nodeData, &parent_iter);
+}
+
+void CtStorageSqlite::_node_data_from_stmt(sqlite3_stmt* pStmt, const int firstCol, CtNodeData& nodeData)
+{
+    // columns: name, syntax, tags, is_ro, is_richtxt, level, ts_creation, ts_lastsave
+    nodeData.name = safe_sqlite3_column_text(pStmt, firstCol);
+    nodeData.syntax = safe_sqlite3_column_text(pStmt, firstCol+1);
+    nodeData.tags = safe_sqlite3_column_text(pStmt, firstCol+2);
+    const gint64 readonly_n_custom_icon_id = sqlite3_column_int64(pStmt, firstCol+3);
     nodeData.isReadOnly = static_cast<bool>(readonly_n_custom_icon_id & 0x01);
     nodeData.customIconId = readonly_n_custom_icon_id >> 1;
-    const gint64 richtxt_bold_foreground = sqlite3_column_int64(*uStmt, 4);
+    const gint64 richtxt_bold_foreground = sqlite3_column_int64(pStmt, firstCol+4);
     nodeData.isBold = static_cast<bool>((richtxt_bold_foreground >> 1) & 0x01);
     if (static_cast<bool>((richtxt_bold_foreground >> 2) & 0x01)) {
         char foregroundRgb24[8];
         CtRgbUtil::set_rgb24str_from_rgb24int((richtxt_bold_foreground >> 3) & 0xffffff, foregroundRgb24);
         nodeData.foregroundRgb24 = foregroundRgb24;
     }
-    const gint64 exclude_from_search = sqlite3_column_int64(*uStmt, 5);
+    const gint64 exclude_from_search = sqlite3_column_int64(pStmt, firstCol+5);
     nodeData.excludeMeFromSearch = exclude_from_search & 0x01;
     nodeData.excludeChildrenFromSearch = exclude_from_search & 0x02;
-    nodeData.tsCreation = sqlite3_column_int64(*uStmt, 6);
-    nodeData.tsLastSave = sqlite3_column_int64(*uStmt, 7);
+    nodeData.tsCreation = sqlite3_column_int64(pStmt, firstCol+6);
+    nodeData.tsLastSave = sqlite3_column_int64(pStmt, firstCol+7);
+}
 
+void CtStorageSqlite::_skeleton_from_db()
+{
+    const gint64 time_start = g_get_monotonic_time();
+    _skeleton_clear();
+
+    // the whole tree structure with the node properties in a single query
+    // (an older version of the SQLite db didn't have master_id, ts_creation, ts_lastsave)
+    const bool has_master_id = 1u == _get_table_field_names("children").count("master_id");
+    const bool has_timestamps = 1u == _get_table_field_names("node").count("ts_creation");
+    const std::string sqlCmd = fmt::format("SELECT c.node_id, c.father_id, {}, n.node_id, "
+                                           "n.name, n.syntax, n.tags, n.is_ro, n.is_richtxt, n.level, {} "
+                                           "FROM children AS c LEFT JOIN node AS n ON n.node_id={} "
+                                           "ORDER BY c.father_id ASC, c.sequence ASC",
+                                           has_master_id ? "IFNULL(c.master_id,0)" : "0",
+                                           has_timestamps ? "n.ts_creation, n.ts_lastsave" : "0, 0",
+                                           has_master_id ? "(CASE WHEN c.master_id>0 THEN c.master_id ELSE c.node_id END)" : "c.node_id");
+    Sqlite3StmtAuto stmt{_pDb, sqlCmd.c_str()};
+    if (stmt.is_bad()) {
+        throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
+    }
+    std::unordered_map<gint64, gint64> missing_props; // node id -> id of the missing node properties
+    size_t num_nodes{0};
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        CtNodeData nodeData{};
+        nodeData.nodeId = sqlite3_column_int64(stmt, 0);
+        nodeData.sharedNodesMasterId = sqlite3_column_int64(stmt, 2);
+        std::vector<CtNodeData>& siblings = _skeletonChildren[sqlite3_column_int64(stmt, 1)];
+        nodeData.sequence = siblings.size() + 1;
+        if (SQLITE_NULL == sqlite3_column_type(stmt, 3)) {
+            missing_props[nodeData.nodeId] = nodeData.sharedNodesMasterId > 0 ? nodeData.sharedNodesMasterId : nodeData.nodeId;
+        }
+        else {
+            _node_data_from_stmt(stmt, 4/*firstCol*/, nodeData);
+        }
+        siblings.push_back(std::move(nodeData));
+        ++num_nodes;
+    }
+
+    // only the nodes reachable from the top level were ever loaded
+    if (not missing_props.empty()) {
+        std::vector<gint64> father_ids{0};
+        while (not father_ids.empty()) {
+            const auto it = _skeletonChildren.find(father_ids.back());
+            father_ids.pop_back();
+            if (_skeletonChildren.end() == it) continue;
+            for (const CtNodeData& nodeData : it->second) {
+                const auto itMissing = missing_props.find(nodeData.nodeId);
+                if (missing_props.end() != itMissing) {
+                    const gint64 props_id = itMissing->second;
+                    _skeleton_clear();
+                    throw std::runtime_error(std::string("CtDocSqliteStorage: missing node properties for id ") + std::to_string(props_id));
+                }
+                father_ids.push_back(nodeData.nodeId);
+            }
+        }
+    }
     if (_isDryRun) {
-        return Gtk::TreeModel::iterator{};
+        _skeleton_clear();
+        return;
     }
 
-    // buffer for imported node should be loaded now because file will be closed
-    if (new_id != -1 and master_id <= 0/*no need for shared non master*/) {
-        nodeData.pTextBuffer = get_delayed_text_buffer(node_id, nodeData.syntax, nodeData.anchoredWidgets);
+    // top level nodes and their children now so that the tree expanders show up,
+    // then one level deeper than what is expanded, the rest in background
+    _skeleton_append_children(0, Gtk::TreeModel::iterator{});
+    const size_t num_top_level = _skeletonQueue.size();
+    for (size_t i = 0; i < num_top_level; ++i) {
+        (void)_skeleton_append_next();
     }
+    if (_pCtMainWin->no_gui() or CtRestoreExpColl::ALL_EXP == _pCtMainWin->get_ct_config()->restoreExpColl) {
+        populate_treestore_complete();
+    }
+    else if (not _skeletonQueue.empty()) {
+        _skeletonExpandConn = _pCtMainWin->get_tree_view().signal_test_expand_row().connect(
+            sigc::mem_fun(*this, &CtStorageSqlite::_on_treeview_test_expand_row), false/*after*/);
+        _skeletonIdleConn = Glib::signal_idle().connect(sigc::mem_fun(*this, &CtStorageSqlite::_on_skeleton_idle));
+    }
+    spdlog::debug("{} {} nodes in {} ms, background {}", __FUNCTION__, num_nodes,
+        (g_get_monotonic_time() - time_start)/1000, not _skeletonQueue.empty());
+}
 
-    return _pCtMainWin->get_tree_store().append_node(&nodeData, &parent_iter);
+void CtStorageSqlite::_skeleton_append_children(const gint64 father_id, const Gtk::TreeModel::iterator& father_iter)
+{
+    const auto it = _skeletonChildren.find(father_id);
+    if (_skeletonChildren.end() == it) return;
+    std::vector<CtNodeData> children = std::move(it->second);
+    _skeletonChildren.erase(it);
+    CtTreeStore& ct_tree_store = _pCtMainWin->get_tree_store();
+    for (CtNodeData& nodeData : children) {
+        Gtk::TreeModel::iterator new_iter = ct_tree_store.append_node(&nodeData, &father_iter);
+        if (1u == _skeletonChildren.count(nodeData.nodeId)) {
+            _skeletonQueue.emplace_back(nodeData.nodeId, new_iter);
+        }
+    }
+}
+
+bool CtStorageSqlite::_skeleton_append_next()
+{
+    if (_skeletonQueue.empty()) return false;
+    const std::pair<gint64, Gtk::TreeModel::iterator> id_iter = _skeletonQueue.front();
+    _skeletonQueue.pop_front();
+    _skeleton_append_children(id_iter.first, id_iter.second); // no-op if already appended on row expand
+    return true;
+}
+
+void CtStorageSqlite::_skeleton_clear()
+{
+    _skeletonIdleConn.disconnect();
+    _skeletonExpandConn.disconnect();
+    _skeletonQueue.clear();
+    _skeletonChildren.clear(); // unreachable from the top level, never loaded
+}
+
+void CtStorageSqlite::populate_treestore_complete()
+{
+    if (_skeletonQueue.empty()) return;
+    while (_skeleton_append_next()) {}
+    _skeleton_clear();
+}
+
+bool CtStorageSqlite::_on_skeleton_idle()
+{
+    const gint64 time_start = g_get_monotonic_time();
+    while (_skeleton_append_next()) {
+        if (g_get_monotonic_time() - time_start > 20000) {
+            return true; // continue at next idle
+        }
+    }
+    _skeleton_clear();
+    return false;
+}
+
+bool CtStorageSqlite::_on_treeview_test_expand_row(const Gtk::TreeModel::iterator& iter, const Gtk::TreeModel::Path&/*path*/)
+{
+    // the children are about to show up, their expanders need the grandchildren
+    CtTreeIter ctTreeIter = _pCtMainWin->get_tree_store().to_ct_tree_iter(iter);
+    for (CtTreeIter child = ctTreeIter.first_child(); child; ++child) {
+        _skeleton_append_children(child.get_node_id(), child);
+    }
+    return false; /* false to allow the expand */
 }
 
 Glib::RefPtr<Gtk::TextBuffer> CtStorageSqlite::get_delayed_text_buffer(const gint64 node_id,
                                                                        const std::string& syntax,
                                                                        std::list<CtAnchoredWidget*>& widgets) const
 {
+    gint64 stored_node_id{node_id};
+    const auto iterShared = _sharedDelayedIds.find(node_id);
+    if (iterShared != _sharedDelayedIds.end()) {
+        stored_node_id = iterShared->second;
+        _sharedDelayedIds.erase(iterShared);
+    }
     Sqlite3StmtAuto stmt{_pDb, "SELECT txt, has_codebox, has_table, has_image FROM node WHERE node_id=?"};
     if (stmt.is_bad()) {
         spdlog::error("{}: {}", ERR_SQLITE_PREPV2, sqlite3_errmsg(_pDb));
         return Glib::RefPtr<Gtk::TextBuffer>{};
     }
 
-    sqlite3_bind_int64(stmt, 1, node_id);
+    sqlite3_bind_int64(stmt, 1, stored_node_id);
     if (sqlite3_step(stmt) != SQLITE_ROW) {
-        spdlog::error("!! missing node properties for id {}", node_id);
+        spdlog::error("!! missing node properties for id {}", stored_node_id);
         return Glib::RefPtr<Gtk::TextBuffer>{};
     }
 
@@ -513,9 +830,9 @@ Glib::RefPtr<Gtk::TextBuffer> CtStorageSqlite::get_delayed_text_buffer(const gin
             spdlog::error("!! xml read: {}", textContent);
             return rRetTextBuffer;
         }
-        if (sqlite3_column_int64(stmt, 1)) _codebox_from_db(node_id, widgets);
-        if (sqlite3_column_int64(stmt, 2)) _table_from_db(node_id, widgets);
-        if (sqlite3_column_int64(stmt, 3)) _image_from_db(node_id, widgets);
+        if (sqlite3_column_int64(stmt, 1)) _codebox_from_db(stored_node_id, widgets);
+        if (sqlite3_column_int64(stmt, 2)) _table_from_db(stored_node_id, widgets);
+        if (sqlite3_column_int64(stmt, 3)) _image_from_db(stored_node_id, widgets);
 
         widgets.sort([](const CtAnchoredWidget* w1, const CtAnchoredWidget* w2) { return w1->getOffset() < w2->getOffset(); });
         #if !GTK_SOURCE_CHECK_VERSION(5, 0, 0)
@@ -531,14 +848,75 @@ Glib::RefPtr<Gtk::TextBuffer> CtStorageSqlite::get_delayed_text_buffer(const gin
     return rRetTextBuffer;
 }
 
+bool CtStorageSqlite::delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id)
+{
+    // the row of the source node is left untouched until the next save
+    const auto iterShared = _sharedDelayedIds.find(node_id);
+    _sharedDelayedIds[copy_node_id] = iterShared != _sharedDelayedIds.end() ? iterShared->second : node_id;
+    return true;
+}
+
+bool CtStorageSqlite::_shared_delayed_row_copy(const CtTreeIter& ct_tree_iter, const CtStorageNodeState& node_state)
+{
+    const gint64 node_id = ct_tree_iter.get_node_id();
+    const auto iterShared = _sharedDelayedIds.find(node_id);
+    if (iterShared == _sharedDelayedIds.end() or
+        node_state.is_update_of_existing or
+        not node_state.prop or
+        not node_state.buff or
+        ct_tree_iter.get_node_shared_master_id() > 0)
+    {
+        return false;
+    }
+    const gint64 stored_node_id = iterShared->second;
+    sqlite3_stmt* stmt = _get_cached_stmt_or_throw(TABLE_NODE_COPY);
+    sqlite3_bind_int64(stmt, 1, node_id);
+    sqlite3_bind_int64(stmt, 2, ct_tree_iter.get_node_creating_time());
+    sqlite3_bind_int64(stmt, 3, ct_tree_iter.get_node_modification_time());
+    sqlite3_bind_int64(stmt, 4, stored_node_id);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
+    }
+    if (0 == sqlite3_changes(_pDb)) {
+        // no stored row to copy, the text buffer is needed
+        return false;
+    }
+    for (const char* sqlCmd : {TABLE_CODEBOX_COPY, TABLE_TABLE_COPY, TABLE_IMAGE_COPY_NODE}) {
+        stmt = _get_cached_stmt_or_throw(sqlCmd);
+        sqlite3_bind_int64(stmt, 1, node_id);
+        sqlite3_bind_int64(stmt, 2, stored_node_id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
+        }
+    }
+    // from now on the node reads its own row
+    _sharedDelayedIds.erase(iterShared);
+    std::shared_ptr<CtNodeState> pNodeState;
+    (void)_pCtMainWin->get_tree_store().lazy_content_pop(node_id, pNodeState);
+    return true;
+}
+
 void CtStorageSqlite::_image_from_db(const gint64& nodeId, std::list<CtAnchoredWidget*>& anchoredWidgets) const
 {
-    Sqlite3StmtAuto stmt{_pDb, "SELECT * FROM image WHERE node_id=? ORDER BY offset ASC"};
-    if (stmt.is_bad()) {
-        spdlog::error("{}: {}", ERR_SQLITE_PREPV2, sqlite3_errmsg(_pDb));
-        return;
+    // the content of the embedded files is left in the db, only the rowid and size are read
+    auto uStmt = std::make_unique<Sqlite3StmtAuto>(_pDb, "SELECT node_id, offset, justification, anchor, "
+        "CASE WHEN filename IS NULL OR filename='' OR filename=? THEN png END, filename, link, time, rowid, length(png) "
+        "FROM image WHERE node_id=? ORDER BY offset ASC");
+    const bool embfilesInDb = not uStmt->is_bad();
+    if (embfilesInDb) {
+        sqlite3_bind_text(*uStmt, 1, CtImageLatex::LatexSpecialFilename.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(*uStmt, 2, nodeId);
     }
-    sqlite3_bind_int64(stmt, 1, nodeId);
+    else {
+        // an older version of the SQLite db didn't have filename, link, time
+        uStmt.reset(new Sqlite3StmtAuto{_pDb, "SELECT * FROM image WHERE node_id=? ORDER BY offset ASC"});
+        if (uStmt->is_bad()) {
+            spdlog::error("{}: {}", ERR_SQLITE_PREPV2, sqlite3_errmsg(_pDb));
+            return;
+        }
+        sqlite3_bind_int64(*uStmt, 1, nodeId);
+    }
+    sqlite3_stmt* stmt = *uStmt;
 
     while (SQLITE_ROW == sqlite3_step(stmt)) {
         int charOffset = sqlite3_column_int64(stmt, 1);
@@ -571,9 +949,12 @@ void CtStorageSqlite::_image_from_db(const gint64& nodeId, std::list<CtAnchoredW
                 }
                 else {
                     const time_t timeSeconds = sqlite3_column_int64(stmt, 7);
+                    std::shared_ptr<CtEmbFileBlob> pBlob = embfilesInDb ?
+                        CtEmbFileBlob::from_sqlite(_pDb, sqlite3_column_int64(stmt, 8), static_cast<size_t>(sqlite3_column_int64(stmt, 9))) :
+                        CtEmbFileBlob::from_memory(rawBlob);
                     anchoredWidgets.push_back(new CtImageEmbFile{_pCtMainWin,
                                                                  fileName,
-                                                                 rawBlob,
+                                                                 pBlob,
                                                                  timeSeconds,
                                                                  charOffset,
                                                                  justification,
@@ -676,18 +1057,14 @@ void CtStorageSqlite::_write_bookmarks_to_db(const std::list<gint64>& bookmarks)
 {
     _exec_no_callback(TABLE_BOOKMARK_DELETE);
 
-    Sqlite3StmtAuto stmt{_pDb, TABLE_BOOKMARK_INSERT};
-    if (stmt.is_bad())
-        throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-
     gint64 sequence{0};
     for (gint64 bookmark : bookmarks) {
         ++sequence;
-        sqlite3_bind_int64(stmt, 1, bookmark);
-        sqlite3_bind_int64(stmt, 2, sequence);
-        if (sqlite3_step(stmt) != SQLITE_DONE)
+        sqlite3_stmt* pStmt = _get_cached_stmt_or_throw(TABLE_BOOKMARK_INSERT);
+        sqlite3_bind_int64(pStmt, 1, bookmark);
+        sqlite3_bind_int64(pStmt, 2, sequence);
+        if (sqlite3_step(pStmt) != SQLITE_DONE)
             throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
-        sqlite3_reset(stmt);
     }
 }
 
@@ -730,10 +1107,7 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
             // clear old hierarchy
             _exec_bind_int64(TABLE_CHILDREN_DELETE, node_id);
         }
-        Sqlite3StmtAuto stmt{_pDb, TABLE_CHILDREN_INSERT};
-        if (stmt.is_bad()) {
-            throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-        }
+        sqlite3_stmt* stmt = _get_cached_stmt_or_throw(TABLE_CHILDREN_INSERT);
         sqlite3_bind_int64(stmt, 1, node_id);
         sqlite3_bind_int64(stmt, 2, node_father_id);
         sqlite3_bind_int64(stmt, 3, sequence);
@@ -766,20 +1140,38 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
         exclude_from_search |= 0x02;
     }
 
+    // a duplicated node not used yet is written from the snapshot of its source, with no text buffer
+    const std::shared_ptr<CtNodeState> pLazyState = (is_richtxt & 0x01) ?
+        _pCtMainWin->get_tree_store().lazy_content_to_write(*ct_tree_iter, start_offset, end_offset) : nullptr;
+
     // write widgets
     bool has_codebox{false};
     bool has_table{false};
     bool has_image{false};
+    bool images_detached{false};
     if (node_state.buff) {
         if (node_state.is_update_of_existing and ((is_richtxt & 0x01) or node_state.prop)) {
             // if it's a rich text or has property changed (maybe was a rich text) clear old widgets
             _exec_bind_int64(TABLE_CODEBOX_DELETE, node_id);
             _exec_bind_int64(TABLE_TABLE_DELETE, node_id);
-            _exec_bind_int64(TABLE_IMAGE_DELETE, node_id);
+            // the old images are set aside so that the unchanged embedded files take back their rows
+            _exec_bind_int64(TABLE_IMAGE_DETACH, node_id);
+            images_detached = true;
         }
         if (is_richtxt & 0x01) {
-            for (CtAnchoredWidget* pAnchoredWidget : ct_tree_iter->get_anchored_widgets(start_offset, end_offset)) {
-                if (not pAnchoredWidget->to_sqlite(_pDb, node_id, start_offset >= 0 ? -start_offset : 0, storage_cache))
+            std::list<std::unique_ptr<CtAnchoredWidget>> lazyWidgets;
+            std::list<CtAnchoredWidget*> anchoredWidgets;
+            if (pLazyState) {
+                lazyWidgets = _pCtMainWin->get_tree_store().lazy_content_widgets(*pLazyState);
+                for (const std::unique_ptr<CtAnchoredWidget>& pLazyWidget : lazyWidgets) {
+                    anchoredWidgets.push_back(pLazyWidget.get());
+                }
+            }
+            else {
+                anchoredWidgets = ct_tree_iter->get_anchored_widgets(start_offset, end_offset);
+            }
+            for (CtAnchoredWidget* pAnchoredWidget : anchoredWidgets) {
+                if (not pAnchoredWidget->to_sqlite(_pDb, _stmtsCache, node_id, start_offset >= 0 ? -start_offset : 0, storage_cache))
                     throw std::runtime_error("couldn't save widget");
                 switch (pAnchoredWidget->get_type()) {
                     case CtAnchWidgType::CodeBox: has_codebox = true; break;
@@ -789,14 +1181,15 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
                 }
             }
         }
+        if (images_detached) {
+            _image_rows_release(-node_id);
+            _exec_bind_int64(TABLE_IMAGE_DELETE, -node_id);
+        }
     }
 
     // if only node prop to write / no buffer
     if (node_state.prop and not node_state.buff) {
-        Sqlite3StmtAuto stmt{_pDb, "UPDATE node SET name=?, syntax=?, tags=?, is_ro=?, is_richtxt=?, level=? WHERE node_id=?"};
-        if (stmt.is_bad()) {
-            throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-        }
+        sqlite3_stmt* stmt = _get_cached_stmt_or_throw(NODE_PROP_UPDATE);
         const std::string node_name = ct_tree_iter->get_node_name();
         const std::string node_syntax = ct_tree_iter->get_node_syntax_highlighting();
         const std::string node_tags = ct_tree_iter->get_node_tags();
@@ -813,40 +1206,53 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
     }
     // write node buffer (with or without node prop)
     else if (node_state.buff) {
-        // get buffer content
+        // get buffer content, the plain text is not copied but streamed into the row in slices
         std::string node_txt;
-        if (is_richtxt & 0x01) {
+        Gtk::TextIter plain_start, plain_end;
+        size_t txt_bytes{0};
+        const bool is_plain = not (is_richtxt & 0x01);
+        if (not is_plain) {
             xmlpp::Document xml_doc;
             xml_doc.create_root_node("node");
-            CtStorageXmlHelper{_pCtMainWin}.save_buffer_no_widgets_to_xml(xml_doc.get_root_node(),
-                ct_tree_iter->get_node_text_buffer(), start_offset, end_offset, 'n');
+            if (pLazyState) {
+                // the snapshot holds the same slots that the text buffer would give
+                for (xmlpp::Node* pSlot : pLazyState->buffer_xml.get_root_node()->get_children()) {
+                    xml_doc.get_root_node()->import_node(pSlot);
+                }
+            }
+            else {
+                CtStorageXmlHelper{_pCtMainWin}.save_buffer_no_widgets_to_xml(xml_doc.get_root_node(),
+                    ct_tree_iter->get_node_text_buffer(), start_offset, end_offset, 'n');
+            }
             node_txt = xml_doc.write_to_string();
+            txt_bytes = node_txt.size();
         }
         else {
             const auto text_buffer = ct_tree_iter->get_node_text_buffer();
-            if (end_offset < 0) {
-                node_txt = text_buffer->get_text();
-            }
-            else {
-                node_txt = text_buffer->get_iter_at_offset(start_offset).get_text(text_buffer->get_iter_at_offset(end_offset));
-            }
+            plain_start = end_offset < 0 ? text_buffer->begin() : text_buffer->get_iter_at_offset(start_offset);
+            plain_end = end_offset < 0 ? text_buffer->end() : text_buffer->get_iter_at_offset(end_offset);
+            CtTextIterUtil::text_for_each_chunk(plain_start, plain_end, [&txt_bytes](const Glib::ustring& chunk){
+                txt_bytes += chunk.bytes();
+            });
         }
+        auto f_bind_txt = [&](sqlite3_stmt* stmt, const int col){
+            if (is_plain) sqlite3_bind_zeroblob64(stmt, col, txt_bytes);
+            else sqlite3_bind_text(stmt, col, node_txt.c_str(), node_txt.size(), SQLITE_STATIC);
+        };
+        gint64 node_rowid{-1};
 
         // full node rewrite (buf + prop)
         if (node_state.prop) {
             if (node_state.is_update_of_existing) {
                 _exec_bind_int64(TABLE_NODE_DELETE, node_id);
             }
-            Sqlite3StmtAuto stmt{_pDb, TABLE_NODE_INSERT};
-            if (stmt.is_bad()) {
-                throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-            }
+            sqlite3_stmt* stmt = _get_cached_stmt_or_throw(TABLE_NODE_INSERT);
             const std::string node_name = ct_tree_iter->get_node_name();
             const std::string node_syntax = ct_tree_iter->get_node_syntax_highlighting();
             const std::string node_tags = ct_tree_iter->get_node_tags();
             sqlite3_bind_int64(stmt, 1, node_id);
             sqlite3_bind_text(stmt, 2, node_name.c_str(), node_name.size(), SQLITE_STATIC);
-            sqlite3_bind_text(stmt, 3, node_txt.c_str(), node_txt.size(), SQLITE_STATIC);
+            f_bind_txt(stmt, 3);
             sqlite3_bind_text(stmt, 4, node_syntax.c_str(), node_syntax.size(), SQLITE_STATIC);
             sqlite3_bind_text(stmt, 5, node_tags.c_str(), node_tags.size(), SQLITE_STATIC);
             sqlite3_bind_int64(stmt, 6, is_ro);
@@ -860,15 +1266,13 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
             if (sqlite3_step(stmt) != SQLITE_DONE) {
                 throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
             }
+            node_rowid = sqlite3_last_insert_rowid(_pDb);
         }
         // only node buff rewrite
         else {
-            Sqlite3StmtAuto stmt{_pDb, "UPDATE node SET txt=?, syntax=?, is_richtxt=?, has_codebox=?, has_table=?, has_image=?, ts_lastsave=? WHERE node_id=?"};
-            if (stmt.is_bad()) {
-                throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-            }
+            sqlite3_stmt* stmt = _get_cached_stmt_or_throw(NODE_BUFF_UPDATE);
             const std::string node_syntax = ct_tree_iter->get_node_syntax_highlighting();
-            sqlite3_bind_text(stmt, 1, node_txt.c_str(), node_txt.size(), SQLITE_STATIC);
+            f_bind_txt(stmt, 1);
             sqlite3_bind_text(stmt, 2, node_syntax.c_str(), node_syntax.size(), SQLITE_STATIC);
             sqlite3_bind_int64(stmt, 3, is_richtxt);
             sqlite3_bind_int64(stmt, 4, has_codebox);
@@ -879,10 +1283,49 @@ void CtStorageSqlite::_write_node_to_db(const CtTreeIter* ct_tree_iter,
             if (sqlite3_step(stmt) != SQLITE_DONE) {
                 throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
             }
+            if (is_plain) {
+                sqlite3_stmt* stmt_rowid = _get_cached_stmt_or_throw(NODE_ROWID_SELECT);
+                sqlite3_bind_int64(stmt_rowid, 1, node_id);
+                if (sqlite3_step(stmt_rowid) != SQLITE_ROW) {
+                    throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
+                }
+                node_rowid = sqlite3_column_int64(stmt_rowid, 0);
+            }
         }
+        _writtenNodesChecksums[node_id] = is_plain ?
+            _write_node_txt_slices(node_rowid, plain_start, plain_end, txt_bytes) :
+            static_cast<size_t>(node_txt_checksum_update(NODE_TXT_CHECKSUM_INIT, node_txt.c_str(), node_txt.size()));
     }
 }
 
+size_t CtStorageSqlite::_write_node_txt_slices(const gint64 node_rowid,
+                                               const Gtk::TextIter& start_iter,
+                                               const Gtk::TextIter& end_iter,
+                                               const size_t txt_bytes)
+{
+    sqlite3_blob* pSqliteBlob{nullptr};
+    if (SQLITE_OK != sqlite3_blob_open(_pDb, "main", "node", "txt", node_rowid, 1/*read write*/, &pSqliteBlob)) {
+        sqlite3_blob_close(pSqliteBlob);
+        throw std::runtime_error(fmt::format("!! sqlite3_blob_open node rowid {}: {}", node_rowid, sqlite3_errmsg(_pDb)));
+    }
+    auto on_scope_exit = scope_guard([pSqliteBlob](void*) { sqlite3_blob_close(pSqliteBlob); });
+    uint64_t checksum{NODE_TXT_CHECKSUM_INIT};
+    size_t offset{0};
+    CtTextIterUtil::text_for_each_chunk(start_iter, end_iter, [&](const Glib::ustring& chunk){
+        if (offset + chunk.bytes() > txt_bytes or
+            SQLITE_OK != sqlite3_blob_write(pSqliteBlob, chunk.data(), static_cast<int>(chunk.bytes()), static_cast<int>(offset)))
+        {
+            throw std::runtime_error(fmt::format("!! sqlite3_blob_write node rowid {} offset {}: {}", node_rowid, offset, sqlite3_errmsg(_pDb)));
+        }
+        checksum = node_txt_checksum_update(checksum, chunk.data(), chunk.bytes());
+        offset += chunk.bytes();
+    });
+    if (offset != txt_bytes) {
+        throw std::runtime_error(fmt::format("!! {} node rowid {} wrote {} of {} bytes", __FUNCTION__, node_rowid, offset, txt_bytes));
+    }
+    return static_cast<size_t>(checksum);
+}
+
 std::list<std::pair<gint64,gint64>> CtStorageSqlite::_get_children_node_ids_from_db(const gint64 father_id)
 {
     auto uStmt = std::make_unique<Sqlite3StmtAuto>(_pDb, "SELECT node_id, master_id FROM children WHERE father_id=? ORDER BY sequence ASC");
@@ -905,6 +1348,7 @@ void CtStorageSqlite::_remove_db_node_with_children(const gint64 node_id)
 {
     _exec_bind_int64(TABLE_CODEBOX_DELETE, node_id);
     _exec_bind_int64(TABLE_TABLE_DELETE, node_id);
+    _image_rows_release(node_id);
     _exec_bind_int64(TABLE_IMAGE_DELETE, node_id);
     _exec_bind_int64(TABLE_NODE_DELETE, node_id);
     _exec_bind_int64(TABLE_CHILDREN_DELETE, node_id);
@@ -914,6 +1358,20 @@ void CtStorageSqlite::_remove_db_node_with_children(const gint64 node_id)
     }
 }
 
+void CtStorageSqlite::_image_rows_release(const gint64 node_id)
+{
+    // the embedded files of these rows still in use (e.g. by the undo) are read in memory before the rows are deleted
+    std::unordered_set<gint64> rowids;
+    sqlite3_stmt* pStmt = _get_cached_stmt_or_throw(TABLE_IMAGE_SELECT_ROWIDS);
+    sqlite3_bind_int64(pStmt, 1, node_id);
+    while (SQLITE_ROW == sqlite3_step(pStmt)) {
+        rowids.insert(sqlite3_column_int64(pStmt, 0));
+    }
+    if (not rowids.empty()) {
+        CtEmbFileBlob::sqlite_rows_release(_pDb, rowids);
+    }
+}
+
 void CtStorageSqlite::_exec_no_callback(const char* sqlCmd)
 {
     char* p_err_msg{nullptr};
@@ -926,16 +1384,22 @@ void CtStorageSqlite::_exec_no_callback(const char* sqlCmd)
 
 void CtStorageSqlite::_exec_bind_int64(const char* sqlCmd, const gint64 bind_int64)
 {
-    Sqlite3StmtAuto stmt{_pDb, sqlCmd};
-    if (stmt.is_bad()) {
-        throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
-    }
-    sqlite3_bind_int64(stmt, 1, bind_int64);
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
+    sqlite3_stmt* pStmt = _get_cached_stmt_or_throw(sqlCmd);
+    sqlite3_bind_int64(pStmt, 1, bind_int64);
+    if (sqlite3_step(pStmt) != SQLITE_DONE) {
         throw std::runtime_error(ERR_SQLITE_STEP + sqlite3_errmsg(_pDb));
     }
 }
 
+sqlite3_stmt* CtStorageSqlite::_get_cached_stmt_or_throw(const char* sqlCmd)
+{
+    sqlite3_stmt* pStmt = _stmtsCache.get(_pDb, sqlCmd);
+    if (not pStmt) {
+        throw std::runtime_error(ERR_SQLITE_PREPV2 + sqlite3_errmsg(_pDb));
+    }
+    return pStmt;
+}
+
 void CtStorageSqlite::import_nodes(const fs::path& path, const Gtk::TreeModel::iterator& parent_iter)
 {
     _open_db(path); // storage is temp so can just open db
@@ -967,6 +1431,8 @@ void CtStorageSqlite::import_nodes(const fs::path& path, const Gtk::TreeModel::i
     for (const std::pair<gint64,gint64>& node_id_pair : _get_children_node_ids_from_db(0)) {
         f_nodes_from_db(node_id_pair, ++sequence, parent_iter);
     }
+    // the imported embedded files cannot stay in a file that is not the document
+    CtEmbFileBlob::sqlite_db_release(_pDb);
     _close_db();
     for (CtTreeIter& ctTreeIter : nodes_shared_non_master) {
         // the shared node master id is remapped after the import
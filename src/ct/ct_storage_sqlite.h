@@ -26,17 +26,44 @@
 #include "ct_types.h"
 #include "ct_widgets.h"
 #include "ct_filesystem.h"
+#include "ct_treestore.h"
 #include <sqlite3.h>
 #include <glibmm/refptr.h>
 #include <gtkmm/textbuffer.h>
 #include <gtkmm/treeiter.h>
 #include <unordered_set>
+#include <unordered_map>
+#include <deque>
 
 class CtMainWin;
 class CtAnchoredWidget;
 class CtTreeIter;
 class CtStorageCache;
 
+// The write statements of a connection, prepared once then reset and reused
+class CtSqliteStmtsCache
+{
+public:
+    CtSqliteStmtsCache() = default;
+    CtSqliteStmtsCache(const CtSqliteStmtsCache&) = delete;
+    CtSqliteStmtsCache& operator=(const CtSqliteStmtsCache&) = delete;
+
+    // reset and with the bindings cleared, nullptr on prepare failure
+    sqlite3_stmt* get(sqlite3* pDb, const char* sql);
+    // a statement left after its step would block the transaction commit
+    void reset_all();
+    // must be done before closing the connection
+    void finalize_all();
+
+    size_t get_num_prepared() const { return _numPrepared; }
+    size_t get_num_executed() const { return _numExecuted; }
+
+private:
+    std::unordered_map<std::string, sqlite3_stmt*> _stmts;
+    size_t _numPrepared{0};
+    size_t _numExecuted{0};
+};
+
 class CtStorageSqlite : public CtStorageEntity
 {
 public:
@@ -60,13 +87,21 @@ public:
                         const int end_offset = -1) override;
     void vacuum() override;
     void import_nodes(const fs::path& path, const Gtk::TreeModel::iterator& parent_iter) override;
+    void populate_treestore_complete() override;
 
     Glib::RefPtr<Gtk::TextBuffer> get_delayed_text_buffer(const gint64 node_id,
                                                           const std::string& syntax,
                                                           std::list<CtAnchoredWidget*>& widgets) const override;
+    bool delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id) override;
+    bool delayed_text_buffer_share_saved() const override { return true; }
 
     fs::path get_embedded_filepath(const CtTreeIter&/*ct_tree_iter*/, const std::string&/*filename*/) const override { return ""; }
 
+    // PRAGMA quick_check plus the text of the given nodes against their checksums
+    static bool quick_check_pass(const fs::path& file_path,
+                                 const std::unordered_map<gint64, size_t>& nodes_checksums,
+                                 Glib::ustring& error);
+
 private:
     void _open_db(const fs::path& path);
     void _close_db();
@@ -77,6 +112,14 @@ private:
                                 const gint64 sequence,
                                 Gtk::TreeModel::iterator parent_iter,
                                 const gint64 new_id);
+    void _node_data_from_stmt(sqlite3_stmt* pStmt, const int firstCol, CtNodeData& nodeData);
+
+    void _skeleton_from_db();
+    void _skeleton_append_children(const gint64 father_id, const Gtk::TreeModel::iterator& father_iter);
+    bool _skeleton_append_next();
+    void _skeleton_clear();
+    bool _on_skeleton_idle();
+    bool _on_treeview_test_expand_row(const Gtk::TreeModel::iterator& iter, const Gtk::TreeModel::Path& path);
 
     /**
      * @brief Check that the database contains the required tables
@@ -107,38 +150,69 @@ private:
                                           CtStorageCache* storage_cache,
                                           const CtExporting export_type,
                                           const std::map<gint64, gint64>* pExpoMasterReassign);
+    // returns the checksum of the written text
+    size_t              _write_node_txt_slices(const gint64 node_rowid,
+                                               const Gtk::TextIter& start_iter,
+                                               const Gtk::TextIter& end_iter,
+                                               const size_t txt_bytes);
+
+    // copies the stored rows a duplicated node shares with its source, false if the node is to be written from its text buffer
+    bool                _shared_delayed_row_copy(const CtTreeIter& ct_tree_iter, const CtStorageNodeState& node_state);
 
     std::list<std::pair<gint64,gint64>> _get_children_node_ids_from_db(const gint64 father_id);
     void                _remove_db_node_with_children(const gint64 node_id);
+    void                _image_rows_release(const gint64 node_id);
 
     void                _exec_no_callback(const char* sqlCmd);
     void                _exec_bind_int64(const char* sqlCmd, const gint64 bind_int64);
+    sqlite3_stmt*       _get_cached_stmt_or_throw(const char* sqlCmd);
 
 public:
     static const char TABLE_NODE_CREATE[];
     static const char TABLE_NODE_INSERT[];
     static const char TABLE_NODE_DELETE[];
+    static const char TABLE_NODE_COPY[];
     static const char TABLE_CODEBOX_CREATE[];
     static const char TABLE_CODEBOX_INSERT[];
     static const char TABLE_CODEBOX_DELETE[];
+    static const char TABLE_CODEBOX_COPY[];
     static const char TABLE_TABLE_CREATE[];
     static const char TABLE_TABLE_INSERT[];
     static const char TABLE_TABLE_DELETE[];
+    static const char TABLE_TABLE_COPY[];
     static const char TABLE_IMAGE_CREATE[];
     static const char TABLE_IMAGE_INSERT[];
     static const char TABLE_IMAGE_DELETE[];
+    static const char TABLE_IMAGE_INSERT_ZEROBLOB[];
+    static const char TABLE_IMAGE_DETACH[];
+    static const char TABLE_IMAGE_REATTACH[];
+    static const char TABLE_IMAGE_COPY[];
+    static const char TABLE_IMAGE_SELECT_ROWIDS[];
+    static const char TABLE_IMAGE_COPY_NODE[];
     static const char TABLE_CHILDREN_CREATE[];
     static const char TABLE_CHILDREN_INSERT[];
     static const char TABLE_CHILDREN_DELETE[];
     static const char TABLE_BOOKMARK_CREATE[];
     static const char TABLE_BOOKMARK_INSERT[];
     static const char TABLE_BOOKMARK_DELETE[];
+    static const char NODE_PROP_UPDATE[];
+    static const char NODE_BUFF_UPDATE[];
+    static const char NODE_ROWID_SELECT[];
     static const std::string ERR_SQLITE_PREPV2;
     static const std::string ERR_SQLITE_STEP;
     static const char* safe_sqlite3_column_text(sqlite3_stmt* stmt, int iCol);
 
 private:
-    CtMainWin*    _pCtMainWin;
-    sqlite3*      _pDb{nullptr};
-    fs::path      _file_path;
+    CtMainWin*         _pCtMainWin;
+    sqlite3*           _pDb{nullptr};
+    CtSqliteStmtsCache _stmtsCache; // finalized with the closing of _pDb
+    fs::path           _file_path;
+
+    // the tree structure is read in one query, the nodes not yet visible are appended in background
+    std::unordered_map<gint64, std::vector<CtNodeData>>      _skeletonChildren; // father id -> children not yet in tree store
+    std::deque<std::pair<gint64, Gtk::TreeModel::iterator>> _skeletonQueue;    // nodes with children not yet in tree store
+    sigc::connection                                         _skeletonIdleConn;
+    sigc::connection                                         _skeletonExpandConn;
+
+    mutable std::unordered_map<gint64, gint64> _sharedDelayedIds; // copy node id -> source node id
 };
@@ -26,12 +26,14 @@
 #include "ct_misc_utils.h"
 #include <libxml++/libxml++.h>
 #include <libxml2/libxml/parser.h>
+#include <libxml2/libxml/xmlreader.h>
 #include "ct_image.h"
 #include "ct_codebox.h"
 #include "ct_table.h"
 #include "ct_main_win.h"
 #include "ct_storage_control.h"
 #include "ct_storage_multifile.h"
+#include "ct_links_index.h"
 #include "ct_logging.h"
 
 // GtkSourceView 5 removed begin/end_not_undoable_action
@@ -248,6 +250,42 @@ Glib::RefPtr<Gtk::TextBuffer> CtStorageXml::get_delayed_text_buffer(const gint64
     return ret_buffer;
 }
 
+bool CtStorageXml::delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id)
+{
+    const auto iterDelayed = _delayed_text_buffers.find(node_id);
+    if (iterDelayed == _delayed_text_buffers.end()) {
+        return false;
+    }
+    // the parsed document is not modified, each node builds its own text buffer from it
+    _delayed_text_buffers[copy_node_id] = iterDelayed->second;
+    return true;
+}
+
+const xmlpp::Element* CtStorageXml::_get_shared_stored_content(const CtTreeIter& ct_tree_iter,
+                                                              const int start_offset,
+                                                              const int end_offset) const
+{
+    // only a duplicated node not used yet that shares the parsed document of its source
+    std::shared_ptr<CtNodeState> pNodeState;
+    if (0 != start_offset or
+        end_offset >= 0 or
+        not _pCtMainWin->get_tree_store().lazy_content_get(ct_tree_iter.get_node_id(), pNodeState) or
+        pNodeState)
+    {
+        return nullptr;
+    }
+    const auto iterDelayed = _delayed_text_buffers.find(ct_tree_iter.get_node_id());
+    if (iterDelayed == _delayed_text_buffers.end()) {
+        return nullptr;
+    }
+    return dynamic_cast<const xmlpp::Element*>(iterDelayed->second->get_root_node()->get_first_child());
+}
+
+void CtStorageXml::populate_memory_info(CtMemoryInfo& memoryInfo) const
+{
+    CtXmlHelper::populate_memory_info(_delayed_text_buffers, memoryInfo);
+}
+
 void CtStorageXml::_nodes_to_xml(CtTreeIter* ct_tree_iter,
                                  xmlpp::Element* p_node_parent,
                                  CtStorageCache* storage_cache,
@@ -256,8 +294,11 @@ void CtStorageXml::_nodes_to_xml(CtTreeIter* ct_tree_iter,
                                  const int start_offset/*= 0*/,
                                  const int end_offset/*= -1*/)
 {
-    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = ct_tree_iter->get_node_text_buffer();
-    if (not pTextBuffer) {
+    const xmlpp::Element* p_stored_content = _get_shared_stored_content(*ct_tree_iter, start_offset, end_offset);
+    if (not p_stored_content and
+        not _pCtMainWin->get_tree_store().lazy_content_to_write(*ct_tree_iter, start_offset, end_offset) and
+        not ct_tree_iter->get_node_text_buffer())
+    {
         throw std::runtime_error(str::format(_("Failed to retrieve the content of the node '%s'"), ct_tree_iter->get_node_name().raw()));
     }
     xmlpp::Element* p_node_node =  CtStorageXmlHelper{_pCtMainWin}.node_to_xml(
@@ -268,7 +309,8 @@ void CtStorageXml::_nodes_to_xml(CtTreeIter* ct_tree_iter,
         export_type,
         pExpoMasterReassign,
         start_offset,
-        end_offset
+        end_offset,
+        p_stored_content
     );
     if ( CtExporting::CURRENT_NODE != export_type and
          CtExporting::SELECTED_TEXT != export_type )
@@ -319,6 +361,30 @@ void CtStorageXml::_nodes_to_xml(CtTreeIter* ct_tree_iter,
     return parser;
 }
 
+/*static*/bool CtStorageXml::well_formed_check_pass(const fs::path& file_path, Glib::ustring& error)
+{
+    xmlTextReaderPtr pReader = xmlReaderForFile(file_path.c_str(), nullptr/*encoding*/, XML_PARSE_HUGE);
+    if (not pReader) {
+        error = fmt::format("{} cannot be read", file_path.string());
+        return false;
+    }
+    bool root_found{false};
+    bool root_ok{false};
+    int ret;
+    while ((ret = xmlTextReaderRead(pReader)) == 1) {
+        if (not root_found and XML_READER_TYPE_ELEMENT == xmlTextReaderNodeType(pReader)) {
+            root_found = true;
+            const xmlChar* pName = xmlTextReaderConstName(pReader);
+            root_ok = pName and 0 == g_strcmp0(reinterpret_cast<const char*>(pName), CtConst::APP_NAME);
+        }
+    }
+    xmlFreeTextReader(pReader);
+    if (0 != ret or not root_ok) {
+        error = fmt::format("{} is not well formed", file_path.string());
+        return false;
+    }
+    return true;
+}
 
 // Remove the body from the XML file before parsing.
 // Last chance for a node file we definitely can't parse. 
@@ -349,7 +415,8 @@ xmlpp::Element* CtStorageXmlHelper::node_to_xml(const CtTreeIter* ct_tree_iter,
                                                 const CtExporting export_type,
                                                 const std::map<gint64, gint64>* pExpoMasterReassign/*= nullptr*/,
                                                 const int start_offset/*= 0*/,
-                                                const int end_offset/*= -1*/)
+                                                const int end_offset/*= -1*/,
+                                                const xmlpp::Element* p_stored_content/*= nullptr*/)
 {
     xmlpp::Element* p_node_node = p_node_parent->add_child("node");
     const gint64 my_node_id = ct_tree_iter->get_node_id();
@@ -387,11 +454,32 @@ xmlpp::Element* CtStorageXmlHelper::node_to_xml(const CtTreeIter* ct_tree_iter,
         p_node_node->set_attribute("ts_creation", std::to_string(ct_tree_iter->get_node_creating_time()));
         p_node_node->set_attribute("ts_lastsave", std::to_string(ct_tree_iter->get_node_modification_time()));
 
-        Glib::RefPtr<Gtk::TextBuffer> buffer = ct_tree_iter->get_node_text_buffer();
-        save_buffer_no_widgets_to_xml(p_node_node, buffer, start_offset, end_offset, 'n');
+        // a duplicated node not used yet is written with no text buffer, the multifile node folder
+        // instead takes the embedded files of the widgets in the tree
+        const std::shared_ptr<CtNodeState> pLazyState = multifile_dir.empty() ?
+            _pCtMainWin->get_tree_store().lazy_content_to_write(*ct_tree_iter, start_offset, end_offset) : nullptr;
+        if (p_stored_content) {
+            for (const xmlpp::Node* pChild : p_stored_content->get_children()) {
+                if (dynamic_cast<const xmlpp::Element*>(pChild) and pChild->get_name() != "node") {
+                    p_node_node->import_node(pChild);
+                }
+            }
+        }
+        else if (pLazyState) {
+            for (xmlpp::Node* pSlot : pLazyState->buffer_xml.get_root_node()->get_children()) {
+                p_node_node->import_node(pSlot);
+            }
+            for (const std::unique_ptr<CtAnchoredWidget>& pAnchoredWidget : _pCtMainWin->get_tree_store().lazy_content_widgets(*pLazyState)) {
+                pAnchoredWidget->to_xml(p_node_node, 0, storage_cache, multifile_dir);
+            }
+        }
+        else {
+            Glib::RefPtr<Gtk::TextBuffer> buffer = ct_tree_iter->get_node_text_buffer();
+            save_buffer_no_widgets_to_xml(p_node_node, buffer, start_offset, end_offset, 'n');
 
-        for (CtAnchoredWidget* pAnchoredWidget : ct_tree_iter->get_anchored_widgets(start_offset, end_offset)) {
-            pAnchoredWidget->to_xml(p_node_node, start_offset > 0 ? -start_offset : 0, storage_cache, multifile_dir);
+            for (CtAnchoredWidget* pAnchoredWidget : ct_tree_iter->get_anchored_widgets(start_offset, end_offset)) {
+                pAnchoredWidget->to_xml(p_node_node, start_offset > 0 ? -start_offset : 0, storage_cache, multifile_dir);
+            }
         }
     }
     return p_node_node;
@@ -419,22 +507,9 @@ Gtk::TreeModel::iterator CtStorageXmlHelper::node_from_xml(const xmlpp::Element*
         node_data.nodeId = new_id;
         if (pImportedIdsRemap) (*pImportedIdsRemap)[readNodeId] = new_id;
     }
-    node_data.sharedNodesMasterId = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("master_id").c_str());
     node_data.sequence = sequence;
-    if (node_data.sharedNodesMasterId <= 0) {
-        node_data.name = xml_element->get_attribute_value("name");
-        node_data.syntax = xml_element->get_attribute_value("prog_lang");
-        node_data.tags = xml_element->get_attribute_value("tags");
-        node_data.isReadOnly = CtStrUtil::is_str_true(xml_element->get_attribute_value("readonly"));
-        node_data.excludeMeFromSearch = CtStrUtil::is_str_true(xml_element->get_attribute_value("nosearch_me"));
-        node_data.excludeChildrenFromSearch = CtStrUtil::is_str_true(xml_element->get_attribute_value("nosearch_ch"));
-        node_data.customIconId = (guint32)CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("custom_icon_id").c_str());
-        node_data.isBold = CtStrUtil::is_str_true(xml_element->get_attribute_value("is_bold"));
-        node_data.foregroundRgb24 = xml_element->get_attribute_value("foreground");
-        node_data.tsCreation = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("ts_creation").c_str());
-        node_data.tsLastSave = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("ts_lastsave").c_str());
-    }
-    else if (pIsSharedNonMaster) {
+    node_props_from_xml(xml_element, node_data);
+    if (node_data.sharedNodesMasterId > 0 and pIsSharedNonMaster) {
         *pIsSharedNonMaster = true;
     }
 
@@ -467,6 +542,24 @@ Gtk::TreeModel::iterator CtStorageXmlHelper::node_from_xml(const xmlpp::Element*
     return _pCtMainWin->get_tree_store().append_node(&node_data, &parent_iter);
 }
 
+void CtStorageXmlHelper::node_props_from_xml(const xmlpp::Element* xml_element, CtNodeData& node_data)
+{
+    node_data.sharedNodesMasterId = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("master_id").c_str());
+    if (node_data.sharedNodesMasterId <= 0) {
+        node_data.name = xml_element->get_attribute_value("name");
+        node_data.syntax = xml_element->get_attribute_value("prog_lang");
+        node_data.tags = xml_element->get_attribute_value("tags");
+        node_data.isReadOnly = CtStrUtil::is_str_true(xml_element->get_attribute_value("readonly"));
+        node_data.excludeMeFromSearch = CtStrUtil::is_str_true(xml_element->get_attribute_value("nosearch_me"));
+        node_data.excludeChildrenFromSearch = CtStrUtil::is_str_true(xml_element->get_attribute_value("nosearch_ch"));
+        node_data.customIconId = (guint32)CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("custom_icon_id").c_str());
+        node_data.isBold = CtStrUtil::is_str_true(xml_element->get_attribute_value("is_bold"));
+        node_data.foregroundRgb24 = xml_element->get_attribute_value("foreground");
+        node_data.tsCreation = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("ts_creation").c_str());
+        node_data.tsLastSave = CtStrUtil::gint64_from_gstring(xml_element->get_attribute_value("ts_lastsave").c_str());
+    }
+}
+
 Glib::RefPtr<Gtk::TextBuffer> CtStorageXmlHelper::create_buffer_and_widgets_from_xml(const xmlpp::Element* parent_xml_element,
                                                                                      const Glib::ustring&/*syntax*/,
                                                                                      std::list<CtAnchoredWidget*>& widgets,
@@ -629,16 +722,26 @@ void CtStorageXmlHelper::_add_rich_text_from_xml(Glib::RefPtr<Gtk::TextBuffer> b
     const Glib::ustring text_content = text_node->get_content();
     if (text_content.empty()) return;
     std::vector<Glib::ustring> tags;
+    Glib::ustring link_target;
     for (const xmlpp::Attribute* pAttribute : xml_element->get_attributes()) {
         if (CtStrUtil::contains(CtConst::TAG_PROPERTIES, pAttribute->get_name().c_str())) {
             tags.push_back(_pCtMainWin->get_text_tag_name_exist_or_create(pAttribute->get_name(), pAttribute->get_value()));
+            if (CtConst::TAG_LINK == pAttribute->get_name()) {
+                link_target = pAttribute->get_value();
+            }
         }
     }
     Gtk::TextIter iter = text_insert_pos ? *text_insert_pos : buffer->end();
+    const int start_offset = iter.get_offset();
     if (tags.size() > 0)
         buffer->insert_with_tags_by_name(iter, text_content, tags);
     else
         buffer->insert(iter, text_content);
+    if (not link_target.empty()) {
+        CtLinksIndex::get(buffer).set_target(buffer->get_iter_at_offset(start_offset),
+                                             buffer->get_iter_at_offset(start_offset + (int)text_content.size()),
+                                             link_target);
+    }
 }
 
 CtAnchoredWidget* CtStorageXmlHelper::_create_image_from_xml(xmlpp::Element* xml_element,
@@ -663,6 +766,7 @@ CtAnchoredWidget* CtStorageXmlHelper::_create_image_from_xml(xmlpp::Element* xml
         return new CtImageLatex{_pCtMainWin, encodedBlob, charOffset, justification, CtImageEmbFile::get_next_unique_id()};
     }
     std::string rawBlob;
+    std::shared_ptr<CtEmbFileBlob> pEmbFileBlob;
     if (multifile_dir.empty()) {
         // type is single file
         if (encodedBlob.empty()) {
@@ -682,6 +786,15 @@ CtAnchoredWidget* CtStorageXmlHelper::_create_image_from_xml(xmlpp::Element* xml
             }
             // if file name is non empty, it is ok since this is a multifile type and it means file name is constant on disk
         }
+        else if (not file_name.empty()) {
+            // the embedded file content stays on disk until needed
+            const fs::path blob_filepath = CtStorageMultiFile::find_blob(multifile_dir, sha256sum);
+            if (blob_filepath.empty()) {
+                spdlog::warn("!! {} unexp not found {} in {}", __FUNCTION__, sha256sum, multifile_dir);
+                return nullptr;
+            }
+            pEmbFileBlob = CtEmbFileBlob::from_file(blob_filepath, sha256sum);
+        }
         else if (not CtStorageMultiFile::read_blob(multifile_dir, sha256sum, rawBlob)) {
             spdlog::warn("!! {} unexp not found {} in {}", __FUNCTION__, sha256sum, multifile_dir);
             return nullptr;
@@ -695,7 +808,7 @@ CtAnchoredWidget* CtStorageXmlHelper::_create_image_from_xml(xmlpp::Element* xml
         const time_t timeInt = std::stoll(timeStr);
         return new CtImageEmbFile{_pCtMainWin,
                                   file_name,
-                                  rawBlob,
+                                  pEmbFileBlob ? pEmbFileBlob : CtEmbFileBlob::from_memory(std::move(rawBlob)),
                                   timeInt,
                                   charOffset,
                                   justification,
@@ -817,3 +930,41 @@ bool CtXmlHelper::safe_parse_memory(xmlpp::DomParser& parser, const Glib::ustrin
     }
     return parser.get_document() and parser.get_document()->get_root_node();
 }
+
+size_t CtXmlHelper::get_document_bytes(const xmlpp::Document* pDocument)
+{
+    const xmlDoc* pXmlDoc = pDocument->cobj();
+    size_t bytes{sizeof(xmlDoc)};
+    std::vector<const xmlNode*> siblingsFirst{pXmlDoc->children};
+    while (not siblingsFirst.empty()) {
+        const xmlNode* pXmlNode = siblingsFirst.back();
+        siblingsFirst.pop_back();
+        for (; pXmlNode; pXmlNode = pXmlNode->next) {
+            bytes += sizeof(xmlNode);
+            if (pXmlNode->name) bytes += static_cast<size_t>(xmlStrlen(pXmlNode->name));
+            if (pXmlNode->content) bytes += static_cast<size_t>(xmlStrlen(pXmlNode->content));
+            if (XML_ELEMENT_NODE == pXmlNode->type) {
+                for (const xmlAttr* pXmlAttr = pXmlNode->properties; pXmlAttr; pXmlAttr = pXmlAttr->next) {
+                    bytes += sizeof(xmlAttr) + static_cast<size_t>(xmlStrlen(pXmlAttr->name));
+                    if (pXmlAttr->children and pXmlAttr->children->content) {
+                        bytes += sizeof(xmlNode) + static_cast<size_t>(xmlStrlen(pXmlAttr->children->content));
+                    }
+                }
+            }
+            if (pXmlNode->children) siblingsFirst.push_back(pXmlNode->children);
+        }
+    }
+    return bytes;
+}
+
+void CtXmlHelper::populate_memory_info(const CtDelayedTextBufferMap& delayed_text_buffers, CtMemoryInfo& memoryInfo)
+{
+    for (const auto& [node_id, pDocument] : delayed_text_buffers) {
+        // the copies of a node not yet loaded share its document
+        if (pDocument and memoryInfo.sharedSeen.insert(pDocument.get()).second) {
+            const size_t documentBytes = get_document_bytes(pDocument.get());
+            memoryInfo.nodes[node_id].delayedXmlDoc.add(documentBytes);
+            memoryInfo.delayedXmlDocs.add(documentBytes);
+        }
+    }
+}
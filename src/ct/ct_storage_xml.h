@@ -42,6 +42,7 @@ class CtAnchoredWidget;
 class CtMainWin;
 class CtTreeIter;
 class CtStorageCache;
+struct CtNodeData;
 
 class CtStorageXml : public CtStorageEntity
 {
@@ -58,6 +59,8 @@ public:
 
     static std::unique_ptr<xmlpp::DomParser> get_parser(const fs::path& file_path);
     static std::unique_ptr<xmlpp::DomParser> get_parser_header_only(const fs::path &file_path);
+    // well formed and with the expected root, streamed without building the document
+    static bool well_formed_check_pass(const fs::path& file_path, Glib::ustring& error);
 
     bool populate_treestore(const fs::path& file_path, Glib::ustring& error) override;
     bool save_treestore(const fs::path& file_path,
@@ -72,6 +75,9 @@ public:
     Glib::RefPtr<Gtk::TextBuffer> get_delayed_text_buffer(const gint64 node_id,
                                                           const std::string& syntax,
                                                           std::list<CtAnchoredWidget*>& widgets) const override;
+    bool delayed_text_buffer_share(const gint64 node_id, const gint64 copy_node_id) override;
+    bool delayed_text_buffer_share_saved() const override { return true; }
+    void populate_memory_info(CtMemoryInfo& memoryInfo) const override;
 
     fs::path get_embedded_filepath(const CtTreeIter&/*ct_tree_iter*/, const std::string&/*filename*/) const override { return ""; }
 
@@ -83,6 +89,10 @@ private:
                        const std::map<gint64, gint64>* pExpoMasterReassign = nullptr,
                        const int start_offset = 0,
                        const int end_offset =-1);
+    // the stored element a duplicated node not used yet is written from, with no text buffer
+    const xmlpp::Element* _get_shared_stored_content(const CtTreeIter& ct_tree_iter,
+                                                     const int start_offset,
+                                                     const int end_offset) const;
 
 private:
     CtMainWin* const _pCtMainWin;
@@ -103,7 +113,8 @@ public:
                                 const CtExporting export_type,
                                 const std::map<gint64, gint64>* pExpoMasterReassign = nullptr,
                                 const int start_offset = 0,
-                                const int end_offset = -1);
+                                const int end_offset = -1,
+                                const xmlpp::Element* p_stored_content = nullptr);
     Gtk::TreeModel::iterator node_from_xml(const xmlpp::Element* xml_element,
                                 const gint64 sequence,
                                 const Gtk::TreeModel::iterator parent_iter,
@@ -114,6 +125,7 @@ public:
                                 CtDelayedTextBufferMap& delayed_text_buffers,
                                 const bool isDryRun,
                                 const std::string& multifile_dir);
+    void node_props_from_xml(const xmlpp::Element* xml_element, CtNodeData& node_data);
 
     Glib::RefPtr<Gtk::TextBuffer> create_buffer_and_widgets_from_xml(const xmlpp::Element* parent_xml_element,
                                                                      const Glib::ustring& syntax,
@@ -167,4 +179,8 @@ void table_to_xml(xmlpp::Element* parent,
 
 bool safe_parse_memory(xmlpp::DomParser& parser, const Glib::ustring& xml_content);
 
+// estimate of the memory held by the libxml2 tree of the document
+size_t get_document_bytes(const xmlpp::Document* pDocument);
+void populate_memory_info(const CtDelayedTextBufferMap& delayed_text_buffers, CtMemoryInfo& memoryInfo);
+
 } // namespace CtXmlHelper
@@ -278,11 +278,11 @@ void CtTableCommon::to_xml(xmlpp::Element* p_node_parent, const int offset_adjus
                               CtAnchWidgType::TableLight == get_type());
 }
 
-bool CtTableCommon::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
+bool CtTableCommon::to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache*)
 {
     bool retVal{true};
-    sqlite3_stmt *p_stmt;
-    if (sqlite3_prepare_v2(pDb, CtStorageSqlite::TABLE_TABLE_INSERT, -1, &p_stmt, nullptr) != SQLITE_OK) {
+    sqlite3_stmt* p_stmt = stmtsCache.get(pDb, CtStorageSqlite::TABLE_TABLE_INSERT);
+    if (not p_stmt) {
         spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_PREPV2, sqlite3_errmsg(pDb));
         retVal = false;
     }
@@ -305,7 +305,6 @@ bool CtTableCommon::to_sqlite(sqlite3* pDb, const gint64 node_id, const int offs
             spdlog::error("{}: {}", CtStorageSqlite::ERR_SQLITE_STEP, sqlite3_errmsg(pDb));
             retVal = false;
         }
-        sqlite3_finalize(p_stmt);
     }
     return retVal;
 }
@@ -0,0 +1,228 @@
+/*
+ * ct_task_pool.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "ct_task_pool.h"
+#include "ct_logging.h"
+#include <algorithm>
+
+namespace {
+
+constexpr size_t NO_WORKER{static_cast<size_t>(-1)};
+// the index of the worker running on this thread, if any
+thread_local size_t tl_workerIdx{NO_WORKER};
+
+} // namespace (anonymous)
+
+/*static*/CtTaskPool& CtTaskPool::get()
+{
+    static CtTaskPool taskPool;
+    return taskPool;
+}
+
+CtTaskPool::CtTaskPool()
+{
+    size_t workers_num = std::thread::hardware_concurrency();
+    if (0 == workers_num) workers_num = 4;
+    for (size_t i = 0; i < workers_num; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers_num; ++i) {
+        _workers[i]->thread = std::thread{&CtTaskPool::_worker_loop, this, i};
+    }
+    _dispatcher.connect(sigc::mem_fun(*this, &CtTaskPool::_on_dispatch));
+}
+
+CtTaskPool::~CtTaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{_sleepMutex};
+        _stop = true;
+    }
+    _sleepCv.notify_all();
+    for (std::unique_ptr<Worker>& pWorker : _workers) {
+        pWorker->thread.join();
+    }
+}
+
+void CtTaskPool::submit(std::function<void()> task, const Priority priority, const CancelToken& cancelToken)
+{
+    // from a worker onto its own deque, else spread over the workers
+    const size_t workerIdx = NO_WORKER != tl_workerIdx ? tl_workerIdx : _nextWorker++ % _workers.size();
+    Worker& worker = *_workers[workerIdx];
+    {
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        worker.deques[static_cast<size_t>(priority)].push_back(Task{std::move(task), cancelToken});
+        ++_pendingNum;
+    }
+    {
+        // the sleeping worker either sees the pending task or gets the notification
+        std::lock_guard<std::mutex> lock{_sleepMutex};
+    }
+    _sleepCv.notify_one();
+}
+
+void CtTaskPool::submit_then(std::function<void()> task,
+                             std::function<void()> on_main,
+                             const Priority priority,
+                             const CancelToken& cancelToken)
+{
+    submit([this, task, on_main, cancelToken](){
+        task();
+        if (cancelToken.is_cancelled()) return;
+        run_on_main([on_main, cancelToken](){
+            if (not cancelToken.is_cancelled()) {
+                on_main();
+            }
+        });
+    }, priority, cancelToken);
+}
+
+void CtTaskPool::run_on_main(std::function<void()> f)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mainMutex};
+        _mainQueue.push_back(std::move(f));
+    }
+    _dispatcher.emit();
+}
+
+void CtTaskPool::parallel_for(const size_t first, const size_t last, const std::function<void(size_t)>& f)
+{
+    if (last <= first) return;
+    struct State
+    {
+        std::function<void(size_t)> f;
+        size_t                      last;
+        size_t                      total;
+        std::atomic<size_t>         next;
+        std::atomic<size_t>         doneNum{0};
+        std::mutex                  mutex;
+        std::condition_variable     cv;
+    };
+    auto pState = std::make_shared<State>();
+    pState->f = f;
+    pState->last = last;
+    pState->total = last - first;
+    pState->next = first;
+    // the indexes are handed out one at a time, so that the faster threads take more of them;
+    // a helper started after the range is exhausted returns without touching f
+    auto f_slice = [pState](){
+        for (size_t index = pState->next++; index < pState->last; index = pState->next++) {
+            try {
+                pState->f(index);
+            }
+            catch (std::exception& e) {
+                spdlog::error("!! parallel_for {}", e.what());
+            }
+            if (++pState->doneNum == pState->total) {
+                std::lock_guard<std::mutex> lock{pState->mutex};
+                pState->cv.notify_all();
+            }
+        }
+    };
+    const size_t helpers_num = std::min(pState->total - 1, _workers.size());
+    for (size_t i = 0; i < helpers_num; ++i) {
+        submit(f_slice, Priority::High);
+    }
+    f_slice();
+    std::unique_lock<std::mutex> lock{pState->mutex};
+    pState->cv.wait(lock, [&pState](){ return pState->doneNum == pState->total; });
+}
+
+bool CtTaskPool::_try_pop(const size_t workerIdx, Task& task)
+{
+    for (size_t prio = 0; prio < 3u; ++prio) {
+        {
+            // own tasks, the newest first
+            Worker& worker = *_workers[workerIdx];
+            std::lock_guard<std::mutex> lock{worker.mutex};
+            std::deque<Task>& deque = worker.deques[prio];
+            if (not deque.empty()) {
+                task = std::move(deque.back());
+                deque.pop_back();
+                --_pendingNum;
+                return true;
+            }
+        }
+        // steal the oldest task of another worker
+        for (size_t i = 1; i < _workers.size(); ++i) {
+            Worker& victim = *_workers[(workerIdx + i) % _workers.size()];
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            std::deque<Task>& deque = victim.deques[prio];
+            if (not deque.empty()) {
+                task = std::move(deque.front());
+                deque.pop_front();
+                --_pendingNum;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void CtTaskPool::_worker_loop(const size_t workerIdx)
+{
+    tl_workerIdx = workerIdx;
+    while (true) {
+        Task task;
+        if (_try_pop(workerIdx, task)) {
+            _run_task(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock{_sleepMutex};
+        _sleepCv.wait(lock, [this](){ return _stop or _pendingNum > 0; });
+        if (_stop) {
+            return;
+        }
+    }
+}
+
+/*static*/void CtTaskPool::_run_task(Task& task)
+{
+    if (task.cancelToken.is_cancelled()) {
+        return;
+    }
+    try {
+        task.f();
+    }
+    catch (std::exception& e) {
+        spdlog::error("!! {} {}", __FUNCTION__, e.what());
+    }
+}
+
+void CtTaskPool::_on_dispatch()
+{
+    std::vector<std::function<void()>> mainQueue;
+    {
+        std::lock_guard<std::mutex> lock{_mainMutex};
+        mainQueue.swap(_mainQueue);
+    }
+    for (std::function<void()>& f : mainQueue) {
+        try {
+            f();
+        }
+        catch (std::exception& e) {
+            spdlog::error("!! {} {}", __FUNCTION__, e.what());
+        }
+    }
+}
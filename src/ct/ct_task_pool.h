@@ -0,0 +1,111 @@
+/*
+ * ct_task_pool.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <glibmm/dispatcher.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Application wide pool of worker threads, one per core, shared by all the background work.
+// Every worker has its own deques (one per priority): it runs the newest of its own tasks first
+// and when out of work it steals the oldest tasks of the other workers.
+// The first call to get() is to be done from the GUI thread, where the main loop continuations run.
+class CtTaskPool
+{
+public:
+    enum class Priority { High = 0, Normal = 1, Low = 2 };
+
+    // shared by the submitter and the task, a task cancelled before being started is dropped
+    class CancelToken
+    {
+    public:
+        CancelToken() : _pCancelled{std::make_shared<std::atomic<bool>>(false)} {}
+        void cancel() { _pCancelled->store(true); }
+        bool is_cancelled() const { return _pCancelled->load(); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> _pCancelled;
+    };
+
+    static CtTaskPool& get();
+
+    CtTaskPool(const CtTaskPool&) = delete;
+    CtTaskPool& operator=(const CtTaskPool&) = delete;
+
+    void submit(std::function<void()> task,
+                const Priority priority = Priority::Normal,
+                const CancelToken& cancelToken = CancelToken{});
+    // on_main runs on the GUI thread after the task, unless cancelled in the meantime
+    void submit_then(std::function<void()> task,
+                     std::function<void()> on_main,
+                     const Priority priority = Priority::Normal,
+                     const CancelToken& cancelToken = CancelToken{});
+    // from any thread, f is queued to run on the GUI thread
+    void run_on_main(std::function<void()> f);
+    // returns when f was called for every index in [first, last), the calling thread takes part
+    // so that it can also be used from within a task
+    void parallel_for(const size_t first, const size_t last, const std::function<void(size_t)>& f);
+
+    size_t get_workers_num() const { return _workers.size(); }
+
+private:
+    struct Task
+    {
+        std::function<void()> f;
+        CancelToken           cancelToken;
+    };
+    struct Worker
+    {
+        std::mutex                      mutex;
+        std::array<std::deque<Task>, 3> deques;
+        std::thread                     thread;
+    };
+
+    CtTaskPool();
+    ~CtTaskPool();
+
+    bool _try_pop(const size_t workerIdx, Task& task);
+    void _worker_loop(const size_t workerIdx);
+    void _on_dispatch();
+
+    static void _run_task(Task& task);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t>                  _nextWorker{0};
+    std::atomic<size_t>                  _pendingNum{0};
+    std::mutex                           _sleepMutex;
+    std::condition_variable              _sleepCv;
+    bool                                 _stop{false};
+
+    std::mutex                           _mainMutex;
+    std::vector<std::function<void()>>   _mainQueue;
+    Glib::Dispatcher                     _dispatcher;
+};
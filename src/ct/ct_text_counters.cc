@@ -0,0 +1,123 @@
+/*
+ * ct_text_counters.cc
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include "ct_text_counters.h"
+#include "ct_misc_utils.h"
+#include <algorithm>
+
+namespace {
+
+const char TEXT_COUNTERS_KEY[]{"ct-text-counters"};
+
+} // namespace (anonymous)
+
+/*static*/CtTextCounters& CtTextCounters::get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer)
+{
+    GObject* pObject = G_OBJECT(pTextBuffer->gobj());
+    auto pTextCounters = static_cast<CtTextCounters*>(g_object_get_data(pObject, TEXT_COUNTERS_KEY));
+    if (not pTextCounters) {
+        pTextCounters = new CtTextCounters{pTextBuffer->gobj()};
+        g_object_set_data_full(pObject, TEXT_COUNTERS_KEY, pTextCounters, [](gpointer pData){
+            delete static_cast<CtTextCounters*>(pData);
+        });
+    }
+    return *pTextCounters;
+}
+
+/*static*/CtTextCounts CtTextCounters::get_counts(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer)
+{
+    if (not pTextBuffer) {
+        return CtTextCounts{};
+    }
+    Gtk::TextIter iter_sel_start;
+    Gtk::TextIter iter_sel_end;
+    if (pTextBuffer->get_selection_bounds(iter_sel_start, iter_sel_end)) {
+        return CtTextCounts{CtTextIterUtil::get_words_count(pTextBuffer->get_text(iter_sel_start, iter_sel_end, true)),
+                            iter_sel_end.get_offset() - iter_sel_start.get_offset(),
+                            iter_sel_end.get_line() - iter_sel_start.get_line() + 1};
+    }
+    const CtTextCounters& textCounters = get(pTextBuffer);
+    return CtTextCounts{textCounters.get_words(), textCounters.get_chars(), textCounters.get_lines()};
+}
+
+/*static*/CtTextCounts CtTextCounters::get_counts(const Glib::ustring& text)
+{
+    return CtTextCounts{CtTextIterUtil::get_words_count(text),
+                        static_cast<int>(text.size()),
+                        static_cast<int>(std::count(text.begin(), text.end(), '\n')) + 1};
+}
+
+CtTextCounters::CtTextCounters(GtkTextBuffer* pBuffer)
+ : _pBuffer{pBuffer}
+{
+    GtkTextIter start, end;
+    gtk_text_buffer_get_bounds(_pBuffer, &start, &end);
+    _words = _get_lines_words(&start, &end);
+    g_signal_connect(_pBuffer, "insert-text", G_CALLBACK(_on_insert_text_before), this);
+    g_signal_connect_after(_pBuffer, "insert-text", G_CALLBACK(_on_insert_text_after), this);
+    g_signal_connect(_pBuffer, "delete-range", G_CALLBACK(_on_delete_range_before), this);
+    g_signal_connect_after(_pBuffer, "delete-range", G_CALLBACK(_on_delete_range_after), this);
+}
+
+// words of the whole lines from pStart to pEnd, a word never spans over a newline
+/*static*/int CtTextCounters::_get_lines_words(const GtkTextIter* pStart, const GtkTextIter* pEnd)
+{
+    GtkTextIter line_start = *pStart;
+    GtkTextIter line_end = *pEnd;
+    gtk_text_iter_order(&line_start, &line_end);
+    gtk_text_iter_set_line_offset(&line_start, 0);
+    if (not gtk_text_iter_ends_line(&line_end)) {
+        gtk_text_iter_forward_to_line_end(&line_end);
+    }
+    g_autofree gchar* pText = gtk_text_iter_get_text(&line_start, &line_end);
+    return CtTextIterUtil::get_words_count(Glib::ustring{pText});
+}
+
+/*static*/void CtTextCounters::_on_insert_text_before(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pLocation, gchar*/*pText*/, gint/*len*/, gpointer pData)
+{
+    auto pTextCounters = static_cast<CtTextCounters*>(pData);
+    pTextCounters->_words -= _get_lines_words(pLocation, pLocation);
+}
+
+/*static*/void CtTextCounters::_on_insert_text_after(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pLocation, gchar* pText, gint len, gpointer pData)
+{
+    // the location was moved by the default handler to the end of the inserted text
+    auto pTextCounters = static_cast<CtTextCounters*>(pData);
+    GtkTextIter insert_start = *pLocation;
+    gtk_text_iter_backward_chars(&insert_start, g_utf8_strlen(pText, len));
+    pTextCounters->_words += _get_lines_words(&insert_start, pLocation);
+}
+
+/*static*/void CtTextCounters::_on_delete_range_before(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData)
+{
+    auto pTextCounters = static_cast<CtTextCounters*>(pData);
+    pTextCounters->_words -= _get_lines_words(pStart, pEnd);
+}
+
+/*static*/void CtTextCounters::_on_delete_range_after(GtkTextBuffer*/*pBuffer*/, GtkTextIter* pStart, GtkTextIter*/*pEnd*/, gpointer pData)
+{
+    // the range is now empty, the lines at its edges have been joined
+    auto pTextCounters = static_cast<CtTextCounters*>(pData);
+    pTextCounters->_words += _get_lines_words(pStart, pStart);
+}
@@ -0,0 +1,57 @@
+/*
+ * ct_text_counters.h
+ *
+ * Copyright 2009-2026
+ * Giuseppe Penone <giuspen@gmail.com>
+ * Evgenii Gurianov <https://github.com/txe>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#include "ct_types.h"
+#include <gtkmm/textbuffer.h>
+
+// Words count of a text buffer kept up to date from the buffer signals and owned by the buffer.
+// Before an insertion or deletion the words of the lines involved are subtracted,
+// after it the words of the resulting lines are added back, so only the edited paragraphs are recounted.
+class CtTextCounters
+{
+public:
+    static CtTextCounters& get(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer);
+    // of the selection if any, else of the whole buffer
+    static CtTextCounts    get_counts(const Glib::RefPtr<Gtk::TextBuffer>& pTextBuffer);
+    static CtTextCounts    get_counts(const Glib::ustring& text);
+
+    int get_words() const { return _words; }
+    int get_chars() const { return gtk_text_buffer_get_char_count(_pBuffer); }
+    int get_lines() const { return gtk_text_buffer_get_line_count(_pBuffer); }
+
+private:
+    explicit CtTextCounters(GtkTextBuffer* pBuffer);
+
+    static int _get_lines_words(const GtkTextIter* pStart, const GtkTextIter* pEnd);
+
+    static void _on_insert_text_before(GtkTextBuffer* pBuffer, GtkTextIter* pLocation, gchar* pText, gint len, gpointer pData);
+    static void _on_insert_text_after(GtkTextBuffer* pBuffer, GtkTextIter* pLocation, gchar* pText, gint len, gpointer pData);
+    static void _on_delete_range_before(GtkTextBuffer* pBuffer, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData);
+    static void _on_delete_range_after(GtkTextBuffer* pBuffer, GtkTextIter* pStart, GtkTextIter* pEnd, gpointer pData);
+
+    GtkTextBuffer* _pBuffer; // owns these counters
+    int            _words{0};
+};
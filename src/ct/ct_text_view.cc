@@ -27,6 +27,7 @@
 #include "ct_actions.h"
 #include "ct_list.h"
 #include "ct_clipboard.h"
+#include "ct_links_index.h"
 
 #ifdef HAVE_GSPELL
 std::unordered_map<std::string, GspellChecker*> CtTextView::_static_spell_checkers;
@@ -137,6 +138,9 @@ CtTextView::CtTextView(CtMainWin* pCtMainWin)
 
 CtTextView::~CtTextView()
 {
+#ifdef HAVE_GSPELL
+    _uSpellCheck.reset(); // while the textview is still there
+#endif
 #ifdef HAVE_LIBSPELLING
     g_clear_object(&_spellingAdapter);
     g_clear_object(&_spellingChecker);
@@ -377,15 +381,12 @@ void CtTextView::for_event_after_double_click_button12(GdkEvent* event)
          (iter_rect.get_width() < 0/*RTL*/ and (iter_rect.get_x() + iter_rect.get_width()) <= x and x <= iter_rect.get_x()) )
     {
         if (_pCtConfig->doubleClickLink) {
-            auto tags = text_iter.get_tags();
             // check whether we are hovering a link
-            for (auto& tag : tags) {
-                Glib::ustring tag_name = tag->property_name();
-                if (str::startswith(tag_name, CtConst::TAG_LINK)) {
-                    _pCtMainWin->get_ct_actions()->link_clicked(tag_name.substr(5), event->button.button == 2);
-                    text_buffer->place_cursor(text_iter);
-                    return;
-                }
+            const Glib::ustring link_target = CtLinksIndex::get_target_at(text_iter);
+            if (not link_target.empty()) {
+                _pCtMainWin->get_ct_actions()->link_clicked(link_target, event->button.button == 2);
+                text_buffer->place_cursor(text_iter);
+                return;
             }
         }
     }
@@ -511,16 +512,13 @@ void CtTextView::for_event_after_button_press(GdkEvent* event)
         if ( (iter_rect.get_width() >= 0/*LTR*/ and iter_rect.get_x() <= x and x <= (iter_rect.get_x() + iter_rect.get_width())) or
              (iter_rect.get_width() < 0/*RTL*/ and (iter_rect.get_x() + iter_rect.get_width()) <= x and x <= iter_rect.get_x()) )
         {
-            auto tags = text_iter.get_tags();
             // check whether we are hovering a link
-            for (auto& tag : tags) {
-                Glib::ustring tag_name = tag->property_name();
-                if (str::startswith(tag_name, CtConst::TAG_LINK)) {
-                    if (not _pCtConfig->doubleClickLink) {
-                        _pCtMainWin->get_ct_actions()->link_clicked(tag_name.substr(5), event->button.button == 2);
-                    }
-                    return;
+            const Glib::ustring link_target = CtLinksIndex::get_target_at(text_iter);
+            if (not link_target.empty()) {
+                if (not _pCtConfig->doubleClickLink) {
+                    _pCtMainWin->get_ct_actions()->link_clicked(link_target, event->button.button == 2);
                 }
+                return;
             }
             if (CtList{_pCtConfig, text_buffer}.is_list_todo_beginning(text_iter)) {
                 if (_pCtMainWin->get_ct_actions()->_is_curr_node_not_read_only_or_error()) {
@@ -810,16 +808,11 @@ void CtTextView::cursor_and_tooltips_handler(int x, int y)
             _pTextView->set_tooltip_text("");
             return;
         }
-        auto tags = text_iter.get_tags();
-        bool find_link = false;
-        for (auto tag : tags) {
-            Glib::ustring tag_name = tag->property_name();
-            if (str::startswith(tag_name, CtConst::TAG_LINK)) {
-                find_link = true;
-                hovering_link_iter_offset = text_iter.get_offset();
-                tooltip = _pCtMainWin->sourceview_hovering_link_get_tooltip(tag_name.substr(5));
-                break;
-            }
+        const Glib::ustring link_target = CtLinksIndex::get_target_at(text_iter);
+        const bool find_link = not link_target.empty();
+        if (find_link) {
+            hovering_link_iter_offset = text_iter.get_offset();
+            tooltip = _pCtMainWin->sourceview_hovering_link_get_tooltip(link_target);
         }
         if (not find_link) {
             Gtk::TextIter iter_anchor = text_iter;
@@ -983,6 +976,9 @@ void CtTextView::zoom_text(const std::optional<bool> is_increase, const std::str
 
 void CtTextView::set_spell_check(bool allow_on)
 {
+    if (allow_on and _pCtMainWin->text_buffer_is_large(get_buffer())) {
+        allow_on = false; // large node mode
+    }
 #ifdef HAVE_GSPELL
     auto gtk_view = GTK_TEXT_VIEW(gobj());
     auto gtk_buffer = gtk_text_view_get_buffer(gtk_view);
@@ -995,8 +991,13 @@ void CtTextView::set_spell_check(bool allow_on)
         // g_object_unref (gspell_checker); no need to unref because we keep it global
     }
     auto gspell_view = gspell_text_view_get_from_gtk_text_view(gtk_view);
-    gspell_text_view_set_inline_spell_checking(gspell_view, allow_on && _pCtConfig->enableSpellCheck);
+    // the gspell inline checking goes through the whole buffer at once, ours in idle slices
+    gspell_text_view_set_inline_spell_checking(gspell_view, false);
     gspell_text_view_set_enable_language_menu(gspell_view, allow_on && _pCtConfig->enableSpellCheck);
+    if (not _uSpellCheck) {
+        _uSpellCheck = std::make_unique<CtSpellCheck>(*_pTextView);
+    }
+    _uSpellCheck->set_checker(allow_on && _pCtConfig->enableSpellCheck ? gspell_checker : nullptr);
 #elif defined(HAVE_LIBSPELLING)
     auto gtk_view = GTK_TEXT_VIEW(gobj());
     auto gtk_buffer = gtk_text_view_get_buffer(gtk_view);
@@ -1017,6 +1018,19 @@ void CtTextView::set_spell_check(bool allow_on)
 #endif
 }
 
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+void CtTextView::spell_check_populate_popup(Gtk::Menu* pMenu)
+{
+#ifdef HAVE_GSPELL
+    if (_uSpellCheck) {
+        _uSpellCheck->populate_popup(pMenu);
+    }
+#else
+    (void)pMenu;
+#endif
+}
+#endif
+
 void CtTextView::synch_spell_check_change_from_gspell_right_click_menu()
 {
 #ifdef HAVE_GSPELL
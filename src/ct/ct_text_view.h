@@ -25,6 +25,7 @@
 
 #include "ct_types.h"
 #include "ct_column_edit.h"
+#include "ct_spell_check.h"
 
 #include <gtkmm/textview.h>
 #ifdef HAVE_GSPELL
@@ -72,6 +73,9 @@ public:
     void zoom_text(const std::optional<bool> is_increase, const std::string& syntaxHighlighting);
     void set_spell_check(bool allow_on);
     void synch_spell_check_change_from_gspell_right_click_menu();
+#if GTKMM_MAJOR_VERSION < 4 && !defined(GTKMM_DISABLE_DEPRECATED)
+    void spell_check_populate_popup(Gtk::Menu* pMenu);
+#endif
 
     void set_buffer(const Glib::RefPtr<Gtk::TextBuffer>& buffer);
     CtColEditState column_edit_get_state() const {
@@ -157,6 +161,7 @@ private:
 #ifdef HAVE_GSPELL
     static std::unordered_map<std::string, GspellChecker*> _static_spell_checkers;
     static GspellChecker* _get_spell_checker(const std::string& lang);
+    std::unique_ptr<CtSpellCheck> _uSpellCheck;
 #endif
 #ifdef HAVE_LIBSPELLING
     SpellingChecker* _spellingChecker{nullptr};
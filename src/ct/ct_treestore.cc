@@ -25,10 +25,23 @@
 #include <algorithm>
 #include "ct_treestore.h"
 #include "ct_misc_utils.h"
+#include "ct_anchors_index.h"
+#include "ct_links_index.h"
+#include "ct_text_counters.h"
 #include "ct_storage_control.h"
 #include "ct_actions.h"
+#include "ct_storage_xml.h"
 #include "ct_logging.h"
 
+// GtkSourceView 5 removed begin/end_not_undoable_action
+#if GTK_SOURCE_CHECK_VERSION(5, 0, 0)
+#define CT_SOURCE_BUFFER_BEGIN_NOT_UNDOABLE(buf) /* no-op */
+#define CT_SOURCE_BUFFER_END_NOT_UNDOABLE(buf)   /* no-op */
+#else
+#define CT_SOURCE_BUFFER_BEGIN_NOT_UNDOABLE(buf) gtk_source_buffer_begin_not_undoable_action(buf)
+#define CT_SOURCE_BUFFER_END_NOT_UNDOABLE(buf)   gtk_source_buffer_end_not_undoable_action(buf)
+#endif
+
 #if GTKMM_MAJOR_VERSION >= 4
 namespace {
 void gtk4_refresh_anchored_widgets(Gtk::TextView& textView,
@@ -299,7 +312,10 @@ void CtTreeIter::set_node_children_are_excluded_from_search(const bool val)
 Glib::RefPtr<Gdk::Pixbuf> CtTreeIter::get_node_icon() const
 {
     if (*this) {
-        return (*this)->get_value(_pColumns->rColPixbuf);
+        CtTreeStore& ctTreeStore = _pCtMainWin->get_tree_store();
+        return ctTreeStore.get_icon_cached(ctTreeStore.get_node_icon(ctTreeStore.get_store()->iter_depth(*this),
+                                                                     get_node_syntax_highlighting(),
+                                                                     get_node_custom_icon_id()));
     }
     spdlog::error("!! {}", __FUNCTION__);
     return Glib::RefPtr<Gdk::Pixbuf>{};
@@ -355,6 +371,7 @@ void CtTreeIter::set_node_name(const Glib::ustring& node_name)
             (*this)->set_value(_pColumns->colSharedNodesMasterId, static_cast<gint64>(0));
         }
         (*this)->set_value(_pColumns->colNodeName, node_name);
+        _pCtMainWin->get_tree_store().nodes_fuzzy_index_invalidate();
     }
     else {
         spdlog::error("!! {}", __FUNCTION__);
@@ -544,9 +561,16 @@ Glib::RefPtr<Gtk::TextBuffer> CtTreeIter::get_node_text_buffer() const
                 const gint64 nodeId = get_node_id();
                 const std::string nodeSyntaxHighl = get_node_syntax_highlighting();
                 CtStorageControl* pCtStorageControl = _pCtMainWin->get_ct_storage();
-                rRetTextBuffer = pCtStorageControl->get_delayed_text_buffer(nodeId,
-                                                                            nodeSyntaxHighl,
-                                                                            anchoredWidgetList);
+                std::shared_ptr<CtNodeState> pNodeState;
+                if (_pCtMainWin->get_tree_store().lazy_content_pop(nodeId, pNodeState) and pNodeState) {
+                    // duplicated node, from the snapshot of the source node
+                    rRetTextBuffer = _pCtMainWin->get_tree_store().lazy_content_text_buffer(*pNodeState, anchoredWidgetList);
+                }
+                else {
+                    rRetTextBuffer = pCtStorageControl->get_delayed_text_buffer(nodeId,
+                                                                                nodeSyntaxHighl,
+                                                                                anchoredWidgetList);
+                }
                 if (not rRetTextBuffer) {
                     Glib::ustring error;
                     if (not pCtStorageControl->try_reopen(error)) {
@@ -690,9 +714,20 @@ std::list<CtAnchoredWidget*> CtTreeIter::get_anchored_widgets(const int start_of
         }
         Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = get_node_text_buffer(); // ensure buffer/widgets loaded
         std::list<CtAnchoredWidget*> retAnchoredWidgetsList;
-        if ((*this)->get_value(_pColumns->colAnchoredWidgets).size() > 0 or also_links) {
+        if ((*this)->get_value(_pColumns->colAnchoredWidgets).size() > 0 and not also_links) {
+            for (const Glib::RefPtr<Gtk::TextChildAnchor>& pChildAnchor : CtAnchorsIndex::get(pTextBuffer).get_anchors(start_offset, end_offset)) {
+                CtAnchoredWidget* pCtAnchoredWidget = get_anchored_widget(pChildAnchor);
+                if (pCtAnchoredWidget) {
+                    const Gtk::TextIter anchor_iter = pTextBuffer->get_iter_at_child_anchor(pChildAnchor);
+                    pCtAnchoredWidget->updateOffset(anchor_iter.get_offset());
+                    pCtAnchoredWidget->updateJustification(anchor_iter);
+                    retAnchoredWidgetsList.push_back(pCtAnchoredWidget);
+                }
+            }
+        }
+        else if (also_links) {
             Gtk::TextIter curr_iter = start_offset >= 0 ? pTextBuffer->get_iter_at_offset(start_offset) : pTextBuffer->begin();
-            Glib::ustring lastLinkTagName;
+            Glib::ustring lastLinkTarget;
             do {
                 if (end_offset >= 0 and curr_iter.get_offset() > end_offset) {
                     break;
@@ -708,13 +743,13 @@ std::list<CtAnchoredWidget*> CtTreeIter::get_anchored_widgets(const int start_of
                 }
                 else if (also_links) {
                     // CAREFUL, also_links OPTION NEEDS MANUAL CLEANUP!
-                    std::optional<Glib::ustring> tag_name = CtTextIterUtil::iter_get_tag_startingwith(curr_iter, CtConst::TAG_LINK_PREFIX);
-                    if (tag_name.has_value() and tag_name.value() != lastLinkTagName) {
-                        lastLinkTagName = tag_name.value();
-                        CtLinkEntry link_entry = CtMiscUtil::get_link_entry_from_property(lastLinkTagName.substr(5));
-                        if (CtLinkType::None != link_entry.type) {
-                            Glib::RefPtr<Gtk::TextTag> pTextTag = _pCtMainWin->get_text_tag_table()->lookup(lastLinkTagName);
-                            (void)curr_iter.forward_to_tag_toggle(pTextTag);
+                    const Glib::ustring link_target = CtLinksIndex::get_target_at(curr_iter);
+                    if (not link_target.empty() and link_target != lastLinkTarget) {
+                        lastLinkTarget = link_target;
+                        CtLinkEntry link_entry = CtMiscUtil::get_link_entry_from_property(lastLinkTarget);
+                        Gtk::TextIter iter_link_start, iter_link_end;
+                        if (CtLinkType::None != link_entry.type and CtLinksIndex::get_link_bounds(curr_iter, iter_link_start, iter_link_end)) {
+                            curr_iter = iter_link_end;
                             (void)curr_iter.backward_char();
                             auto pCtAnchoredWidget = new CtAnchWidgLink{_pCtMainWin, curr_iter.get_offset(), link_entry,
                                                                         CtTextIterUtil::get_text_iter_alignment(curr_iter, _pCtMainWin)};
@@ -744,12 +779,7 @@ CtAnchoredWidget* CtTreeIter::get_anchored_widget(Glib::RefPtr<Gtk::TextChildAnc
             spdlog::error("!! {} master {}", __FUNCTION__, masterId);
             (*this)->set_value(_pColumns->colSharedNodesMasterId, static_cast<gint64>(0));
         }
-        for (CtAnchoredWidget* pCtAnchoredWidget : (*this)->get_value(_pColumns->colAnchoredWidgets)) {
-            if (pChildAnchor == pCtAnchoredWidget->getTextChildAnchor()) {
-                return pCtAnchoredWidget;
-            }
-        }
-        return nullptr;
+        return CtAnchorsIndex::get_anchor_widget(pChildAnchor);
     }
     spdlog::error("!! {}", __FUNCTION__);
     return nullptr;
@@ -785,6 +815,13 @@ CtTreeStore::CtTreeStore(CtMainWin* pCtMainWin)
  : _pCtMainWin{pCtMainWin}
 {
     _rTreeStore = Gtk::TreeStore::create(_columns);
+    // node names are tracked by update_node_data and set_node_name, the structure here
+    _rTreeStore->signal_row_inserted().connect([this](const Gtk::TreeModel::Path&, const Gtk::TreeModel::iterator&){
+        nodes_fuzzy_index_invalidate();
+    });
+    _rTreeStore->signal_row_deleted().connect([this](const Gtk::TreeModel::Path&){
+        nodes_fuzzy_index_invalidate();
+    });
 }
 
 CtTreeStore::~CtTreeStore()
@@ -805,6 +842,100 @@ void CtTreeStore::pending_edit_db_bookmarks()
     _pCtMainWin->get_ct_storage()->pending_edit_db_bookmarks();
 }
 
+void CtTreeStore::lazy_content_set(const gint64 nodeId, std::shared_ptr<CtNodeState> pNodeState)
+{
+    _lazyContents[nodeId] = pNodeState;
+}
+
+bool CtTreeStore::lazy_content_get(const gint64 nodeId, std::shared_ptr<CtNodeState>& pNodeState) const
+{
+    const auto iterLazy = _lazyContents.find(nodeId);
+    if (iterLazy == _lazyContents.end()) {
+        return false;
+    }
+    pNodeState = iterLazy->second;
+    return true;
+}
+
+bool CtTreeStore::lazy_content_pop(const gint64 nodeId, std::shared_ptr<CtNodeState>& pNodeState)
+{
+    if (not lazy_content_get(nodeId, pNodeState)) {
+        return false;
+    }
+    _lazyContents.erase(nodeId);
+    return true;
+}
+
+Glib::RefPtr<Gtk::TextBuffer> CtTreeStore::lazy_content_text_buffer(CtNodeState& nodeState,
+                                                                    std::list<CtAnchoredWidget*>& anchoredWidgetList)
+{
+    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = _pCtMainWin->get_new_text_buffer();
+    #if !GTK_SOURCE_CHECK_VERSION(5, 0, 0)
+    auto pGtkSourceBuffer = GTK_SOURCE_BUFFER(pTextBuffer->gobj());
+    #endif
+    CT_SOURCE_BUFFER_BEGIN_NOT_UNDOABLE(pGtkSourceBuffer);
+    for (xmlpp::Node* text_node : nodeState.buffer_xml.get_root_node()->get_children()) {
+        CtStorageXmlHelper{_pCtMainWin}.get_text_buffer_one_slot_from_xml(pTextBuffer, text_node, anchoredWidgetList, nullptr, -1, "");
+    }
+    // the snapshot keeps the widgets apart from the text
+    for (const std::shared_ptr<CtAnchoredWidgetState>& widgetState : nodeState.widgetStates) {
+        anchoredWidgetList.push_back(widgetState->to_widget(_pCtMainWin));
+    }
+    for (CtAnchoredWidget* pAnchoredWidget : anchoredWidgetList) {
+        pAnchoredWidget->insertInTextBuffer(pTextBuffer);
+    }
+    CT_SOURCE_BUFFER_END_NOT_UNDOABLE(pGtkSourceBuffer);
+    pTextBuffer->set_modified(false);
+    return pTextBuffer;
+}
+
+std::shared_ptr<CtNodeState> CtTreeStore::lazy_content_to_write(const CtTreeIter& ctTreeIter,
+                                                               const int start_offset,
+                                                               const int end_offset) const
+{
+    std::shared_ptr<CtNodeState> pNodeState;
+    if (0 == start_offset and end_offset < 0) {
+        (void)lazy_content_get(ctTreeIter.get_node_id(), pNodeState);
+    }
+    return pNodeState;
+}
+
+std::list<std::unique_ptr<CtAnchoredWidget>> CtTreeStore::lazy_content_widgets(const CtNodeState& nodeState)
+{
+    std::list<std::unique_ptr<CtAnchoredWidget>> anchoredWidgets;
+    for (const std::shared_ptr<CtAnchoredWidgetState>& widgetState : nodeState.widgetStates) {
+        anchoredWidgets.emplace_back(widgetState->to_widget(_pCtMainWin));
+    }
+    return anchoredWidgets;
+}
+
+void CtTreeStore::lazy_contents_materialize()
+{
+    if (_lazyContents.empty()) {
+        return;
+    }
+    // one walk of the tree, the duplicated nodes removed in the meantime are just dropped
+    std::unordered_map<gint64, std::shared_ptr<CtNodeState>> snapshots;
+    std::list<CtTreeIter> sharingIters;
+    _rTreeStore->foreach_iter([&](const Gtk::TreeModel::iterator& iter){
+        const auto iterLazy = _lazyContents.find(iter->get_value(_columns.colNodeUniqueId));
+        if (iterLazy != _lazyContents.end()) {
+            if (iterLazy->second) {
+                snapshots.insert(*iterLazy);
+            }
+            else {
+                sharingIters.push_back(to_ct_tree_iter(iter));
+            }
+        }
+        return false; /* continue */
+    });
+    // the snapshots do not depend on the stored content
+    _lazyContents.swap(snapshots);
+    for (const CtTreeIter& ctTreeIter : sharingIters) {
+        (void)ctTreeIter.get_node_text_buffer();
+    }
+}
+
 void CtTreeStore::_iter_delete_anchored_widgets(const Gtk::TreeModel::Children& children)
 {
     for (auto const_iter = children.begin(); const_iter != children.end(); ++const_iter) {
@@ -834,6 +965,11 @@ void CtTreeStore::treeview_set_tree_path_n_text_cursor(CtTreeView* pTreeView,
     bool treeSelFromConfig{false};
     if (not node_path.empty()) {
         Gtk::TreeModel::iterator treeIter = _rTreeStore->get_iter(node_path);
+        if (not treeIter) {
+            // the node may be still loading in background
+            _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+            treeIter = _rTreeStore->get_iter(node_path);
+        }
         if (static_cast<bool>(treeIter)) {
             pTreeView->set_cursor_safe(treeIter);
             treeSelFromConfig = true;
@@ -876,6 +1012,10 @@ void CtTreeStore::treeview_set_tree_expanded_collapsed_string(const std::string&
             expanded_collapsed_dict[std::stoll(couple[0])] = CtStrUtil::is_str_true(couple[1]);
         }
     }
+    if (nodes_bookm_exp and not _bookmarks.empty()) {
+        // the bookmarked nodes may be still loading in background
+        _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+    }
     treeView.collapse_all();
     _rTreeStore->foreach(
         [this, &treeView, &expanded_collapsed_dict, &nodes_bookm_exp](const Gtk::TreePath& path, const Gtk::TreeModel::iterator& iter)->bool{
@@ -897,11 +1037,21 @@ void CtTreeStore::tree_view_connect(Gtk::TreeView* pTreeView)
 
     // if change column num, then change CtTreeView::TITLE_COL_NUM
     Gtk::TreeView::Column* pColumns = Gtk::manage(new Gtk::TreeView::Column(""));
-    pColumns->pack_start(_columns.rColPixbuf, /*expand=*/false);
+    _column_pack_node_icon(*pColumns);
     pColumns->pack_start(_columns.colNodeName);
     pColumns->set_expand(true);
     pTreeView->append_column(*pColumns);
-    pTreeView->append_column("", _columns.rColPixbufAux);
+    Gtk::TreeView::Column* pAuxColumn = Gtk::manage(new Gtk::TreeView::Column(""));
+    Gtk::CellRendererPixbuf* pCellRendererAux = Gtk::manage(new Gtk::CellRendererPixbuf{});
+    pAuxColumn->pack_start(*pCellRendererAux, /*expand=*/false);
+    pAuxColumn->set_cell_data_func(
+        *pCellRendererAux,
+        [this](Gtk::CellRenderer* pCell, const auto& treeIter){
+            const char* stock_id = _get_node_aux_icon(*treeIter);
+            dynamic_cast<Gtk::CellRendererPixbuf*>(pCell)->property_pixbuf() = stock_id ? get_icon_cached(stock_id) : Glib::RefPtr<Gdk::Pixbuf>{};
+        }
+    );
+    pTreeView->append_column(*pAuxColumn);
 
     Gtk::TreeViewColumn* pTVCol0 = pTreeView->get_column(CtTreeView::TITLE_COL_NUM);
     std::vector<Gtk::CellRenderer*> cellRenderers0 = pTVCol0->get_cells();
@@ -925,8 +1075,33 @@ void CtTreeStore::tree_view_connect(Gtk::TreeView* pTreeView)
     }
 }
 
+void CtTreeStore::tree_view_append_node_icon_column(Gtk::TreeView& treeView)
+{
+    Gtk::TreeView::Column* pColumn = Gtk::manage(new Gtk::TreeView::Column(""));
+    _column_pack_node_icon(*pColumn);
+    treeView.append_column(*pColumn);
+}
+
+void CtTreeStore::_column_pack_node_icon(Gtk::TreeView::Column& column)
+{
+    // the icons are resolved at render time from the shared cache rather than stored in every row
+    Gtk::CellRendererPixbuf* pCellRendererIcon = Gtk::manage(new Gtk::CellRendererPixbuf{});
+    column.pack_start(*pCellRendererIcon, /*expand=*/false);
+    column.set_cell_data_func(
+        *pCellRendererIcon,
+        [this](Gtk::CellRenderer* pCell, const auto& treeIter){
+            const auto row = *treeIter;
+            const char* stock_id = get_node_icon(_rTreeStore->iter_depth(treeIter),
+                                                 row.get_value(_columns.colSyntaxHighlighting),
+                                                 row.get_value(_columns.colCustomIconId));
+            dynamic_cast<Gtk::CellRendererPixbuf*>(pCell)->property_pixbuf() = get_icon_cached(stock_id);
+        }
+    );
+}
+
 void CtTreeStore::text_view_apply_textbuffer(CtTreeIter& treeIter, CtTextView* pCtTextView)
 {
+    CtPerfScope perfScope{"node_switch"};
     auto& textView = pCtTextView->mm();
     if (not static_cast<bool>(treeIter)) {
         pCtTextView->set_buffer(Glib::RefPtr<Gtk::TextBuffer>{});
@@ -948,12 +1123,15 @@ void CtTreeStore::text_view_apply_textbuffer(CtTreeIter& treeIter, CtTextView* p
     else spdlog::debug("Node {}[{}] > {}", nodeId, nodeMasterId, nodeName.raw());
 
     Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = treeIter.get_node_text_buffer();
+    if (_pCtMainWin->text_buffer_is_large(pTextBuffer)) {
+        _pCtMainWin->large_node_mode_apply(pTextBuffer);
+    }
     _pCtMainWin->apply_syntax_highlighting(pTextBuffer, treeIter.get_node_syntax_highlighting(), false/*forceReApply*/);
     pCtTextView->setup_for_syntax(treeIter.get_node_syntax_highlighting());
     pCtTextView->set_buffer(pTextBuffer);
     pCtTextView->set_spell_check(treeIter.get_node_is_text());
     textView.set_sensitive(true);
-    textView.set_editable(not treeIter.get_node_read_only());
+    textView.set_editable(not treeIter.get_node_read_only() and not _pCtMainWin->text_buffer_is_too_large_to_edit(pTextBuffer));
     pCtTextView->cursor_and_tooltips_reset();
 
     std::list<CtAnchoredWidget*> anchored_widgets_to_hide;
@@ -1051,19 +1229,29 @@ int CtTreeStore::get_tree_icon_size() const
     return _cached_icon_size;
 }
 
-Glib::RefPtr<Gdk::Pixbuf> CtTreeStore::_get_node_icon(int nodeDepth, const std::string &syntax, guint32 customIconId)
+Glib::RefPtr<Gdk::Pixbuf> CtTreeStore::get_icon_cached(const std::string& stock_id)
 {
-    const char* stock_id = get_node_icon(nodeDepth, syntax, customIconId);
     const int icon_size = get_tree_icon_size();
+    const auto key = std::make_pair(stock_id, icon_size);
+    const auto it = _iconsCache.find(key);
+    if (it != _iconsCache.end()) {
+        return it->second;
+    }
+    Glib::RefPtr<Gdk::Pixbuf> rPixbuf;
     #if GTKMM_MAJOR_VERSION < 4
-    return _pCtMainWin->get_icon_theme()->load_icon(stock_id, icon_size);
+    try {
+        rPixbuf = _pCtMainWin->get_icon_theme()->load_icon(stock_id, icon_size);
+    } catch (Glib::Error& error) {
+        spdlog::error("!! {} {} {}", __FUNCTION__, stock_id, std::string(error.what()));
+    }
     #else
     try {
-        return Gdk::Pixbuf::create_from_resource(std::string{"/icons/"} + stock_id + ".svg",
-                                                icon_size, icon_size, false);
+        rPixbuf = Gdk::Pixbuf::create_from_resource(std::string{"/icons/"} + stock_id + ".svg",
+                                                    icon_size, icon_size, false);
     } catch (...) {}
-    return Glib::RefPtr<Gdk::Pixbuf>{};
     #endif
+    _iconsCache[key] = rPixbuf;
+    return rPixbuf;
 }
 
 const char* CtTreeStore::get_node_icon(int nodeDepth, const std::string &syntax, guint32 customIconId)
@@ -1139,7 +1327,6 @@ void CtTreeStore::update_node_data(const Gtk::TreeModel::iterator& treeIter, con
     row[_columns.colSharedNodesMasterId] = nodeData.sharedNodesMasterId;
     row[_columns.colNodeSequence] = nodeData.sequence;
 
-    row[_columns.rColPixbuf] = _get_node_icon(_rTreeStore->iter_depth(treeIter), nodeData.syntax, nodeData.customIconId);
     row[_columns.colNodeName] = nodeData.name;
     row[_columns.rColTextBuffer] = nodeData.pTextBuffer;
     row[_columns.colSyntaxHighlighting] = nodeData.syntax;
@@ -1154,18 +1341,50 @@ void CtTreeStore::update_node_data(const Gtk::TreeModel::iterator& treeIter, con
     row[_columns.colTsLastSave] = nodeData.tsLastSave;
     row[_columns.colAnchoredWidgets] = nodeData.anchoredWidgets;
 
-    update_node_aux_icon(treeIter);
     add_used_tags(nodeData.tags);
     _nodes_names_dict[nodeData.nodeId] = nodeData.name;
+    _nodesFuzzyIndexValid = false;
+}
+
+CtFuzzyIndex& CtTreeStore::get_nodes_fuzzy_index()
+{
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+    if (not _nodesFuzzyIndexValid) {
+        _nodesFuzzyIndex.clear();
+        _nodesFuzzyIndexIters.clear();
+        const std::string separator{" / "};
+        // depth first, carrying the parent path rather than walking up from every node
+        std::function<void(const Gtk::TreeModel::Children&, const Glib::ustring&)> f_index_children;
+        f_index_children = [&](const Gtk::TreeModel::Children& children, const Glib::ustring& parent_path) {
+            for (Gtk::TreeModel::iterator treeIter = children.begin(); treeIter != children.end(); ++treeIter) {
+                CtTreeIter ctTreeIter = to_ct_tree_iter(treeIter);
+                const Glib::ustring node_name = ctTreeIter.get_node_name();
+                const Glib::ustring node_path = parent_path.empty() ? str::trim(node_name) : parent_path + separator + str::trim(node_name);
+                (void)_nodesFuzzyIndex.add(ctTreeIter.get_node_id(), node_name, node_path);
+                _nodesFuzzyIndexIters.push_back(treeIter);
+                f_index_children(treeIter->children(), node_path);
+            }
+        };
+        f_index_children(_rTreeStore->children(), "");
+        _nodesFuzzyIndexValid = true;
+        spdlog::debug("{} {} nodes", __FUNCTION__, _nodesFuzzyIndex.size());
+    }
+    return _nodesFuzzyIndex;
+}
+
+CtTreeIter CtTreeStore::get_nodes_fuzzy_index_iter(const size_t idx)
+{
+    if (not _nodesFuzzyIndexValid or idx >= _nodesFuzzyIndexIters.size()) {
+        spdlog::error("!! {} {}", __FUNCTION__, idx);
+        return CtTreeIter{};
+    }
+    return to_ct_tree_iter(_nodesFuzzyIndexIters[idx]);
 }
 
 void CtTreeStore::update_node_icon(const Gtk::TreeModel::iterator& treeIter)
 {
-    CtTreeIter ctTreeIter = to_ct_tree_iter(treeIter);
-    auto icon = _get_node_icon(_rTreeStore->iter_depth(treeIter),
-                               ctTreeIter.get_node_syntax_highlighting(),
-                               ctTreeIter.get_node_custom_icon_id());
-    treeIter->set_value(_columns.rColPixbuf, icon);
+    // the icon is resolved at render time, only a redraw of the row is needed
+    _rTreeStore->row_changed(_rTreeStore->get_path(treeIter), treeIter);
 }
 
 void CtTreeStore::update_nodes_icon(Gtk::TreeModel::iterator father_iter, bool cherry_only)
@@ -1177,70 +1396,52 @@ void CtTreeStore::update_nodes_icon(Gtk::TreeModel::iterator father_iter, bool c
     }
     if (father_iter) {
         update_node_icon(father_iter);
-        update_node_aux_icon(father_iter);
     }
-    auto children = father_iter ? father_iter->children() : _rTreeStore->children();
-    for (auto child_const_iter = children.begin(); child_const_iter != children.end(); ++child_const_iter)
-    {
-        Gtk::TreeModel::iterator child_iter = _rTreeStore->get_iter(_rTreeStore->get_path(child_const_iter));
-        if (child_iter) {
-            update_nodes_icon(child_iter, cherry_only);
-        }
+    else {
+        // whole tree, the icon theme may have changed too
+        _iconsCache.clear();
     }
+    // the subtree rows are redrawn as a whole, the icon size may have changed too
+    _pCtMainWin->get_tree_view().columns_autosize();
+    _pCtMainWin->get_tree_view().queue_draw();
 }
 
 void CtTreeStore::update_node_aux_icon(const Gtk::TreeModel::iterator& treeIter)
 {
-    // use low level treeIter here, only data local to the id
+    update_node_icon(treeIter);
+}
+
+const char* CtTreeStore::_get_node_aux_icon(const Gtk::TreeRow& row) const
+{
+    // use low level row here, only data local to the id
     // no magic to try and fetch the master as this data is anyway
-    // replicated for rendering ans this method is also called
-    // when loading the tree and the master may not be loaded yet
-    const bool is_ro = treeIter->get_value(_columns.colNodeIsReadOnly);
-    const bool is_bookmark = vec::exists(_bookmarks, treeIter->get_value(_columns.colNodeUniqueId));
-    const bool is_excl_search = treeIter->get_value(_columns.colNodeIsExcludedFromSearch) or
-                                treeIter->get_value(_columns.colNodeChildrenAreExcludedFromSearch);
-    auto f_getAuxStock = [is_ro, is_bookmark, is_excl_search]()->std::string{
-        if (is_ro) {
-            if (is_bookmark) {
-                if (is_excl_search) {
-                    return "ct_ghostlockpin";
-                }
-                return "ct_lockpin";
-            }
-            if (is_excl_search) {
-                return "ct_ghostlock";
-            }
-            return "ct_locked";
-        }
+    // replicated for rendering
+    const bool is_ro = row.get_value(_columns.colNodeIsReadOnly);
+    const bool is_bookmark = vec::exists(_bookmarks, row.get_value(_columns.colNodeUniqueId));
+    const bool is_excl_search = row.get_value(_columns.colNodeIsExcludedFromSearch) or
+                                row.get_value(_columns.colNodeChildrenAreExcludedFromSearch);
+    if (is_ro) {
         if (is_bookmark) {
             if (is_excl_search) {
-                return "ct_ghostpin";
+                return "ct_ghostlockpin";
             }
-            return "ct_pin";
+            return "ct_lockpin";
         }
         if (is_excl_search) {
-            return "ct_ghost";
+            return "ct_ghostlock";
         }
-        return "";
-    };
-
-    auto stock_id = f_getAuxStock();
-    if (stock_id.empty()) {
-        treeIter->set_value(_columns.rColPixbufAux, Glib::RefPtr<Gdk::Pixbuf>{});
+        return "ct_locked";
     }
-    else {
-        const int icon_size = get_tree_icon_size();
-        #if GTKMM_MAJOR_VERSION < 4
-        treeIter->set_value(_columns.rColPixbufAux, _pCtMainWin->get_icon_theme()->load_icon(stock_id, icon_size));
-        #else
-        try {
-            treeIter->set_value(_columns.rColPixbufAux, Gdk::Pixbuf::create_from_resource(
-                std::string{"/icons/"} + stock_id + ".svg", icon_size, icon_size, false));
-        } catch (...) {
-            treeIter->set_value(_columns.rColPixbufAux, Glib::RefPtr<Gdk::Pixbuf>{});
+    if (is_bookmark) {
+        if (is_excl_search) {
+            return "ct_ghostpin";
         }
-        #endif
+        return "ct_pin";
+    }
+    if (is_excl_search) {
+        return "ct_ghost";
     }
+    return nullptr;
 }
 
 Gtk::TreeModel::iterator CtTreeStore::append_node(CtNodeData* pNodeData, const Gtk::TreeModel::iterator* pParentIter)
@@ -1272,8 +1473,21 @@ void CtTreeStore::_on_textbuffer_modified_changed(Glib::RefPtr<Gtk::TextBuffer>
     }
 }
 
-void CtTreeStore::_on_textbuffer_insert(const Gtk::TextBuffer::iterator& pos, const Glib::ustring& text, int /*bytes*/)
+void CtTreeStore::_on_textbuffer_insert(const Gtk::TextBuffer::iterator& pos, const Glib::ustring& text, int bytes)
 {
+    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = pos.get_buffer();
+    if (bytes > 1024 and not pTextBuffer->get_data(CtConst::LARGE_NODE_MODE_ID)) {
+        // e.g. a huge paste, the large node mode is to be applied once the text is in
+        Glib::signal_idle().connect_once([this, pTextBuffer](){
+            if (_pCtMainWin->text_buffer_is_large(pTextBuffer) and pTextBuffer == _pCtMainWin->curr_buffer()) {
+                _pCtMainWin->large_node_mode_apply(pTextBuffer);
+                CtTreeIter currTreeIter = _pCtMainWin->curr_tree_iter();
+                _pCtMainWin->get_text_view().set_spell_check(currTreeIter.get_node_is_text());
+                _pCtMainWin->get_text_view().mm().set_editable(not currTreeIter.get_node_read_only() and
+                                                               not _pCtMainWin->text_buffer_is_too_large_to_edit(pTextBuffer));
+            }
+        });
+    }
     if (_pCtMainWin->user_active() and not _pCtMainWin->get_text_view().column_edit_get_own_insert_delete_active()) {
         _pCtMainWin->get_text_view().column_edit_text_inserted(pos, text);
         CtTreeIter currTreeIter = _pCtMainWin->curr_tree_iter();
@@ -1372,6 +1586,7 @@ gint64 CtTreeStore::node_id_get(gint64 original_id/*=-1*/,
     for (const auto& curr_pair : remapping_ids) {
         allocated_for_remapping_ids.insert(curr_pair.second);
     }
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     const CtStorageSyncPending* pCtStorageSyncPending = _pCtMainWin->get_ct_storage()->get_storage_sync_pending();
 
     // (@txe) this function works differently from python code
@@ -1424,28 +1639,44 @@ std::string CtTreeStore::get_node_name_from_node_id(const gint64 node_id)
 {
     auto iter = _nodes_names_dict.find(node_id); // node_id from link can be invalid
     if (iter != _nodes_names_dict.end()) return iter->second;
+    // the node may be still loading in background
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+    iter = _nodes_names_dict.find(node_id);
+    if (iter != _nodes_names_dict.end()) return iter->second;
     return "";
 }
 
 CtTreeIter CtTreeStore::get_node_from_node_id(const gint64 node_id)
 {
     Gtk::TreeModel::iterator find_iter;
-    _rTreeStore->foreach_iter([&node_id, &find_iter, this](const Gtk::TreeModel::iterator& iter) {
+    auto f_find = [&node_id, &find_iter, this](const Gtk::TreeModel::iterator& iter) {
         if (iter->get_value(_columns.colNodeUniqueId) != node_id) return false; /* continue */
         find_iter = iter;
         return true;
-    });
+    };
+    _rTreeStore->foreach_iter(f_find);
+    if (not find_iter) {
+        // the node may be still loading in background
+        _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+        _rTreeStore->foreach_iter(f_find);
+    }
     return to_ct_tree_iter(find_iter);
 }
 
 CtTreeIter CtTreeStore::get_node_from_node_name(const Glib::ustring& node_name)
 {
     Gtk::TreeModel::iterator find_iter;
-    _rTreeStore->foreach_iter([&node_name, &find_iter, this](const Gtk::TreeModel::iterator& iter) {
+    auto f_find = [&node_name, &find_iter, this](const Gtk::TreeModel::iterator& iter) {
         if (iter->get_value(_columns.colNodeName) != node_name) return false; /* continue */
         find_iter = iter;
         return true;
-    });
+    };
+    _rTreeStore->foreach_iter(f_find);
+    if (not find_iter) {
+        // the node may be still loading in background
+        _pCtMainWin->get_ct_storage()->populate_treestore_complete();
+        _rTreeStore->foreach_iter(f_find);
+    }
     return to_ct_tree_iter(find_iter);
 }
 
@@ -1556,6 +1787,7 @@ unsigned CtTreeStore::tree_clear_property_exclude_from_search()
 
 unsigned CtTreeStore::populate_shared_nodes_map(CtSharedNodesMap& sharedNodesMap) const
 {
+    _pCtMainWin->get_ct_storage()->populate_treestore_complete();
     unsigned count_shared_nodes{0u};
     _rTreeStore->foreach(
         [&](const Gtk::TreePath&/*treePath*/, const Gtk::TreeModel::iterator& treeIter)->bool{
@@ -1607,6 +1839,10 @@ bool CtTreeStore::populate_summary_info(CtSummaryInfo& summaryInfo)
             }
             else {
                 // non shared or shared master (data holder)
+                const CtTextCounters& textCounters = CtTextCounters::get(pTextBuffer);
+                summaryInfo.words_num += textCounters.get_words();
+                summaryInfo.chars_num += textCounters.get_chars();
+                summaryInfo.lines_num += textCounters.get_lines();
                 for (CtAnchoredWidget* pAnchoredWidget : ctTreeIter.get_anchored_widgets_fast()) {
                     switch (pAnchoredWidget->get_type()) {
                         case CtAnchWidgType::CodeBox: ++summaryInfo.codeboxes_num; break;
@@ -1629,3 +1865,107 @@ bool CtTreeStore::populate_summary_info(CtSummaryInfo& summaryInfo)
     CtDialogs::error_dialog(error, *_pCtMainWin);
     return false;
 }
+
+namespace {
+
+size_t get_pixbuf_bytes(const Glib::RefPtr<Gdk::Pixbuf>& rPixbuf)
+{
+    return static_cast<size_t>(rPixbuf->get_rowstride()) * static_cast<size_t>(rPixbuf->get_height());
+}
+
+// the bytes of the widget with its pixbuf and blobs, these in their own totals
+size_t get_anchored_widget_memory(CtAnchoredWidget* pAnchoredWidget, CtMemoryInfo& memoryInfo)
+{
+    size_t ownBytes{0u};
+    size_t sharedBytes{0u};
+    if (auto pImage = dynamic_cast<CtImage*>(pAnchoredWidget)) {
+        const Glib::RefPtr<Gdk::Pixbuf> rPixbuf = pImage->get_pixbuf();
+        if (rPixbuf and memoryInfo.sharedSeen.insert(rPixbuf.get()).second) {
+            const size_t pixbufBytes = get_pixbuf_bytes(rPixbuf);
+            memoryInfo.pixbufs.add(pixbufBytes);
+            sharedBytes += pixbufBytes;
+        }
+    }
+    switch (pAnchoredWidget->get_type()) {
+        case CtAnchWidgType::ImagePng: {
+            const std::shared_ptr<const std::string> pRawBlob = dynamic_cast<CtImagePng*>(pAnchoredWidget)->get_raw_blob_shared();
+            if (pRawBlob and memoryInfo.sharedSeen.insert(pRawBlob.get()).second) {
+                memoryInfo.pngBlobs.add(pRawBlob->size());
+                sharedBytes += pRawBlob->size();
+            }
+        } break;
+        case CtAnchWidgType::ImageEmbFile: {
+            const std::shared_ptr<CtEmbFileBlob>& pBlob = dynamic_cast<CtImageEmbFile*>(pAnchoredWidget)->get_blob();
+            if (pBlob and pBlob->in_memory() and memoryInfo.sharedSeen.insert(pBlob.get()).second) {
+                memoryInfo.embFileBlobs.add(pBlob->size());
+                sharedBytes += pBlob->size();
+            }
+        } break;
+        case CtAnchWidgType::ImageLatex: {
+            ownBytes += dynamic_cast<CtImageLatex*>(pAnchoredWidget)->get_latex_text().bytes();
+        } break;
+        case CtAnchWidgType::CodeBox: {
+            ownBytes += dynamic_cast<CtCodebox*>(pAnchoredWidget)->get_text_content().bytes();
+        } break;
+        case CtAnchWidgType::TableHeavy:
+        case CtAnchWidgType::TableLight: {
+            std::vector<std::vector<Glib::ustring>> rows;
+            dynamic_cast<CtTableCommon*>(pAnchoredWidget)->write_strings_matrix(rows);
+            for (const std::vector<Glib::ustring>& row : rows) {
+                for (const Glib::ustring& cell : row) {
+                    ownBytes += sizeof(Glib::ustring) + cell.bytes();
+                }
+            }
+        } break;
+        default: break;
+    }
+    memoryInfo.widgets.add(ownBytes);
+    return ownBytes + sharedBytes;
+}
+
+} // namespace (anonymous)
+
+void CtTreeStore::populate_memory_info(CtMemoryInfo& memoryInfo)
+{
+    // also the nodes not loaded, known to the undo states or to the storage
+    std::unordered_map<gint64, Glib::ustring> nodesNames;
+    _rTreeStore->foreach(
+        [&](const Gtk::TreePath&/*treePath*/, const Gtk::TreeModel::iterator& treeIter)->bool{
+            auto ctTreeIter = to_ct_tree_iter(treeIter);
+            nodesNames[ctTreeIter.get_node_id()] = ctTreeIter.get_node_name();
+            if (ctTreeIter.get_node_shared_master_id() > 0 or not ctTreeIter.get_node_buffer_already_loaded()) {
+                return false; /* false for continue */
+            }
+            CtMemoryNodeInfo& nodeInfo = memoryInfo.nodes[ctTreeIter.get_node_id()];
+            size_t textBytes{0};
+            const auto pTextBuffer = ctTreeIter.get_node_text_buffer();
+            CtTextIterUtil::text_for_each_chunk(pTextBuffer->begin(), pTextBuffer->end(), [&textBytes](const Glib::ustring& chunk){
+                textBytes += chunk.bytes();
+            });
+            nodeInfo.textBuffer.add(textBytes);
+            memoryInfo.textBuffers.add(textBytes);
+            for (CtAnchoredWidget* pAnchoredWidget : ctTreeIter.get_anchored_widgets_fast()) {
+                nodeInfo.widgets.add(get_anchored_widget_memory(pAnchoredWidget, memoryInfo));
+            }
+            return false; /* false for continue */
+        }
+    );
+    // after the widgets, so that the blobs they share with the undo states are accounted to the widgets
+    _pCtMainWin->get_state_machine().populate_memory_info(memoryInfo);
+    if (CtStorageControl* pCtStorage = _pCtMainWin->get_ct_storage()) {
+        pCtStorage->populate_memory_info(memoryInfo);
+    }
+    _pCtMainWin->get_text_tag_table()->foreach([&memoryInfo](const Glib::RefPtr<Gtk::TextTag>& rTextTag){
+#if GTKMM_MAJOR_VERSION >= 4
+        memoryInfo.textTags.add(rTextTag->property_name().get_value().bytes());
+#else
+        memoryInfo.textTags.add(sizeof(GtkTextAttributes) + rTextTag->property_name().get_value().bytes());
+#endif
+    });
+    for (auto& [node_id, nodeInfo] : memoryInfo.nodes) {
+        const auto it = nodesNames.find(node_id);
+        if (it != nodesNames.end()) {
+            nodeInfo.node_name = it->second;
+        }
+    }
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "ct_types.h"
+#include "ct_fuzzy_index.h"
 #include <gtkmm.h>
 #include <set>
 #include <unordered_map>
@@ -31,6 +32,7 @@
 class CtMainWin;
 class CtAnchoredWidget;
 class CtTreeView;
+struct CtNodeState;
 
 struct CtNodeData
 {
@@ -56,13 +58,12 @@ struct CtNodeData
 struct CtTreeModelColumns : public Gtk::TreeModelColumnRecord
 {
     CtTreeModelColumns() {
-        add(rColPixbuf); add(colNodeName); add(rColTextBuffer); add(colNodeUniqueId); add(colSharedNodesMasterId);
+        add(colNodeName); add(rColTextBuffer); add(colNodeUniqueId); add(colSharedNodesMasterId);
         add(colSyntaxHighlighting); add(colNodeSequence); add(colNodeTags); add(colNodeIsReadOnly);
         add(colNodeIsExcludedFromSearch); add(colNodeChildrenAreExcludedFromSearch);
-        add(rColPixbufAux); add(colCustomIconId); add(colWeight); add(colForeground);
+        add(colCustomIconId); add(colWeight); add(colForeground);
         add(colTsCreation); add(colTsLastSave); add(colAnchoredWidgets);
     }
-    Gtk::TreeModelColumn<Glib::RefPtr<Gdk::Pixbuf>>    rColPixbuf;
     Gtk::TreeModelColumn<Glib::ustring>                colNodeName;
     Gtk::TreeModelColumn<Glib::RefPtr<Gtk::TextBuffer>>  rColTextBuffer;
     Gtk::TreeModelColumn<gint64>                       colNodeUniqueId;
@@ -73,7 +74,6 @@ struct CtTreeModelColumns : public Gtk::TreeModelColumnRecord
     Gtk::TreeModelColumn<bool>                         colNodeIsReadOnly;
     Gtk::TreeModelColumn<bool>                         colNodeIsExcludedFromSearch;
     Gtk::TreeModelColumn<bool>                         colNodeChildrenAreExcludedFromSearch;
-    Gtk::TreeModelColumn<Glib::RefPtr<Gdk::Pixbuf>>    rColPixbufAux;
     Gtk::TreeModelColumn<guint16>                      colCustomIconId;
     Gtk::TreeModelColumn<int>                          colWeight;
     Gtk::TreeModelColumn<std::string>                  colForeground;
@@ -163,10 +163,13 @@ public:
     virtual ~CtTreeStore();
 
     void          tree_view_connect(Gtk::TreeView* pTreeView);
+    void          tree_view_append_node_icon_column(Gtk::TreeView& treeView);
     void          text_view_apply_textbuffer(CtTreeIter& treeIter, CtTextView* pTextView);
 
     void          get_node_data(const Gtk::TreeModel::iterator& treeIter, CtNodeData& nodeData, const bool loadTextBuffer);
     bool          populate_summary_info(CtSummaryInfo& summaryInfo);
+    // without loading the nodes not yet loaded
+    void          populate_memory_info(CtMemoryInfo& memoryInfo);
     unsigned      tree_clear_property_exclude_from_search();
     unsigned      populate_shared_nodes_map(CtSharedNodesMap& sharedNodesMap) const;
 
@@ -211,15 +214,35 @@ public:
 
     void nodes_sequences_fix(Gtk::TreeModel::iterator father_iter, bool process_children);
 
+    CtFuzzyIndex& get_nodes_fuzzy_index();
+    CtTreeIter    get_nodes_fuzzy_index_iter(const size_t idx);
+    void          nodes_fuzzy_index_invalidate() { _nodesFuzzyIndexValid = false; }
+
     const CtTreeModelColumns& get_columns() const { return _columns; }
 
     void pending_edit_db_bookmarks();
     void pending_rm_db_nodes(const std::vector<gint64>& node_ids);
+
+    // duplicated node whose text buffer is built only when first needed, from the node state snapshot
+    // or (null snapshot) from the stored content of the source node that the storage shares with it
+    void lazy_content_set(const gint64 nodeId, std::shared_ptr<CtNodeState> pNodeState);
+    bool lazy_content_get(const gint64 nodeId, std::shared_ptr<CtNodeState>& pNodeState) const;
+    bool lazy_content_pop(const gint64 nodeId, std::shared_ptr<CtNodeState>& pNodeState);
+    Glib::RefPtr<Gtk::TextBuffer> lazy_content_text_buffer(CtNodeState& nodeState,
+                                                           std::list<CtAnchoredWidget*>& anchoredWidgetList);
+    // the snapshot to write the whole node from with no text buffer, nullptr if there is none
+    std::shared_ptr<CtNodeState> lazy_content_to_write(const CtTreeIter& ctTreeIter, const int start_offset, const int end_offset) const;
+    // the widgets of the snapshot only to be written, deleted with the list
+    std::list<std::unique_ptr<CtAnchoredWidget>> lazy_content_widgets(const CtNodeState& nodeState);
+    // before the stored content of the source nodes is rewritten, the snapshots are kept as they are
+    void lazy_contents_materialize();
     const char* get_node_icon(int nodeDepth, const std::string &syntax, guint32 customIconId);
     int get_tree_icon_size() const;
+    Glib::RefPtr<Gdk::Pixbuf> get_icon_cached(const std::string& stock_id);
 
 protected:
-    Glib::RefPtr<Gdk::Pixbuf> _get_node_icon(int nodeDepth, const std::string &syntax, guint32 customIconId);
+    void                      _column_pack_node_icon(Gtk::TreeView::Column& column);
+    const char*               _get_node_aux_icon(const Gtk::TreeRow& row) const;
     void                      _iter_delete_anchored_widgets(const Gtk::TreeModel::Children& children);
 
     void _on_textbuffer_modified_changed(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer);
@@ -237,4 +260,9 @@ private:
     CtMainWin*                      _pCtMainWin;
     mutable int                     _cached_icon_size{-1};
     mutable Glib::ustring           _cached_tree_font;
+    std::map<std::pair<std::string, int>, Glib::RefPtr<Gdk::Pixbuf>> _iconsCache; // (stock id, size), shared by all rows
+    CtFuzzyIndex                    _nodesFuzzyIndex; // node names and paths, rebuilt on demand after changes
+    std::vector<Gtk::TreeModel::iterator> _nodesFuzzyIndexIters;
+    bool                            _nodesFuzzyIndexValid{false};
+    std::unordered_map<gint64, std::shared_ptr<CtNodeState>> _lazyContents;
 };
@@ -26,7 +26,9 @@
 #include <string>
 #include <list>
 #include <set>
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <deque>
 #include <mutex>
 #include <optional>
@@ -312,6 +314,7 @@ struct CtBackupEncryptData
     std::string file_path;
     std::string password;
     std::string extracted_copy;
+    std::unordered_map<gint64, size_t> nodes_checksums;
     time_t* p_mod_time;
 };
 
@@ -337,6 +340,13 @@ struct CtExportOptions
     bool single_file{false};
 };
 
+struct CtTextCounts
+{
+    int words{0};
+    int chars{0};
+    int lines{0};
+};
+
 struct CtSummaryInfo
 {
     size_t nodes_rich_text_num{0u};
@@ -351,6 +361,50 @@ struct CtSummaryInfo
     size_t lighttables_num{0u};
     size_t codeboxes_num{0u};
     size_t anchors_num{0u};
+    size_t words_num{0u};
+    size_t chars_num{0u};
+    size_t lines_num{0u};
+};
+
+struct CtMemoryCount
+{
+    size_t num{0u};
+    size_t bytes{0u};
+
+    void add(const size_t add_bytes) { ++num; bytes += add_bytes; }
+};
+
+// what a node keeps in memory, the text buffer and widgets of shared nodes are on the master
+struct CtMemoryNodeInfo
+{
+    Glib::ustring node_name;
+    CtMemoryCount textBuffer;
+    CtMemoryCount widgets;    // with their pixbufs and blobs
+    CtMemoryCount undoStates;
+    CtMemoryCount delayedXmlDoc; // the content parsed, not yet in the text buffer
+
+    size_t get_bytes() const { return textBuffer.bytes + widgets.bytes + undoStates.bytes + delayedXmlDoc.bytes; }
+};
+
+// Estimate of the memory held by a document: the payloads (text, pixels, blobs, xml)
+// plus the fixed size of the items, not the allocator or toolkit overhead
+struct CtMemoryInfo
+{
+    CtMemoryCount textBuffers;
+    CtMemoryCount widgets;        // the anchored widgets own text or cells
+    CtMemoryCount pixbufs;
+    CtMemoryCount pngBlobs;       // the encoded images, shared by the widgets and the undo states
+    CtMemoryCount embFileBlobs;   // the embedded files read in memory
+    CtMemoryCount undoStates;
+    CtMemoryCount delayedXmlDocs; // the nodes content parsed, not yet in a text buffer
+    CtMemoryCount textTags;
+    std::map<gint64, CtMemoryNodeInfo> nodes;
+    std::unordered_set<const void*>    sharedSeen; // the data shared by widgets and undo states is counted once
+
+    size_t get_total_bytes() const {
+        return textBuffers.bytes + widgets.bytes + pixbufs.bytes + pngBlobs.bytes + embFileBlobs.bytes +
+               undoStates.bytes + delayedXmlDocs.bytes + textTags.bytes;
+    }
 };
 
 template<class F> auto scope_guard(F&& f) {
@@ -376,6 +430,15 @@ public:
         q.pop_front();
         return val;
     }
+    std::optional<T> try_pop_front() {
+        std::optional<T> retVal;
+        std::lock_guard<std::mutex> lock(m);
+        if (not q.empty()) {
+            retVal = std::move(q.front());
+            q.pop_front();
+        }
+        return retVal;
+    }
     std::optional<T> peek() const {
         std::optional<T> retVal;
         std::lock_guard<std::mutex> lock(m);
@@ -517,6 +580,8 @@ private:
 
 enum class CtCurrFindType { None, SingleNode, MultipleNodes };
 
+class CtSearchMatcher;
+
 struct CtSearchState {
     bool           replace_active{false};
     bool           replace_subsequent{false};
@@ -551,6 +616,15 @@ struct CtSearchState {
     Glib::RefPtr<CtMatchDialogStore> match_store;
     Gtk::Dialog*                     pMatchStoreDialog{nullptr};
     bool                             in_loading{false};
+
+    std::shared_ptr<CtSearchMatcher> pLiteralMatcher; // unless the pattern is a regular expression
+    struct CtFoldedText {
+        Glib::ustring    text;
+        GtkTextBuffer*   pTextBuffer;
+        sigc::connection bufferChangedConn; // no longer connected after the buffer is gone
+    };
+    std::unordered_map<gint64, CtFoldedText> foldedTexts; // accent insensitive node texts, dropped on change
+    size_t                                   foldedTextsBytes{0u};
 };
 
 class CtAnchoredWidget;
@@ -23,6 +23,7 @@
 
 #include "ct_widgets.h"
 #include "ct_main_win.h"
+#include "ct_anchors_index.h"
 #include <glib/gstdio.h>
 #include "ct_app.h"
 
@@ -105,9 +106,17 @@ void CtAnchoredWidget::set_hidden(const bool hidden)
     set_visible(!hidden);
 }
 
+CtAnchoredWidget::~CtAnchoredWidget()
+{
+    if (_rTextChildAnchor) {
+        CtAnchorsIndex::set_anchor_widget(_rTextChildAnchor, nullptr);
+    }
+}
+
 void CtAnchoredWidget::insertInTextBuffer(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer)
 {
     _rTextChildAnchor = pTextBuffer->create_child_anchor(pTextBuffer->get_iter_at_offset(_charOffset));
+    CtAnchorsIndex::set_anchor_widget(_rTextChildAnchor, this);
     if (not _justification.empty()) {
         Gtk::TextIter textIterStart = pTextBuffer->get_iter_at_child_anchor(_rTextChildAnchor);
         Gtk::TextIter textIterEnd = textIterStart;
@@ -173,7 +182,7 @@ bool CtTreeView::_on_query_tooltip(int x, int y, bool keyboard_tooltip, const Gl
     }
 
     gchar* pNodeName = nullptr;
-    gtk_tree_model_get(pModel, &treeIter, 1 /* colNodeName */, &pNodeName, -1);
+    gtk_tree_model_get(pModel, &treeIter, 0 /* colNodeName */, &pNodeName, -1);
     if (nullptr == pNodeName) {
         gtk_tree_path_free(pPath);
         return false;
@@ -50,6 +50,7 @@ protected:
 class CtMainWin;
 class CtAnchoredWidgetState;
 class CtStorageCache;
+class CtSqliteStmtsCache;
 
 #if GTKMM_MAJOR_VERSION >= 4
 class CtAnchoredWidget : public Gtk::Frame
@@ -59,7 +60,7 @@ class CtAnchoredWidget : public Gtk::EventBox
 {
 public:
     CtAnchoredWidget(CtMainWin* pCtMainWin, const int charOffset, const std::string& justification);
-    ~CtAnchoredWidget() override {}
+    ~CtAnchoredWidget() override;
 
     void insertInTextBuffer(Glib::RefPtr<Gtk::TextBuffer> pTextBuffer);
     Glib::RefPtr<Gtk::TextChildAnchor> getTextChildAnchor() { return _rTextChildAnchor; }
@@ -67,7 +68,7 @@ public:
     virtual void apply_width_height(const int parentTextWidth) = 0;
     virtual void apply_syntax_highlighting(const bool forceReApply) = 0;
     virtual void to_xml(xmlpp::Element* p_node_parent, const int offset_adjustment, CtStorageCache* cache, const std::string& multifile_dir) = 0;
-    virtual bool to_sqlite(sqlite3* pDb, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) = 0;
+    virtual bool to_sqlite(sqlite3* pDb, CtSqliteStmtsCache& stmtsCache, const gint64 node_id, const int offset_adjustment, CtStorageCache* cache) = 0;
     virtual void set_modified_false() = 0;
     virtual CtAnchWidgType get_type() const = 0;
     virtual std::shared_ptr<CtAnchoredWidgetState> get_state() = 0;
@@ -120,7 +121,7 @@ public:
     void to_xml(xmlpp::Element*/*p_node_parent*/, const int/*offset_adjustment*/, CtStorageCache*/*cache*/, const std::string&/*multifile_dir*/) override {
         spdlog::warn("!! {} UNEXP", __FUNCTION__);
     }
-    bool to_sqlite(sqlite3*/*pDb*/, const gint64/*node_id*/, const int/*offset_adjustment*/, CtStorageCache*/*cache*/) override {
+    bool to_sqlite(sqlite3*/*pDb*/, CtSqliteStmtsCache&/*stmtsCache*/, const gint64/*node_id*/, const int/*offset_adjustment*/, CtStorageCache*/*cache*/) override {
         spdlog::warn("!! {} UNEXP", __FUNCTION__);
         return false;
     }
@@ -201,14 +202,30 @@ public:
                                 const int end_offset = -1) = 0;
     virtual void vacuum() = 0;
     virtual void import_nodes(const fs::path& path, const Gtk::TreeModel::iterator& parent_iter) = 0;
+    // append now the nodes that populate_treestore left to be loaded in background
+    virtual void populate_treestore_complete() {}
 
     virtual Glib::RefPtr<Gtk::TextBuffer> get_delayed_text_buffer(const gint64 node_id,
                                                                   const std::string& syntax,
                                                                   std::list<CtAnchoredWidget*>& widgets) const = 0;
+    // the duplicate of a node not yet loaded reads the same stored content when first needed,
+    // return false if the storage cannot share it (the content of the node is then to be copied)
+    virtual bool delayed_text_buffer_share(const gint64/*node_id*/, const gint64/*copy_node_id*/) { return false; }
+    // true if the save writes the copies still sharing the stored content of their source with no text buffer
+    virtual bool delayed_text_buffer_share_saved() const { return false; }
     virtual fs::path get_embedded_filepath(const CtTreeIter& ct_tree_iter, const std::string& filename) const = 0;
+    // the content parsed but not yet loaded in the tree
+    virtual void populate_memory_info(CtMemoryInfo&/*memoryInfo*/) const {}
+
+    // return false if the storage cannot be watched for external changes (mod time polling instead)
+    virtual bool external_changes_watch_start() { return false; }
+    virtual void external_changes_watch_stop() {}
 
     void set_is_dry_run() { _isDryRun = true; }
+    // node id -> hash of the text of the nodes written by the last save, to verify the saved file cheaply
+    const std::unordered_map<gint64, size_t>& get_written_nodes_checksums() const { return _writtenNodesChecksums; }
 
 protected:
     bool _isDryRun{false};
+    std::unordered_map<gint64, size_t> _writtenNodesChecksums;
 };
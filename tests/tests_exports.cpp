@@ -54,6 +54,9 @@ void TestCtApp::on_activate()
     if (_pVecArgs->at(2) == "--export_to_txt_dir") {
         _export_to_txt_dir = _pVecArgs->at(3);
     }
+    else if (_pVecArgs->at(2) == "--export_to_md_dir") {
+        _export_to_md_dir = _pVecArgs->at(3);
+    }
     else if (_pVecArgs->at(2) == "--export_to_pdf_dir") {
         _export_to_pdf_dir = _pVecArgs->at(3);
     }
@@ -68,7 +71,7 @@ void TestCtApp::on_activate()
     on_open(files, "");
 }
 
-enum class ExportType { None, Txt, Pdf, Html };
+enum class ExportType { None, Txt, Md, Pdf, Html };
 
 class ExportsMultipleParametersTests : public ::testing::TestWithParam<std::tuple<std::string, std::string>>
 {
@@ -86,6 +89,10 @@ TEST_P(ExportsMultipleParametersTests, ChecksExports)
         exportType = ExportType::Txt;
         tmpFilepath = tmpDirpath / (Glib::path_get_basename(inDocPath)+".txt");
     }
+    else if (exportSwitch.find("_md_") != std::string::npos) {
+        exportType = ExportType::Md;
+        tmpFilepath = tmpDirpath / (Glib::path_get_basename(inDocPath)+".md");
+    }
     else if (exportSwitch.find("pdf") != std::string::npos) {
         exportType = ExportType::Pdf;
         tmpFilepath = tmpDirpath / (Glib::path_get_basename(inDocPath)+".pdf");
@@ -110,6 +117,18 @@ TEST_P(ExportsMultipleParametersTests, ChecksExports)
         ASSERT_STREQ(str::replace(expectTxt, "\n", "\r\n").c_str(), resultTxt.c_str());
 #else
         ASSERT_STREQ(expectTxt.c_str(), resultTxt.c_str());
+#endif
+    }
+    else if (ExportType::Md == exportType) {
+        std::string expectMd_path{Glib::build_filename(UT::unitTestsDataDir, "test.export.md")};
+        std::string expectMd = Glib::file_get_contents(expectMd_path);
+        std::string resultMd = Glib::file_get_contents(tmpFilepath.string());
+        ASSERT_FALSE(resultMd.empty());
+        //g_file_set_contents(Glib::build_filename(UT::unitTestsDataDir, "test.export.mdd").c_str(), resultMd.c_str(), -1, NULL);
+#if defined(_WIN32)
+        ASSERT_STREQ(str::replace(expectMd, "\n", "\r\n").c_str(), resultMd.c_str());
+#else
+        ASSERT_STREQ(expectMd.c_str(), resultMd.c_str());
 #endif
     }
     else if (ExportType::Pdf == exportType) {
@@ -138,9 +157,62 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(
             std::make_tuple(UT::testCtbDocPath, "--export_to_txt_dir"),
             std::make_tuple(UT::testCtdDocPath, "--export_to_txt_dir"),
+            std::make_tuple(UT::testCtbDocPath, "--export_to_md_dir"),
+            std::make_tuple(UT::testCtdDocPath, "--export_to_md_dir"),
             std::make_tuple(UT::testCtbDocPath, "--export_to_pdf_dir"),
             std::make_tuple(UT::testCtdDocPath, "--export_to_pdf_dir"),
             std::make_tuple(UT::testCtbDocPath, "--export_to_html_dir"),
             std::make_tuple(UT::testCtdDocPath, "--export_to_html_dir"),
             std::make_tuple(UT::testMultiFileSourCherry, "--export_to_txt_dir"))
 );
+
+class ExportsMdMultipleFilesTests : public ::testing::TestWithParam<std::string>
+{
+};
+
+// a file per node, rendered by the worker threads
+TEST_P(ExportsMdMultipleFilesTests, ChecksExportsMdMultipleFiles)
+{
+    TestCtApp testCtApp{};
+    const std::string inDocPath = GetParam();
+    fs::path tmpDirpath = testCtApp.getCtTmp()->getHiddenDirPath("UT");
+    const std::vector<std::string> vec_args{"cherrytree", inDocPath, "--export_to_md_dir", tmpDirpath.string()};
+    testCtApp.register_args(&vec_args);
+    gchar** pp_args = CtStrUtil::vector_to_array(vec_args);
+    testCtApp.run(vec_args.size(), pp_args);
+    const fs::path exportDirpath = tmpDirpath / (Glib::path_get_basename(inDocPath)+"_MD");
+    ASSERT_TRUE(fs::is_directory(exportDirpath));
+    size_t num_md_files{0};
+    for (const fs::path& filepath : fs::get_dir_entries(exportDirpath)) {
+        if (filepath.extension() == ".md") {
+            ASSERT_NE(0, fs::file_size(filepath));
+            ++num_md_files;
+        }
+    }
+    ASSERT_EQ(10u, num_md_files); // also the shared node copy
+
+    // the content of a node is the same as in the single file, without the node anchor
+    const std::string expectMd = Glib::file_get_contents(Glib::build_filename(UT::unitTestsDataDir, "test.export.md"));
+    const std::string nodeAnchorB{"<a id=\"node-2\"></a>\n\n"};
+    const size_t startB = expectMd.find(nodeAnchorB) + nodeAnchorB.size();
+    std::string expectB = expectMd.substr(startB, expectMd.find("<a id=\"node-3\"></a>") - startB);
+    std::string resultB = Glib::file_get_contents((exportDirpath / "b_2.md").string());
+#if defined(_WIN32)
+    expectB = str::replace(expectB, "\n", "\r\n");
+#endif
+    ASSERT_STREQ(expectB.c_str(), resultB.c_str());
+
+    // the links to the nodes go to their files
+    const std::string resultE = Glib::file_get_contents((exportDirpath / "e_5.md").string());
+    ASSERT_TRUE(resultE.find("[link to node ‘d’](d_4.md)") != std::string::npos);
+    ASSERT_TRUE(resultE.find("[link to node ‘e’ + anchor](e_5.md#йцукенгшщз)") != std::string::npos);
+    ASSERT_TRUE(fs::is_regular_file(exportDirpath / "images" / "5-1.png"));
+    ASSERT_TRUE(fs::is_regular_file(exportDirpath / "EmbeddedFiles" / "5-йцукенгшщз.txt"));
+    g_strfreev(pp_args);
+}
+
+INSTANTIATE_TEST_CASE_P(
+        ExportsTests,
+        ExportsMdMultipleFilesTests,
+        ::testing::Values(UT::testCtbDocPath, UT::testCtdDocPath)
+);
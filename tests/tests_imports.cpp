@@ -22,6 +22,7 @@
  */
 
 #include "ct_imports.h"
+#include "ct_parser.h"
 #include "ct_config.h"
 #include "ct_filesystem.h"
 #include "tests_common.h"
@@ -74,3 +75,101 @@ TEST(ImportsGroup, TomboyEmptyTagDoesNotCrash)
       ASSERT_STREQ("Harmless Meeting Note", importedNode->node_name.c_str());
     }
 }
+
+TEST(ImportsGroup, MdImportMatchesExpected)
+{
+    Glib::init();
+
+    const fs::path mdPath{UT::unitTestsDataDir + "/md_testfile.md"};
+    CtMDImport importer{CtConfig::GetCtConfig()};
+    std::unique_ptr<CtImportedNode> importedNode = importer.import_file(mdPath);
+    ASSERT_TRUE(importedNode);
+    ASSERT_STREQ("md_testfile", importedNode->node_name.c_str());
+
+    // the rich text runs (attributes and text) of the document given by the importer before
+    // the tokenizer worked on views of the mapped file
+    const std::vector<std::pair<std::string, std::string>> expectedRuns{
+        {"scale=h1", "H1\n"},
+        {"scale=h2", "H2\n"},
+        {"scale=h3", "H3\n"},
+        {"scale=h3", "H4\n"},
+        {"", "\n"},
+        {"", "• "},
+        {"", "List item 1"},
+        {"", "\n"},
+        {"", "• "},
+        {"", "List item 2"},
+        {"", "\n"},
+        {"", "• "},
+        {"", "List item 3"},
+        {"", "\n"},
+        {"", "\n\n"},
+        {"strikethrough=true", "StrikedOuted"},
+        {"", "\n\n"},
+        {"weight=heavy", "Italic"},
+        {"", "\n\n"},
+        {"weight=heavy", "Bold"},
+        {"", " "},
+        {"weight=heavy", "Italic AND Bold"},
+        {"", "**\n\n"},
+        {"weight=heavy", "Italic"},
+        {"", " and then **bold** and then **"},
+        {"weight=heavy", "bold and italic"},
+        {"", "**\n\n\n"},
+        {"", "And I am a "},
+        {"link=webs https://google.com", "link to google"},
+        {"", "\n\n(I a some text in brackets)\n\n"},
+    };
+    std::vector<std::pair<std::string, std::string>> runs;
+    xmlpp::Node* pSlot = importedNode->xml_content->get_root_node()->get_first_child("slot");
+    ASSERT_TRUE(pSlot);
+    for (xmlpp::Node* pNode : pSlot->get_children("rich_text")) {
+        auto pElement = static_cast<xmlpp::Element*>(pNode);
+        const xmlpp::TextNode* pTextNode = pElement->get_child_text();
+        if (not pTextNode) {
+            continue;
+        }
+        std::string attributes;
+        for (const xmlpp::Attribute* pAttribute : pElement->get_attributes()) {
+            if (not attributes.empty()) attributes += " ";
+            attributes += pAttribute->get_name() + "=" + pAttribute->get_value();
+        }
+        runs.emplace_back(attributes, pTextNode->get_content());
+    }
+    ASSERT_EQ(expectedRuns, runs);
+}
+
+TEST(ImportsGroup, MdTokensAreViewsOnTheText)
+{
+    CtMDParser parser{CtConfig::GetCtConfig()};
+    const std::string text{"# H1\n* item **bold** and [link](https://example.com) `code`\n| a | b |\n"};
+    const std::vector<std::string_view> tokens = parser.text_parser()->tokenize(text);
+    ASSERT_FALSE(tokens.empty());
+    std::string joined;
+    for (const std::string_view token : tokens) {
+        if (not token.empty()) {
+            ASSERT_TRUE(token.data() >= text.data() and token.data() + token.size() <= text.data() + text.size());
+        }
+        joined += token;
+    }
+    ASSERT_EQ(text, joined);
+
+    // and so are the contents of the parsed tokens, but for the ones around an escape
+    const CtTextParser::token_stream_t token_stream = parser.text_parser()->parse_tokens(tokens);
+    ASSERT_FALSE(token_stream.tokens.empty());
+    for (const auto& token : token_stream.tokens) {
+        if (not token.second.empty() and
+            std::none_of(token_stream.joined_contents.begin(), token_stream.joined_contents.end(),
+                         [&token](const std::string& joinedContent){ return joinedContent.data() == token.second.data(); }))
+        {
+            ASSERT_TRUE(token.second.data() >= text.data() and token.second.data() + token.second.size() <= text.data() + text.size());
+        }
+    }
+    const std::string textEscape{"**a\\*b**"};
+    const std::vector<std::string_view> tokensEscape = parser.text_parser()->tokenize(textEscape);
+    const CtTextParser::token_stream_t token_stream_escape = parser.text_parser()->parse_tokens(tokensEscape);
+    ASSERT_EQ(1u, token_stream_escape.tokens.size());
+    ASSERT_TRUE(token_stream_escape.tokens.front().first);
+    ASSERT_EQ("a*b", token_stream_escape.tokens.front().second);
+    ASSERT_EQ(1u, token_stream_escape.joined_contents.size());
+}
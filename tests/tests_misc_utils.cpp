@@ -22,10 +22,16 @@
  */
 
 #include "ct_misc_utils.h"
+#include "ct_text_counters.h"
 #include "ct_const.h"
 #include "ct_filesystem.h"
+#include "ct_fuzzy_index.h"
+#include "ct_task_pool.h"
+#include "ct_search_matcher.h"
 #include "tests_common.h"
+#include <atomic>
 #include <cstdint>
+#include <future>
 #include <thread>
 
 TEST(MiscUtilsGroup, get_encoding)
@@ -293,6 +299,37 @@ TEST(MiscUtilsGroup, iter_util__get_words_count_ustring)
     ASSERT_EQ(CtTextIterUtil::get_words_count(text), CtTextIterUtil::get_words_count(pTextBuffer));
 }
 
+TEST(MiscUtilsGroup, text_counters_incremental)
+{
+    Glib::init();
+    Glib::RefPtr<Gtk::TextBuffer> pTextBuffer = Gtk::TextBuffer::create();
+    pTextBuffer->set_text("one two\nthree four five\n\nsix");
+    const CtTextCounters& textCounters = CtTextCounters::get(pTextBuffer);
+    ASSERT_EQ(6, textCounters.get_words());
+    ASSERT_EQ(4, textCounters.get_lines());
+    auto f_assert_as_recount = [&](){
+        ASSERT_EQ(CtTextIterUtil::get_words_count(pTextBuffer->get_text(true)), textCounters.get_words());
+        ASSERT_EQ(static_cast<int>(pTextBuffer->get_text(true).size()), textCounters.get_chars());
+    };
+    // split a word
+    pTextBuffer->insert(pTextBuffer->get_iter_at_offset(2), " ");
+    f_assert_as_recount();
+    ASSERT_EQ(7, textCounters.get_words());
+    // join two lines
+    pTextBuffer->erase(pTextBuffer->get_iter_at_offset(8), pTextBuffer->get_iter_at_offset(9));
+    f_assert_as_recount();
+    ASSERT_EQ(3, textCounters.get_lines());
+    // multi line insert and erase across lines
+    pTextBuffer->insert(pTextBuffer->get_iter_at_offset(4), "seven\neight nine\n");
+    f_assert_as_recount();
+    pTextBuffer->erase(pTextBuffer->get_iter_at_offset(1), pTextBuffer->get_iter_at_offset(20));
+    f_assert_as_recount();
+    pTextBuffer->set_text("");
+    f_assert_as_recount();
+    ASSERT_EQ(0, textCounters.get_words());
+    ASSERT_EQ(1, textCounters.get_lines());
+}
+
 TEST(MiscUtilsGroup, contains)
 {
     ASSERT_TRUE(CtStrUtil::contains(CtConst::TAG_PROPERTIES, CtConst::TAG_STRIKETHROUGH));
@@ -591,8 +628,8 @@ TEST(MiscUtilsGroup, parallel_for)
     ASSERT_TRUE(check_range_in_vec(vec, 1, 1) == false);
     ASSERT_TRUE(check_range_in_vec(vec, 1, 2) == false);
 
-    // parallel_for splits the given range on slices, one slice per thread.
-    // The formula to calculate slices is not simple, so the unit test checks that every element
+    // parallel_for hands out the indexes of the given range to the task pool workers and the caller.
+    // The unit test checks that every element
     // in the given range is processed, processed only once, no one is skipped,
     // and elements that are out of the range should not be touched.
     // To be sure, it is checked for different combinations of ranges, including empty range.
@@ -608,6 +645,44 @@ TEST(MiscUtilsGroup, parallel_for)
         }
 }
 
+TEST(MiscUtilsGroup, task_pool)
+{
+    CtTaskPool& taskPool = CtTaskPool::get();
+    ASSERT_GT(taskPool.get_workers_num(), 0u);
+
+    // nested in the tasks, each caller takes part in its own range so that no one waits forever
+    std::atomic<size_t> sum{0};
+    taskPool.parallel_for(0, 8, [&](size_t outer){
+        taskPool.parallel_for(0, 100, [&](size_t inner){
+            sum += outer * 100 + inner;
+        });
+    });
+    ASSERT_EQ(319600u, sum.load());
+
+    // with all the workers busy, a task cancelled after being submitted is never started
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic<size_t> blocked{0};
+    for (size_t i = 0; i < taskPool.get_workers_num(); ++i) {
+        taskPool.submit([&blocked, gate](){
+            ++blocked;
+            gate.wait();
+        }, CtTaskPool::Priority::High);
+    }
+    while (blocked < taskPool.get_workers_num()) {
+        std::this_thread::yield();
+    }
+    std::atomic<bool> cancelled_ran{false};
+    CtTaskPool::CancelToken cancelToken;
+    taskPool.submit([&cancelled_ran](){ cancelled_ran = true; }, CtTaskPool::Priority::High, cancelToken);
+    cancelToken.cancel();
+    std::promise<void> done;
+    taskPool.submit([&done](){ done.set_value(); }, CtTaskPool::Priority::Low);
+    release.set_value();
+    done.get_future().wait();
+    ASSERT_FALSE(cancelled_ran);
+}
+
 TEST(MiscUtilsGroup, get_link_entry_from_property)
 {
     ASSERT_EQ(CtLinkType::Webs, CtMiscUtil::get_link_entry_from_property("webs https://example.com").type);
@@ -673,9 +748,83 @@ TEST(MiscUtilsGroup, contains_words)
     ASSERT_FALSE(CtStrUtil::contains_words(Glib::ustring{"uno due tre"}, {Glib::ustring{"quattro"}, Glib::ustring{"cinque"}}, false/*require_all*/));
 }
 
+TEST(MiscUtilsGroup, fuzzy_index)
+{
+    CtFuzzyIndex fuzzyIndex;
+    fuzzyIndex.add(11, "Uno", "Uno");
+    fuzzyIndex.add(12, "Due Tre", "Uno / Due Tre");
+    fuzzyIndex.add(13, "Tre", "Quattro / Tre");
+    fuzzyIndex.add(14, "Cinque", "Quattro / Cinque");
+    ASSERT_STREQ("uno due", CtFuzzyIndex::normalise_filter("  UNO \t  Due ").c_str());
+
+    auto f_ids = [&](const Glib::ustring& filter, const size_t max_results) {
+        std::vector<gint64> ids;
+        for (const CtFuzzyIndex::Match& match : fuzzyIndex.query(filter, max_results)) {
+            ids.push_back(fuzzyIndex.get_id(match.idx));
+        }
+        return ids;
+    };
+    // label starts with < label contains < path contains
+    ASSERT_EQ(std::vector<gint64>({13, 12}), f_ids("tre", 10));
+    ASSERT_EQ(std::vector<gint64>({11, 12}), f_ids("UNO", 10));
+    ASSERT_EQ(std::vector<gint64>({13, 14}), f_ids("quattro", 10));
+    // extending the query narrows the previous candidates
+    ASSERT_EQ(std::vector<gint64>({13, 14}), f_ids("q", 10));
+    ASSERT_EQ(std::vector<gint64>({14, 13}), f_ids("quattro cin", 10));
+    ASSERT_EQ(std::vector<gint64>({13, 14}), f_ids("quattro", 10));
+    ASSERT_EQ(std::vector<gint64>{}, f_ids("sei", 10));
+    // top N
+    ASSERT_EQ(std::vector<gint64>({11, 12}), f_ids("", 2));
+    ASSERT_EQ(std::vector<gint64>({13}), f_ids("tre", 1));
+}
+
 TEST(MiscUtilsGroup, highlight_words)
 {
     ASSERT_STREQ("uno <b>due</b> <b>tre</b>", CtStrUtil::highlight_words(Glib::ustring{"uno due tre"}, {Glib::ustring{"due"}, Glib::ustring{"tre"}}).c_str());
     ASSERT_STREQ("uno <u>due</u> <u>tre</u>", CtStrUtil::highlight_words(Glib::ustring{"uno due tre"}, {Glib::ustring{"due"}, Glib::ustring{"tre"}}, "u").c_str());
     ASSERT_STREQ("uno <b>due</b> <b>tre</b>", CtStrUtil::highlight_words(Glib::ustring{"uno due tre"}, {Glib::ustring{"tre"}, Glib::ustring{"due"}}).c_str());
 }
+
+TEST(MiscUtilsGroup, search_matcher)
+{
+    ASSERT_FALSE(CtSearchMatcher::create_literal("", true/*match_case*/, false/*whole_word*/, false/*start_word*/));
+    ASSERT_FALSE(CtSearchMatcher::create_literal("città", false/*match_case*/, false/*whole_word*/, false/*start_word*/));
+
+    auto pMatcher = CtSearchMatcher::create_literal("due", true/*match_case*/, false/*whole_word*/, false/*start_word*/);
+    const Glib::ustring text{"uno due Due già due"};
+    ASSERT_EQ(std::make_pair(4, 7), pMatcher->find(text));
+    ASSERT_EQ(std::make_pair(17, 20), pMatcher->find(text, 5u)); // byte positions, 'à' is two bytes
+    ASSERT_EQ(std::make_pair(-1, -1), pMatcher->find(text.data(), 19u, 5u));
+
+    pMatcher = CtSearchMatcher::create_literal("DUE", false/*match_case*/, false/*whole_word*/, false/*start_word*/);
+    ASSERT_EQ(std::make_pair(8, 11), pMatcher->find(text, 5u));
+
+    pMatcher = CtSearchMatcher::create_literal("ab", true/*match_case*/, true/*whole_word*/, false/*start_word*/);
+    ASSERT_EQ(std::make_pair(12, 14), pMatcher->find(Glib::ustring{"abc xab àb ab"}));
+    ASSERT_EQ(std::make_pair(0, 2), pMatcher->find("abc", 2u, 0u)); // no word after the given length
+
+    pMatcher = CtSearchMatcher::create_literal("ab", true/*match_case*/, false/*whole_word*/, true/*start_word*/);
+    ASSERT_EQ(std::make_pair(5, 7), pMatcher->find(Glib::ustring{"éab abc"}));
+}
+
+TEST(MiscUtilsGroup, memory_info)
+{
+    ASSERT_STREQ("1023 B", CtMiscUtil::bytes_to_human_readable(1023u).c_str());
+    ASSERT_STREQ("1.5 KB", CtMiscUtil::bytes_to_human_readable(1536u).c_str());
+    ASSERT_STREQ("2.0 MB", CtMiscUtil::bytes_to_human_readable(2u*1024u*1024u).c_str());
+
+    CtMemoryInfo memoryInfo;
+    memoryInfo.nodes[1].textBuffer.add(100u);
+    memoryInfo.nodes[2].textBuffer.add(10u);
+    memoryInfo.nodes[2].undoStates.add(500u);
+    memoryInfo.nodes[3].widgets.add(200u);
+    memoryInfo.textBuffers.add(110u);
+    memoryInfo.undoStates.add(500u);
+    ASSERT_EQ(610u, memoryInfo.get_total_bytes());
+    const auto nodes = CtMiscUtil::get_memory_info_nodes_sorted(memoryInfo);
+    ASSERT_EQ(3u, nodes.size());
+    ASSERT_EQ(2, nodes.at(0).first);
+    ASSERT_EQ(3, nodes.at(1).first);
+    ASSERT_EQ(1, nodes.at(2).first);
+    ASSERT_EQ(510u, nodes.at(0).second->get_bytes());
+}
@@ -24,6 +24,7 @@
 #include "ct_app.h"
 #include "ct_misc_utils.h"
 #include "ct_storage_control.h"
+#include "ct_actions.h"
 #include "tests_common.h"
 
 class TestCtApp : public CtApp
@@ -51,6 +52,7 @@ private:
     void _run_test(const fs::path doc_filepath_from, const fs::path doc_filepath_to);
     void _assert_tree_data(CtMainWin* pWin, const bool after_mods);
     void _assert_node_text(CtTreeIter& ctTreeIter, const Glib::ustring& expectedText);
+    void _assert_memory_info(CtMainWin* pWin, const CtDocType docType, const bool all_loaded);
     void _process_rich_text_buffer(CtMainWin* pWin, std::list<ExpectedTag>& expectedTags, Glib::RefPtr<Gtk::TextBuffer> pTextBuffer);
 
     const std::vector<std::string>& _vec_args;
@@ -104,8 +106,11 @@ void TestCtApp::_run_test(const fs::path doc_filepath_from, const fs::path doc_f
     ASSERT_FALSE(pWin2->get_tree_store().get_iter_first());
     // load file previously saved
     ASSERT_TRUE(pWin2->file_open(tmp_filepath, ""/*file*/, ""/*anchor*/, docEncrypt_to != CtDocEncrypt::True ? "" : UT::testPasswordBis));
+    _assert_memory_info(pWin2, doc_type, false/*all_loaded*/);
     // check tree
     _assert_tree_data(pWin2, false/*after_mods*/);
+    // the summary info has loaded all the nodes
+    _assert_memory_info(pWin2, doc_type, true/*all_loaded*/);
 
     const CtStorageSyncPending* pCtStorageSyncPending = pWin2->get_ct_storage()->get_storage_sync_pending();
     {
@@ -113,6 +118,10 @@ void TestCtApp::_run_test(const fs::path doc_filepath_from, const fs::path doc_f
         CtTreeIter ctTreeIter = pWin2->get_tree_store().get_node_from_node_name("e");
         auto pTextBuffer = ctTreeIter.get_node_text_buffer();
         pTextBuffer->insert(pTextBuffer->end(), "after_mods");
+        // two links of the same type side by side share the link tag, the targets are told apart by the links index
+        const int after_offset = pTextBuffer->end().get_offset() - 10;
+        pWin2->apply_link_tag(pTextBuffer, "webs http://www.after.it", pTextBuffer->get_iter_at_offset(after_offset), pTextBuffer->get_iter_at_offset(after_offset + 6));
+        pWin2->apply_link_tag(pTextBuffer, "webs http://www.mods.it", pTextBuffer->get_iter_at_offset(after_offset + 6), pTextBuffer->end());
         pWin2->update_window_save_needed(CtSaveNeededUpdType::nbuf, false/*new_machine_state*/, &ctTreeIter);
         const auto node_data_holder_id = ctTreeIter.get_node_id_data_holder();
         ASSERT_TRUE(pCtStorageSyncPending->nodes_to_write_dict.at(node_data_holder_id).buff);
@@ -179,6 +188,42 @@ void TestCtApp::_run_test(const fs::path doc_filepath_from, const fs::path doc_f
     remove_window(*pWin3);
 }
 
+void TestCtApp::_assert_memory_info(CtMainWin* pWin, const CtDocType docType, const bool all_loaded)
+{
+    CtMemoryInfo memoryInfo{};
+    pWin->get_tree_store().populate_memory_info(memoryInfo);
+    CtMemoryCount nodesDelayedXmlDocs;
+    for (const auto& [node_id, nodeInfo] : memoryInfo.nodes) {
+        nodesDelayedXmlDocs.num += nodeInfo.delayedXmlDoc.num;
+        nodesDelayedXmlDocs.bytes += nodeInfo.delayedXmlDoc.bytes;
+    }
+    // the parsed documents of the nodes not yet loaded are all given to a node
+    ASSERT_EQ(memoryInfo.delayedXmlDocs.num, nodesDelayedXmlDocs.num);
+    ASSERT_EQ(memoryInfo.delayedXmlDocs.bytes, nodesDelayedXmlDocs.bytes);
+    if (not all_loaded) {
+        if (CtDocType::SQLite == docType) ASSERT_EQ(0u, memoryInfo.delayedXmlDocs.num);
+        else ASSERT_LT(0u, memoryInfo.delayedXmlDocs.num);
+        return;
+    }
+    ASSERT_EQ(0u, memoryInfo.delayedXmlDocs.num);
+    // 10 nodes, one of them the copy of a shared node
+    ASSERT_EQ(9u, memoryInfo.textBuffers.num);
+    ASSERT_LT(0u, memoryInfo.textBuffers.bytes);
+    // codebox, two tables, latex, image, anchor, embedded file
+    ASSERT_EQ(7u, memoryInfo.widgets.num);
+    ASSERT_EQ(1u, memoryInfo.pngBlobs.num);
+    ASSERT_LT(0u, memoryInfo.pngBlobs.bytes);
+    ASSERT_LE(1u, memoryInfo.pixbufs.num);
+    ASSERT_LT(0u, memoryInfo.textTags.num);
+    // all the objects are in the master of the shared node "e"
+    CtTreeIter ctTreeIter = pWin->get_tree_store().get_node_from_node_name("e");
+    ASSERT_TRUE(ctTreeIter);
+    const CtMemoryNodeInfo& nodeInfo = memoryInfo.nodes.at(ctTreeIter.get_node_id_data_holder());
+    ASSERT_EQ(1u, nodeInfo.textBuffer.num);
+    ASSERT_EQ(7u, nodeInfo.widgets.num);
+    ASSERT_LT(memoryInfo.pngBlobs.bytes, nodeInfo.widgets.bytes);
+}
+
 void TestCtApp::_process_rich_text_buffer(CtMainWin* pWin, std::list<ExpectedTag>& expectedTags, Glib::RefPtr<Gtk::TextBuffer> pTextBuffer)
 {
     CtTextIterUtil::SerializeFunc test_slot = [&expectedTags](Gtk::TextIter& start_iter,
@@ -546,10 +591,22 @@ void TestCtApp::_assert_tree_data(CtMainWin* pWin, const bool after_mods)
                 .text_slot="link to file /etc/fstab",
                 .attr_map=CtCurrAttributesMap{{CtConst::TAG_LINK, "file L2V0Yy9mc3RhYg=="}}},
         };
+        if (after_mods) {
+            expectedTags.push_back(ExpectedTag{
+                .text_slot="after_",
+                .attr_map=CtCurrAttributesMap{{CtConst::TAG_LINK, "webs http://www.after.it"}}});
+            expectedTags.push_back(ExpectedTag{
+                .text_slot="mods",
+                .attr_map=CtCurrAttributesMap{{CtConst::TAG_LINK, "webs http://www.mods.it"}}});
+        }
         _process_rich_text_buffer(pWin, expectedTags, ctTreeIter.get_node_text_buffer());
         for (auto& expTag : expectedTags) {
             ASSERT_TRUE(expTag.found);
         }
+        // one tag per link type, not per link target
+        ASSERT_TRUE(pWin->get_text_tag_table()->lookup("link_webs"));
+        ASSERT_TRUE(pWin->get_text_tag_table()->lookup("link_file"));
+        ASSERT_FALSE(pWin->get_text_tag_table()->lookup("link_webs http://www.ansa.it"));
         // assert anchored widgets
         std::list<CtAnchoredWidget*> anchoredWidgets = ctTreeIter.get_anchored_widgets();
         ASSERT_EQ(7, anchoredWidgets.size());
@@ -723,3 +780,120 @@ INSTANTIATE_TEST_CASE_P(
                 std::make_tuple(UT::testCtzDocPath, UT::testCtxDocPath, false/*test_save*/),
                 std::make_tuple(UT::testCtzDocPath, UT::testMultiFilePath, false/*test_save*/))
 );
+
+class TestCtAppDuplicate : public CtApp
+{
+public:
+    TestCtAppDuplicate(const std::string& doc_filepath)
+     : CtApp{"_test_read_write_duplicate"}
+     , _doc_filepath{doc_filepath}
+    {
+        _no_gui = true;
+    }
+
+private:
+    void on_activate() final;
+
+    const std::string _doc_filepath;
+};
+
+void TestCtAppDuplicate::on_activate()
+{
+    _on_startup();
+    // the duplicated nodes are saved into a copy of the document
+    const fs::path doc_filepath_from{_doc_filepath};
+    const fs::path tmp_filepath = _uCtTmp->getHiddenDirPath("UT") / doc_filepath_from.filename();
+    ASSERT_TRUE(fs::copy_file(doc_filepath_from, tmp_filepath));
+
+    CtMainWin* pWin = _create_window(true/*start_hidden*/);
+    ASSERT_TRUE(pWin->file_open(tmp_filepath, ""/*node_to_focus*/, ""/*anchor_to_focus*/, ""/*password*/));
+    CtTreeStore& treeStore = pWin->get_tree_store();
+    {
+        // move the rich text node "d", loaded, under "b"
+        CtTreeIter ctTreeIter = treeStore.get_node_from_node_name("d");
+        CtTreeIter ctTreeIterNewParent = treeStore.get_node_from_node_name("b");
+        Gtk::TreeModel::iterator new_node_iter = treeStore.get_store()->append(ctTreeIterNewParent->children());
+        CtNodeData node_data;
+        treeStore.get_node_data(ctTreeIter, node_data, true/*loadTextBuffer*/);
+        treeStore.update_node_data(new_node_iter, node_data);
+        treeStore.get_store()->erase(ctTreeIter);
+        treeStore.to_ct_tree_iter(new_node_iter).pending_edit_db_node_hier();
+    }
+    // duplicate "b" and its sub nodes, the copy is the next sibling
+    pWin->get_tree_view().set_cursor_safe(treeStore.get_node_from_node_name("b"));
+    pWin->get_ct_actions()->node_subnodes_duplicate();
+    auto f_get_node = [&](const char* path)->CtTreeIter{
+        return treeStore.to_ct_tree_iter(treeStore.get_store()->get_iter(path));
+    };
+    ASSERT_STREQ("b", f_get_node("2").get_node_name().c_str());
+    std::shared_ptr<CtNodeState> pNodeState;
+    // "c" not loaded shares the stored content, "d" loaded is a snapshot
+    ASSERT_TRUE(treeStore.lazy_content_get(f_get_node("2:0").get_node_id(), pNodeState));
+    ASSERT_FALSE(pNodeState);
+    ASSERT_TRUE(treeStore.lazy_content_get(f_get_node("2:3").get_node_id(), pNodeState));
+    ASSERT_TRUE(pNodeState);
+
+    ASSERT_TRUE(pWin->file_save(false/*need_vacuum*/));
+    // the copies are written with no text buffer
+    for (const char* path : {"2:0", "2:1", "2:1:0", "2:1:1", "2:2", "2:3"}) {
+        ASSERT_FALSE(f_get_node(path).get_node_buffer_already_loaded());
+    }
+    pWin->force_exit() = true;
+    remove_window(*pWin);
+
+    CtMainWin* pWin2 = _create_window(true/*start_hidden*/);
+    ASSERT_TRUE(pWin2->file_open(tmp_filepath, ""/*node_to_focus*/, ""/*anchor_to_focus*/, ""/*password*/));
+    CtTreeStore& treeStore2 = pWin2->get_tree_store();
+    for (const char* path : {"1", "1:0", "1:1", "1:1:0", "1:1:1", "1:2", "1:3"}) {
+        std::string path_copy{path};
+        path_copy[0] = '2';
+        CtTreeIter ctTreeIter = treeStore2.to_ct_tree_iter(treeStore2.get_store()->get_iter(path));
+        CtTreeIter ctTreeIterCopy = treeStore2.to_ct_tree_iter(treeStore2.get_store()->get_iter(path_copy));
+        ASSERT_TRUE(ctTreeIter);
+        ASSERT_TRUE(ctTreeIterCopy);
+        ASSERT_NE(ctTreeIter.get_node_id(), ctTreeIterCopy.get_node_id());
+        ASSERT_STREQ(ctTreeIter.get_node_name().c_str(), ctTreeIterCopy.get_node_name().c_str());
+        ASSERT_STREQ(ctTreeIter.get_node_syntax_highlighting().c_str(), ctTreeIterCopy.get_node_syntax_highlighting().c_str());
+        ASSERT_EQ(ctTreeIter.get_node_is_bold(), ctTreeIterCopy.get_node_is_bold());
+        ASSERT_STREQ(ctTreeIter.get_node_text_buffer()->get_text().c_str(), ctTreeIterCopy.get_node_text_buffer()->get_text().c_str());
+    }
+    ASSERT_STREQ("d", treeStore2.to_ct_tree_iter(treeStore2.get_store()->get_iter("2:3")).get_node_name().c_str());
+    pWin2->force_exit() = true;
+    remove_window(*pWin2);
+}
+
+class ReadWriteDuplicateTests : public ::testing::TestWithParam<std::string>
+{
+};
+
+TEST_P(ReadWriteDuplicateTests, ChecksDuplicateSaveReopen)
+{
+    const std::vector<std::string> vec_args{"cherrytree"};
+    gchar** pp_args = CtStrUtil::vector_to_array(vec_args);
+    TestCtAppDuplicate testCtApp{GetParam()};
+    testCtApp.run(vec_args.size(), pp_args);
+    g_strfreev(pp_args);
+}
+
+INSTANTIATE_TEST_CASE_P(
+        ReadWriteTests,
+        ReadWriteDuplicateTests,
+        ::testing::Values(UT::testCtbDocPath, UT::testCtdDocPath)
+);
+
+TEST(ReadWriteTests, QuickIntegrityCheck)
+{
+    Glib::ustring error;
+    ASSERT_TRUE(CtStorageControl::document_quick_integrity_check_pass(UT::testCtbDocPath, {}/*nodes_checksums*/, error));
+    ASSERT_TRUE(CtStorageControl::document_quick_integrity_check_pass(UT::testCtdDocPath, {}/*nodes_checksums*/, error));
+    // the text of a node is not what we wrote
+    ASSERT_FALSE(CtStorageControl::document_quick_integrity_check_pass(UT::testCtbDocPath, {{1, 0u}}, error));
+    ASSERT_FALSE(error.empty());
+
+    const fs::path broken_ctd_path{Glib::build_filename(Glib::get_tmp_dir(), "ct_ut_broken.ctd")};
+    Glib::file_set_contents(broken_ctd_path.string(), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<cherrytree><node name=\"a\">");
+    error.clear();
+    ASSERT_FALSE(CtStorageControl::document_quick_integrity_check_pass(broken_ctd_path, {}/*nodes_checksums*/, error));
+    ASSERT_FALSE(error.empty());
+    (void)fs::remove(broken_ctd_path);
+}